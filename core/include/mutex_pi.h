@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    core_sync_mutex_pi Priority inheritance mutex
+ * @ingroup     core_sync
+ * @brief       Mutex that bounds priority inversion
+ *
+ * A plain @ref mutex_t queues its waiters by priority, but the owner keeps
+ * running at its own priority. If a low priority thread holds the mutex, a
+ * high priority waiter can be delayed for an unbounded time by any number of
+ * medium priority threads preempting the owner.
+ *
+ * A @ref mutex_pi_t raises the priority of its owner to the priority of the
+ * highest priority waiter for as long as the mutex is held, so the waiter is
+ * only blocked for the duration of the critical section itself. The owner's
+ * priority is restored when it unlocks the mutex.
+ *
+ * Limitations:
+ * - inheritance is not transitive: if the owner itself waits for another
+ *   mutex, the owner of that mutex is not boosted
+ * - a thread holding several priority inheritance mutexes must unlock them in
+ *   the reverse order it locked them in
+ * - mutex_pi_lock() and mutex_pi_unlock() must not be called from interrupt
+ *   context
+ *
+ * @{
+ *
+ * @file
+ * @brief       Priority inheritance mutex API
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef MUTEX_PI_H
+#define MUTEX_PI_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "mutex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Priority inheritance mutex structure. Must never be modified by
+ *          the user.
+ */
+typedef struct {
+    mutex_t mutex;          /**< underlying mutex, holds the waiting queue */
+    kernel_pid_t owner;     /**< current owner or KERNEL_PID_UNDEF */
+    uint8_t owner_prio;     /**< owner's priority before locking the mutex */
+} mutex_pi_t;
+
+/**
+ * @brief   Static initializer for mutex_pi_t.
+ */
+#define MUTEX_PI_INIT { MUTEX_INIT, KERNEL_PID_UNDEF, 0 }
+
+/**
+ * @brief   Initializes a priority inheritance mutex object.
+ *
+ * @param[out] mutex    pre-allocated mutex structure, must not be NULL.
+ */
+static inline void mutex_pi_init(mutex_pi_t *mutex)
+{
+    mutex_init(&mutex->mutex);
+    mutex->owner = KERNEL_PID_UNDEF;
+    mutex->owner_prio = 0;
+}
+
+/**
+ * @brief   Tries to get a priority inheritance mutex, non-blocking.
+ *
+ * @param[in] mutex     mutex object to lock
+ *
+ * @return  1 if mutex was unlocked, now it is locked.
+ * @return  0 if the mutex was locked.
+ */
+int mutex_pi_trylock(mutex_pi_t *mutex);
+
+/**
+ * @brief   Locks a priority inheritance mutex, blocking.
+ *
+ * If the mutex is locked by a thread with a lower priority than the calling
+ * thread, the owner is raised to the priority of the calling thread until it
+ * unlocks the mutex.
+ *
+ * @param[in] mutex     mutex object to lock
+ */
+void mutex_pi_lock(mutex_pi_t *mutex);
+
+/**
+ * @brief   Unlocks a priority inheritance mutex.
+ *
+ * Restores the priority the calling thread had when it locked the mutex and
+ * passes the mutex to the highest priority waiter, if any.
+ *
+ * @pre     The calling thread is the owner of @p mutex
+ *
+ * @param[in] mutex     mutex object to unlock
+ */
+void mutex_pi_unlock(mutex_pi_t *mutex);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MUTEX_PI_H */
+/** @} */
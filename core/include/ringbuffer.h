@@ -98,12 +98,45 @@ unsigned ringbuffer_get(ringbuffer_t *__restrict rb, char *buf, unsigned n);
 
 /**
  * @brief           Remove a number of elements from the ringbuffer.
+ * @details         Removes the oldest elements, e.g. after processing them in
+ *                  place through ringbuffer_peek_ptr().
  * @param[in,out]   rb    Ringbuffer to operate on.
  * @param[in]       n     Read at most n elements.
  * @returns         Number of elements actually removed.
  */
 unsigned ringbuffer_remove(ringbuffer_t *__restrict rb, unsigned n);
 
+/**
+ * @brief           Get the contiguous free space after the newest element.
+ * @details         Write to the space directly, e.g. by DMA, then call
+ *                  ringbuffer_commit() to add the written elements.
+ *                  Free space that wraps around the end of the buffer is
+ *                  returned by a second call after committing the first part.
+ * @param[in]       rb    Ringbuffer to operate on.
+ * @param[out]      ptr   Start of the free space.
+ * @returns         Number of elements that can be written at ptr.
+ */
+unsigned ringbuffer_reserve(ringbuffer_t *__restrict rb, char **ptr);
+
+/**
+ * @brief           Add elements written to space got with ringbuffer_reserve().
+ * @param[in,out]   rb    Ringbuffer to operate on.
+ * @param[in]       n     Number of elements written, at most the size reserved.
+ */
+void ringbuffer_commit(ringbuffer_t *__restrict rb, unsigned n);
+
+/**
+ * @brief           Get the oldest elements that are contiguous in memory.
+ * @details         Read or parse the elements in place, then remove them with
+ *                  ringbuffer_remove(). Elements that wrap around the end of
+ *                  the buffer are returned by a second call after removing the
+ *                  first part.
+ * @param[in]       rb    Ringbuffer to operate on.
+ * @param[out]      ptr   Start of the oldest element.
+ * @returns         Number of elements that can be read at ptr.
+ */
+unsigned ringbuffer_peek_ptr(const ringbuffer_t *__restrict rb, const char **ptr);
+
 /**
  * @brief           Test if the ringbuffer is empty.
  * @param[in,out]   rb    Ringbuffer to operate on.
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    core_sync_rwlock Reader-writer lock
+ * @ingroup     core_sync
+ * @brief       Reader-writer lock for read-mostly data
+ *
+ * A reader-writer lock can be held by any number of readers or by a single
+ * writer. The lock state is kept in a single @ref atomic_int_t, so locking
+ * and unlocking an uncontended lock is a single compare-and-swap and does not
+ * disable interrupts on platforms providing an atomic compare-and-swap. Only
+ * if a thread has to block, the waiting queues are handled with interrupts
+ * disabled.
+ *
+ * Writers are preferred: once a writer waits for the lock, new readers block
+ * until the writer is done. When the lock is released, the waiters with the
+ * highest priority are woken up, either a single writer or all readers.
+ *
+ * The lock must not be used from interrupt context and is not recursive.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Reader-writer lock API
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef RWLOCK_H
+#define RWLOCK_H
+
+#include "atomic.h"
+#include "list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Lock state flags
+ * @{
+ */
+#define RWLOCK_WRITER           (0x4000)    /**< lock is held by a writer */
+#define RWLOCK_WAITERS          (0x2000)    /**< threads are waiting */
+#define RWLOCK_READERS_MASK     (0x1fff)    /**< number of readers */
+/** @} */
+
+/**
+ * @brief   Reader-writer lock structure. Must never be modified by the user.
+ */
+typedef struct {
+    atomic_int_t state;     /**< number of readers and state flags */
+    list_node_t readers;    /**< readers waiting for the lock */
+    list_node_t writers;    /**< writers waiting for the lock */
+} rwlock_t;
+
+/**
+ * @brief   Static initializer for rwlock_t.
+ */
+#define RWLOCK_INIT { ATOMIC_INIT(0), { NULL }, { NULL } }
+
+/**
+ * @brief   Initializes a reader-writer lock.
+ *
+ * @param[out] rwlock   lock to initialize, must not be NULL.
+ */
+static inline void rwlock_init(rwlock_t *rwlock)
+{
+    ATOMIC_VALUE(rwlock->state) = 0;
+    rwlock->readers.next = NULL;
+    rwlock->writers.next = NULL;
+}
+
+/**
+ * @brief   Tries to lock a reader-writer lock for reading, non-blocking.
+ *
+ * @param[in] rwlock    lock to acquire
+ *
+ * @return  1 if the lock was acquired
+ * @return  0 if the lock is held or requested by a writer
+ */
+int rwlock_tryrdlock(rwlock_t *rwlock);
+
+/**
+ * @brief   Locks a reader-writer lock for reading, blocking.
+ *
+ * @param[in] rwlock    lock to acquire
+ */
+void rwlock_rdlock(rwlock_t *rwlock);
+
+/**
+ * @brief   Tries to lock a reader-writer lock for writing, non-blocking.
+ *
+ * @param[in] rwlock    lock to acquire
+ *
+ * @return  1 if the lock was acquired
+ * @return  0 if the lock is held
+ */
+int rwlock_trywrlock(rwlock_t *rwlock);
+
+/**
+ * @brief   Locks a reader-writer lock for writing, blocking.
+ *
+ * @param[in] rwlock    lock to acquire
+ */
+void rwlock_wrlock(rwlock_t *rwlock);
+
+/**
+ * @brief   Releases a reader-writer lock held for reading or writing.
+ *
+ * @pre     The calling thread holds @p rwlock
+ *
+ * @param[in] rwlock    lock to release
+ */
+void rwlock_unlock(rwlock_t *rwlock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RWLOCK_H */
+/** @} */
@@ -119,6 +119,22 @@ int sched_run(void);
  */
 void sched_set_status(thread_t *process, unsigned int status);
 
+/**
+ * @brief   Change the priority of the specified thread
+ *
+ * If the thread is on the runqueue, it is moved to the runqueue of its new
+ * priority. This function does not yield, the caller has to trigger the
+ * scheduler if the change might require a context switch.
+ *
+ * @note    Threads waiting in a priority ordered list (e.g., a mutex queue)
+ *          keep their position in that list.
+ *
+ * @param[in]   thread      Pointer to the thread control block of the
+ *                          targeted thread
+ * @param[in]   priority    The new priority of the thread
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief       Yield if approriate.
  *
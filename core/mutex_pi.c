@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_sync_mutex_pi
+ * @{
+ *
+ * @file
+ * @brief       Priority inheritance mutex implementation
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+
+#include "assert.h"
+#include "irq.h"
+#include "list.h"
+#include "mutex_pi.h"
+#include "sched.h"
+#include "thread.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static inline void _set_owner(mutex_pi_t *mutex, thread_t *thread)
+{
+    mutex->owner = thread->pid;
+    mutex->owner_prio = thread->priority;
+}
+
+int mutex_pi_trylock(mutex_pi_t *mutex)
+{
+    unsigned irqstate = irq_disable();
+
+    if (mutex->mutex.queue.next == NULL) {
+        mutex->mutex.queue.next = MUTEX_LOCKED;
+        _set_owner(mutex, (thread_t *)sched_active_thread);
+        irq_restore(irqstate);
+        return 1;
+    }
+
+    irq_restore(irqstate);
+    return 0;
+}
+
+void mutex_pi_lock(mutex_pi_t *mutex)
+{
+    unsigned irqstate = irq_disable();
+    thread_t *me = (thread_t *)sched_active_thread;
+
+    if (mutex->mutex.queue.next == NULL) {
+        /* mutex is unlocked */
+        mutex->mutex.queue.next = MUTEX_LOCKED;
+        _set_owner(mutex, me);
+        irq_restore(irqstate);
+        return;
+    }
+
+    thread_t *owner = (thread_t *)sched_threads[mutex->owner];
+    assert(owner != me);
+
+    if (owner && (owner->priority > me->priority)) {
+        DEBUG("mutex_pi_lock: raising priority of %" PRIkernel_pid " to %u\n",
+              owner->pid, (unsigned)me->priority);
+        sched_change_priority(owner, me->priority);
+    }
+
+    sched_set_status(me, STATUS_MUTEX_BLOCKED);
+    if (mutex->mutex.queue.next == MUTEX_LOCKED) {
+        mutex->mutex.queue.next = (list_node_t *)&me->rq_entry;
+        mutex->mutex.queue.next->next = NULL;
+    }
+    else {
+        thread_add_to_list(&mutex->mutex.queue, me);
+    }
+
+    irq_restore(irqstate);
+    thread_yield_higher();
+    /* the unlocking thread removed us from the queue and made us the owner */
+}
+
+void mutex_pi_unlock(mutex_pi_t *mutex)
+{
+    unsigned irqstate = irq_disable();
+    thread_t *me = (thread_t *)sched_active_thread;
+
+    if (mutex->mutex.queue.next == NULL) {
+        /* the mutex was not locked */
+        irq_restore(irqstate);
+        return;
+    }
+
+    assert(mutex->owner == me->pid);
+
+    /* drop any inherited priority */
+    int lowered = (me->priority != mutex->owner_prio);
+    if (lowered) {
+        DEBUG("mutex_pi_unlock: restoring priority of %" PRIkernel_pid
+              " to %u\n", me->pid, (unsigned)mutex->owner_prio);
+        sched_change_priority(me, mutex->owner_prio);
+    }
+
+    if (mutex->mutex.queue.next == MUTEX_LOCKED) {
+        /* nobody was waiting */
+        mutex->mutex.queue.next = NULL;
+        mutex->owner = KERNEL_PID_UNDEF;
+        irq_restore(irqstate);
+        if (lowered) {
+            thread_yield_higher();
+        }
+        return;
+    }
+
+    list_node_t *next = list_remove_head(&mutex->mutex.queue);
+    thread_t *process = container_of((clist_node_t *)next, thread_t, rq_entry);
+
+    DEBUG("mutex_pi_unlock: passing mutex to %" PRIkernel_pid "\n",
+          process->pid);
+    _set_owner(mutex, process);
+    sched_set_status(process, STATUS_PENDING);
+
+    if (!mutex->mutex.queue.next) {
+        mutex->mutex.queue.next = MUTEX_LOCKED;
+    }
+    else {
+        /* the new owner inherits the priority of the remaining waiters */
+        thread_t *waiter = container_of((clist_node_t *)mutex->mutex.queue.next,
+                                        thread_t, rq_entry);
+        if (waiter->priority < process->priority) {
+            sched_change_priority(process, waiter->priority);
+        }
+    }
+
+    uint16_t process_priority = process->priority;
+    irq_restore(irqstate);
+
+    if (lowered) {
+        thread_yield_higher();
+    }
+    else {
+        sched_switch(process_priority);
+    }
+}
@@ -54,14 +54,42 @@ static char get_head(ringbuffer_t *restrict rb)
 
 unsigned ringbuffer_add(ringbuffer_t *restrict rb, const char *buf, unsigned n)
 {
-    unsigned i;
-    for (i = 0; i < n; i++) {
-        if (ringbuffer_full(rb)) {
-            break;
+    unsigned free = rb->size - rb->avail;
+    if (n > free) {
+        n = free;
+    }
+
+    /* copy up to the end of the buffer, then the rest from its start */
+    unsigned written = 0;
+    while (written < n) {
+        char *ptr;
+        unsigned len = ringbuffer_reserve(rb, &ptr);
+        if (len > n - written) {
+            len = n - written;
         }
-        add_tail(rb, buf[i]);
+        memcpy(ptr, buf + written, len);
+        rb->avail += len;
+        written += len;
+    }
+    return n;
+}
+
+unsigned ringbuffer_reserve(ringbuffer_t *restrict rb, char **ptr)
+{
+    unsigned tail = rb->start + rb->avail;
+    if (tail >= rb->size) {
+        tail -= rb->size;
+        /* free space ends at the read position */
+        *ptr = rb->buf + tail;
+        return rb->start - tail;
     }
-    return i;
+    *ptr = rb->buf + tail;
+    return rb->size - tail;
+}
+
+void ringbuffer_commit(ringbuffer_t *restrict rb, unsigned n)
+{
+    rb->avail += n;
 }
 
 int ringbuffer_add_one(ringbuffer_t *restrict rb, char c)
@@ -112,23 +140,30 @@ unsigned ringbuffer_get(ringbuffer_t *restrict rb, char *buf, unsigned n)
 
 unsigned ringbuffer_remove(ringbuffer_t *restrict rb, unsigned n)
 {
-    if (n > rb->avail) {
+    if (n >= rb->avail) {
         n = rb->avail;
         rb->start = rb->avail = 0;
     }
     else {
-        rb->start -= n;
+        rb->start += n;
         rb->avail -= n;
 
-        /* compensate underflow */
-        if (rb->start > rb->size) {
-            rb->start += rb->size;
+        /* compensate overflow */
+        if (rb->start >= rb->size) {
+            rb->start -= rb->size;
         }
     }
 
     return n;
 }
 
+unsigned ringbuffer_peek_ptr(const ringbuffer_t *restrict rb, const char **ptr)
+{
+    unsigned bytes_till_end = rb->size - rb->start;
+    *ptr = rb->buf + rb->start;
+    return (rb->avail < bytes_till_end) ? rb->avail : bytes_till_end;
+}
+
 int ringbuffer_peek_one(const ringbuffer_t *restrict rb_)
 {
     ringbuffer_t rb = *rb_;
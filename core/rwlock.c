@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     core_sync_rwlock
+ * @{
+ *
+ * @file
+ * @brief       Reader-writer lock implementation
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "assert.h"
+#include "irq.h"
+#include "rwlock.h"
+#include "sched.h"
+#include "thread.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* must be called with interrupts disabled */
+static void _block(list_node_t *queue)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+
+    DEBUG("rwlock: thread %" PRIkernel_pid " blocks\n", me->pid);
+    sched_set_status(me, STATUS_MUTEX_BLOCKED);
+    thread_add_to_list(queue, me);
+}
+
+static inline thread_t *_head(list_node_t *queue)
+{
+    if (queue->next == NULL) {
+        return NULL;
+    }
+    return container_of((clist_node_t *)queue->next, thread_t, rq_entry);
+}
+
+/* Hands the lock over to the waiters with the highest priority and returns
+ * that priority. Must be called with interrupts disabled. */
+static uint16_t _wake(rwlock_t *rwlock)
+{
+    thread_t *reader = _head(&rwlock->readers);
+    thread_t *writer = _head(&rwlock->writers);
+
+    assert(reader || writer);
+
+    if (writer && (!reader || (writer->priority <= reader->priority))) {
+        list_remove_head(&rwlock->writers);
+        sched_set_status(writer, STATUS_PENDING);
+        ATOMIC_VALUE(rwlock->state) = RWLOCK_WRITER |
+            ((rwlock->readers.next || rwlock->writers.next) ? RWLOCK_WAITERS : 0);
+        DEBUG("rwlock: waking writer %" PRIkernel_pid "\n", writer->pid);
+        return writer->priority;
+    }
+
+    /* the first reader in the queue has the highest priority */
+    uint16_t prio = reader->priority;
+    int readers = 0;
+    list_node_t *node;
+
+    while ((node = list_remove_head(&rwlock->readers)) != NULL) {
+        thread_t *thread = container_of((clist_node_t *)node, thread_t, rq_entry);
+        sched_set_status(thread, STATUS_PENDING);
+        readers++;
+    }
+    ATOMIC_VALUE(rwlock->state) = readers |
+        (rwlock->writers.next ? RWLOCK_WAITERS : 0);
+    DEBUG("rwlock: waking %d readers\n", readers);
+    return prio;
+}
+
+int rwlock_tryrdlock(rwlock_t *rwlock)
+{
+    int old;
+
+    do {
+        old = ATOMIC_VALUE(rwlock->state);
+        if (old & (RWLOCK_WRITER | RWLOCK_WAITERS)) {
+            return 0;
+        }
+        assert((old & RWLOCK_READERS_MASK) != RWLOCK_READERS_MASK);
+    } while (!atomic_cas(&rwlock->state, old, old + 1));
+
+    return 1;
+}
+
+void rwlock_rdlock(rwlock_t *rwlock)
+{
+    if (rwlock_tryrdlock(rwlock)) {
+        return;
+    }
+
+    unsigned irqstate = irq_disable();
+    int state = ATOMIC_VALUE(rwlock->state);
+
+    if (!(state & (RWLOCK_WRITER | RWLOCK_WAITERS))) {
+        /* the lock was released in the meantime */
+        ATOMIC_VALUE(rwlock->state) = state + 1;
+        irq_restore(irqstate);
+        return;
+    }
+
+    ATOMIC_VALUE(rwlock->state) = state | RWLOCK_WAITERS;
+    _block(&rwlock->readers);
+    irq_restore(irqstate);
+    thread_yield_higher();
+    /* the releasing thread accounted for us, we hold the lock now */
+}
+
+int rwlock_trywrlock(rwlock_t *rwlock)
+{
+    return atomic_cas(&rwlock->state, 0, RWLOCK_WRITER);
+}
+
+void rwlock_wrlock(rwlock_t *rwlock)
+{
+    if (rwlock_trywrlock(rwlock)) {
+        return;
+    }
+
+    unsigned irqstate = irq_disable();
+    int state = ATOMIC_VALUE(rwlock->state);
+
+    if (state == 0) {
+        /* the lock was released in the meantime */
+        ATOMIC_VALUE(rwlock->state) = RWLOCK_WRITER;
+        irq_restore(irqstate);
+        return;
+    }
+
+    ATOMIC_VALUE(rwlock->state) = state | RWLOCK_WAITERS;
+    _block(&rwlock->writers);
+    irq_restore(irqstate);
+    thread_yield_higher();
+    /* the releasing thread made us the owner */
+}
+
+void rwlock_unlock(rwlock_t *rwlock)
+{
+    /* fast path: nobody is waiting */
+    while (1) {
+        int old = ATOMIC_VALUE(rwlock->state);
+        assert(old & (RWLOCK_WRITER | RWLOCK_READERS_MASK));
+        if (old & RWLOCK_WAITERS) {
+            break;
+        }
+        int now = (old & RWLOCK_WRITER) ? 0 : (old - 1);
+        if (atomic_cas(&rwlock->state, old, now)) {
+            return;
+        }
+    }
+
+    unsigned irqstate = irq_disable();
+    int state = ATOMIC_VALUE(rwlock->state);
+    int readers = (state & RWLOCK_WRITER) ? 0 : ((state & RWLOCK_READERS_MASK) - 1);
+
+    if (readers) {
+        ATOMIC_VALUE(rwlock->state) = readers | RWLOCK_WAITERS;
+        irq_restore(irqstate);
+        return;
+    }
+
+    uint16_t prio = _wake(rwlock);
+    irq_restore(irqstate);
+    sched_switch(prio);
+}
@@ -23,6 +23,10 @@
 #include <unistd.h>
 #include <fcntl.h>
 
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
 #include "async_read.h"
 #include "native_internal.h"
 
@@ -36,6 +40,45 @@ static pid_t _sigio_child_pids[ASYNC_READ_NUMOF];
 static void _sigio_child(int fd);
 #endif
 
+#ifdef __linux__
+static int _epfd = -1;
+static uint32_t _events[ASYNC_READ_NUMOF];
+static void *_write_args[ASYNC_READ_NUMOF];
+static native_async_read_callback_t _native_async_write_callbacks[ASYNC_READ_NUMOF];
+
+static void _epoll_update(int index)
+{
+    struct epoll_event ev = { .events = _events[index], .data.u32 = index };
+
+    if (epoll_ctl(_epfd, EPOLL_CTL_MOD, _fds[index], &ev) == -1) {
+        err(EXIT_FAILURE, "native_async_read: epoll_ctl(EPOLL_CTL_MOD)");
+    }
+}
+
+static void _async_io_isr(void) {
+    struct epoll_event events[ASYNC_READ_NUMOF];
+
+    /* only the file descriptors that are ready are returned */
+    int n = epoll_wait(_epfd, events, ASYNC_READ_NUMOF, 0);
+
+    for (int i = 0; i < n; i++) {
+        int index = events[i].data.u32;
+
+        if ((events[i].events & EPOLLOUT) && _native_async_write_callbacks[index]) {
+            native_async_read_callback_t cb = _native_async_write_callbacks[index];
+            /* write readiness is reported only once */
+            _native_async_write_callbacks[index] = NULL;
+            _events[index] &= ~EPOLLOUT;
+            _epoll_update(index);
+            cb(_fds[index], _write_args[index]);
+        }
+        if ((events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) &&
+            _native_async_read_callbacks[index]) {
+            _native_async_read_callbacks[index](_fds[index], _args[index]);
+        }
+    }
+}
+#else
 static void _async_io_isr(void) {
     fd_set rfds;
 
@@ -61,8 +104,16 @@ static void _async_io_isr(void) {
         }
     }
 }
+#endif
 
 void native_async_read_setup(void) {
+#ifdef __linux__
+    if (_epfd == -1) {
+        if ((_epfd = epoll_create1(EPOLL_CLOEXEC)) == -1) {
+            err(EXIT_FAILURE, "native_async_read_setup(): epoll_create1");
+        }
+    }
+#endif
     register_interrupt(SIGIO, _async_io_isr);
 }
 
@@ -74,6 +125,12 @@ void native_async_read_cleanup(void) {
         kill(_sigio_child_pids[i], SIGKILL);
     }
 #endif
+#ifdef __linux__
+    if (_epfd != -1) {
+        real_close(_epfd);
+        _epfd = -1;
+    }
+#endif
 }
 
 void native_async_read_continue(int fd) {
@@ -87,19 +144,26 @@ void native_async_read_continue(int fd) {
 #endif
 }
 
-void native_async_read_add_handler(int fd, void *arg, native_async_read_callback_t handler) {
+/* returns the index of fd, registering it if it is not known yet */
+static int _get_index(int fd)
+{
+    for (int i = 0; i < _next_index; i++) {
+        if (_fds[i] == fd) {
+            return i;
+        }
+    }
+
     if (_next_index >= ASYNC_READ_NUMOF) {
         err(EXIT_FAILURE, "native_async_read_add_handler(): too many callbacks");
     }
 
-    _fds[_next_index] = fd;
-    _args[_next_index] = arg;
-    _native_async_read_callbacks[_next_index] = handler;
+    int index = _next_index++;
+    _fds[index] = fd;
 
 #ifdef __MACH__
     /* tuntap signalled IO is not working in OSX,
      * * check http://sourceforge.net/p/tuntaposx/bugs/17/ */
-    _sigio_child(_next_index);
+    _sigio_child(index);
 #else
     /* configure fds to send signals on io */
     if (fcntl(fd, F_SETOWN, _native_pid) == -1) {
@@ -111,7 +175,59 @@ void native_async_read_add_handler(int fd, void *arg, native_async_read_callback
     }
 #endif /* not OSX */
 
-    _next_index++;
+#ifdef __linux__
+    struct epoll_event ev = { .events = 0, .data.u32 = index };
+
+    _events[index] = 0;
+    if (epoll_ctl(_epfd, EPOLL_CTL_ADD, fd, &ev) == -1) {
+        err(EXIT_FAILURE, "native_async_read_add_handler(): epoll_ctl(EPOLL_CTL_ADD)");
+    }
+#endif
+
+    return index;
+}
+
+static void _add_read_handler(int fd, void *arg,
+                              native_async_read_callback_t handler, int edge)
+{
+    int index = _get_index(fd);
+
+    _args[index] = arg;
+    _native_async_read_callbacks[index] = handler;
+
+#ifdef __linux__
+    _events[index] |= EPOLLIN;
+    if (edge) {
+        _events[index] |= EPOLLET;
+    }
+    _epoll_update(index);
+#else
+    (void)edge;
+#endif
+}
+
+void native_async_read_add_handler(int fd, void *arg, native_async_read_callback_t handler) {
+    _add_read_handler(fd, arg, handler, 0);
+}
+
+void native_async_read_add_edge_handler(int fd, void *arg, native_async_read_callback_t handler) {
+    _add_read_handler(fd, arg, handler, 1);
+}
+
+void native_async_write_add_handler(int fd, void *arg, native_async_read_callback_t handler) {
+#ifdef __linux__
+    int index = _get_index(fd);
+
+    _write_args[index] = arg;
+    _native_async_write_callbacks[index] = handler;
+    _events[index] |= EPOLLOUT;
+    _epoll_update(index);
+#else
+    (void)fd;
+    (void)arg;
+    (void)handler;
+    errx(EXIT_FAILURE, "native_async_write_add_handler(): not supported on this host");
+#endif
 }
 
 #ifdef __MACH__
@@ -13,6 +13,10 @@
  * @file
  * @brief       Multiple asynchronus read on file descriptors
  *
+ * On Linux, readiness of the registered file descriptors is collected with
+ * epoll, so handling a SIGIO only costs time for the descriptors that are
+ * actually ready. Other hosts fall back to select().
+ *
  * @author      Takuo Yonezawa <Yonezawa-T2@mail.dnp.co.jp>
  */
 #ifndef ASYNC_READ_H
@@ -67,6 +71,39 @@ void native_async_read_continue(int fd);
  */
 void native_async_read_add_handler(int fd, void *arg, native_async_read_callback_t handler);
 
+/**
+ * @brief   start edge-triggered monitoring of file descriptor
+ *
+ * The callback is only called when new data arrives on @p fd, so it has to
+ * read until the file descriptor would block. Calling
+ * native_async_read_continue() is not needed.
+ *
+ * @note    Edge-triggered readiness requires epoll (Linux). On other hosts
+ *          this behaves like native_async_read_add_handler().
+ *
+ * @param[in] fd       The file descriptor to monitor
+ * @param[in] arg      Pointer to be passed as arguments to the callback
+ * @param[in] handler  The callback function to be called when new data can
+ *                     be read from the file descriptor.
+ */
+void native_async_read_add_edge_handler(int fd, void *arg, native_async_read_callback_t handler);
+
+/**
+ * @brief   wait once for a file descriptor to become writable
+ *
+ * The callback is called a single time when @p fd can be written to. Call
+ * this function again to wait for the next time, e.g. after a write returned
+ * `EAGAIN`.
+ *
+ * @note    Only supported on Linux.
+ *
+ * @param[in] fd       The file descriptor to monitor
+ * @param[in] arg      Pointer to be passed as arguments to the callback
+ * @param[in] handler  The callback function to be called when the file
+ *                     descriptor is ready to write.
+ */
+void native_async_write_add_handler(int fd, void *arg, native_async_read_callback_t handler);
+
 #ifdef __cplusplus
 }
 #endif
@@ -97,6 +97,8 @@ extern int (*real_bind)(int socket, ...);
 extern int (*real_chdir)(const char *path);
 extern int (*real_close)(int);
 /* The ... is a hack to save includes: */
+extern int (*real_connect)(int socket, ...);
+/* The ... is a hack to save includes: */
 extern int (*real_creat)(const char *path, ...);
 extern int (*real_dup2)(int, int);
 extern int (*real_execve)(const char *, char *const[], char *const[]);
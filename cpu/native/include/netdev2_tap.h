@@ -27,6 +27,7 @@ extern "C" {
 #include <stdint.h>
 #include "net/netdev2.h"
 
+#include "net/ethernet.h"
 #include "net/ethernet/hdr.h"
 
 #ifdef __MACH__
@@ -35,6 +36,17 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief Maximum number of frames handled per interrupt event
+ *
+ * The driver drains up to this many frames from the tap device each time it
+ * is signalled, before it re-arms the asynchronous read. Set to 1 to handle
+ * a single frame per event.
+ */
+#ifndef NETDEV2_TAP_RX_BATCH
+#define NETDEV2_TAP_RX_BATCH    (16U)
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -44,6 +56,8 @@ typedef struct netdev2_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscous;                 /**< Flag for promiscous mode */
+    uint16_t rx_len;                    /**< length of the frame in rx_buf */
+    uint8_t rx_buf[ETHERNET_FRAME_LEN]; /**< frame currently being received */
 } netdev2_tap_t;
 
 /**
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/**
+ * @ingroup     netdev2
+ * @brief       IEEE 802.15.4 driver for a simulated radio medium on native
+ *
+ * Every native instance is a node of a virtual 802.15.4 network. Frames
+ * are sent to a broker process (`dist/tools/vmedium/vmedium.py`) via UDP.
+ * The broker forwards them to the neighbors of the sending node according
+ * to a topology file, applying per-link loss, delay and bandwidth.
+ *
+ * The node is identified by its native instance id (`-i <id>`). Its short
+ * address is the id and its long address is derived from it, so addresses
+ * are stable between runs.
+ *
+ * Applications can report the transmission and reception of their own
+ * packets with netdev2_vmedium_flow_tx() and netdev2_vmedium_flow_rx(). The
+ * broker then records delivery ratio and end-to-end latency per flow,
+ * measured with a single clock.
+ * @{
+ *
+ * @file
+ * @brief       Definitions for the virtual 802.15.4 medium @ref netdev2
+ *              driver
+ *
+ * @author      agent <agent@local>
+ */
+#ifndef NETDEV2_VMEDIUM_H
+#define NETDEV2_VMEDIUM_H
+
+#include <stdint.h>
+
+#include "net/ieee802154.h"
+#include "net/netdev2.h"
+#include "net/netdev2/ieee802154.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Default host of the broker
+ */
+#ifndef NETDEV2_VMEDIUM_HOST
+#define NETDEV2_VMEDIUM_HOST        "127.0.0.1"
+#endif
+
+/**
+ * @brief   Default UDP port of the broker
+ */
+#ifndef NETDEV2_VMEDIUM_PORT
+#define NETDEV2_VMEDIUM_PORT        "17754"
+#endif
+
+/**
+ * @brief   Default PAN ID
+ */
+#ifndef NETDEV2_VMEDIUM_PANID
+#define NETDEV2_VMEDIUM_PANID       (0x0023)
+#endif
+
+/**
+ * @brief   Default channel
+ */
+#ifndef NETDEV2_VMEDIUM_CHANNEL
+#define NETDEV2_VMEDIUM_CHANNEL     (26U)
+#endif
+
+/**
+ * @name    Message types exchanged with the broker
+ *
+ * Each datagram starts with the message type (1 byte) and the node id
+ * (2 byte, network byte order). For @ref NETDEV2_VMEDIUM_MSG_FRAME the node
+ * id is the sender and the raw frame (without FCS) follows. The broker adds
+ * one byte of LQI after the id when it delivers a frame. The flow messages
+ * carry the flow id (2 byte) and a sequence number (4 byte), both in network
+ * byte order. @ref NETDEV2_VMEDIUM_MSG_RADIO carries one byte, 1 when the
+ * radio is switched on and 0 when it is switched off.
+ * @{
+ */
+#define NETDEV2_VMEDIUM_MSG_HELLO   (0U)    /**< node announces itself */
+#define NETDEV2_VMEDIUM_MSG_FRAME   (1U)    /**< 802.15.4 frame */
+#define NETDEV2_VMEDIUM_MSG_FLOW_TX (2U)    /**< application sent a packet */
+#define NETDEV2_VMEDIUM_MSG_FLOW_RX (3U)    /**< application received a packet */
+#define NETDEV2_VMEDIUM_MSG_RADIO   (4U)    /**< radio switched on or off */
+/** @} */
+
+/**
+ * @brief   Length of the header the broker prepends to delivered frames
+ */
+#define NETDEV2_VMEDIUM_RX_HDR_LEN  (4U)
+
+/**
+ * @brief   Device parameters
+ */
+typedef struct {
+    const char *host;               /**< host of the broker */
+    const char *port;               /**< UDP port of the broker */
+    uint16_t node_id;               /**< id of this node in the topology */
+} netdev2_vmedium_params_t;
+
+/**
+ * @brief   Device descriptor
+ * @extends netdev2_ieee802154_t
+ */
+typedef struct {
+    netdev2_ieee802154_t netdev;    /**< IEEE 802.15.4 netdev2 base */
+    netdev2_vmedium_params_t params;    /**< device parameters */
+    int sock_fd;                    /**< socket connected to the broker */
+    uint8_t promiscuous;            /**< deliver frames not addressed to us */
+    uint8_t sleeping;               /**< radio is off, frames are lost */
+    uint8_t rx_lqi;                 /**< LQI of the frame in rx_buf */
+    uint16_t rx_len;                /**< length of the frame in rx_buf */
+    uint8_t rx_buf[NETDEV2_VMEDIUM_RX_HDR_LEN + IEEE802154_FRAME_LEN_MAX];
+                                    /**< datagram currently being received */
+} netdev2_vmedium_t;
+
+/**
+ * @brief   Sets up the device descriptor
+ *
+ * The connection to the broker is opened by netdev2_driver_t::init.
+ *
+ * @param[out] dev      device descriptor
+ * @param[in] params    device parameters, copied into @p dev
+ */
+void netdev2_vmedium_setup(netdev2_vmedium_t *dev,
+                           const netdev2_vmedium_params_t *params);
+
+/**
+ * @brief   Reports to the broker that a packet of a flow was sent
+ *
+ * @param[in] dev       device descriptor
+ * @param[in] flow      application defined flow id
+ * @param[in] seq       sequence number of the packet within @p flow
+ */
+void netdev2_vmedium_flow_tx(netdev2_vmedium_t *dev, uint16_t flow,
+                             uint32_t seq);
+
+/**
+ * @brief   Reports to the broker that a packet of a flow was received
+ *
+ * @param[in] dev       device descriptor
+ * @param[in] flow      flow id the sender reported with
+ *                      netdev2_vmedium_flow_tx()
+ * @param[in] seq       sequence number of the packet within @p flow
+ */
+void netdev2_vmedium_flow_rx(netdev2_vmedium_t *dev, uint16_t flow,
+                             uint32_t seq);
+
+/**
+ * @brief   Closes the connection to the broker
+ *
+ * @param[in] dev       device descriptor
+ */
+void netdev2_vmedium_cleanup(netdev2_vmedium_t *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETDEV2_VMEDIUM_H */
+/** @} */
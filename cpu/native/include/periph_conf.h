@@ -63,6 +63,20 @@
 
 /** @} */
 
+/**
+ * @name SPI configuration (emulated, see @ref native_spi_emu)
+ *
+ * Native has no SPI, unless the application uses the spi_emu module.
+ * @{
+ */
+#ifdef MODULE_SPI_EMU
+#ifndef SPI_NUMOF
+#define SPI_NUMOF           (1U)
+#endif
+#define SPI_0_EN            1
+#endif
+/** @} */
+
 /**
  * @brief UART configuration
  * @{
@@ -32,6 +32,29 @@ extern "C" {
 #define CPUID_LEN           (4U)
 #endif
 
+/**
+ * @name    SPI configuration
+ *
+ * The emulated bus implements spi_transfer_bytes() and
+ * spi_transfer_async(), the remaining functions use the common fallbacks.
+ * @{
+ */
+#define PERIPH_SPI_NEEDS_TRANSFER_BYTE
+#define PERIPH_SPI_NEEDS_TRANSFER_REG
+#define PERIPH_SPI_NEEDS_TRANSFER_REGS
+#define PERIPH_SPI_HAS_TRANSFER_ASYNC
+/** @} */
+
+/**
+ * @brief   Number of power modes
+ *
+ * Native has no power modes of its own. Applications using pm_layered on
+ * native simulate them and provide pm_set().
+ */
+#ifndef PM_NUM_MODES
+#define PM_NUM_MODES        (1U)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
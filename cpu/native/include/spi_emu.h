@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_cpu
+ * @defgroup    native_spi_emu SPI bus emulator
+ * @brief       Emulated SPI slaves for the native SPI peripheral
+ *
+ * The native SPI peripheral has no hardware behind it. Instead, a software
+ * model of a slave device can be attached to each bus. It sees every byte
+ * the master clocks out and supplies the byte that is clocked in. A
+ * transaction starts with spi_acquire() and ends with spi_release(). On
+ * real hardware the chip select line marks these boundaries, and drivers
+ * toggle it inside that window.
+ *
+ * Asynchronous transfers (spi_transfer_async()) complete in interrupt
+ * context, signalled by `SIGUSR2`, like a DMA completion interrupt would.
+ *
+ * The bus keeps counters of the transfers, so tests can check not only the
+ * data but also how a driver uses the bus.
+ *
+ * Native provides SPI only to applications that select the emulator with
+ * `USEMODULE += spi_emu`, so drivers that require `periph_spi` are not
+ * built for native by default.
+ * @{
+ *
+ * @file
+ * @brief       SPI bus emulator interface
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef SPI_EMU_H
+#define SPI_EMU_H
+
+#include <stdint.h>
+
+#include "periph/spi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Model of an emulated SPI slave
+ */
+typedef struct {
+    /**
+     * @brief   Called when a transaction starts (chip select asserted)
+     *
+     * May be NULL.
+     */
+    void (*begin)(void *arg);
+    /**
+     * @brief   Exchanges one byte
+     *
+     * @param[in] arg   context given to spi_emu_attach()
+     * @param[in] out   byte sent by the master
+     *
+     * @return  byte returned to the master
+     */
+    uint8_t (*transfer)(void *arg, uint8_t out);
+    /**
+     * @brief   Called when a transaction ends (chip select released)
+     *
+     * May be NULL.
+     */
+    void (*end)(void *arg);
+} spi_emu_slave_t;
+
+/**
+ * @brief   Bus usage counters
+ */
+typedef struct {
+    uint32_t transactions;      /**< number of acquire/release pairs */
+    uint32_t transfers;         /**< number of blocking transfer calls */
+    uint32_t async_transfers;   /**< number of asynchronous transfers */
+    uint32_t bytes;             /**< number of bytes exchanged in total */
+} spi_emu_stats_t;
+
+/**
+ * @brief   Attaches a slave model to a bus
+ *
+ * Without a slave, the master reads 0xff (a floating MISO line).
+ *
+ * @param[in] dev       SPI bus
+ * @param[in] slave     slave model, NULL to detach the current slave
+ * @param[in] arg       context passed to the callbacks of @p slave
+ */
+void spi_emu_attach(spi_t dev, const spi_emu_slave_t *slave, void *arg);
+
+/**
+ * @brief   Gets the usage counters of a bus
+ *
+ * @param[in] dev       SPI bus
+ * @param[out] stats    counters
+ */
+void spi_emu_get_stats(spi_t dev, spi_emu_stats_t *stats);
+
+/**
+ * @brief   Resets the usage counters of a bus
+ *
+ * @param[in] dev       SPI bus
+ */
+void spi_emu_reset_stats(spi_t dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPI_EMU_H */
+/** @} */
@@ -93,16 +93,33 @@ static inline int _set_promiscous(netdev2_t *netdev, int value)
     return value;
 }
 
+static int _read_frame(netdev2_tap_t *dev);
+static void _continue_reading(netdev2_tap_t *dev);
+
 static inline void _isr(netdev2_t *netdev)
 {
-    if (netdev->event_callback) {
-        netdev->event_callback(netdev, NETDEV2_EVENT_RX_COMPLETE);
-    }
+    netdev2_tap_t *dev = (netdev2_tap_t*)netdev;
+
+    if (!netdev->event_callback) {
 #if DEVELHELP
-    else {
         puts("netdev2_tap: _isr(): no event_callback set.");
-    }
 #endif
+        return;
+    }
+
+    /* drain all pending frames (up to the batch limit) before re-arming the
+     * asynchronous read, the upper layer fetches each frame from rx_buf */
+    for (unsigned i = 0; i < NETDEV2_TAP_RX_BATCH; i++) {
+        int nread = _read_frame(dev);
+        if (nread <= 0) {
+            break;
+        }
+        dev->rx_len = nread;
+        netdev->event_callback(netdev, NETDEV2_EVENT_RX_COMPLETE);
+        dev->rx_len = 0;
+    }
+
+    _continue_reading(dev);
 }
 
 static int _get(netdev2_t *dev, netopt_t opt, void *value, size_t max_len)
@@ -209,6 +226,43 @@ static void _continue_reading(netdev2_tap_t *dev)
     _native_in_syscall--;
 }
 
+/* reads the next frame addressed to us into rx_buf, returns its length or 0
+ * if no frame is pending */
+static int _read_frame(netdev2_tap_t *dev)
+{
+    while (1) {
+        int nread = real_read(dev->tap_fd, dev->rx_buf, sizeof(dev->rx_buf));
+        DEBUG("netdev2_tap: read %d bytes\n", nread);
+
+        if (nread > 0) {
+            ethernet_hdr_t *hdr = (ethernet_hdr_t *)dev->rx_buf;
+            if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
+                !_is_addr_broadcast(hdr->dst) &&
+                (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
+                DEBUG("netdev2_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
+                      "That's not me => Dropped\n",
+                      hdr->dst[0], hdr->dst[1], hdr->dst[2],
+                      hdr->dst[3], hdr->dst[4], hdr->dst[5]);
+                continue;
+            }
+            return nread;
+        }
+        else if (nread == -1) {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+                err(EXIT_FAILURE, "netdev2_tap: read");
+            }
+        }
+        else if (nread == 0) {
+            DEBUG("_native_handle_tap_input: ignoring null-event\n");
+        }
+        else {
+            errx(EXIT_FAILURE, "internal error _rx_event");
+        }
+
+        return 0;
+    }
+}
+
 static int _recv(netdev2_t *netdev2, void *buf, size_t len, void *info)
 {
     netdev2_tap_t *dev = (netdev2_tap_t*)netdev2;
@@ -218,68 +272,27 @@ static int _recv(netdev2_t *netdev2, void *buf, size_t len, void *info)
         if (len > 0) {
             /* no memory available in pktbuf, discarding the frame */
             DEBUG("netdev2_tap: discarding the frame\n");
-
-            /* repeating `real_read` for small size on tap device results in
-             * freeze for some reason. Using a large buffer for now. */
-            /*
-            uint8_t buf[4];
-            while (real_read(dev->tap_fd, buf, sizeof(buf)) > 0) {
-            }
-            */
-
-            static uint8_t buf[ETHERNET_FRAME_LEN];
-
-            real_read(dev->tap_fd, buf, sizeof(buf));
-
-            _continue_reading(dev);
+            dev->rx_len = 0;
+            return 0;
         }
 
-        /* no way of figuring out packet size without racey buffering,
-         * so we return the maximum possible size */
-        return ETHERNET_FRAME_LEN;
+        /* the frame was already read by _isr(), so its exact size is known */
+        return dev->rx_len;
     }
 
-    int nread = real_read(dev->tap_fd, buf, len);
-    DEBUG("netdev2_tap: read %d bytes\n", nread);
-
-    if (nread > 0) {
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)buf;
-        if (!(dev->promiscous) && !_is_addr_multicast(hdr->dst) &&
-            !_is_addr_broadcast(hdr->dst) &&
-            (memcmp(hdr->dst, dev->addr, ETHERNET_ADDR_LEN) != 0)) {
-            DEBUG("netdev2_tap: received for %02x:%02x:%02x:%02x:%02x:%02x\n"
-                  "That's not me => Dropped\n",
-                  hdr->dst[0], hdr->dst[1], hdr->dst[2],
-                  hdr->dst[3], hdr->dst[4], hdr->dst[5]);
-
-            native_async_read_continue(dev->tap_fd);
-
-            return 0;
-        }
+    if (dev->rx_len == 0) {
+        return -1;
+    }
 
-        _continue_reading(dev);
+    size_t nread = (len < dev->rx_len) ? len : dev->rx_len;
+    memcpy(buf, dev->rx_buf, nread);
+    dev->rx_len = 0;
 
 #ifdef MODULE_NETSTATS_L2
-        netdev2->stats.rx_count++;
-        netdev2->stats.rx_bytes += nread;
+    netdev2->stats.rx_count++;
+    netdev2->stats.rx_bytes += nread;
 #endif
-        return nread;
-    }
-    else if (nread == -1) {
-        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
-        }
-        else {
-            err(EXIT_FAILURE, "netdev2_tap: read");
-        }
-    }
-    else if (nread == 0) {
-        DEBUG("_native_handle_tap_input: ignoring null-event\n");
-    }
-    else {
-        errx(EXIT_FAILURE, "internal error _rx_event");
-    }
-
-    return -1;
+    return nread;
 }
 
 static int _send(netdev2_t *netdev, const struct iovec *vector, unsigned n)
@@ -0,0 +1,421 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for
+ * more details.
+ */
+
+/*
+ * @ingroup netdev2
+ * @{
+ * @brief   IEEE 802.15.4 driver for a simulated radio medium on native
+ * @author  agent <agent@local>
+ * @}
+ */
+#include <assert.h>
+#include <err.h>
+#include <errno.h>
+#include <netdb.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "native_internal.h"
+
+#include "async_read.h"
+
+#include "byteorder.h"
+#include "net/ieee802154.h"
+#include "net/netdev2.h"
+#include "net/netdev2/ieee802154.h"
+#include "net/netopt.h"
+#include "netdev2_vmedium.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _HDR_LEN            (3U)    /**< message type and node id */
+#define _FLOW_MSG_LEN       (_HDR_LEN + 6U)
+
+/* support one simulated radio for now */
+netdev2_vmedium_t netdev2_vmedium;
+
+static int _init(netdev2_t *netdev);
+static int _send(netdev2_t *netdev, const struct iovec *vector, unsigned n);
+static int _recv(netdev2_t *netdev, void *buf, size_t len, void *info);
+static void _isr(netdev2_t *netdev);
+static int _get(netdev2_t *netdev, netopt_t opt, void *value, size_t max_len);
+static int _set(netdev2_t *netdev, netopt_t opt, void *value, size_t value_len);
+
+static const netdev2_driver_t netdev2_driver_vmedium = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+static void _set_hdr(netdev2_vmedium_t *dev, uint8_t *hdr, uint8_t type)
+{
+    hdr[0] = type;
+    hdr[1] = (uint8_t)(dev->params.node_id >> 8);
+    hdr[2] = (uint8_t)(dev->params.node_id);
+}
+
+static void _send_flow_msg(netdev2_vmedium_t *dev, uint8_t type,
+                           uint16_t flow, uint32_t seq)
+{
+    uint8_t msg[_FLOW_MSG_LEN];
+
+    if (dev->sock_fd < 0) {
+        return;
+    }
+    _set_hdr(dev, msg, type);
+    msg[3] = (uint8_t)(flow >> 8);
+    msg[4] = (uint8_t)(flow);
+    msg[5] = (uint8_t)(seq >> 24);
+    msg[6] = (uint8_t)(seq >> 16);
+    msg[7] = (uint8_t)(seq >> 8);
+    msg[8] = (uint8_t)(seq);
+
+    _native_write(dev->sock_fd, msg, sizeof(msg));
+}
+
+void netdev2_vmedium_flow_tx(netdev2_vmedium_t *dev, uint16_t flow,
+                             uint32_t seq)
+{
+    _send_flow_msg(dev, NETDEV2_VMEDIUM_MSG_FLOW_TX, flow, seq);
+}
+
+void netdev2_vmedium_flow_rx(netdev2_vmedium_t *dev, uint16_t flow,
+                             uint32_t seq)
+{
+    _send_flow_msg(dev, NETDEV2_VMEDIUM_MSG_FLOW_RX, flow, seq);
+}
+
+static void _send_radio_msg(netdev2_vmedium_t *dev)
+{
+    uint8_t msg[_HDR_LEN + 1];
+
+    if (dev->sock_fd < 0) {
+        return;
+    }
+    _set_hdr(dev, msg, NETDEV2_VMEDIUM_MSG_RADIO);
+    msg[_HDR_LEN] = !dev->sleeping;
+
+    _native_write(dev->sock_fd, msg, sizeof(msg));
+}
+
+/* hardware address filter: accept broadcasts and frames for our PAN and
+ * address, as well as beacons and acknowledgements, which carry no address */
+static bool _addressed_to_us(netdev2_vmedium_t *dev, const uint8_t *mhr)
+{
+    return ieee802154_dst_filter(mhr, dev->netdev.pan, dev->netdev.short_addr,
+                                 dev->netdev.long_addr) == 0;
+}
+
+/* reads the next frame addressed to us into rx_buf, returns its length or 0
+ * if no frame is pending */
+static int _read_frame(netdev2_vmedium_t *dev)
+{
+    while (1) {
+        int nread = real_read(dev->sock_fd, dev->rx_buf, sizeof(dev->rx_buf));
+
+        if (nread == -1) {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK) &&
+                (errno != ECONNREFUSED)) {
+                err(EXIT_FAILURE, "netdev2_vmedium: read");
+            }
+            return 0;
+        }
+        if ((nread <= (int)NETDEV2_VMEDIUM_RX_HDR_LEN) ||
+            (dev->rx_buf[0] != NETDEV2_VMEDIUM_MSG_FRAME)) {
+            DEBUG("netdev2_vmedium: ignoring invalid datagram\n");
+            continue;
+        }
+        nread -= NETDEV2_VMEDIUM_RX_HDR_LEN;
+        if (dev->sleeping) {
+            DEBUG("netdev2_vmedium: radio off, frame lost\n");
+            continue;
+        }
+        if (!dev->promiscuous &&
+            !_addressed_to_us(dev, dev->rx_buf + NETDEV2_VMEDIUM_RX_HDR_LEN)) {
+            DEBUG("netdev2_vmedium: frame not for us, dropped\n");
+            continue;
+        }
+        dev->rx_lqi = dev->rx_buf[_HDR_LEN];
+        return nread;
+    }
+}
+
+static void _isr(netdev2_t *netdev)
+{
+    netdev2_vmedium_t *dev = (netdev2_vmedium_t *)netdev;
+    int nread;
+
+    if (!netdev->event_callback) {
+        return;
+    }
+    while ((nread = _read_frame(dev)) > 0) {
+        dev->rx_len = nread;
+        netdev->event_callback(netdev, NETDEV2_EVENT_RX_COMPLETE);
+        dev->rx_len = 0;
+    }
+    native_async_read_continue(dev->sock_fd);
+}
+
+static int _recv(netdev2_t *netdev, void *buf, size_t len, void *info)
+{
+    netdev2_vmedium_t *dev = (netdev2_vmedium_t *)netdev;
+
+    if (!buf) {
+        if (len > 0) {
+            /* no memory available in pktbuf, discarding the frame */
+            dev->rx_len = 0;
+            return 0;
+        }
+        return dev->rx_len;
+    }
+    if (dev->rx_len == 0) {
+        return -1;
+    }
+    if (len < dev->rx_len) {
+        return -ENOBUFS;
+    }
+
+    len = dev->rx_len;
+    memcpy(buf, dev->rx_buf + NETDEV2_VMEDIUM_RX_HDR_LEN, len);
+    dev->rx_len = 0;
+
+    if (info != NULL) {
+        netdev2_ieee802154_rx_info_t *radio_info = info;
+        radio_info->lqi = dev->rx_lqi;
+        radio_info->rssi = 0;
+    }
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.rx_count++;
+    netdev->stats.rx_bytes += len;
+#endif
+    return len;
+}
+
+static int _send(netdev2_t *netdev, const struct iovec *vector, unsigned n)
+{
+    netdev2_vmedium_t *dev = (netdev2_vmedium_t *)netdev;
+    struct iovec iov[n + 1];
+    uint8_t hdr[_HDR_LEN];
+    size_t len = 0;
+
+    _set_hdr(dev, hdr, NETDEV2_VMEDIUM_MSG_FRAME);
+    iov[0].iov_base = hdr;
+    iov[0].iov_len = sizeof(hdr);
+    for (unsigned i = 0; i < n; i++) {
+        iov[i + 1] = vector[i];
+        len += vector[i].iov_len;
+    }
+    /* account for the FCS a real radio would append */
+    if ((len + IEEE802154_FCS_LEN) > IEEE802154_FRAME_LEN_MAX) {
+        DEBUG("netdev2_vmedium: frame too large (%u byte)\n", (unsigned)len);
+        return -EOVERFLOW;
+    }
+
+    int res = _native_writev(dev->sock_fd, iov, n + 1);
+    if (res < 0) {
+        return -EIO;
+    }
+#ifdef MODULE_NETSTATS_L2
+    netdev->stats.tx_bytes += len;
+#endif
+    if (netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV2_EVENT_TX_COMPLETE);
+    }
+    return (int)len;
+}
+
+static int _get(netdev2_t *netdev, netopt_t opt, void *value, size_t max_len)
+{
+    netdev2_vmedium_t *dev = (netdev2_vmedium_t *)netdev;
+
+    switch (opt) {
+        case NETOPT_CHANNEL:
+            assert(max_len >= sizeof(uint16_t));
+            *((uint16_t *)value) = dev->netdev.chan;
+            return sizeof(uint16_t);
+        case NETOPT_MAX_PACKET_SIZE:
+            assert(max_len >= sizeof(int16_t));
+            *((uint16_t *)value) = IEEE802154_FRAME_LEN_MAX -
+                                   IEEE802154_FCS_LEN;
+            return sizeof(uint16_t);
+        case NETOPT_PROMISCUOUSMODE:
+            *((netopt_enable_t *)value) = dev->promiscuous ? NETOPT_ENABLE
+                                                           : NETOPT_DISABLE;
+            return sizeof(netopt_enable_t);
+        case NETOPT_STATE:
+            assert(max_len >= sizeof(netopt_state_t));
+            *((netopt_state_t *)value) = (dev->sleeping) ? NETOPT_STATE_SLEEP
+                                                         : NETOPT_STATE_IDLE;
+            return sizeof(netopt_state_t);
+        default:
+            return netdev2_ieee802154_get(&dev->netdev, opt, value, max_len);
+    }
+}
+
+static int _set(netdev2_t *netdev, netopt_t opt, void *value, size_t value_len)
+{
+    netdev2_vmedium_t *dev = (netdev2_vmedium_t *)netdev;
+
+    switch (opt) {
+        case NETOPT_CHANNEL: {
+            assert(value_len == sizeof(uint16_t));
+            uint16_t chan = *((uint16_t *)value);
+            if ((chan < IEEE802154_CHANNEL_MIN) ||
+                (chan > IEEE802154_CHANNEL_MAX)) {
+                return -EINVAL;
+            }
+            dev->netdev.chan = chan;
+            return sizeof(uint16_t);
+        }
+        case NETOPT_PROMISCUOUSMODE:
+            dev->promiscuous = (*((netopt_enable_t *)value) == NETOPT_ENABLE);
+            return sizeof(netopt_enable_t);
+        case NETOPT_STATE: {
+            assert(value_len >= sizeof(netopt_state_t));
+            uint8_t sleeping;
+
+            switch (*((netopt_state_t *)value)) {
+                case NETOPT_STATE_OFF:
+                case NETOPT_STATE_SLEEP:
+                    sleeping = 1;
+                    break;
+                case NETOPT_STATE_IDLE:
+                case NETOPT_STATE_RX:
+                    sleeping = 0;
+                    break;
+                default:
+                    return -ENOTSUP;
+            }
+            if (sleeping != dev->sleeping) {
+                dev->sleeping = sleeping;
+                /* the broker accounts the radio-on time */
+                _send_radio_msg(dev);
+            }
+            return sizeof(netopt_state_t);
+        }
+        default:
+            return netdev2_ieee802154_set(&dev->netdev, opt, value, value_len);
+    }
+}
+
+static void _sock_isr(int fd, void *arg)
+{
+    (void)fd;
+    netdev2_t *netdev = arg;
+
+    if (netdev->event_callback) {
+        netdev->event_callback(netdev, NETDEV2_EVENT_ISR);
+    }
+    else {
+        puts("netdev2_vmedium: _isr: no event callback.");
+    }
+}
+
+static int _connect(netdev2_vmedium_t *dev)
+{
+    struct addrinfo hints, *res, *cur;
+    int fd = -1;
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+
+    int gai = real_getaddrinfo(dev->params.host, dev->params.port, &hints, &res);
+    if (gai != 0) {
+        errx(EXIT_FAILURE, "netdev2_vmedium: getaddrinfo(%s): %s",
+             dev->params.host, real_gai_strerror(gai));
+    }
+    for (cur = res; cur != NULL; cur = cur->ai_next) {
+        fd = real_socket(cur->ai_family, cur->ai_socktype, cur->ai_protocol);
+        if (fd == -1) {
+            continue;
+        }
+        /* a connected UDP socket allows using read() and writev() */
+        if (real_connect(fd, cur->ai_addr, cur->ai_addrlen) == 0) {
+            break;
+        }
+        real_close(fd);
+        fd = -1;
+    }
+    real_freeaddrinfo(res);
+    return fd;
+}
+
+static int _init(netdev2_t *netdev)
+{
+    netdev2_vmedium_t *dev = (netdev2_vmedium_t *)netdev;
+    uint8_t hello[_HDR_LEN];
+    uint16_t id = dev->params.node_id;
+
+    if ((dev->sock_fd = _connect(dev)) == -1) {
+        err(EXIT_FAILURE, "netdev2_vmedium: unable to reach broker at %s:%s",
+            dev->params.host, dev->params.port);
+    }
+
+    /* derive stable addresses from the node id, the long address is marked
+     * as locally administered */
+    memset(dev->netdev.long_addr, 0, sizeof(dev->netdev.long_addr));
+    dev->netdev.long_addr[0] = 0x02;
+    dev->netdev.long_addr[6] = (uint8_t)(id >> 8);
+    dev->netdev.long_addr[7] = (uint8_t)id;
+    dev->netdev.short_addr[0] = (uint8_t)(id >> 8);
+    dev->netdev.short_addr[1] = (uint8_t)id;
+    dev->netdev.pan = NETDEV2_VMEDIUM_PANID;
+    dev->netdev.chan = NETDEV2_VMEDIUM_CHANNEL;
+    dev->netdev.flags = NETDEV2_IEEE802154_SRC_MODE_LONG;
+#ifdef MODULE_GNRC_SIXLOWPAN
+    dev->netdev.proto = GNRC_NETTYPE_SIXLOWPAN;
+#elif MODULE_GNRC
+    dev->netdev.proto = GNRC_NETTYPE_UNDEF;
+#endif
+    dev->promiscuous = 0;
+    dev->rx_len = 0;
+
+    /* tell the broker where to deliver frames for this node */
+    _set_hdr(dev, hello, NETDEV2_VMEDIUM_MSG_HELLO);
+    if (real_write(dev->sock_fd, hello, sizeof(hello)) == -1) {
+        err(EXIT_FAILURE, "netdev2_vmedium: write");
+    }
+
+    native_async_read_setup();
+    native_async_read_add_handler(dev->sock_fd, netdev, _sock_isr);
+
+#ifdef MODULE_NETSTATS_L2
+    memset(&netdev->stats, 0, sizeof(netstats_t));
+#endif
+    DEBUG("netdev2_vmedium: node %u initialized\n", (unsigned)id);
+    return 0;
+}
+
+void netdev2_vmedium_setup(netdev2_vmedium_t *dev,
+                           const netdev2_vmedium_params_t *params)
+{
+    memset(dev, 0, sizeof(netdev2_vmedium_t));
+    dev->netdev.netdev.driver = &netdev2_driver_vmedium;
+    dev->params = *params;
+    dev->sock_fd = -1;
+}
+
+void netdev2_vmedium_cleanup(netdev2_vmedium_t *dev)
+{
+    if (!dev || (dev->sock_fd < 0)) {
+        return;
+    }
+    real_close(dev->sock_fd);
+    dev->sock_fd = -1;
+}
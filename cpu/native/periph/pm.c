@@ -28,6 +28,7 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#ifndef MODULE_PM_LAYERED
 void pm_set_lowest(void)
 {
     _native_in_syscall++; // no switching here
@@ -39,6 +40,7 @@ void pm_set_lowest(void)
         _native_syscall_leave();
     }
 }
+#endif
 
 void pm_off(void)
 {
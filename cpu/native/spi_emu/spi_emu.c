@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     native_spi_emu
+ * @{
+ *
+ * @file
+ * @brief       Emulated SPI peripheral for native
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <err.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "irq.h"
+#include "mutex.h"
+#include "native_internal.h"
+#include "periph/spi.h"
+#include "spi_emu.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#if SPI_NUMOF
+
+/**
+ * @brief   Signal used to complete asynchronous transfers
+ */
+#define SPI_EMU_SIGNAL      (SIGUSR2)
+
+typedef struct {
+    const spi_emu_slave_t *slave;
+    void *slave_arg;
+    spi_emu_stats_t stats;
+    /* asynchronous transfer in progress, cb is NULL if none */
+    spi_async_cb_t cb;
+    void *cb_arg;
+    char *out;
+    char *in;
+    unsigned int length;
+} spi_emu_t;
+
+static spi_emu_t _spi[SPI_NUMOF];
+static mutex_t _locks[SPI_NUMOF] = { MUTEX_INIT };
+static int _signal_registered;
+
+static unsigned _exchange(spi_emu_t *spi, char *out, char *in,
+                          unsigned int length)
+{
+    for (unsigned i = 0; i < length; i++) {
+        uint8_t o = out ? (uint8_t)out[i] : 0;
+        uint8_t r = spi->slave ? spi->slave->transfer(spi->slave_arg, o) : 0xff;
+        if (in) {
+            in[i] = (char)r;
+        }
+    }
+    spi->stats.bytes += length;
+    return length;
+}
+
+/* "DMA complete" interrupt */
+static void _async_isr(void)
+{
+    for (unsigned i = 0; i < SPI_NUMOF; i++) {
+        spi_emu_t *spi = &_spi[i];
+        spi_async_cb_t cb = spi->cb;
+
+        if (cb == NULL) {
+            continue;
+        }
+        int res = _exchange(spi, spi->out, spi->in, spi->length);
+        spi->cb = NULL;
+        DEBUG("spi: async transfer of %u byte done\n", spi->length);
+        cb(spi->cb_arg, res);
+    }
+}
+
+int spi_init_master(spi_t dev, spi_conf_t conf, spi_speed_t speed)
+{
+    (void)conf;
+    (void)speed;
+
+    if (dev >= SPI_NUMOF) {
+        return -1;
+    }
+    if (!_signal_registered) {
+        if (register_interrupt(SPI_EMU_SIGNAL, _async_isr) != 0) {
+            err(EXIT_FAILURE, "spi_init_master: register_interrupt");
+        }
+        _signal_registered = 1;
+    }
+    return 0;
+}
+
+int spi_init_slave(spi_t dev, spi_conf_t conf, char (*cb)(char data))
+{
+    (void)dev;
+    (void)conf;
+    (void)cb;
+
+    /* the emulated bus only knows native as master */
+    return -1;
+}
+
+int spi_conf_pins(spi_t dev)
+{
+    return (dev < SPI_NUMOF) ? 0 : -1;
+}
+
+int spi_acquire(spi_t dev)
+{
+    if (dev >= SPI_NUMOF) {
+        return -1;
+    }
+    mutex_lock(&_locks[dev]);
+    _spi[dev].stats.transactions++;
+    if (_spi[dev].slave && _spi[dev].slave->begin) {
+        _spi[dev].slave->begin(_spi[dev].slave_arg);
+    }
+    return 0;
+}
+
+int spi_release(spi_t dev)
+{
+    if (dev >= SPI_NUMOF) {
+        return -1;
+    }
+    if (_spi[dev].slave && _spi[dev].slave->end) {
+        _spi[dev].slave->end(_spi[dev].slave_arg);
+    }
+    mutex_unlock(&_locks[dev]);
+    return 0;
+}
+
+int spi_transfer_bytes(spi_t dev, char *out, char *in, unsigned int length)
+{
+    if ((dev >= SPI_NUMOF) || (_spi[dev].cb != NULL)) {
+        return -1;
+    }
+    _spi[dev].stats.transfers++;
+    return _exchange(&_spi[dev], out, in, length);
+}
+
+int spi_transfer_async(spi_t dev, char *out, char *in, unsigned int length,
+                       spi_async_cb_t cb, void *arg)
+{
+    if ((dev >= SPI_NUMOF) || (cb == NULL) || !_signal_registered) {
+        return -1;
+    }
+
+    spi_emu_t *spi = &_spi[dev];
+
+    unsigned state = irq_disable();
+    if (spi->cb != NULL) {
+        irq_restore(state);
+        return -1;
+    }
+    spi->out = out;
+    spi->in = in;
+    spi->length = length;
+    spi->cb_arg = arg;
+    spi->cb = cb;
+    spi->stats.async_transfers++;
+    irq_restore(state);
+
+    /* the data is exchanged in the completion interrupt */
+    _native_syscall_enter();
+    if (kill(_native_pid, SPI_EMU_SIGNAL) == -1) {
+        err(EXIT_FAILURE, "spi_transfer_async: kill");
+    }
+    _native_syscall_leave();
+
+    return 0;
+}
+
+void spi_transmission_begin(spi_t dev, char reset_val)
+{
+    (void)dev;
+    (void)reset_val;
+}
+
+void spi_poweron(spi_t dev)
+{
+    (void)dev;
+}
+
+void spi_poweroff(spi_t dev)
+{
+    (void)dev;
+}
+
+void spi_emu_attach(spi_t dev, const spi_emu_slave_t *slave, void *arg)
+{
+    unsigned state = irq_disable();
+    _spi[dev].slave = slave;
+    _spi[dev].slave_arg = arg;
+    irq_restore(state);
+}
+
+void spi_emu_get_stats(spi_t dev, spi_emu_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    *stats = _spi[dev].stats;
+    irq_restore(state);
+}
+
+void spi_emu_reset_stats(spi_t dev)
+{
+    unsigned state = irq_disable();
+    memset(&_spi[dev].stats, 0, sizeof(spi_emu_stats_t));
+    irq_restore(state);
+}
+
+#endif /* SPI_NUMOF */
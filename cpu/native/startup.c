@@ -52,6 +52,10 @@ const char *_native_unix_socket_path = NULL;
 #include "netdev2_tap.h"
 extern netdev2_tap_t netdev2_tap;
 #endif
+#ifdef MODULE_NETDEV2_VMEDIUM
+#include "netdev2_vmedium.h"
+extern netdev2_vmedium_t netdev2_vmedium;
+#endif
 
 /**
  * initialize _native_null_in_pipe to allow for reading from stdin
@@ -202,7 +206,11 @@ void usage_exit(void)
     real_printf(" <tap interface>");
 #endif
 
-    real_printf(" [-i <id>] [-d] [-e|-E] [-o] [-c <tty device>]\n");
+    real_printf(" [-i <id>] [-d] [-e|-E] [-o] [-c <tty device>]");
+#if defined(MODULE_NETDEV2_VMEDIUM)
+    real_printf(" [-m <host>:<port>]");
+#endif
+    real_printf("\n");
 
     real_printf(" help: %s -h\n", _progname);
 
@@ -220,6 +228,12 @@ void usage_exit(void)
 -o          redirect stdout to file (/tmp/riot.stdout.PID) when not attached\n\
             to socket\n\
 -c          specify TTY device for UART\n");
+#if defined(MODULE_NETDEV2_VMEDIUM)
+    real_printf("\
+-m          specify the virtual medium broker (default " NETDEV2_VMEDIUM_HOST ":"
+            NETDEV2_VMEDIUM_PORT "),\n\
+            the instance id (-i) is used as node id\n");
+#endif
 
     real_printf("\n\
 The order of command line arguments matters.\n");
@@ -243,6 +257,9 @@ __attribute__((constructor)) static void startup(int argc, char **argv)
     char *stdouttype = "stdio";
     char *stdiotype = "stdio";
     int uart = 0;
+#if defined(MODULE_NETDEV2_VMEDIUM)
+    char *vmedium = NULL;
+#endif
 
 #if defined(MODULE_NETDEV2_TAP)
     if (
@@ -311,6 +328,17 @@ __attribute__((constructor)) static void startup(int argc, char **argv)
 
             tty_uart_setup(uart++, argv[argp]);
         }
+#if defined(MODULE_NETDEV2_VMEDIUM)
+        else if (strcmp("-m", arg) == 0) {
+            if (argp + 1 < argc) {
+                argp++;
+            }
+            else {
+                usage_exit();
+            }
+            vmedium = argv[argp];
+        }
+#endif
         else {
             usage_exit();
         }
@@ -331,6 +359,26 @@ __attribute__((constructor)) static void startup(int argc, char **argv)
     p.tap_name = &(argv[1]);
     netdev2_tap_setup(&netdev2_tap, &p);
 #endif
+#ifdef MODULE_NETDEV2_VMEDIUM
+    netdev2_vmedium_params_t vp = {
+        .host = NETDEV2_VMEDIUM_HOST,
+        .port = NETDEV2_VMEDIUM_PORT,
+        .node_id = (uint16_t)_native_id,
+    };
+    if (vmedium != NULL) {
+        /* split "<host>:<port>", the port may be given alone as ":<port>" */
+        char *sep = strrchr(vmedium, ':');
+        if (sep == NULL) {
+            usage_exit();
+        }
+        *sep = '\0';
+        if (*vmedium != '\0') {
+            vp.host = vmedium;
+        }
+        vp.port = sep + 1;
+    }
+    netdev2_vmedium_setup(&netdev2_vmedium, &vp);
+#endif
 
     board_init();
 
@@ -0,0 +1,400 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+# Copyright (C) 2016 agent <agent@local>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Broker for the virtual IEEE 802.15.4 medium of RIOT native.
+
+Native instances built with the `netdev2_vmedium` module send their frames
+to this broker via UDP. The broker forwards each frame to the neighbors of
+the sender as given by a topology file, applying per-link loss, delay and
+bandwidth. It also collects per-link and per-flow statistics and the share
+of time the radio of each node was switched on.
+
+Optionally the broker spawns one native instance per node of the topology
+and feeds shell commands to them at given times, so that a complete
+experiment runs with a single command line.
+"""
+
+import argparse
+import heapq
+import json
+import os
+import random
+import select
+import signal
+import socket
+import struct
+import subprocess
+import sys
+import time
+
+MSG_HELLO = 0
+MSG_FRAME = 1
+MSG_FLOW_TX = 2
+MSG_FLOW_RX = 3
+MSG_RADIO = 4
+
+HDR = struct.Struct("!BH")
+FLOW = struct.Struct("!HI")
+
+DEFAULT_PORT = 17754
+DEFAULT_KBPS = 250.0
+
+
+class Link(object):
+    def __init__(self, src, dst, loss=0.0, delay=0.0, kbps=DEFAULT_KBPS):
+        self.src = src
+        self.dst = dst
+        self.loss = loss
+        self.delay = delay          # in seconds
+        self.kbps = kbps
+        self.busy_until = 0.0
+        self.frames = 0
+        self.lost = 0
+        self.delivered = 0
+        self.undeliverable = 0
+        self.bytes = 0
+
+    @property
+    def lqi(self):
+        return int(round(255 * (1.0 - self.loss)))
+
+    def stats(self):
+        return {"src": self.src, "dst": self.dst, "frames": self.frames,
+                "delivered": self.delivered, "lost": self.lost,
+                "undeliverable": self.undeliverable, "bytes": self.bytes}
+
+
+class Flow(object):
+    def __init__(self, flow_id):
+        self.id = flow_id
+        self.pending = {}
+        self.sent = 0
+        self.received = 0
+        self.duplicates = 0
+        self.latencies = []
+
+    def tx(self, seq, now):
+        self.sent += 1
+        self.pending[seq] = now
+
+    def rx(self, seq, now):
+        if seq not in self.pending:
+            self.duplicates += 1
+            return
+        self.received += 1
+        self.latencies.append(now - self.pending.pop(seq))
+
+    def stats(self):
+        res = {"flow": self.id, "sent": self.sent, "received": self.received,
+               "duplicates": self.duplicates,
+               "pdr": (float(self.received) / self.sent) if self.sent else 0.0}
+        if self.latencies:
+            lat = sorted(self.latencies)
+            res["latency_ms"] = {
+                "min": lat[0] * 1000,
+                "avg": sum(lat) / len(lat) * 1000,
+                "p95": lat[min(len(lat) - 1, int(len(lat) * 0.95))] * 1000,
+                "max": lat[-1] * 1000,
+            }
+        return res
+
+
+class Radio(object):
+    """Radio-on time of a node, radios are on until a node reports otherwise.
+    """
+    def __init__(self, node, now):
+        self.node = node
+        self.start = now
+        self.since = now
+        self.on = True
+        self.on_time = 0.0
+        self.switches = 0
+
+    def set(self, on, now):
+        if on == self.on:
+            return
+        if self.on:
+            self.on_time += now - self.since
+        self.on = on
+        self.since = now
+        self.switches += 1
+
+    def stats(self, now):
+        on_time = self.on_time + ((now - self.since) if self.on else 0.0)
+        total = now - self.start
+        return {"node": self.node, "time": total, "on_time": on_time,
+                "switches": self.switches,
+                "on_ratio": (on_time / total) if total > 0 else 1.0}
+
+
+def parse_topology(path, bidirectional):
+    """Parses lines of `<src> <dst> [loss] [delay_ms] [kbps]`."""
+    links = {}
+    nodes = set()
+    with open(path) as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.split("#", 1)[0].strip()
+            if not line:
+                continue
+            fields = line.split()
+            try:
+                src, dst = int(fields[0]), int(fields[1])
+                loss = float(fields[2]) if len(fields) > 2 else 0.0
+                delay = float(fields[3]) / 1000 if len(fields) > 3 else 0.0
+                kbps = float(fields[4]) if len(fields) > 4 else DEFAULT_KBPS
+            except (IndexError, ValueError):
+                sys.exit("%s:%d: invalid link definition" % (path, lineno))
+            if not (0.0 <= loss <= 1.0) or (kbps <= 0):
+                sys.exit("%s:%d: invalid link parameters" % (path, lineno))
+            pairs = [(src, dst)]
+            if bidirectional:
+                pairs.append((dst, src))
+            for a, b in pairs:
+                links.setdefault(a, {})[b] = Link(a, b, loss, delay, kbps)
+            nodes.update((src, dst))
+    return nodes, links
+
+
+def parse_commands(path):
+    """Parses lines of `<time_s> <node|*> <shell command>`."""
+    cmds = []
+    with open(path) as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            fields = line.split(None, 2)
+            try:
+                at = float(fields[0])
+                node = None if fields[1] == "*" else int(fields[1])
+                cmds.append((at, node, fields[2]))
+            except (IndexError, ValueError):
+                sys.exit("%s:%d: invalid command" % (path, lineno))
+    return cmds
+
+
+class Broker(object):
+    def __init__(self, args):
+        self.nodes, self.links = parse_topology(args.topology,
+                                                args.bidirectional)
+        self.rng = random.Random(args.seed)
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.bind((args.host, args.port))
+        self.addrs = {}
+        self.flows = {}
+        self.radios = {}
+        self.events = []
+        self.event_seq = 0
+        self.procs = {}
+        self.verbose = args.verbose
+
+    def schedule(self, at, action, *args):
+        heapq.heappush(self.events, (at, self.event_seq, action, args))
+        self.event_seq += 1
+
+    def spawn(self, elf, host, port, log_dir):
+        for node in sorted(self.nodes):
+            log = open(os.path.join(log_dir, "vmedium-%d.log" % node), "w")
+            cmd = [elf, "-i", str(node), "-m", "%s:%d" % (host, port)]
+            self.procs[node] = subprocess.Popen(cmd, stdin=subprocess.PIPE,
+                                                stdout=log,
+                                                stderr=subprocess.STDOUT)
+
+    def _command(self, node, cmd):
+        targets = self.procs.keys() if node is None else [node]
+        for target in targets:
+            proc = self.procs.get(target)
+            if proc is None or proc.poll() is not None:
+                print("vmedium: node %d is not running" % target)
+                continue
+            proc.stdin.write((cmd + "\n").encode())
+            proc.stdin.flush()
+
+    def _deliver(self, dst, datagram):
+        addr = self.addrs.get(dst)
+        if addr is not None:
+            self.sock.sendto(datagram, addr)
+
+    def _frame(self, src, frame, now):
+        for link in self.links.get(src, {}).values():
+            link.frames += 1
+            link.bytes += len(frame)
+            if link.dst not in self.addrs:
+                link.undeliverable += 1
+                continue
+            if self.rng.random() < link.loss:
+                link.lost += 1
+                continue
+            link.delivered += 1
+            # frames on a link are serialized, add two byte of FCS and the
+            # six byte of PHY header a real radio transmits
+            airtime = (len(frame) + 8) * 8 / (link.kbps * 1000)
+            start = max(now, link.busy_until)
+            link.busy_until = start + airtime
+            datagram = HDR.pack(MSG_FRAME, src) + bytes([link.lqi]) + frame
+            self.schedule(link.busy_until + link.delay, self._deliver,
+                          link.dst, datagram)
+
+    def _receive(self, now):
+        data, addr = self.sock.recvfrom(2048)
+        if len(data) < HDR.size:
+            return
+        msg_type, node = HDR.unpack_from(data)
+        payload = data[HDR.size:]
+        if msg_type == MSG_HELLO:
+            if node not in self.nodes:
+                print("vmedium: node %d is not part of the topology" % node)
+            self.addrs[node] = addr
+            self.radios[node] = Radio(node, now)
+            if self.verbose:
+                print("vmedium: node %d at %s:%d" % ((node,) + addr[:2]))
+        elif msg_type == MSG_FRAME:
+            # frames can only be received by nodes that announced themselves
+            self.addrs.setdefault(node, addr)
+            self._frame(node, payload, now)
+        elif msg_type in (MSG_FLOW_TX, MSG_FLOW_RX) and \
+                len(payload) >= FLOW.size:
+            flow_id, seq = FLOW.unpack_from(payload)
+            flow = self.flows.setdefault(flow_id, Flow(flow_id))
+            if msg_type == MSG_FLOW_TX:
+                flow.tx(seq, now)
+            else:
+                flow.rx(seq, now)
+        elif msg_type == MSG_RADIO and len(payload) >= 1:
+            radio = self.radios.setdefault(node, Radio(node, now))
+            radio.set(payload[0] != 0, now)
+
+    def run(self, duration):
+        start = time.time()
+        end = (start + duration) if duration else None
+        while True:
+            now = time.time()
+            while self.events and self.events[0][0] <= now:
+                _, _, action, args = heapq.heappop(self.events)
+                action(*args)
+            if end is not None and now >= end:
+                break
+            timeout = None
+            if self.events:
+                timeout = self.events[0][0] - now
+            if end is not None:
+                timeout = (end - now) if timeout is None else min(end - now,
+                                                                timeout)
+            readable, _, _ = select.select([self.sock], [], [], timeout)
+            if readable:
+                self._receive(time.time())
+
+    def stop(self):
+        for proc in self.procs.values():
+            if proc.poll() is None:
+                proc.terminate()
+        for proc in self.procs.values():
+            try:
+                proc.wait(timeout=2)
+            except subprocess.TimeoutExpired:
+                proc.kill()
+
+    def stats(self):
+        now = time.time()
+        return {
+            "links": [l.stats() for src in sorted(self.links)
+                      for _, l in sorted(self.links[src].items())],
+            "flows": [f.stats() for _, f in sorted(self.flows.items())],
+            "radios": [r.stats(now) for _, r in sorted(self.radios.items())],
+        }
+
+
+def print_stats(stats):
+    print("\n%-11s %8s %9s %6s %6s %9s" % ("link", "frames", "delivered",
+                                           "lost", "undel.", "bytes"))
+    for l in stats["links"]:
+        print("%4d -> %-4d %8d %9d %6d %6d %9d" % (
+            l["src"], l["dst"], l["frames"], l["delivered"], l["lost"],
+            l["undeliverable"], l["bytes"]))
+    if stats["radios"]:
+        print("\n%-6s %9s %9s %8s %9s" % ("node", "time [s]", "on [s]",
+                                          "on", "switches"))
+        for r in stats["radios"]:
+            print("%-6d %9.1f %9.1f %7.1f%% %9d" % (
+                r["node"], r["time"], r["on_time"], r["on_ratio"] * 100,
+                r["switches"]))
+    if not stats["flows"]:
+        return
+    print("\n%-6s %6s %6s %5s %7s %9s %9s %9s %9s" % (
+        "flow", "sent", "recv", "dup", "pdr", "min [ms]", "avg [ms]",
+        "p95 [ms]", "max [ms]"))
+    for f in stats["flows"]:
+        lat = f.get("latency_ms")
+        lat = ("%9.2f %9.2f %9.2f %9.2f" % (lat["min"], lat["avg"],
+               lat["p95"], lat["max"])) if lat else "%9s" % "-"
+        print("%-6d %6d %6d %5d %6.1f%% %s" % (
+            f["flow"], f["sent"], f["received"], f["duplicates"],
+            f["pdr"] * 100, lat))
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    p.add_argument("topology", help="topology file, one link per line: "
+                   "<src> <dst> [loss] [delay_ms] [kbps]")
+    p.add_argument("-b", "--bidirectional", action="store_true",
+                   help="add the reverse direction for every link")
+    p.add_argument("-H", "--host", default="127.0.0.1",
+                   help="address to listen on (default: %(default)s)")
+    p.add_argument("-p", "--port", type=int, default=DEFAULT_PORT,
+                   help="UDP port to listen on (default: %(default)s)")
+    p.add_argument("-s", "--seed", type=int, default=0,
+                   help="seed for the loss model (default: %(default)s)")
+    p.add_argument("-d", "--duration", type=float, default=0,
+                   help="stop after this many seconds (default: run until "
+                   "interrupted)")
+    p.add_argument("-e", "--elf",
+                   help="spawn one instance of this native binary per node")
+    p.add_argument("-c", "--commands",
+                   help="shell commands for the spawned nodes, one per line: "
+                   "<time_s> <node|*> <command>")
+    p.add_argument("-l", "--log-dir", default="/tmp",
+                   help="directory for the output of spawned nodes "
+                   "(default: %(default)s)")
+    p.add_argument("-j", "--json", help="also write the statistics to a "
+                   "JSON file")
+    p.add_argument("-v", "--verbose", action="store_true")
+    args = p.parse_args()
+
+    if args.commands and not args.elf:
+        p.error("--commands requires --elf")
+
+    broker = Broker(args)
+
+    def _interrupt(signum, frame):
+        raise KeyboardInterrupt()
+    signal.signal(signal.SIGTERM, _interrupt)
+
+    if args.elf:
+        broker.spawn(args.elf, args.host, args.port, args.log_dir)
+        now = time.time()
+        for at, node, cmd in parse_commands(args.commands) \
+                if args.commands else []:
+            broker.schedule(now + at, broker._command, node, cmd)
+
+    try:
+        broker.run(args.duration)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        broker.stop()
+
+    stats = broker.stats()
+    print_stats(stats)
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(stats, f, indent=2)
+
+
+if __name__ == "__main__":
+    main()
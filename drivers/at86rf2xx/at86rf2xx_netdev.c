@@ -22,6 +22,7 @@
  */
 
 #include <string.h>
+#include <stdbool.h>
 #include <assert.h>
 #include <errno.h>
 
@@ -127,6 +128,88 @@ static int _send(netdev2_t *netdev, const struct iovec *vector, unsigned count)
     return (int)len;
 }
 
+/**
+ * @brief   Decides on the MAC header if a received frame is passed up
+ *
+ * Only the MAC header is read from the frame buffer, so frames not addressed
+ * to us and retransmissions of the last received frame are dropped without
+ * transferring their payload over SPI. Must be called after the PHR was read.
+ */
+static bool _rx_accept(at86rf2xx_t *dev, size_t pkt_len)
+{
+    uint8_t mhr[IEEE802154_MAX_HDR_LEN];
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];
+    le_uint16_t src_pan;
+    size_t hdr_len = (pkt_len < sizeof(mhr)) ? pkt_len : sizeof(mhr);
+    uint8_t seq;
+    int src_len;
+
+    if (dev->netdev.flags & (AT86RF2XX_OPT_PROMISCUOUS | AT86RF2XX_OPT_RAWDUMP)) {
+        return true;
+    }
+    if (pkt_len < (IEEE802154_FCF_LEN + 1)) {
+        return false;
+    }
+    at86rf2xx_fb_read(dev, mhr, hdr_len);
+    if ((ieee802154_get_frame_hdr_len(mhr) == 0) ||
+        (ieee802154_get_frame_hdr_len(mhr) > hdr_len)) {
+        DEBUG("[at86rf2xx] dropping frame with invalid MAC header\n");
+        return false;
+    }
+    if (ieee802154_dst_filter(mhr, dev->netdev.pan, dev->netdev.short_addr,
+                              dev->netdev.long_addr) != 0) {
+        DEBUG("[at86rf2xx] dropping frame not addressed to us\n");
+        return false;
+    }
+    /* only acknowledged frames are retransmitted by the sender */
+    if (mhr[0] & IEEE802154_FCF_ACK_REQ) {
+        src_len = ieee802154_get_src(mhr, src, &src_pan);
+        seq = ieee802154_get_seq(mhr);
+        if (src_len < 0) {
+            return false;
+        }
+        if ((src_len == dev->rx_last_src_len) && (seq == dev->rx_last_seq) &&
+            (memcmp(src, dev->rx_last_src, src_len) == 0)) {
+            DEBUG("[at86rf2xx] dropping duplicate frame (seq: %u)\n",
+                  (unsigned)seq);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief   Remembers source and sequence number of a received frame to drop
+ *          its retransmissions
+ *
+ * Only called once the frame was read, so the length query of _recv() has
+ * no side effects.
+ */
+static void _rx_track(at86rf2xx_t *dev, const uint8_t *mhr, size_t pkt_len)
+{
+    le_uint16_t src_pan;
+    int src_len;
+    size_t mhr_len;
+
+    if (dev->netdev.flags & (AT86RF2XX_OPT_PROMISCUOUS | AT86RF2XX_OPT_RAWDUMP)) {
+        return;
+    }
+    if ((pkt_len < (IEEE802154_FCF_LEN + 1)) || !(mhr[0] & IEEE802154_FCF_ACK_REQ)) {
+        return;
+    }
+    mhr_len = ieee802154_get_frame_hdr_len(mhr);
+    if ((mhr_len == 0) || (mhr_len > pkt_len)) {
+        return;
+    }
+    src_len = ieee802154_get_src(mhr, dev->rx_last_src, &src_pan);
+    if (src_len < 0) {
+        dev->rx_last_src_len = 0;
+        return;
+    }
+    dev->rx_last_src_len = (uint8_t)src_len;
+    dev->rx_last_seq = ieee802154_get_seq(mhr);
+}
+
 static int _recv(netdev2_t *netdev, void *buf, size_t len, void *info)
 {
     at86rf2xx_t *dev = (at86rf2xx_t *)netdev;
@@ -140,11 +223,21 @@ static int _recv(netdev2_t *netdev, void *buf, size_t len, void *info)
     /* get the size of the received packet */
     at86rf2xx_fb_read(dev, &phr, 1);
 
-    /* ignore MSB (refer p.80) and substract length of FCS field */
-    pkt_len = (phr & 0x7f) - 2;
+    /* ignore MSB (refer p.80) */
+    phr &= 0x7f;
+    if (phr < IEEE802154_FCS_LEN) {
+        at86rf2xx_fb_stop(dev);
+        return 0;
+    }
+    /* substract length of FCS field */
+    pkt_len = phr - IEEE802154_FCS_LEN;
 
-    /* just return length when buf == NULL */
+    /* just return length when buf == NULL, drop the frame already here if
+     * the upper layer would discard it anyway */
     if (buf == NULL) {
+        if ((len == 0) && !_rx_accept(dev, pkt_len)) {
+            pkt_len = 0;
+        }
         at86rf2xx_fb_stop(dev);
         return pkt_len;
     }
@@ -159,6 +252,7 @@ static int _recv(netdev2_t *netdev, void *buf, size_t len, void *info)
     #endif
     /* copy payload */
     at86rf2xx_fb_read(dev, (uint8_t *)buf, pkt_len);
+    _rx_track(dev, buf, pkt_len);
 
     /* Ignore FCS but advance fb read - we must give a temporary buffer here,
      * as we are not allowed to issue SPI transfers without any buffer */
@@ -163,6 +163,13 @@ typedef struct {
     uint8_t pending_tx;                 /**< keep track of pending TX calls
                                              this is required to know when to
                                              return to @ref at86rf2xx_t::idle_state */
+    uint8_t rx_last_seq;                /**< sequence number of the last
+                                             accepted frame */
+    uint8_t rx_last_src_len;            /**< source address length of the
+                                             last accepted frame */
+    uint8_t rx_last_src[IEEE802154_LONG_ADDRESS_LEN]; /**< source address
+                                                           of the last
+                                                           accepted frame */
     /** @} */
 } at86rf2xx_t;
 
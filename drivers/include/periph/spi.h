@@ -13,7 +13,11 @@
  *
  * The current design of this interface targets implementations that use the SPI in blocking mode.
  *
- * TODO: add means for asynchronous SPI usage
+ * Bulk transfers can additionally be started asynchronously with
+ * spi_transfer_async(). CPUs that can move the data with DMA implement it
+ * natively and define `PERIPH_SPI_HAS_TRANSFER_ASYNC` in their
+ * `periph_cpu.h`. All other CPUs get a fallback that transfers the data
+ * with spi_transfer_bytes() and calls the callback before returning.
  *
  * @{
  * @file
@@ -201,6 +205,39 @@ int spi_transfer_byte(spi_t dev, char out, char *in);
  */
 int spi_transfer_bytes(spi_t dev, char *out, char *in, unsigned int length);
 
+/**
+ * @brief   Signature of the callback for asynchronous transfers
+ *
+ * @param[in] arg       context given to spi_transfer_async()
+ * @param[in] res       number of bytes transferred, -1 on error
+ */
+typedef void (*spi_async_cb_t)(void *arg, int res);
+
+/**
+ * @brief Start transferring a number of bytes on the given SPI bus
+ *
+ * The function returns as soon as the transfer was started. The buffers
+ * must stay valid and must not be accessed until @p cb was called. The
+ * callback may be called from interrupt context, or from within this
+ * function if the CPU has no means to transfer the data in the background.
+ *
+ * The bus must have been acquired with spi_acquire() before and must only
+ * be released after @p cb was called. Only one transfer per bus can be in
+ * progress at a time.
+ *
+ * @param[in] dev       SPI device to use
+ * @param[in] out       Array of bytes to send, set NULL if only receiving
+ * @param[out] in       Buffer to receive bytes to, set NULL if only sending
+ * @param[in] length    Number of bytes to transfer
+ * @param[in] cb        Function called when the transfer is done
+ * @param[in] arg       Context passed to @p cb
+ *
+ * @return              0 if the transfer was started
+ * @return              -1 on error, @p cb is not called in this case
+ */
+int spi_transfer_async(spi_t dev, char *out, char *in, unsigned int length,
+                       spi_async_cb_t cb, void *arg);
+
 /**
  * @brief Transfer one byte to/from a given register address
  *
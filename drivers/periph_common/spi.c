@@ -95,4 +95,20 @@ int spi_transfer_regs(spi_t dev, uint8_t reg, char *out, char *in, unsigned int
 }
 #endif
 
+#ifndef PERIPH_SPI_HAS_TRANSFER_ASYNC
+int spi_transfer_async(spi_t dev, char *out, char *in, unsigned int length,
+                       spi_async_cb_t cb, void *arg)
+{
+    int res;
+
+    if (cb == NULL) {
+        return -1;
+    }
+    res = spi_transfer_bytes(dev, out, in, length);
+    cb(arg, res);
+
+    return 0;
+}
+#endif
+
 #endif /* SPI_NUMOF */
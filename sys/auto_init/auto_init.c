@@ -224,6 +224,11 @@ void auto_init(void)
     auto_init_netdev2_tap();
 #endif
 
+#ifdef MODULE_NETDEV2_VMEDIUM
+    extern void auto_init_netdev2_vmedium(void);
+    auto_init_netdev2_vmedium();
+#endif
+
 #ifdef MODULE_NORDIC_SOFTDEVICE_BLE
     extern void gnrc_nordic_ble_6lowpan_init(void);
     gnrc_nordic_ble_6lowpan_init();
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ *
+ */
+
+/**
+ * @ingroup auto_init_ng_netif
+ * @{
+ *
+ * @file
+ * @brief   Auto initialization for the native virtual 802.15.4 medium
+ *
+ * @author  agent <agent@local>
+ */
+
+#ifdef MODULE_NETDEV2_VMEDIUM
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#include "netdev2_vmedium.h"
+#include "net/gnrc/netdev2.h"
+#include "net/gnrc/netdev2/ieee802154.h"
+#ifdef MODULE_GNRC_LWMAC
+#include "net/gnrc/lwmac/lwmac.h"
+#endif
+#ifdef MODULE_GNRC_TSCH
+#include "net/gnrc/tsch/tsch.h"
+#endif
+
+extern netdev2_vmedium_t netdev2_vmedium;
+
+/**
+ * @brief   Define stack parameters for the MAC layer thread
+ * @{
+ */
+#define VMEDIUM_MAC_STACKSIZE       (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
+#ifndef VMEDIUM_MAC_PRIO
+#define VMEDIUM_MAC_PRIO            (GNRC_NETDEV2_MAC_PRIO)
+#endif
+/** @} */
+
+static char _netdev2_vmedium_stack[VMEDIUM_MAC_STACKSIZE];
+static gnrc_netdev2_t _gnrc_netdev2_vmedium;
+
+void auto_init_netdev2_vmedium(void)
+{
+    int res = gnrc_netdev2_ieee802154_init(&_gnrc_netdev2_vmedium,
+                                           (netdev2_ieee802154_t *)&netdev2_vmedium);
+
+    if (res < 0) {
+        DEBUG("Error initializing virtual medium device!\n");
+    }
+    else {
+#if defined(MODULE_GNRC_LWMAC)
+        gnrc_lwmac_init(_netdev2_vmedium_stack, VMEDIUM_MAC_STACKSIZE,
+                        VMEDIUM_MAC_PRIO, "netdev2_vmedium",
+                        &_gnrc_netdev2_vmedium);
+#elif defined(MODULE_GNRC_TSCH)
+        gnrc_tsch_init(_netdev2_vmedium_stack, VMEDIUM_MAC_STACKSIZE,
+                       VMEDIUM_MAC_PRIO, "netdev2_vmedium",
+                       &_gnrc_netdev2_vmedium);
+#else
+        gnrc_netdev2_init(_netdev2_vmedium_stack, VMEDIUM_MAC_STACKSIZE,
+                          VMEDIUM_MAC_PRIO, "netdev2_vmedium",
+                          &_gnrc_netdev2_vmedium);
+#endif
+    }
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_NETDEV2_VMEDIUM */
+/** @} */
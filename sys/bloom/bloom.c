@@ -13,6 +13,8 @@
  *
  */
 
+#include <assert.h>
+#include <errno.h>
 #include <limits.h>
 #include <stdarg.h>
 #include <stdbool.h>
@@ -23,12 +25,80 @@
 
 #define ROUND(size) ((size + CHAR_BIT - 1) / CHAR_BIT)
 
+/**
+ * @brief   Index generator for double hashing
+ *
+ * Yields (h1 + i * h2) mod m for i = 0 .. k - 1 without multiplication.
+ * The step is kept within [1, m - 1] and odd for even m, so for the common
+ * case of m being a power of 2 the k indexes are pairwise distinct as long
+ * as k <= m.
+ */
+typedef struct {
+    size_t idx;
+    size_t step;
+    size_t m;
+} _dh_t;
+
+static inline void _dh_init(_dh_t *dh, uint32_t h1, uint32_t h2, size_t m)
+{
+    dh->m = m;
+    dh->idx = h1 % m;
+    dh->step = 1 + (h2 % (m - 1));
+    if (!(m & 1)) {
+        dh->step |= 1;
+    }
+}
+
+static inline size_t _dh_next(_dh_t *dh)
+{
+    size_t idx = dh->idx;
+
+    dh->idx += dh->step;
+    if (dh->idx >= dh->m) {
+        dh->idx -= dh->m;
+    }
+    return idx;
+}
+
+static void _dh_add(bloom_t *bloom, uint32_t h1, uint32_t h2)
+{
+    _dh_t dh;
+
+    _dh_init(&dh, h1, h2, bloom->m);
+    for (size_t n = 0; n < bloom->k; n++) {
+        bf_set(bloom->a, _dh_next(&dh));
+    }
+}
+
+static bool _dh_check(bloom_t *bloom, uint32_t h1, uint32_t h2)
+{
+    _dh_t dh;
+
+    _dh_init(&dh, h1, h2, bloom->m);
+    for (size_t n = 0; n < bloom->k; n++) {
+        if (!bf_isset(bloom->a, _dh_next(&dh))) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void bloom_init(bloom_t *bloom, size_t size, uint8_t *bitfield, hashfp_t *hashes, int hashes_numof)
 {
     bloom->m = size;
     bloom->a = bitfield;
     bloom->hash = hashes;
     bloom->k = hashes_numof;
+    bloom->double_hashing = false;
+}
+
+void bloom_init_double(bloom_t *bloom, size_t size, uint8_t *bitfield,
+                       hashfp_t *hashes, int k)
+{
+    /* _dh_init() takes the step modulo size - 1 */
+    assert(size >= 2);
+    bloom_init(bloom, size, bitfield, hashes, k);
+    bloom->double_hashing = true;
 }
 
 void bloom_del(bloom_t *bloom)
@@ -40,10 +110,15 @@ void bloom_del(bloom_t *bloom)
     bloom->m = 0;
     bloom->hash = NULL;
     bloom->k = 0;
+    bloom->double_hashing = false;
 }
 
 void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len)
 {
+    if (bloom->double_hashing) {
+        _dh_add(bloom, bloom->hash[0](buf, len), bloom->hash[1](buf, len));
+        return;
+    }
     for (size_t n = 0; n < bloom->k; n++) {
         uint32_t hash = bloom->hash[n](buf, len);
         bf_set(bloom->a, (hash % bloom->m));
@@ -52,6 +127,10 @@ void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len)
 
 bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len)
 {
+    if (bloom->double_hashing) {
+        return _dh_check(bloom, bloom->hash[0](buf, len),
+                         bloom->hash[1](buf, len));
+    }
     for (size_t n = 0; n < bloom->k; n++) {
         uint32_t hash = bloom->hash[n](buf, len);
 
@@ -62,3 +141,156 @@ bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len)
 
     return true; /* ? */
 }
+
+static inline unsigned _counter_get(const uint8_t *c, size_t idx)
+{
+    return (c[idx / 2] >> ((idx & 1) * 4)) & 0xf;
+}
+
+static inline void _counter_set(uint8_t *c, size_t idx, unsigned val)
+{
+    unsigned shift = (idx & 1) * 4;
+
+    c[idx / 2] = (c[idx / 2] & ~(0xf << shift)) | (val << shift);
+}
+
+void bloom_counting_init(bloom_counting_t *bloom, size_t size,
+                         uint8_t *counters, hashfp_t *hashes, int k)
+{
+    assert(size >= 2);
+    bloom->m = size;
+    bloom->k = k;
+    bloom->c = counters;
+    bloom->hash = hashes;
+    memset(counters, 0, BLOOM_COUNTING_BYTES(size));
+}
+
+void bloom_counting_add(bloom_counting_t *bloom, const uint8_t *buf,
+                        size_t len)
+{
+    _dh_t dh;
+
+    _dh_init(&dh, bloom->hash[0](buf, len), bloom->hash[1](buf, len),
+             bloom->m);
+    for (size_t n = 0; n < bloom->k; n++) {
+        size_t idx = _dh_next(&dh);
+        unsigned val = _counter_get(bloom->c, idx);
+
+        if (val < BLOOM_COUNTING_MAX) {
+            _counter_set(bloom->c, idx, val + 1);
+        }
+    }
+}
+
+int bloom_counting_remove(bloom_counting_t *bloom, const uint8_t *buf,
+                          size_t len)
+{
+    uint32_t h1 = bloom->hash[0](buf, len);
+    uint32_t h2 = bloom->hash[1](buf, len);
+    _dh_t dh;
+
+    /* check first, so a missing string does not corrupt the counters */
+    _dh_init(&dh, h1, h2, bloom->m);
+    for (size_t n = 0; n < bloom->k; n++) {
+        if (!_counter_get(bloom->c, _dh_next(&dh))) {
+            return -ENOENT;
+        }
+    }
+
+    _dh_init(&dh, h1, h2, bloom->m);
+    for (size_t n = 0; n < bloom->k; n++) {
+        size_t idx = _dh_next(&dh);
+        unsigned val = _counter_get(bloom->c, idx);
+
+        if (val < BLOOM_COUNTING_MAX) {
+            _counter_set(bloom->c, idx, val - 1);
+        }
+    }
+    return 0;
+}
+
+bool bloom_counting_check(bloom_counting_t *bloom, const uint8_t *buf,
+                          size_t len)
+{
+    _dh_t dh;
+
+    _dh_init(&dh, bloom->hash[0](buf, len), bloom->hash[1](buf, len),
+             bloom->m);
+    for (size_t n = 0; n < bloom->k; n++) {
+        if (!_counter_get(bloom->c, _dh_next(&dh))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* elements a filter of m bits with k indexes holds at a fill ratio of 1/2,
+ * i.e. m * ln(2) / k */
+static size_t _scalable_capacity(const bloom_t *bloom)
+{
+    return (bloom->m * 693U) / (1000U * bloom->k);
+}
+
+static int _scalable_grow(bloom_scalable_t *bloom, size_t size, size_t k)
+{
+    size_t bytes = ROUND(size);
+
+    if ((bloom->numof >= BLOOM_SCALABLE_SLICES_MAX) ||
+        (bytes > (bloom->buf_size - bloom->buf_used))) {
+        return -ENOMEM;
+    }
+
+    bloom_t *slice = &bloom->slices[bloom->numof++];
+    bloom_init_double(slice, size, bloom->buf + bloom->buf_used,
+                      bloom->slices[0].hash, k);
+    bloom->buf_used += bytes;
+    bloom->n = 0;
+    bloom->capacity = _scalable_capacity(slice);
+    return 0;
+}
+
+int bloom_scalable_init(bloom_scalable_t *bloom, uint8_t *buf, size_t buf_size,
+                        size_t size, hashfp_t *hashes, int k)
+{
+    assert(size >= 8);
+    memset(buf, 0, buf_size);
+    bloom->buf = buf;
+    bloom->buf_size = buf_size;
+    bloom->buf_used = 0;
+    bloom->numof = 0;
+    /* _scalable_grow() takes the hash functions from the first slice */
+    bloom->slices[0].hash = hashes;
+    return _scalable_grow(bloom, size, k);
+}
+
+int bloom_scalable_add(bloom_scalable_t *bloom, const uint8_t *buf,
+                       size_t len)
+{
+    bloom_t *last = &bloom->slices[bloom->numof - 1];
+    int res = 0;
+
+    if (bloom->n >= bloom->capacity) {
+        /* twice the bits and one more index halve the false positive rate
+         * of the new filter at the same fill ratio */
+        res = _scalable_grow(bloom, last->m * 2, last->k + 1);
+        last = &bloom->slices[bloom->numof - 1];
+    }
+    bloom_add(last, buf, len);
+    bloom->n++;
+    return res;
+}
+
+bool bloom_scalable_check(bloom_scalable_t *bloom, const uint8_t *buf,
+                          size_t len)
+{
+    /* all filters share the hash functions, so hash only once */
+    uint32_t h1 = bloom->slices[0].hash[0](buf, len);
+    uint32_t h2 = bloom->slices[0].hash[1](buf, len);
+
+    for (unsigned i = 0; i < bloom->numof; i++) {
+        if (_dh_check(&bloom->slices[i], h1, h2)) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -17,6 +17,7 @@
 
 #include "byteorder.h"
 
+#include <errno.h>
 #include <inttypes.h>
 #include <math.h>
 #include <stdint.h>
@@ -786,6 +787,371 @@ bool cbor_at_end(const cbor_stream_t *s, size_t offset)
     return s ? offset >= s->pos - 1 : true;
 }
 
+/* BEGIN: Pull parser */
+/**
+ * Parse the item at @p p, including all contained items
+ *
+ * @return 0 on success, -EBADMSG on malformed input
+ */
+static int iter_parse(const unsigned char *p, const unsigned char *end,
+                      cbor_item_t *item, unsigned depth)
+{
+    if (p >= end) {
+        return -EBADMSG;
+    }
+
+    unsigned char major_type = *p & CBOR_TYPE_MASK;
+    unsigned char additional_info = *p & CBOR_INFO_MASK;
+    uint64_t val = additional_info;
+    const unsigned char *arg = ++p;
+
+    if (additional_info >= CBOR_UINT8_FOLLOWS &&
+        additional_info <= CBOR_UINT64_FOLLOWS) {
+        unsigned char bytes_follow = uint_bytes_follow(additional_info);
+
+        if ((size_t)(end - p) < bytes_follow) {
+            return -EBADMSG;
+        }
+        val = 0;
+        for (unsigned i = 0; i < bytes_follow; i++) {
+            val = (val << 8) | *p++;
+        }
+    }
+    else if (additional_info == CBOR_VAR_FOLLOWS) {
+        /* a break is only valid where cbor_iter_next() expects it */
+        if (major_type == CBOR_UINT || major_type == CBOR_NEGINT ||
+            major_type == CBOR_TAG || major_type == CBOR_7) {
+            return -EBADMSG;
+        }
+        val = CBOR_ITER_INDEFINITE;
+    }
+    else if (additional_info > CBOR_UINT64_FOLLOWS) {
+        return -EBADMSG;
+    }
+
+    item->type = (cbor_item_type_t)(major_type >> 5);
+    item->val = val;
+    item->data = p;
+
+    switch (major_type) {
+        case CBOR_BYTES:
+        case CBOR_TEXT:
+            if (val != CBOR_ITER_INDEFINITE) {
+                if ((uint64_t)(end - p) < val) {
+                    return -EBADMSG;
+                }
+                p += val;
+                break;
+            }
+            /* chunks must be definite-length strings of the same type */
+            while (p < end && *p != CBOR_BREAK) {
+                cbor_item_t chunk;
+
+                if ((*p & CBOR_TYPE_MASK) != major_type ||
+                    iter_parse(p, end, &chunk, depth) < 0 ||
+                    chunk.val == CBOR_ITER_INDEFINITE) {
+                    return -EBADMSG;
+                }
+                p = chunk.end;
+            }
+            if (p++ >= end) {
+                return -EBADMSG;
+            }
+            break;
+
+        case CBOR_ARRAY:
+        case CBOR_MAP:
+        case CBOR_TAG:
+            if (depth >= CBOR_ITER_NESTING_MAX) {
+                return -EBADMSG;
+            }
+            if (major_type == CBOR_TAG) {
+                val = 1;
+            }
+            for (uint64_t i = 0; i < val; i++) {
+                cbor_item_t sub;
+
+                if (val == CBOR_ITER_INDEFINITE && p < end && *p == CBOR_BREAK) {
+                    p++;
+                    break;
+                }
+                for (unsigned j = 0; j < ((major_type == CBOR_MAP) ? 2 : 1); j++) {
+                    if (iter_parse(p, end, &sub, depth + 1) < 0) {
+                        return -EBADMSG;
+                    }
+                    p = sub.end;
+                }
+            }
+            break;
+
+        case CBOR_7:
+            if (additional_info >= CBOR_UINT16_FOLLOWS) {
+                /* point at the encoded bits to tell the precision */
+                item->type = CBOR_ITEM_FLOAT;
+                item->data = arg;
+            }
+            else {
+                item->type = CBOR_ITEM_SIMPLE;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    item->end = p;
+    return 0;
+}
+
+void cbor_iter_init(cbor_iter_t *it, const unsigned char *buf, size_t len)
+{
+    it->pos = buf;
+    it->end = buf + len;
+    it->remaining = CBOR_ITER_INDEFINITE;
+}
+
+int cbor_iter_next(cbor_iter_t *it, cbor_item_t *item)
+{
+    if (it->remaining == 0 || it->pos >= it->end) {
+        return 0;
+    }
+
+    if (iter_parse(it->pos, it->end, item, 0) < 0) {
+        return -EBADMSG;
+    }
+
+    it->pos = item->end;
+    if (it->remaining != CBOR_ITER_INDEFINITE) {
+        it->remaining--;
+    }
+    return 1;
+}
+
+int cbor_iter_enter(const cbor_item_t *item, cbor_iter_t *child)
+{
+    switch (item->type) {
+        case CBOR_ITEM_BYTES:
+        case CBOR_ITEM_TEXT:
+            if (item->val != CBOR_ITER_INDEFINITE) {
+                return -EINVAL;
+            }
+            /* fall through */
+        case CBOR_ITEM_ARRAY:
+        case CBOR_ITEM_MAP:
+            child->remaining = item->val;
+            if (item->val == CBOR_ITER_INDEFINITE) {
+                /* stop in front of the break */
+                child->pos = item->data;
+                child->end = item->end - 1;
+                return 0;
+            }
+            if (item->type == CBOR_ITEM_MAP) {
+                child->remaining *= 2;
+            }
+            break;
+
+        case CBOR_ITEM_TAG:
+            child->remaining = 1;
+            break;
+
+        default:
+            return -EINVAL;
+    }
+
+    child->pos = item->data;
+    child->end = item->end;
+    return 0;
+}
+
+int cbor_item_get_int(const cbor_item_t *item, int64_t *val)
+{
+    if (item->type != CBOR_ITEM_UINT && item->type != CBOR_ITEM_NEGINT) {
+        return -EINVAL;
+    }
+    if (item->val > INT64_MAX) {
+        return -ERANGE;
+    }
+
+    *val = (item->type == CBOR_ITEM_UINT) ? (int64_t)item->val
+                                           : -1 - (int64_t)item->val;
+    return 0;
+}
+
+#ifndef CBOR_NO_FLOAT
+int cbor_item_get_double(const cbor_item_t *item, double *val)
+{
+    if (item->type != CBOR_ITEM_FLOAT) {
+        return -EINVAL;
+    }
+
+    switch (item->end - item->data) {
+        case 2: {
+            unsigned char half[2] = { item->val >> 8, item->val & 0xff };
+            *val = decode_float_half(half);
+            break;
+        }
+        case 4:
+            *val = ntohf(HTONL((uint32_t)item->val));
+            break;
+
+        default:
+            *val = ntohd(HTONLL(item->val));
+            break;
+    }
+    return 0;
+}
+#endif /* CBOR_NO_FLOAT */
+/* END: Pull parser */
+
+/* BEGIN: Chained buffer encoder */
+void cbor_writer_init(cbor_writer_t *w, unsigned char *buf, size_t size,
+                      cbor_writer_next_t next, void *arg)
+{
+    w->data = buf;
+    w->size = size;
+    w->pos = 0;
+    w->len = 0;
+    w->next = next;
+    w->arg = arg;
+    w->res = 0;
+}
+
+ssize_t cbor_writer_finish(const cbor_writer_t *w)
+{
+    return (w->res < 0) ? w->res : (ssize_t)(w->len + w->pos);
+}
+
+static int writer_put(cbor_writer_t *w, const void *data, size_t len)
+{
+    const unsigned char *src = data;
+
+    if (w->res < 0) {
+        return w->res;
+    }
+
+    while (len) {
+        if (w->pos == w->size) {
+            size_t size = 0;
+            unsigned char *buf = w->next ? w->next(w->arg, w->pos, &size) : NULL;
+
+            if (!buf) {
+                w->res = -ENOBUFS;
+                return w->res;
+            }
+            w->len += w->pos;
+            w->data = buf;
+            w->size = size;
+            w->pos = 0;
+            continue;
+        }
+
+        size_t chunk = w->size - w->pos;
+        if (chunk > len) {
+            chunk = len;
+        }
+        memcpy(&w->data[w->pos], src, chunk);
+        w->pos += chunk;
+        src += chunk;
+        len -= chunk;
+    }
+    return 0;
+}
+
+static int writer_head(cbor_writer_t *w, unsigned char major_type, uint64_t val)
+{
+    unsigned char head[9];
+    unsigned char additional_info = uint_additional_info(val);
+    unsigned char bytes_follow = uint_bytes_follow(additional_info);
+
+    head[0] = major_type | additional_info;
+    for (int i = bytes_follow; i > 0; --i) {
+        head[i] = val & 0xff;
+        val >>= 8;
+    }
+    return writer_put(w, head, bytes_follow + 1);
+}
+
+int cbor_writer_uint(cbor_writer_t *w, uint64_t val)
+{
+    return writer_head(w, CBOR_UINT, val);
+}
+
+int cbor_writer_int(cbor_writer_t *w, int64_t val)
+{
+    if (val >= 0) {
+        return writer_head(w, CBOR_UINT, val);
+    }
+    return writer_head(w, CBOR_NEGINT, -1 - val);
+}
+
+int cbor_writer_bytes(cbor_writer_t *w, const void *val, size_t len)
+{
+    writer_head(w, CBOR_BYTES, len);
+    return writer_put(w, val, len);
+}
+
+int cbor_writer_text(cbor_writer_t *w, const char *val, size_t len)
+{
+    writer_head(w, CBOR_TEXT, len);
+    return writer_put(w, val, len);
+}
+
+int cbor_writer_array(cbor_writer_t *w, size_t len)
+{
+    return writer_head(w, CBOR_ARRAY, len);
+}
+
+int cbor_writer_map(cbor_writer_t *w, size_t len)
+{
+    return writer_head(w, CBOR_MAP, len);
+}
+
+static int writer_byte(cbor_writer_t *w, unsigned char byte)
+{
+    return writer_put(w, &byte, 1);
+}
+
+int cbor_writer_array_indefinite(cbor_writer_t *w)
+{
+    return writer_byte(w, CBOR_ARRAY | CBOR_VAR_FOLLOWS);
+}
+
+int cbor_writer_map_indefinite(cbor_writer_t *w)
+{
+    return writer_byte(w, CBOR_MAP | CBOR_VAR_FOLLOWS);
+}
+
+int cbor_writer_break(cbor_writer_t *w)
+{
+    return writer_byte(w, CBOR_BREAK);
+}
+
+int cbor_writer_tag(cbor_writer_t *w, uint64_t tag)
+{
+    return writer_head(w, CBOR_TAG, tag);
+}
+
+int cbor_writer_bool(cbor_writer_t *w, bool val)
+{
+    return writer_byte(w, val ? CBOR_TRUE : CBOR_FALSE);
+}
+
+int cbor_writer_null(cbor_writer_t *w)
+{
+    return writer_byte(w, CBOR_NULL);
+}
+
+#ifndef CBOR_NO_FLOAT
+int cbor_writer_float(cbor_writer_t *w, float val)
+{
+    uint32_t encoded = htonf(val);
+
+    writer_byte(w, CBOR_FLOAT32);
+    return writer_put(w, &encoded, sizeof(encoded));
+}
+#endif /* CBOR_NO_FLOAT */
+/* END: Chained buffer encoder */
+
 #ifndef CBOR_NO_PRINT
 /* BEGIN: Printers */
 void cbor_stream_print(const cbor_stream_t *stream)
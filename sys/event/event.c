@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2016 Kaspar Schleiser <kaspar@schleiser.de>
+ *               2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_event
+ * @{
+ *
+ * @file
+ * @brief       Event queue implementation
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <assert.h>
+
+#include "event.h"
+#include "irq.h"
+#include "thread_flags.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+void event_queue_init(event_queue_t *queue)
+{
+    assert(queue);
+    queue->event_list.next = NULL;
+    queue->waiter = (thread_t *)sched_active_thread;
+}
+
+void event_post(event_queue_t *queue, event_t *event)
+{
+    assert(queue && queue->waiter && event);
+
+    unsigned state = irq_disable();
+    if (!event->list_node.next) {
+        clist_rpush(&queue->event_list, &event->list_node);
+    }
+    irq_restore(state);
+
+    thread_flags_set(queue->waiter, THREAD_FLAG_EVENT);
+}
+
+void event_cancel(event_queue_t *queue, event_t *event)
+{
+    assert(queue && event);
+
+    unsigned state = irq_disable();
+    clist_remove(&queue->event_list, &event->list_node);
+    event->list_node.next = NULL;
+    irq_restore(state);
+}
+
+event_t *event_get(event_queue_t *queue)
+{
+    unsigned state = irq_disable();
+    event_t *result = (event_t *)clist_lpop(&queue->event_list);
+    if (result) {
+        /* mark as not queued, so it can be posted again from now on */
+        result->list_node.next = NULL;
+    }
+    irq_restore(state);
+
+    return result;
+}
+
+event_t *event_wait(event_queue_t *queue)
+{
+    event_t *result;
+
+    assert(queue->waiter == sched_active_thread);
+
+    while (!(result = event_get(queue))) {
+        thread_flags_wait_any(THREAD_FLAG_EVENT);
+    }
+
+    DEBUG("event: handling %p\n", (void *)result);
+    return result;
+}
+
+void event_loop(event_queue_t *queue)
+{
+    while (1) {
+        event_t *event = event_wait(queue);
+        event->handler(event);
+    }
+}
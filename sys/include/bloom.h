@@ -148,8 +148,63 @@ typedef struct {
     uint8_t *a;
     /** the hash functions */
     hashfp_t *hash;
+    /** derive all indexes from hash[0] and hash[1] (double hashing) */
+    bool double_hashing;
 } bloom_t;
 
+/**
+ * @brief Number of counters of a counting Bloom filter
+ *
+ * Counters are 4 bits wide, two counters share a byte.
+ */
+#define BLOOM_COUNTING_BYTES(size)  (((size) + 1) / 2)
+
+/**
+ * @brief Value at which a counter of a counting Bloom filter sticks
+ */
+#define BLOOM_COUNTING_MAX          (15U)
+
+/**
+ * @brief bloom_counting_t counting Bloom filter object
+ */
+typedef struct {
+    /** number of counters */
+    size_t m;
+    /** number of indexes per element */
+    size_t k;
+    /** the counter array, see @ref BLOOM_COUNTING_BYTES */
+    uint8_t *c;
+    /** the two hash functions used for double hashing */
+    hashfp_t *hash;
+} bloom_counting_t;
+
+/**
+ * @brief Maximum number of filters a scalable Bloom filter grows to
+ */
+#ifndef BLOOM_SCALABLE_SLICES_MAX
+#define BLOOM_SCALABLE_SLICES_MAX   (4)
+#endif
+
+/**
+ * @brief bloom_scalable_t scalable Bloom filter object
+ */
+typedef struct {
+    /** the filters, the last one is the one being filled */
+    bloom_t slices[BLOOM_SCALABLE_SLICES_MAX];
+    /** number of filters in use */
+    unsigned numof;
+    /** number of elements in the last filter */
+    size_t n;
+    /** number of elements the last filter takes before a new one is added */
+    size_t capacity;
+    /** memory backing the bitfields of all filters */
+    uint8_t *buf;
+    /** size of @p buf in bytes */
+    size_t buf_size;
+    /** bytes of @p buf used by the filters */
+    size_t buf_used;
+} bloom_scalable_t;
+
 /**
  * @brief Initialize a Bloom Filter.
  *
@@ -165,6 +220,26 @@ typedef struct {
  */
 void bloom_init(bloom_t *bloom, size_t size, uint8_t *bitfield, hashfp_t *hashes, int hashes_numof);
 
+/**
+ * @brief Initialize a Bloom Filter using double hashing.
+ *
+ * Instead of calling one hash function per index, the @p k indexes of an
+ * element are derived from two hashes h1 and h2 of the element as
+ * h1 + i * h2 (Kirsch and Mitzenmacher, "Less Hashing, Same Performance").
+ * Adding or checking an element thus always costs two passes over it,
+ * independent of @p k.
+ *
+ * @param bloom             bloom_t to initialize
+ * @param size              size of the bloom filter in bits, at least 2
+ * @param bitfield          underlying bitfield of the bloom filter
+ * @param hashes            array of two hash functions
+ * @param k                 number of indexes per element
+ *
+ * @pre     @p bitfield MUST be large enough to hold @p size bits.
+ */
+void bloom_init_double(bloom_t *bloom, size_t size, uint8_t *bitfield,
+                       hashfp_t *hashes, int k);
+
 /**
  * @brief Delete a Bloom filter.
  *
@@ -228,6 +303,115 @@ void bloom_add(bloom_t *bloom, const uint8_t *buf, size_t len);
  */
 bool bloom_check(bloom_t *bloom, const uint8_t *buf, size_t len);
 
+/**
+ * @brief Initialize a counting Bloom filter.
+ *
+ * A counting Bloom filter keeps a 4-bit counter instead of a bit per index,
+ * so elements can be removed again. Indexes are computed by double hashing
+ * (see bloom_init_double()). A counter that reached
+ * @ref BLOOM_COUNTING_MAX is never decremented again.
+ *
+ * @param bloom             bloom_counting_t to initialize
+ * @param size              number of counters, at least 2
+ * @param counters          counter array of @ref BLOOM_COUNTING_BYTES(size)
+ *                          bytes, will be cleared
+ * @param hashes            array of two hash functions
+ * @param k                 number of indexes per element
+ */
+void bloom_counting_init(bloom_counting_t *bloom, size_t size,
+                         uint8_t *counters, hashfp_t *hashes, int k);
+
+/**
+ * @brief Add a string to a counting Bloom filter.
+ *
+ * @param bloom  counting Bloom filter
+ * @param buf    string to add
+ * @param len    the length of the string @p buf
+ */
+void bloom_counting_add(bloom_counting_t *bloom, const uint8_t *buf,
+                        size_t len);
+
+/**
+ * @brief Remove a string from a counting Bloom filter.
+ *
+ * Only strings that were added before may be removed, removing any other
+ * string that happens to be a false positive corrupts the filter.
+ *
+ * @param bloom  counting Bloom filter
+ * @param buf    string to remove
+ * @param len    the length of the string @p buf
+ *
+ * @return       0 on success
+ * @return       -ENOENT if the string is not in the filter, the filter is
+ *               left unchanged
+ */
+int bloom_counting_remove(bloom_counting_t *bloom, const uint8_t *buf,
+                          size_t len);
+
+/**
+ * @brief Determine if a string is in a counting Bloom filter.
+ *
+ * @param bloom  counting Bloom filter
+ * @param buf    string to check
+ * @param len    the length of the string @p buf
+ *
+ * @return       false if string does not exist in the filter
+ * @return       true if string is may be in the filter
+ */
+bool bloom_counting_check(bloom_counting_t *bloom, const uint8_t *buf,
+                          size_t len);
+
+/**
+ * @brief Initialize a scalable Bloom filter.
+ *
+ * A scalable Bloom filter (Almeida et al., "Scalable Bloom Filters") starts
+ * with a single filter of @p size bits and @p k indexes per element. Once it
+ * holds as many elements as it can at a fill ratio of one half, a new filter
+ * with twice the bits and one more index is added. The false positive rate
+ * of the whole filter thus stays bounded while the number of elements is not
+ * known in advance. All filters are carved out of @p buf, no memory is
+ * allocated.
+ *
+ * @param bloom             bloom_scalable_t to initialize
+ * @param buf               memory for the bitfields, will be cleared
+ * @param buf_size          size of @p buf in bytes
+ * @param size              size of the first filter in bits, at least 8
+ * @param hashes            array of two hash functions
+ * @param k                 number of indexes per element of the first filter
+ *
+ * @return       0 on success
+ * @return       -ENOMEM if @p buf cannot hold the first filter
+ */
+int bloom_scalable_init(bloom_scalable_t *bloom, uint8_t *buf, size_t buf_size,
+                        size_t size, hashfp_t *hashes, int k);
+
+/**
+ * @brief Add a string to a scalable Bloom filter.
+ *
+ * @param bloom  scalable Bloom filter
+ * @param buf    string to add
+ * @param len    the length of the string @p buf
+ *
+ * @return       0 on success
+ * @return       -ENOMEM if the filter needed to grow but could not, the
+ *               string was added nonetheless at a higher false positive rate
+ */
+int bloom_scalable_add(bloom_scalable_t *bloom, const uint8_t *buf,
+                       size_t len);
+
+/**
+ * @brief Determine if a string is in a scalable Bloom filter.
+ *
+ * @param bloom  scalable Bloom filter
+ * @param buf    string to check
+ * @param len    the length of the string @p buf
+ *
+ * @return       false if string does not exist in the filter
+ * @return       true if string is may be in the filter
+ */
+bool bloom_scalable_check(bloom_scalable_t *bloom, const uint8_t *buf,
+                          size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,8 @@
  *   throughout the implementation
  * - User may allocate static buffers, this implementation uses the space
  *   provided by them (cf. @ref cbor_stream_t)
+ * - Data can be decoded in place with the pull parser (cf. @ref cbor_iter_t)
+ *   and encoded into a chain of buffers (cf. @ref cbor_writer_t)
  *
  * @par Supported types (categorized by major type (MT)):
  *
@@ -104,6 +106,7 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <sys/types.h>
 
 #ifndef CBOR_NO_CTIME
 #include <time.h>
@@ -637,6 +640,389 @@ bool cbor_at_break(const cbor_stream_t *stream, size_t offset);
  */
 bool cbor_at_end(const cbor_stream_t *stream, size_t offset);
 
+/**
+ * @name Zero-copy pull parser
+ *
+ * The pull parser walks over CBOR encoded data in place. Strings are
+ * returned as pointer and length into the source buffer, nested containers
+ * as items that can be entered with cbor_iter_enter(). Every read is bounds
+ * checked, so the parser can be used on untrusted input.
+ *
+ * Basic usage:
+ * @code
+ * cbor_iter_t it;
+ * cbor_item_t item;
+ * cbor_iter_init(&it, buf, len);
+ * while (cbor_iter_next(&it, &item) > 0) {
+ *     if (item.type == CBOR_ITEM_TEXT) {
+ *         printf("%.*s\n", (int)item.val, (const char *)item.data);
+ *     }
+ * }
+ * @endcode
+ * @{
+ */
+
+/**
+ * @brief Value of cbor_item_t::val for indefinite-length items
+ */
+#define CBOR_ITER_INDEFINITE    (UINT64_MAX)
+
+/**
+ * @brief Maximum nesting depth of containers within a single item
+ */
+#ifndef CBOR_ITER_NESTING_MAX
+#define CBOR_ITER_NESTING_MAX   (8)
+#endif
+
+/**
+ * @brief Type of a CBOR data item
+ */
+typedef enum {
+    CBOR_ITEM_UINT,             /**< unsigned integer (major type 0) */
+    CBOR_ITEM_NEGINT,           /**< negative integer (major type 1) */
+    CBOR_ITEM_BYTES,            /**< byte string (major type 2) */
+    CBOR_ITEM_TEXT,             /**< text string (major type 3) */
+    CBOR_ITEM_ARRAY,            /**< array (major type 4) */
+    CBOR_ITEM_MAP,              /**< map (major type 5) */
+    CBOR_ITEM_TAG,              /**< tagged item (major type 6) */
+    CBOR_ITEM_SIMPLE,           /**< simple value (major type 7) */
+    CBOR_ITEM_FLOAT,            /**< floating-point number (major type 7) */
+} cbor_item_type_t;
+
+/**
+ * @brief A decoded CBOR data item, referencing the source buffer
+ */
+typedef struct {
+    /** Type of the item */
+    cbor_item_type_t type;
+    /**
+     * Argument of the item, depending on cbor_item_t::type:
+     * - CBOR_ITEM_UINT: the value
+     * - CBOR_ITEM_NEGINT: the value is -1 - val
+     * - CBOR_ITEM_BYTES, CBOR_ITEM_TEXT: length in bytes
+     * - CBOR_ITEM_ARRAY: number of items
+     * - CBOR_ITEM_MAP: number of key-value pairs
+     * - CBOR_ITEM_TAG: the tag
+     * - CBOR_ITEM_SIMPLE: the simple value (20 false, 21 true, 22 null)
+     * - CBOR_ITEM_FLOAT: the raw half, single or double precision bits
+     *
+     * @ref CBOR_ITER_INDEFINITE for indefinite-length strings and containers
+     */
+    uint64_t val;
+    /**
+     * Content: string bytes, first contained item, tagged item or the encoded
+     * bits of a floating-point number
+     */
+    const unsigned char *data;
+    /** First byte after the item, including all contained items */
+    const unsigned char *end;
+} cbor_item_t;
+
+/**
+ * @brief Iterator over a sequence of CBOR data items
+ */
+typedef struct {
+    /** Next item */
+    const unsigned char *pos;
+    /** End of the sequence */
+    const unsigned char *end;
+    /** Items left, @ref CBOR_ITER_INDEFINITE to iterate until cbor_iter_t::end */
+    uint64_t remaining;
+} cbor_iter_t;
+
+/**
+ * @brief Initialize an iterator over the top-level items in @p buf
+ *
+ * @param[out] it     The iterator to initialize
+ * @param[in]  buf    CBOR encoded data, must stay valid while iterating
+ * @param[in]  len    Length of @p buf in bytes
+ */
+void cbor_iter_init(cbor_iter_t *it, const unsigned char *buf, size_t len);
+
+/**
+ * @brief Decode the next item of an iterator
+ *
+ * Nested containers are validated and skipped as a whole, use
+ * cbor_iter_enter() on the returned item to iterate over their contents.
+ *
+ * @param[in, out] it     The iterator
+ * @param[out]     item   The decoded item
+ *
+ * @return 1 if an item was decoded
+ * @return 0 if there are no more items
+ * @return -EBADMSG if the data is malformed, truncated or nested deeper than
+ *         @ref CBOR_ITER_NESTING_MAX
+ */
+int cbor_iter_next(cbor_iter_t *it, cbor_item_t *item);
+
+/**
+ * @brief Initialize an iterator over the contents of @p item
+ *
+ * Maps yield keys and values alternately, tags yield the tagged item and
+ * indefinite-length strings yield their chunks.
+ *
+ * @param[in]  item   An array, map, tag or indefinite-length string
+ * @param[out] child  The iterator to initialize
+ *
+ * @return 0 on success
+ * @return -EINVAL if @p item has no contents to iterate over
+ */
+int cbor_iter_enter(const cbor_item_t *item, cbor_iter_t *child);
+
+/**
+ * @brief Get the value of an integer item
+ *
+ * @param[in]  item   The item
+ * @param[out] val    The value
+ *
+ * @return 0 on success
+ * @return -EINVAL if @p item is not an integer
+ * @return -ERANGE if the value does not fit into int64_t
+ */
+int cbor_item_get_int(const cbor_item_t *item, int64_t *val);
+
+#ifndef CBOR_NO_FLOAT
+/**
+ * @brief Get the value of a floating-point item
+ *
+ * @param[in]  item   The item
+ * @param[out] val    The value
+ *
+ * @return 0 on success
+ * @return -EINVAL if @p item is not a floating-point number
+ */
+int cbor_item_get_double(const cbor_item_t *item, double *val);
+#endif /* CBOR_NO_FLOAT */
+/** @} */
+
+/**
+ * @name Chained buffer encoder
+ *
+ * The writer encodes CBOR data items directly into their destination, which
+ * may consist of several buffers, e.g. a chain of packet buffer snips. Once
+ * a buffer is full, the writer asks a callback for the next one and
+ * continues there; items may span buffers.
+ *
+ * Errors are sticky: after a write failed, all further writes are ignored
+ * and cbor_writer_finish() reports the error.
+ *
+ * Basic usage:
+ * @code
+ * cbor_writer_t w;
+ * cbor_writer_init(&w, pdu->payload, pdu->payload_len, NULL, NULL);
+ * cbor_writer_map(&w, 1);
+ * cbor_writer_text(&w, "t", 1);
+ * cbor_writer_int(&w, temperature);
+ * ssize_t len = cbor_writer_finish(&w);
+ * @endcode
+ * @{
+ */
+
+/**
+ * @brief Callback providing the next buffer of a writer
+ *
+ * @param[in]  arg    Argument given to cbor_writer_init()
+ * @param[in]  used   Number of bytes written to the buffer that is full now
+ * @param[out] size   Size of the returned buffer
+ *
+ * @return the next buffer
+ * @return NULL, if there is no more space
+ */
+typedef unsigned char *(*cbor_writer_next_t)(void *arg, size_t used,
+                                            size_t *size);
+
+/**
+ * @brief Writer state
+ */
+typedef struct {
+    /** Current buffer */
+    unsigned char *data;
+    /** Size of the current buffer */
+    size_t size;
+    /** Bytes used in the current buffer */
+    size_t pos;
+    /** Bytes written to previous buffers */
+    size_t len;
+    /** Callback for the next buffer, may be NULL */
+    cbor_writer_next_t next;
+    /** Argument to cbor_writer_t::next */
+    void *arg;
+    /** 0 or the first error */
+    int res;
+} cbor_writer_t;
+
+/**
+ * @brief Initialize a writer
+ *
+ * @param[out] w      The writer to initialize
+ * @param[in]  buf    First buffer to write to
+ * @param[in]  size   Size of @p buf
+ * @param[in]  next   Callback for further buffers, may be NULL
+ * @param[in]  arg    Argument to @p next
+ */
+void cbor_writer_init(cbor_writer_t *w, unsigned char *buf, size_t size,
+                      cbor_writer_next_t next, void *arg);
+
+/**
+ * @brief Finish writing
+ *
+ * The number of bytes in the last buffer is cbor_writer_t::pos.
+ *
+ * @param[in] w       The writer
+ *
+ * @return total number of bytes written
+ * @return -ENOBUFS if the data did not fit into the buffers
+ */
+ssize_t cbor_writer_finish(const cbor_writer_t *w);
+
+/**
+ * @brief Write an unsigned integer
+ *
+ * @param[in, out] w      The writer
+ * @param[in]      val    The value
+ *
+ * @return 0 on success
+ * @return -ENOBUFS if out of space
+ */
+int cbor_writer_uint(cbor_writer_t *w, uint64_t val);
+
+/**
+ * @brief Write a signed integer
+ *
+ * @param[in, out] w      The writer
+ * @param[in]      val    The value
+ *
+ * @return 0 on success
+ * @return -ENOBUFS if out of space
+ */
+int cbor_writer_int(cbor_writer_t *w, int64_t val);
+
+/**
+ * @brief Write a byte string
+ *
+ * @param[in, out] w      The writer
+ * @param[in]      val    The bytes
+ * @param[in]      len    Number of bytes in @p val
+ *
+ * @return 0 on success
+ * @return -ENOBUFS if out of space
+ */
+int cbor_writer_bytes(cbor_writer_t *w, const void *val, size_t len);
+
+/**
+ * @brief Write a text string
+ *
+ * @param[in, out] w      The writer
+ * @param[in]      val    UTF-8 encoded text, need not be terminated
+ * @param[in]      len    Length of @p val in bytes
+ *
+ * @return 0 on success
+ * @return -ENOBUFS if out of space
+ */
+int cbor_writer_text(cbor_writer_t *w, const char *val, size_t len);
+
+/**
+ * @brief Write the head of an array of @p len items
+ *
+ * @param[in, out] w      The writer
+ * @param[in]      len    Number of items that follow
+ *
+ * @return 0 on success
+ * @return -ENOBUFS if out of space
+ */
+int cbor_writer_array(cbor_writer_t *w, size_t len);
+
+/**
+ * @brief Write the head of a map of @p len key-value pairs
+ *
+ * @param[in, out] w      The writer
+ * @param[in]      len    Number of key-value pairs that follow
+ *
+ * @return 0 on success
+ * @return -ENOBUFS if out of space
+ */
+int cbor_writer_map(cbor_writer_t *w, size_t len);
+
+/**
+ * @brief Write the head of an indefinite-length array
+ *
+ * Terminate the array with cbor_writer_break().
+ *
+ * @param[in, out] w      The writer
+ *
+ * @return 0 on success
+ * @return -ENOBUFS if out of space
+ */
+int cbor_writer_array_indefinite(cbor_writer_t *w);
+
+/**
+ * @brief Write the head of an indefinite-length map
+ *
+ * Terminate the map with cbor_writer_break().
+ *
+ * @param[in, out] w      The writer
+ *
+ * @return 0 on success
+ * @return -ENOBUFS if out of space
+ */
+int cbor_writer_map_indefinite(cbor_writer_t *w);
+
+/**
+ * @brief Write a break, terminating an indefinite-length item
+ *
+ * @param[in, out] w      The writer
+ *
+ * @return 0 on success
+ * @return -ENOBUFS if out of space
+ */
+int cbor_writer_break(cbor_writer_t *w);
+
+/**
+ * @brief Write a tag for the next item
+ *
+ * @param[in, out] w      The writer
+ * @param[in]      tag    The tag
+ *
+ * @return 0 on success
+ * @return -ENOBUFS if out of space
+ */
+int cbor_writer_tag(cbor_writer_t *w, uint64_t tag);
+
+/**
+ * @brief Write a boolean
+ *
+ * @param[in, out] w      The writer
+ * @param[in]      val    The value
+ *
+ * @return 0 on success
+ * @return -ENOBUFS if out of space
+ */
+int cbor_writer_bool(cbor_writer_t *w, bool val);
+
+/**
+ * @brief Write null
+ *
+ * @param[in, out] w      The writer
+ *
+ * @return 0 on success
+ * @return -ENOBUFS if out of space
+ */
+int cbor_writer_null(cbor_writer_t *w);
+
+#ifndef CBOR_NO_FLOAT
+/**
+ * @brief Write a single precision floating-point number
+ *
+ * @param[in, out] w      The writer
+ * @param[in]      val    The value
+ *
+ * @return 0 on success
+ * @return -ENOBUFS if out of space
+ */
+int cbor_writer_float(cbor_writer_t *w, float val);
+#endif /* CBOR_NO_FLOAT */
+/** @} */
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2016 Kaspar Schleiser <kaspar@schleiser.de>
+ *               2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_event Event Queue
+ * @ingroup     sys
+ * @brief       Allocation-free event queue for ISR to thread handoff
+ *
+ * An event queue is owned by a single thread. Events are intrusive objects
+ * (usually embedded into a larger, user defined structure) that can be posted
+ * to a queue from any context, including ISRs. Posting an event never
+ * allocates memory and never fails: the event is linked into the queue and
+ * the owning thread is woken up using @ref THREAD_FLAG_EVENT.
+ *
+ * An event that is posted while it is still queued is not queued a second
+ * time; its handler will only run once. Handlers that need to know how often
+ * they were triggered have to count themselves.
+ *
+ * Example:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static void _handler(event_t *event)
+ * {
+ *     puts("triggered");
+ * }
+ *
+ * static event_t _event = { .handler = _handler };
+ * static event_queue_t _queue;
+ *
+ * static void _isr(void *arg)
+ * {
+ *     event_post(&_queue, &_event);
+ * }
+ *
+ * static void *_thread(void *arg)
+ * {
+ *     event_queue_init(&_queue);
+ *     event_loop(&_queue);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       Event queue API
+ *
+ * @author      Kaspar Schleiser <kaspar@schleiser.de>
+ * @author      agent <agent@local>
+ */
+
+#ifndef EVENT_H
+#define EVENT_H
+
+#include <stdint.h>
+
+#include "clist.h"
+#include "kernel_defines.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Thread flag used to signal a non-empty event queue
+ */
+#ifndef THREAD_FLAG_EVENT
+#define THREAD_FLAG_EVENT   (0x1)
+#endif
+
+/**
+ * @brief   Event structure forward declaration
+ */
+typedef struct event event_t;
+
+/**
+ * @brief   Event handler type
+ *
+ * @param[in] event     the event that has been posted
+ */
+typedef void (*event_handler_t)(event_t *event);
+
+/**
+ * @brief   Event structure
+ */
+struct event {
+    clist_node_t list_node;     /**< event queue list entry */
+    event_handler_t handler;    /**< pointer to the event handler function */
+};
+
+/**
+ * @brief   Event queue structure
+ */
+typedef struct {
+    clist_node_t event_list;    /**< list of queued events */
+    thread_t *waiter;           /**< thread owning the event queue */
+} event_queue_t;
+
+/**
+ * @brief   Initializes an event queue
+ *
+ * The calling thread becomes the owner of the queue. Only the owner may
+ * wait on the queue.
+ *
+ * @param[out] queue    event queue object to initialize
+ */
+void event_queue_init(event_queue_t *queue);
+
+/**
+ * @brief   Queues an event
+ *
+ * Can be called from ISR context. If @p event is already queued, this is a
+ * no-op.
+ *
+ * @param[in] queue     event queue to queue event in
+ * @param[in] event     event to queue
+ */
+void event_post(event_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Removes an event from an event queue
+ *
+ * Can be called from ISR context. If @p event is not queued, this is a no-op.
+ *
+ * @param[in] queue     event queue to remove event from
+ * @param[in] event     event to remove
+ */
+void event_cancel(event_queue_t *queue, event_t *event);
+
+/**
+ * @brief   Checks whether an event is currently queued
+ *
+ * @param[in] event     event to check
+ *
+ * @return  1 if @p event is queued, 0 otherwise
+ */
+static inline int event_is_queued(const event_t *event)
+{
+    return (event->list_node.next != NULL);
+}
+
+/**
+ * @brief   Gets the next event from a queue, non-blocking
+ *
+ * @param[in] queue     event queue to get event from
+ *
+ * @return  pointer to the next event
+ * @return  NULL, if the queue is empty
+ */
+event_t *event_get(event_queue_t *queue);
+
+/**
+ * @brief   Gets the next event from a queue, blocking
+ *
+ * Must only be called by the owner of @p queue.
+ *
+ * @param[in] queue     event queue to get event from
+ *
+ * @return  pointer to the next event
+ */
+event_t *event_wait(event_queue_t *queue);
+
+/**
+ * @brief   Handles events from an event queue forever
+ *
+ * Must only be called by the owner of @p queue.
+ *
+ * @param[in] queue     event queue to process
+ */
+NORETURN void event_loop(event_queue_t *queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EVENT_H */
+/** @} */
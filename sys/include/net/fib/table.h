@@ -23,7 +23,7 @@
 
 #include "kernel_types.h"
 #include "universal_address.h"
-#include "mutex.h"
+#include "rwlock.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -119,8 +119,8 @@ typedef struct {
     uint8_t table_type;
     /** the maximim number of entries in this FIB table */
     size_t size;
-    /** table access mutex to grant exclusive operations on calls */
-    mutex_t mtx_access;
+    /** table access lock, shared by readers and exclusive for modifications */
+    rwlock_t mtx_access;
     /** current number of registered RPs. */
     size_t notify_rp_pos;
     /** the kernel_pid_t of the registered RPs.
@@ -59,6 +59,57 @@
  * described above. In fact, the gcoap_response() function is inline, and uses
  * those two functions.
  *
+ * ### Deferring a response ###
+ *
+ * A callback that cannot produce the response right away, for example
+ * because it must wait for a slow sensor, should not block the gcoap thread.
+ * Instead it calls gcoap_resp_defer() with a gcoap_deferred_t it owns, and
+ * returns the result. gcoap then acknowledges a confirmable request with an
+ * empty ACK, and is free to serve other requests.
+ *
+ * Later, from any thread, build the response with gcoap_deferred_init() on a
+ * buffer of your own, write the payload and call gcoap_finish() as above.
+ * Then send it with gcoap_deferred_send().
+ *
+ * ## Block-wise Transfer ##
+ *
+ * gcoap supports the server side of block-wise transfers, RFC 7959, to
+ * exchange representations larger than a single PDU.
+ *
+ * To serve a large representation, the callback calls gcoap_block2_stream()
+ * with a gcoap_stream_handler_t, and returns the result. gcoap reads the
+ * Block2 option of the request, and the stream handler writes only the
+ * requested block, read from the given offset within the representation.
+ * So the representation never needs to be kept in memory as a whole. The
+ * block size is the size requested by the client, limited by
+ * GCOAP_BLOCK_SZX_MAX and the space in the PDU buffer.
+ *
+ * To receive a large representation, the callback calls gcoap_block1_get()
+ * before writing the response. When the request has a Block1 option, the
+ * payload is the block at gcoap_block_t::offset. Store it, and respond with
+ * gcoap_block1_finish(), which also writes the 2.31 Continue response for
+ * all but the last block.
+ *
+ * ## Observe ##
+ *
+ * gcoap supports the server side of CoAP Observe, RFC 7641. A GET request
+ * with the Observe option set to 0 registers the requester as an observer
+ * of the resource. The response from the callback then includes the Observe
+ * option. A GET request with Observe set to 1, or a Reset message for a
+ * notification, removes the registration. Up to
+ * GCOAP_OBS_REGISTRATIONS_MAX registrations are kept; when the table is
+ * full, a request is answered without registration.
+ *
+ * When the state of an observed resource changes, call gcoap_obs_send().
+ * gcoap then runs the resource callback again, as for a GET request, to
+ * build a notification for each observer. Notifications to an observer are
+ * sent at most once per GCOAP_OBS_NOTIFY_INTERVAL. Changes in between are
+ * coalesced into a single notification with the latest state.
+ *
+ * A callback can't tell a notification from a request, so it needs no
+ * changes to support Observe. If it returns an error response, gcoap sends
+ * it and removes the registration.
+ *
  * ## Client Operation ##
  *
  * gcoap uses RIOT's asynchronous messaging facility to send and receive
@@ -122,7 +173,9 @@
  * response, so the gcoap thread does not block while waiting. The user is
  * notified via the same callback whether the message is received or the wait
  * times out. We track the response with an entry in the
- * `_coap_state.open_reqs` array.
+ * `_coap_state.open_reqs` array, at or shortly after the entry for a hash of
+ * the request token. A single timer serves the retransmissions and timeouts
+ * of all entries.
  *
  * @{
  *
@@ -138,6 +191,7 @@
 #include "net/gnrc.h"
 #include "net/gnrc/ipv6.h"
 #include "net/gnrc/udp.h"
+#include "mutex.h"
 #include "nanocoap.h"
 #include "xtimer.h"
 
@@ -171,8 +225,15 @@ extern "C" {
  */
 #define GCOAP_RESP_OPTIONS_BUF  (8)
 
-/** @brief Maximum number of requests awaiting a response */
+/**
+ * @brief Maximum number of requests awaiting a response
+ *
+ * Requests are found by a hash of their token, so a table with some spare
+ * entries is searched faster.
+ */
+#ifndef GCOAP_REQ_WAITING_MAX
 #define GCOAP_REQ_WAITING_MAX   (2)
+#endif
 
 /** @brief Maximum length in bytes for a token */
 #define GCOAP_TOKENLEN_MAX      (8)
@@ -206,11 +267,99 @@ extern "C" {
  */
 #define GCOAP_NON_TIMEOUT    (5000000U)
 
+/**
+ * @name Transmission parameters for confirmable requests, RFC 7252
+ * @{
+ */
+/** @brief Initial time to wait for an ACK, in usec */
+#ifndef GCOAP_ACK_TIMEOUT
+#define GCOAP_ACK_TIMEOUT               (2000000U)
+#endif
+/** @brief Upper bound of the random factor for the initial wait, times 1000 */
+#ifndef GCOAP_ACK_RANDOM_FACTOR_1000
+#define GCOAP_ACK_RANDOM_FACTOR_1000    (1500)
+#endif
+/** @brief Maximum number of retransmissions */
+#ifndef GCOAP_MAX_RETRANSMIT
+#define GCOAP_MAX_RETRANSMIT            (4)
+#endif
+/**
+ * @brief Maximum number of unacknowledged requests to a destination
+ *
+ * Further requests to the destination are queued until one is acknowledged.
+ */
+#ifndef GCOAP_NSTART
+#define GCOAP_NSTART                    (1)
+#endif
+/** @} */
+
 /** @brief Identifies a gcoap-specific timeout IPC message */
 #define GCOAP_NETAPI_MSG_TYPE_TIMEOUT    (0x1501)
 
+/** @brief Identifies a gcoap-specific IPC message to send notifications */
+#define GCOAP_NETAPI_MSG_TYPE_OBS_NOTIFY (0x1502)
+
+/**
+ * @name Option numbers and codes for block-wise transfers, RFC 7959
+ * @{
+ */
+#ifndef COAP_OPT_BLOCK2
+#define COAP_OPT_BLOCK2         (23)
+#endif
+#ifndef COAP_OPT_BLOCK1
+#define COAP_OPT_BLOCK1         (27)
+#endif
+#ifndef COAP_CODE_CONTINUE
+#define COAP_CODE_CONTINUE      (95)    /**< 2.31 Continue */
+#endif
+/** @} */
+
+/**
+ * @brief Largest block size exponent (SZX) used for Block2
+ *
+ * The block size is 2^(SZX + 4) bytes. It is limited further by the space in
+ * the PDU buffer.
+ */
+#ifndef GCOAP_BLOCK_SZX_MAX
+#define GCOAP_BLOCK_SZX_MAX     (2)
+#endif
+
+/** @brief Maximum length in bytes of an encoded block option */
+#define GCOAP_BLOCK_OPTION_LEN  (5)
+
+/** @brief Option number for Observe, RFC 7641 */
+#ifndef COAP_OPT_OBSERVE
+#define COAP_OPT_OBSERVE        (6)
+#endif
+
+/**
+ * @name Values of the Observe option in a request
+ * @{
+ */
+#define GCOAP_OBS_REGISTER      (0)  /**< Register as observer */
+#define GCOAP_OBS_DEREGISTER    (1)  /**< Remove registration */
+/** @} */
+
+/** @brief Maximum number of observer registrations */
+#ifndef GCOAP_OBS_REGISTRATIONS_MAX
+#define GCOAP_OBS_REGISTRATIONS_MAX (2)
+#endif
+
+/**
+ * @brief Minimum time between notifications to an observer, in usec
+ *
+ * Changes to a resource within this time are coalesced into one
+ * notification.
+ */
+#ifndef GCOAP_OBS_NOTIFY_INTERVAL
+#define GCOAP_OBS_NOTIFY_INTERVAL   (1000000U)
+#endif
+
 /**
  * @brief  A modular collection of resources for a server
+ *
+ * gcoap finds the resource for a request with a binary search over each
+ * listener, so the resources must be sorted by path with strcmp() ordering.
  */
 typedef struct gcoap_listener {
     coap_resource_t *resources;   /**< First element in the array of resources;
@@ -235,10 +384,69 @@ typedef struct {
     uint8_t hdr_buf[GCOAP_HEADER_MAXLEN];
                                         /**< Stores a copy of the request header */
     gcoap_resp_handler_t resp_handler;  /**< Callback for the response */
-    xtimer_t response_timer;            /**< Limits wait for response */
-    msg_t timeout_msg;                  /**< For response timer */
+    gnrc_pktsnip_t *pdu_snip;           /**< Confirmable request awaiting ACK,
+                                             kept for retransmission */
+    ipv6_addr_t addr;                   /**< Destination of the request */
+    uint16_t port;                      /**< Port at the destination */
+    uint8_t retransmits;                /**< Number of retransmissions */
+    uint8_t queued;                     /**< Queued until another request to the
+                                             destination is acknowledged */
+    uint32_t timeout;                   /**< Current wait, in usec; 0 to wait
+                                             without limit */
+    uint32_t deadline;                  /**< End of the current wait, in usec */
 } gcoap_request_memo_t;
 
+/**
+ * @brief  Block of a block-wise transfer
+ */
+typedef struct {
+    uint32_t num;       /**< Number of the block */
+    size_t offset;      /**< Offset of the block within the representation */
+    uint8_t szx;        /**< Block size exponent; size is 2^(szx + 4) */
+    uint8_t more;       /**< More blocks follow */
+} gcoap_block_t;
+
+/**
+ * @brief  Writes a part of a representation for a block-wise response
+ *
+ * @param[out] buf Buffer for the data
+ * @param[in] offset Offset of the data within the representation
+ * @param[in] len Length of data to write
+ * @param[in] arg Argument provided to gcoap_block2_stream()
+ *
+ * @return length of data written; less than @p len at the end of the
+ *         representation
+ * @return < 0 on error
+ */
+typedef ssize_t (*gcoap_stream_handler_t)(uint8_t *buf, size_t offset,
+                                          size_t len, void *arg);
+
+/**
+ * @brief  Requester of a deferred response
+ *
+ * Filled by gcoap_resp_defer(), and used to send the response later.
+ */
+typedef struct {
+    ipv6_addr_t addr;                   /**< Address of the requester */
+    uint16_t port;                      /**< Port of the requester */
+    uint8_t token_len;                  /**< Length of the request token */
+    uint8_t token[GCOAP_TOKENLEN_MAX];  /**< Token of the request */
+} gcoap_deferred_t;
+
+/**
+ * @brief  Registration of an observer for a resource
+ */
+typedef struct {
+    const coap_resource_t *resource;    /**< Observed resource; NULL if unused */
+    ipv6_addr_t addr;                   /**< Address of the observer */
+    uint16_t port;                      /**< Port of the observer */
+    uint16_t last_mid;                  /**< Message ID of the last notification */
+    uint32_t last_notify;               /**< Time of the last notification, in usec */
+    uint8_t pending;                    /**< A notification is pending */
+    uint8_t token_len;                  /**< Length of the registration token */
+    uint8_t token[GCOAP_TOKENLEN_MAX];  /**< Token of the registration */
+} gcoap_observe_memo_t;
+
 /**
  * @brief  Container for the state of gcoap itself
  */
@@ -249,7 +457,23 @@ typedef struct {
                                        /**< Storage for open requests; if first
                                             byte of an entry is zero, the entry
                                             is available */
+    unsigned req_probe_max;            /**< Maximum distance of a memo from the
+                                            slot for its token */
+    mutex_t req_lock;                  /**< Protects gcoap_state_t::open_reqs */
+    xtimer_t req_timer;                /**< Shared timer for retransmissions and
+                                            response timeouts */
+    msg_t req_timer_msg;               /**< For request timer */
+    uint32_t req_due;                  /**< Expiry of gcoap_state_t::req_timer */
+    uint8_t req_timer_set;             /**< gcoap_state_t::req_timer is set */
     uint16_t last_message_id;          /**< Last message ID used */
+    gcoap_observe_memo_t observers[GCOAP_OBS_REGISTRATIONS_MAX];
+                                       /**< Observer registrations */
+    mutex_t obs_lock;                  /**< Protects gcoap_state_t::observers */
+    uint32_t obs_seq;                  /**< Last Observe sequence number used */
+    xtimer_t obs_timer;                /**< Delays coalesced notifications */
+    msg_t obs_msg;                     /**< For notification timer */
+    uint32_t obs_due;                  /**< Expiry of gcoap_state_t::obs_timer */
+    uint8_t obs_timer_set;             /**< gcoap_state_t::obs_timer is set */
 } gcoap_state_t;
 
 /**
@@ -322,9 +546,27 @@ static inline ssize_t gcoap_request(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                 : -1;
 }
 
+/**
+ * @brief  Sets the message type in a CoAP header.
+ *
+ * Use to send a request as confirmable, after gcoap_req_init().
+ *
+ * @param[in] hdr Header of the PDU
+ * @param[in] type Message type, a COAP_TYPE...
+ */
+static inline void gcoap_hdr_set_type(coap_hdr_t *hdr, unsigned type)
+{
+    hdr->ver_t_tkl = (hdr->ver_t_tkl & ~0x30) | ((type & 0x3) << 4);
+}
+
 /**
  * @brief  Sends a buffer containing a CoAP request to the provided host/port.
  *
+ * A confirmable request is retransmitted with exponential back-off until it
+ * is acknowledged, up to GCOAP_MAX_RETRANSMIT times. If GCOAP_NSTART
+ * requests to the destination await acknowledgement already, the request is
+ * queued until one of them is acknowledged.
+ *
  * @param[in] buf Buffer containing the PDU
  * @param[in] len Length of the buffer
  * @param[in] addr Destination for the packet
@@ -371,6 +613,122 @@ static inline ssize_t gcoap_response(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                 : -1;
 }
 
+/**
+ * @brief  Defers the response to the request currently being handled.
+ *
+ * Must be called only from a resource callback, which then returns the
+ * result. Records the requester in @p deferred. For a confirmable request,
+ * writes an empty ACK to the buffer.
+ *
+ * @param[in] pdu Request metadata
+ * @param[in] buf Buffer containing the PDU
+ * @param[in] len Length of the buffer
+ * @param[out] deferred Requester to answer later with gcoap_deferred_send()
+ *
+ * @return size of the empty ACK within the buffer
+ * @return 0 if nothing is to be sent now
+ * @return -EINVAL if not called from a resource callback
+ */
+ssize_t gcoap_resp_defer(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                                          gcoap_deferred_t *deferred);
+
+/**
+ * @brief  Initializes a deferred response on a buffer.
+ *
+ * Writes a new non-confirmable header with the token of the deferred request,
+ * and initializes the payload location like gcoap_resp_init(). May be called
+ * from any thread. Finish the PDU with gcoap_finish().
+ *
+ * @param[in] deferred Requester recorded by gcoap_resp_defer()
+ * @param[out] pdu Response metadata
+ * @param[in] buf Buffer for the PDU
+ * @param[in] len Length of the buffer
+ * @param[in] code Response code
+ *
+ * @return 0 on success
+ * @return < 0 on error
+ */
+int gcoap_deferred_init(gcoap_deferred_t *deferred, coap_pkt_t *pdu,
+                        uint8_t *buf, size_t len, unsigned code);
+
+/**
+ * @brief  Sends a deferred response to the requester.
+ *
+ * @param[in] deferred Requester recorded by gcoap_resp_defer()
+ * @param[in] buf Buffer containing the PDU
+ * @param[in] len Length of the PDU
+ *
+ * @return length of the packet
+ * @return 0 if cannot send
+ */
+size_t gcoap_deferred_send(gcoap_deferred_t *deferred, uint8_t *buf, size_t len);
+
+/**
+ * @brief  Reads the Block1 option of the request currently being handled.
+ *
+ * Must be called from a resource callback, before writing the response.
+ *
+ * @param[in] pdu Request metadata
+ * @param[out] block Block carried in the request payload
+ *
+ * @return 0 on success
+ * @return -1 if the request has no Block1 option
+ */
+int gcoap_block1_get(coap_pkt_t *pdu, gcoap_block_t *block);
+
+/**
+ * @brief  Writes the response to a block of a block-wise request.
+ *
+ * Responds with 2.31 Continue while more blocks follow, otherwise with
+ * @p code. Echoes the Block1 option.
+ *
+ * @param[in] pdu Request metadata
+ * @param[in] buf Buffer containing the PDU
+ * @param[in] len Length of the buffer
+ * @param[in] block Block read with gcoap_block1_get()
+ * @param[in] code Response code for the last block
+ *
+ * @return size of the PDU within the buffer
+ * @return < 0 on error
+ */
+ssize_t gcoap_block1_finish(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            gcoap_block_t *block, unsigned code);
+
+/**
+ * @brief  Writes a 2.05 Content response with the block of a representation
+ *         requested by the Block2 option.
+ *
+ * Must be called from a resource callback. Calls @p stream to write the
+ * block. The response includes a Block2 option if the request has one, or
+ * if the representation does not fit in one block.
+ *
+ * @param[in] pdu Request metadata
+ * @param[in] buf Buffer containing the PDU
+ * @param[in] len Length of the buffer
+ * @param[in] format Format code for the representation
+ * @param[in] stream Writes the block
+ * @param[in] arg Argument for @p stream
+ *
+ * @return size of the PDU within the buffer
+ * @return < 0 on error
+ */
+ssize_t gcoap_block2_stream(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            unsigned format, gcoap_stream_handler_t stream,
+                            void *arg);
+
+/**
+ * @brief  Notifies the observers of a resource that its state changed.
+ *
+ * The notifications are built and sent by the gcoap thread, no sooner than
+ * GCOAP_OBS_NOTIFY_INTERVAL after the last notification to an observer.
+ * Calls until then are coalesced. May be called from any thread.
+ *
+ * @param[in] resource Resource with changed state
+ *
+ * @return number of observers of the resource
+ */
+unsigned gcoap_obs_send(const coap_resource_t *resource);
+
 /**
  * @brief Provides important operational statistics.
  *
@@ -27,7 +27,7 @@
 
 #include "kernel_defines.h"
 #include "kernel_types.h"
-#include "mutex.h"
+#include "rwlock.h"
 #include "net/ipv6.h"
 #include "net/ipv6/addr.h"
 #include "net/netstats.h"
@@ -274,7 +274,7 @@ typedef struct {
      * @brief addresses registered to the interface
      */
     gnrc_ipv6_netif_addr_t addrs[GNRC_IPV6_NETIF_ADDR_NUMOF];
-    mutex_t mutex;          /**< mutex for the interface */
+    rwlock_t mutex;         /**< lock for the interface */
     kernel_pid_t pid;       /**< PID of the interface */
     uint16_t flags;         /**< flags for 6LoWPAN and Neighbor Discovery */
     uint16_t mtu;           /**< Maximum Transmission Unit (MTU) of the interface */
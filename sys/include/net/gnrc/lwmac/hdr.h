@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_lwmac
+ * @{
+ *
+ * @file
+ * @brief       Header definitions for LWMAC
+ *
+ * Every LWMAC frame starts with a @ref gnrc_lwmac_hdr_t right after the
+ * IEEE 802.15.4 MAC header. Addresses are taken from the MAC header.
+ *
+ * @author      agent <agent@local>
+ */
+#ifndef GNRC_LWMAC_HDR_H
+#define GNRC_LWMAC_HDR_H
+
+#include <stdint.h>
+
+#include "byteorder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   LWMAC frame types
+ */
+typedef enum {
+    GNRC_LWMAC_FRAMETYPE_WR = 1,        /**< wake-up request */
+    GNRC_LWMAC_FRAMETYPE_WA,            /**< wake-up answer */
+    GNRC_LWMAC_FRAMETYPE_DATA,          /**< unicast data */
+    GNRC_LWMAC_FRAMETYPE_DATA_PENDING,  /**< unicast data, more follows */
+    GNRC_LWMAC_FRAMETYPE_BROADCAST,     /**< broadcast data */
+} gnrc_lwmac_frame_type_t;
+
+/**
+ * @brief   LWMAC header
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t type;                   /**< type of frame, see
+                                     *   @ref gnrc_lwmac_frame_type_t */
+} gnrc_lwmac_hdr_t;
+
+/**
+ * @brief   Wake-up answer
+ */
+typedef struct __attribute__((packed)) {
+    gnrc_lwmac_hdr_t header;        /**< WA header */
+    network_uint32_t phase;         /**< time since the receiver woke up in
+                                     *   microseconds */
+} gnrc_lwmac_frame_wa_t;
+
+/**
+ * @brief   Broadcast data header
+ *
+ * Broadcasts are repeated for a whole wake-up interval, the sequence number
+ * lets receivers detect repetitions.
+ */
+typedef struct __attribute__((packed)) {
+    gnrc_lwmac_hdr_t header;        /**< broadcast header */
+    uint8_t seq_nr;                 /**< sequence number of the broadcast */
+} gnrc_lwmac_frame_broadcast_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_LWMAC_HDR_H */
+/** @} */
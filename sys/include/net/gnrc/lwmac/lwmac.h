@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_lwmac  LWMAC
+ * @ingroup     net_gnrc
+ * @brief       A duty-cycled MAC protocol based on preamble sampling
+ *
+ * LWMAC switches the radio off most of the time. Every node wakes up once
+ * per @ref GNRC_LWMAC_WAKEUP_INTERVAL_US and listens for
+ * @ref GNRC_LWMAC_WAKEUP_DURATION_US. A sender repeats short wake-up requests
+ * (WR) to the destination until the destination answers with a wake-up answer
+ * (WA) during its listening period, then sends its data. The WA carries the
+ * time since the receiver woke up, so the sender learns the receiver's phase
+ * and starts its next wake-up requests just before the receiver wakes up.
+ * All packets queued for the receiver are then sent in one burst.
+ *
+ * Broadcasts are repeated for a whole wake-up interval, so every neighbor
+ * receives a copy while it listens.
+ *
+ * Packets are queued per neighbor in the @ref net_gnrc_mac TX queues and
+ * received packets are handed to the upper layer only after the radio was
+ * switched off again.
+ *
+ * LWMAC runs in the thread of its interface instead of the one started by
+ * gnrc_netdev2_init(). It needs a device that supports the
+ * @ref NETOPT_STATE_SLEEP state.
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for LWMAC
+ *
+ * @author      agent <agent@local>
+ */
+#ifndef GNRC_LWMAC_H
+#define GNRC_LWMAC_H
+
+#include "kernel_types.h"
+#include "timex.h"
+#include "net/gnrc/netdev2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Time between two wake-ups of a node in microseconds
+ */
+#ifndef GNRC_LWMAC_WAKEUP_INTERVAL_US
+#define GNRC_LWMAC_WAKEUP_INTERVAL_US       (200U * MS_IN_USEC)
+#endif
+
+/**
+ * @brief   Time between two wake-up requests in microseconds
+ *
+ * Must be long enough to receive the wake-up answer.
+ */
+#ifndef GNRC_LWMAC_TIME_BETWEEN_WR_US
+#define GNRC_LWMAC_TIME_BETWEEN_WR_US       (5U * MS_IN_USEC)
+#endif
+
+/**
+ * @brief   Time a node listens after waking up in microseconds
+ *
+ * Must be longer than @ref GNRC_LWMAC_TIME_BETWEEN_WR_US to catch at least
+ * one wake-up request.
+ */
+#ifndef GNRC_LWMAC_WAKEUP_DURATION_US
+#define GNRC_LWMAC_WAKEUP_DURATION_US       (GNRC_LWMAC_TIME_BETWEEN_WR_US * 3 / 2)
+#endif
+
+/**
+ * @brief   Time a receiver waits for data after a wake-up answer in
+ *          microseconds
+ */
+#ifndef GNRC_LWMAC_DATA_DELAY_US
+#define GNRC_LWMAC_DATA_DELAY_US            (10U * MS_IN_USEC)
+#endif
+
+/**
+ * @brief   Time between two repetitions of a broadcast in microseconds
+ */
+#ifndef GNRC_LWMAC_TIME_BETWEEN_BROADCAST_US
+#define GNRC_LWMAC_TIME_BETWEEN_BROADCAST_US (GNRC_LWMAC_TIME_BETWEEN_WR_US)
+#endif
+
+/**
+ * @brief   Time a broadcast is repeated in microseconds
+ */
+#ifndef GNRC_LWMAC_BROADCAST_DURATION_US
+#define GNRC_LWMAC_BROADCAST_DURATION_US    (GNRC_LWMAC_WAKEUP_INTERVAL_US + \
+                                             GNRC_LWMAC_WAKEUP_DURATION_US)
+#endif
+
+/**
+ * @brief   Number of wake-up intervals to try to reach a neighbor before the
+ *          packet is dropped
+ */
+#ifndef GNRC_LWMAC_MAX_TX_RETRIES
+#define GNRC_LWMAC_MAX_TX_RETRIES           (3U)
+#endif
+
+/**
+ * @brief   Message queue size of the LWMAC thread
+ */
+#ifndef GNRC_LWMAC_MSG_QUEUE_SIZE
+#define GNRC_LWMAC_MSG_QUEUE_SIZE           (8U)
+#endif
+
+/**
+ * @brief   Starts the LWMAC thread of an interface
+ *
+ * Use instead of gnrc_netdev2_init().
+ *
+ * @param[in] stack         stack for the thread
+ * @param[in] stacksize     size of @p stack
+ * @param[in] priority      priority of the thread
+ * @param[in] name          name of the thread
+ * @param[in] gnrc_netdev2  the interface, set up by e.g.
+ *                          gnrc_netdev2_ieee802154_init()
+ *
+ * @return  PID of the thread
+ * @return  -ENODEV, if @p gnrc_netdev2 has no device
+ * @return  -EINVAL, if the thread could not be created
+ */
+kernel_pid_t gnrc_lwmac_init(char *stack, int stacksize, char priority,
+                             const char *name, gnrc_netdev2_t *gnrc_netdev2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_LWMAC_H */
+/** @} */
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_lwmac
+ * @{
+ *
+ * @file
+ * @brief       Internal data types of LWMAC
+ * @internal
+ *
+ * @author      agent <agent@local>
+ */
+#ifndef GNRC_LWMAC_TYPES_H
+#define GNRC_LWMAC_TYPES_H
+
+#include <stdint.h>
+
+#include "msg.h"
+#include "net/ieee802154.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Message type for the periodic wake-up
+ */
+#define GNRC_LWMAC_MSG_TYPE_WAKEUP      (0x1236)
+
+/**
+ * @brief   Message type for timeouts of the current state
+ */
+#define GNRC_LWMAC_MSG_TYPE_TIMEOUT     (0x1237)
+
+/**
+ * @brief   Number of broadcasts remembered to drop repetitions
+ */
+#ifndef GNRC_LWMAC_BROADCAST_SEEN_NUMOF
+#define GNRC_LWMAC_BROADCAST_SEEN_NUMOF (4U)
+#endif
+
+/**
+ * @brief   States of LWMAC
+ */
+typedef enum {
+    GNRC_LWMAC_SLEEPING = 0,            /**< radio is off */
+    GNRC_LWMAC_LISTENING,               /**< listening for wake-up requests */
+    GNRC_LWMAC_RECEIVING,               /**< answered a wake-up request,
+                                         *   waiting for data */
+    GNRC_LWMAC_TX_WAIT_PHASE,           /**< radio is off until the receiver
+                                         *   of the next packet wakes up */
+    GNRC_LWMAC_TX_WR,                   /**< sending wake-up requests */
+    GNRC_LWMAC_TX_BROADCAST,            /**< repeating a broadcast */
+} gnrc_lwmac_state_t;
+
+/**
+ * @brief   A broadcast received before
+ */
+typedef struct {
+    uint8_t addr[IEEE802154_LONG_ADDRESS_LEN];  /**< source address */
+    uint8_t addr_len;                   /**< length of gnrc_lwmac_bcast_seen_t::addr */
+    uint8_t seq_nr;                     /**< sequence number */
+} gnrc_lwmac_bcast_seen_t;
+
+/**
+ * @brief   LWMAC state of an interface
+ */
+typedef struct {
+    xtimer_t wakeup_timer;              /**< timer of the periodic wake-up */
+    msg_t wakeup_msg;                   /**< message of gnrc_lwmac_t::wakeup_timer */
+    xtimer_t timer;                     /**< timer for timeouts of the state */
+    msg_t timer_msg;                    /**< message of gnrc_lwmac_t::timer */
+    uint32_t next_wakeup;               /**< time of the next wake-up */
+    uint32_t wakeup_start;              /**< time of the last wake-up */
+    uint32_t deadline;                  /**< end of the current transmission
+                                         *   attempt */
+    uint16_t timer_gen;                 /**< identifies the last armed timer
+                                         *   to ignore stale messages */
+    uint8_t state;                      /**< see @ref gnrc_lwmac_state_t */
+    uint8_t radio_on;                   /**< radio is listening */
+    uint8_t tx_retries;                 /**< failed attempts of the current
+                                         *   packet */
+    uint8_t bcast_seq;                  /**< sequence number of the next
+                                         *   broadcast */
+    uint8_t peer[IEEE802154_LONG_ADDRESS_LEN];  /**< sender of the current
+                                                 *   reception */
+    uint8_t peer_len;                   /**< length of gnrc_lwmac_t::peer */
+    uint8_t bcast_seen_next;            /**< next entry to overwrite in
+                                         *   gnrc_lwmac_t::bcast_seen */
+    gnrc_lwmac_bcast_seen_t bcast_seen[GNRC_LWMAC_BROADCAST_SEEN_NUMOF];
+                                        /**< recently received broadcasts */
+} gnrc_lwmac_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_LWMAC_TYPES_H */
+/** @} */
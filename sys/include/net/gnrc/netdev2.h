@@ -38,6 +38,18 @@
 #include "net/gnrc/mac/types.h"
 #include "net/ieee802154.h"
 #include "net/gnrc/mac/mac.h"
+#ifdef MODULE_NETSTATS_NEIGHBOR
+#include "net/netstats/neighbor.h"
+#endif
+#ifdef MODULE_GNRC_NETDEV2_IEEE802154_TX
+#include "net/gnrc/netdev2/ieee802154_tx.h"
+#endif
+#ifdef MODULE_GNRC_LWMAC
+#include "net/gnrc/lwmac/types.h"
+#endif
+#ifdef MODULE_GNRC_TSCH
+#include "net/gnrc/tsch/types.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -99,6 +111,28 @@ typedef struct gnrc_netdev2 {
      */
     kernel_pid_t pid;
 
+#ifdef MODULE_NETSTATS_NEIGHBOR
+    /**
+     * @brief neighbor the last unicast frame was sent to, refers to NULL
+     *        for multicast
+     */
+    netstats_nb_ref_t nb_tx;
+#endif
+
+#ifdef MODULE_GNRC_NETDEV2_IEEE802154_TX
+    /**
+     * @brief state of the software TX engine for IEEE 802.15.4 devices
+     */
+    gnrc_netdev2_ieee802154_tx_t ieee802154_tx;
+#endif
+
+#ifdef MODULE_GNRC_TSCH
+    /**
+     * @brief TSCH slotframe, queues and synchronization state
+     */
+    gnrc_tsch_t tsch;
+#endif
+
 #ifdef MODULE_GNRC_MAC
     /**
      * @brief general information for the MAC protocol
@@ -130,6 +164,13 @@ typedef struct gnrc_netdev2 {
      */
     gnrc_mac_tx_t tx;
 #endif /* ((GNRC_MAC_TX_QUEUE_SIZE != 0) || (GNRC_MAC_NEIGHBOR_COUNT == 0)) || defined(DOXYGEN) */
+
+#ifdef MODULE_GNRC_LWMAC
+    /**
+     * @brief LWMAC internal states and timers
+     */
+    gnrc_lwmac_t lwmac;
+#endif
 #endif /* MODULE_GNRC_MAC */
 } gnrc_netdev2_t;
 
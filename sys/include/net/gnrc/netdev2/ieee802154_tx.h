@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_netdev2_ieee802154_tx  IEEE 802.15.4 software TX engine
+ * @ingroup     net_gnrc
+ * @brief       Non-blocking CSMA/CA, acknowledgements and retransmissions
+ *              for IEEE 802.15.4 devices without hardware support
+ *
+ * Use the pseudo-module `gnrc_netdev2_ieee802154_tx` to enable it for all
+ * IEEE 802.15.4 interfaces. Frames sent to a device that does not do CSMA/CA
+ * itself (see @ref NETOPT_CSMA) are queued. The engine then runs the
+ * unslotted CSMA/CA procedure configured by @ref CSMA_SENDER_CONF_DEFAULT,
+ * waits for the acknowledgement of frames that requested one and retransmits
+ * them if it does not arrive. All waiting is done with timer messages to the
+ * interface's thread, so the interface keeps receiving frames and handling
+ * requests while a transmission is pending.
+ *
+ * The outcome of every queued frame is reported with
+ * @ref NETDEV2_EVENT_TX_COMPLETE, @ref NETDEV2_EVENT_TX_NOACK, or
+ * @ref NETDEV2_EVENT_TX_MEDIUM_BUSY. TX events of the device itself are
+ * ignored while the engine is in use. If the device also does not send
+ * acknowledgements itself (see @ref NETOPT_AUTOACK), the engine acknowledges
+ * received frames that request it.
+ *
+ * Devices that do CSMA/CA in hardware are passed every frame directly, as
+ * without this module.
+ * @{
+ *
+ * @file
+ * @brief   IEEE 802.15.4 software TX engine definitions
+ *
+ * @author  agent <agent@local>
+ */
+#ifndef GNRC_NETDEV2_IEEE802154_TX_H
+#define GNRC_NETDEV2_IEEE802154_TX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "msg.h"
+#include "net/gnrc/pkt.h"
+#include "net/ieee802154.h"
+#include "xtimer.h"
+#ifdef MODULE_NETSTATS_NEIGHBOR
+#include "net/netstats/neighbor.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Message type of the engine's timer messages
+ */
+#define GNRC_NETDEV2_IEEE802154_TX_MSG_TYPE     (0x1235)
+
+/**
+ * @brief   Number of frames that can be queued per interface
+ */
+#ifndef GNRC_NETDEV2_IEEE802154_TX_QUEUE_SIZE
+#define GNRC_NETDEV2_IEEE802154_TX_QUEUE_SIZE   (4U)
+#endif
+
+/**
+ * @brief   Maximum number of retransmissions of unacknowledged frames
+ *
+ * macMaxFrameRetries of IEEE 802.15.4-2011, 6.4.2
+ */
+#ifndef GNRC_NETDEV2_IEEE802154_TX_MAX_RETRANS
+#define GNRC_NETDEV2_IEEE802154_TX_MAX_RETRANS  (3U)
+#endif
+
+/**
+ * @brief   Time to wait for an acknowledgement in microseconds
+ *
+ * The standard's 864 µs (macAckWaitDuration at 2.4 GHz) assume
+ * acknowledgements generated in hardware. Acknowledgements sent by this
+ * engine on the receiving side take the time to schedule its interface
+ * thread on top of that.
+ */
+#ifndef GNRC_NETDEV2_IEEE802154_TX_ACK_TIMEOUT
+#define GNRC_NETDEV2_IEEE802154_TX_ACK_TIMEOUT  (2000U)
+#endif
+
+/**
+ * @brief   A queued frame
+ */
+typedef struct {
+    gnrc_pktsnip_t *vec;                /**< I/O vector snip of the frame,
+                                         *   prepended to its payload */
+    uint8_t mhr[IEEE802154_MAX_HDR_LEN];    /**< MAC header of the frame */
+#ifdef MODULE_NETSTATS_NEIGHBOR
+    netstats_nb_ref_t nb;               /**< neighbor the frame is sent to */
+#endif
+} gnrc_netdev2_ieee802154_tx_frame_t;
+
+/**
+ * @brief   State of the engine for one interface
+ */
+typedef struct {
+    /**
+     * @brief   Queued frames, the one at gnrc_netdev2_ieee802154_tx_t::head
+     *          is being sent
+     */
+    gnrc_netdev2_ieee802154_tx_frame_t queue[GNRC_NETDEV2_IEEE802154_TX_QUEUE_SIZE];
+    xtimer_t timer;                     /**< backoff and ACK timer */
+    msg_t timer_msg;                    /**< message sent by the timer */
+    uint16_t timer_gen;                 /**< identifies the last armed timer
+                                         *   to ignore stale messages */
+    uint8_t head;                       /**< index of the oldest frame */
+    uint8_t len;                        /**< number of queued frames */
+    uint8_t state;                      /**< state of the frame in
+                                         *   transmission */
+    uint8_t be;                         /**< current backoff exponent */
+    uint8_t nb;                         /**< backoffs of the current attempt */
+    uint8_t retrans;                    /**< retransmissions so far */
+    uint8_t flags;                      /**< mode of the device */
+} gnrc_netdev2_ieee802154_tx_t;
+
+struct gnrc_netdev2;
+
+/**
+ * @brief   Sends or queues a frame
+ *
+ * @pre `vec` was returned by gnrc_pktbuf_get_iovec() and its first vector
+ *      element points to the MAC header.
+ *
+ * The MAC header is copied, so it may live on the stack of the caller.
+ * Ownership of @p vec passes to the engine in any case.
+ *
+ * @param[in] gnrc_netdev2  the interface
+ * @param[in] vec           I/O vector snip of the frame
+ *
+ * @return  number of bytes sent or queued
+ * @return  -ENOBUFS, if the queue is full
+ * @return  any error of netdev2_driver_t::send() for devices with hardware
+ *          CSMA/CA
+ */
+int gnrc_netdev2_ieee802154_tx_send(struct gnrc_netdev2 *gnrc_netdev2,
+                                    gnrc_pktsnip_t *vec);
+
+/**
+ * @brief   Handles a message of type @ref GNRC_NETDEV2_IEEE802154_TX_MSG_TYPE
+ *
+ * @param[in] gnrc_netdev2  the interface
+ * @param[in] msg           the message
+ */
+void gnrc_netdev2_ieee802154_tx_timeout(struct gnrc_netdev2 *gnrc_netdev2,
+                                        msg_t *msg);
+
+/**
+ * @brief   Handles the MAC header of a received frame
+ *
+ * Completes the pending transmission on a matching acknowledgement and
+ * acknowledges data frames if the device does not do so itself.
+ *
+ * @param[in] gnrc_netdev2  the interface
+ * @param[in] frame         the received frame
+ * @param[in] len           length of @p frame
+ *
+ * @return  true, if @p frame is an acknowledgement and must not be passed up
+ * @return  false, otherwise
+ */
+bool gnrc_netdev2_ieee802154_tx_recv(struct gnrc_netdev2 *gnrc_netdev2,
+                                     const uint8_t *frame, size_t len);
+
+/**
+ * @brief   Checks if a TX event of the device is replaced by the engine's
+ *
+ * @param[in] gnrc_netdev2  the interface
+ *
+ * @return  true, if TX events of the device are to be ignored
+ */
+bool gnrc_netdev2_ieee802154_tx_ignore_event(struct gnrc_netdev2 *gnrc_netdev2);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_NETDEV2_IEEE802154_TX_H */
+/** @} */
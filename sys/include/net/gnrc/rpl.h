@@ -24,6 +24,11 @@
  *   USEMODULE += gnrc_rpl
  *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  *
+ * - MRHOF with ETX as link metric (see @ref net_gnrc_rpl_mrhof)
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
+ *   USEMODULE += gnrc_rpl_mrhof
+ *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
  * - RPL auto-initialization on interface
  *   ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ {.mk}
  *   USEMODULE += auto_init_gnrc_rpl
@@ -108,6 +113,7 @@
 #include "net/gnrc/rpl/dodag.h"
 #include "net/gnrc/rpl/of_manager.h"
 #include "net/fib.h"
+#include "div.h"
 #include "xtimer.h"
 #include "trickle.h"
 
@@ -198,12 +204,22 @@ extern "C" {
 /**
  * @brief   Number of implemented Objective Functions
  */
+#ifdef MODULE_GNRC_RPL_MRHOF
+#define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (2)
+#else
 #define GNRC_RPL_IMPLEMENTED_OFS_NUMOF (1)
+#endif
 
 /**
- * @brief   Default Objective Code Point (OF0)
+ * @brief   Default Objective Code Point (MRHOF if @ref net_gnrc_rpl_mrhof is used, OF0 otherwise)
  */
+#ifndef GNRC_RPL_DEFAULT_OCP
+#ifdef MODULE_GNRC_RPL_MRHOF
+#define GNRC_RPL_DEFAULT_OCP (1)
+#else
 #define GNRC_RPL_DEFAULT_OCP (0)
+#endif
+#endif
 
 /**
  * @brief   Default Instance ID
@@ -416,7 +432,10 @@ static inline bool GNRC_RPL_COUNTER_GREATER_THAN(uint8_t A, uint8_t B)
 #define GNRC_RPL_ICMPV6_CODE_DAO_ACK (0x03)
 
 /**
- * @brief Update interval of the lifetime update function
+ * @brief Granularity of the lifetime handling in seconds
+ *
+ * A parent is probed with a DIS two steps before its lifetime expires and
+ * removed one step before. P2P-RPL updates its lifetimes in steps of this size.
  */
 #define GNRC_RPL_LIFETIME_UPDATE_STEP (2)
 
@@ -503,6 +522,11 @@ void gnrc_rpl_send_DIS(gnrc_rpl_instance_t *instance, ipv6_addr_t *destination);
 /**
  * @brief   Send a DAO of the @p dodag to the @p destination.
  *
+ * A DAO to the preferred parent only carries the targets that changed since
+ * the last DAO-ACK, unless a full DAO was requested (see
+ * @ref GNRC_RPL_DAO_FLAGS "DAO state flags"). No DAO is sent if there is no
+ * change to advertise.
+ *
  * @param[in] instance          Pointer to the instance.
  * @param[in] destination       IPv6 addres of the destination.
  * @param[in] lifetime          Lifetime of the route to announce.
@@ -569,10 +593,22 @@ void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, ipv6
 /**
  * @brief   Delay the DAO sending interval
  *
+ * The next DAO advertises all targets of this node.
+ *
  * @param[in] dodag     The DODAG of the DAO
  */
 void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag);
 
+/**
+ * @brief   Delay the DAO sending interval for an incremental DAO
+ *
+ * The next DAO only advertises targets that were added or removed since the
+ * last DAO-ACK, unless a full DAO is already scheduled.
+ *
+ * @param[in] dodag     The DODAG of the DAO
+ */
+void gnrc_rpl_delay_dao_incremental(gnrc_rpl_dodag_t *dodag);
+
 /**
  * @brief   Long delay the DAO sending interval
  *
@@ -615,6 +651,52 @@ void gnrc_rpl_send(gnrc_pktsnip_t *pkt, kernel_pid_t iface, ipv6_addr_t *src, ip
  */
 uint8_t gnrc_rpl_gen_instance_id(bool local);
 
+/**
+ * @brief Get the time base used for RPL lifetimes
+ *
+ * @return  Current system time in seconds
+ */
+static inline uint32_t gnrc_rpl_now_sec(void)
+{
+    return (uint32_t) div_u64_by_1000000(xtimer_now_usec64());
+}
+
+/**
+ * @brief (Re-)Schedule the expiry of @p parent after gnrc_rpl_parent_t::lifetime changed
+ *
+ * The RPL thread only wakes up when the earliest scheduled lifetime event of
+ * all parents and DODAGs is due.
+ *
+ * @param[in] parent            Pointer to the parent
+ */
+void gnrc_rpl_lifetime_parent_update(gnrc_rpl_parent_t *parent);
+
+/**
+ * @brief (Re-)Schedule the timers of @p dodag
+ *
+ * Needs to be called after gnrc_rpl_dodag_t::dao_time, gnrc_rpl_dodag_t::dao_refresh
+ * or gnrc_rpl_instance_t::cleanup changed.
+ *
+ * @param[in] dodag             Pointer to the DODAG
+ */
+void gnrc_rpl_lifetime_dodag_update(gnrc_rpl_dodag_t *dodag);
+
+/**
+ * @brief Remove a parent or DODAG from the lifetime handling
+ *
+ * @param[in] node              Pointer to gnrc_rpl_parent_t::lt_node or
+ *                              gnrc_rpl_dodag_t::lt_node
+ */
+void gnrc_rpl_lifetime_remove(priority_queue_node_t *node);
+
+/**
+ * @brief Schedule the removal of @p inst in @ref GNRC_RPL_CLEANUP_TIME seconds
+ *        if it has no parents by then
+ *
+ * @param[in] inst              Pointer to the instance
+ */
+void gnrc_rpl_cleanup_start(gnrc_rpl_instance_t *inst);
+
 #ifndef GNRC_RPL_WITHOUT_PIO
 /**
  * @brief (De-)Activate the transmission of Prefix Information Options within DIOs
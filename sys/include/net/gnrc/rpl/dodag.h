@@ -46,6 +46,13 @@ extern "C" {
 #define GNRC_RPL_PARENTS_NUMOF (3)
 #endif
 
+/**
+ * @brief   Number of downward route targets tracked for incremental DAOs
+ */
+#ifndef GNRC_RPL_DAO_TARGETS_NUMOF
+#define GNRC_RPL_DAO_TARGETS_NUMOF (8)
+#endif
+
 /**
  * @brief   RPL instance table
  */
@@ -56,6 +63,11 @@ extern gnrc_rpl_instance_t gnrc_rpl_instances[GNRC_RPL_INSTANCES_NUMOF];
  */
 extern gnrc_rpl_parent_t gnrc_rpl_parents[GNRC_RPL_PARENTS_NUMOF];
 
+/**
+ * @brief   Table of downward route targets tracked for incremental DAOs
+ */
+extern gnrc_rpl_dao_target_t gnrc_rpl_dao_targets[GNRC_RPL_DAO_TARGETS_NUMOF];
+
 /**
  * @brief   Add a new RPL instance with the id @p instance_id.
  *
@@ -169,6 +181,63 @@ void gnrc_rpl_leaf_operation(gnrc_rpl_dodag_t *dodag);
  * @param[in] dodag     Pointer to the DODAG
  */
 void gnrc_rpl_router_operation(gnrc_rpl_dodag_t *dodag);
+
+/**
+ * @brief   Invalidate the cached DIO options of the @p dodag.
+ *
+ * Needs to be called whenever a value that is advertised in the DODAG
+ * configuration or prefix information option changes. The prefix lifetimes
+ * are not cached, they are taken from the address on every DIO.
+ *
+ * @param[in] dodag     Pointer to the DODAG
+ */
+static inline void gnrc_rpl_dodag_dio_cache_invalidate(gnrc_rpl_dodag_t *dodag)
+{
+    dodag->dio_opts_cached = false;
+}
+
+/**
+ * @brief   Record a change of a downward route target of the @p dodag.
+ *
+ * Targets that are already acknowledged by the parent and are only refreshed
+ * are not recorded again. If no entry is available, a full DAO is requested.
+ *
+ * @param[in] dodag         Pointer to the DODAG
+ * @param[in] addr          IPv6 prefix or address of the target
+ * @param[in] prefix_length Prefix length of the target
+ * @param[in] remove        true, if the target was removed (No-Path DAO)
+ *
+ * @return  true, if the change needs to be advertised to the parent.
+ * @return  false, otherwise.
+ */
+bool gnrc_rpl_dao_target_update(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *addr,
+                                uint8_t prefix_length, bool remove);
+
+/**
+ * @brief   Check whether the @p dodag has target changes that were not acknowledged yet.
+ *
+ * @param[in] dodag     Pointer to the DODAG
+ *
+ * @return  true, if unacknowledged target changes exist.
+ * @return  false, otherwise.
+ */
+bool gnrc_rpl_dao_targets_pending(gnrc_rpl_dodag_t *dodag);
+
+/**
+ * @brief   Apply a DAO-ACK with sequence @p seq to the tracked targets of the @p dodag.
+ *
+ * @param[in] dodag     Pointer to the DODAG
+ * @param[in] seq       Sequence number of the acknowledged DAO
+ */
+void gnrc_rpl_dao_targets_ack(gnrc_rpl_dodag_t *dodag, uint8_t seq);
+
+/**
+ * @brief   Remove all tracked targets of the @p dodag.
+ *
+ * @param[in] dodag     Pointer to the DODAG
+ */
+void gnrc_rpl_dao_targets_remove_all(gnrc_rpl_dodag_t *dodag);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_rpl_mrhof RPL Minimum Rank with Hysteresis Objective Function
+ * @ingroup     net_gnrc_rpl
+ * @brief       MRHOF using the ETX of the links to the parents
+ * @see <a href="https://tools.ietf.org/html/rfc6719">
+ *          RFC 6719
+ *      </a>
+ *
+ * The ETX of a link is taken from @ref net_netstats_neighbor, which is fed
+ * by the link layer with the outcome of every unicast transmission. The
+ * preferred parent is only replaced if another parent offers a path cost
+ * that is lower by at least @ref GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD.
+ * @{
+ *
+ * @file
+ * @brief       Definitions for MRHOF
+ *
+ * @author      agent <agent@local>
+ */
+#ifndef GNRC_RPL_MRHOF_H
+#define GNRC_RPL_MRHOF_H
+
+#include "net/gnrc/rpl/structs.h"
+#include "net/netstats/neighbor.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Objective Code Point of MRHOF
+ */
+#define GNRC_RPL_MRHOF_OCP                      (1)
+
+/**
+ * @brief   Maximum ETX of a link to a parent
+ *          (see @ref NETSTATS_NB_ETX_DIVISOR)
+ *
+ * Parents with a worse link are not used.
+ */
+#ifndef GNRC_RPL_MRHOF_MAX_LINK_METRIC
+#define GNRC_RPL_MRHOF_MAX_LINK_METRIC          (512)
+#endif
+
+/**
+ * @brief   Difference in ETX needed to switch the preferred parent
+ *          (see @ref NETSTATS_NB_ETX_DIVISOR)
+ */
+#ifndef GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD
+#define GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD  (192)
+#endif
+
+/**
+ * @brief   Return the address to the MRHOF objective function
+ *
+ * @return  Address of the MRHOF objective function
+ */
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void);
+
+/**
+ * @brief   Get the ETX of the link to a parent
+ *
+ * @param[in] parent    the parent
+ *
+ * @return  ETX of the link, scaled by @ref NETSTATS_NB_ETX_DIVISOR
+ * @return  @ref NETSTATS_NB_ETX_INIT * @ref NETSTATS_NB_ETX_DIVISOR, if it
+ *          is not known yet
+ */
+uint16_t gnrc_rpl_mrhof_etx(gnrc_rpl_parent_t *parent);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_RPL_MRHOF_H */
+/** @} */
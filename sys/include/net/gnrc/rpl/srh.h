@@ -23,8 +23,14 @@
 #ifndef GNRC_RPL_SRH_H_
 #define GNRC_RPL_SRH_H_
 
+#include <stddef.h>
+
 #include "net/ipv6/hdr.h"
 #include "net/ipv6/addr.h"
+#include "kernel_types.h"
+#ifdef MODULE_FIB
+#include "net/fib.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,6 +41,28 @@ extern "C" {
  */
 #define GNRC_RPL_SRH_TYPE   (3U)
 
+/**
+ * @brief   Number of destinations to cache source routing headers for
+ */
+#ifndef GNRC_RPL_SRH_CACHE_SIZE
+#define GNRC_RPL_SRH_CACHE_SIZE     (4)
+#endif
+
+/**
+ * @brief   Maximum number of hops of a cached source route
+ *          (including the first hop and the destination)
+ */
+#ifndef GNRC_RPL_SRH_CACHE_MAX_HOPS
+#define GNRC_RPL_SRH_CACHE_MAX_HOPS (8)
+#endif
+
+/**
+ * @brief   Number of targets the DODAG root keeps source routes for
+ */
+#ifndef GNRC_RPL_SRH_ROUTES_NUMOF
+#define GNRC_RPL_SRH_ROUTES_NUMOF   (16)
+#endif
+
 /**
  * @brief   The RPL Source routing header.
  *
@@ -66,6 +94,83 @@ typedef struct __attribute__((packed)) {
  */
 int gnrc_rpl_srh_process(ipv6_hdr_t *ipv6, gnrc_rpl_srh_t *rh);
 
+/**
+ * @brief   Build a compressed RPL source routing header.
+ *
+ * The first address of @p route is the next hop and goes into the IPv6
+ * destination field, all others are put into the header. As many prefix
+ * octets as possible are elided (CmprI and CmprE), such that every node on
+ * the path can restore the addresses from its own one.
+ *
+ * @param[out] rh       Buffer for the header. gnrc_rpl_srh_t::nh is left 0.
+ * @param[in] size      Size of @p rh.
+ * @param[in] route     The hops from the next hop to the final destination.
+ * @param[in] route_len Number of addresses in @p route.
+ *
+ * @return  size of the header in @p rh, on success.
+ * @return  -EINVAL, if @p route_len is less than 2.
+ * @return  -ENOBUFS, if @p size is too small.
+ */
+int gnrc_rpl_srh_build(gnrc_rpl_srh_t *rh, size_t size, const ipv6_addr_t *route,
+                       unsigned route_len);
+
+#if defined(MODULE_FIB) || defined(DOXYGEN)
+/**
+ * @brief   Largest header for a route of @ref GNRC_RPL_SRH_CACHE_MAX_HOPS hops
+ */
+#define GNRC_RPL_SRH_CACHE_HDR_MAX  (sizeof(gnrc_rpl_srh_t) + \
+                                     ((GNRC_RPL_SRH_CACHE_MAX_HOPS - 1) * sizeof(ipv6_addr_t)))
+
+/**
+ * @brief   Update the DAO parent of a target in the root's source routes.
+ *
+ * The root keeps one source route per target in a FIB table: the DAO
+ * parent followed by the target, or only the target for children of the
+ * root. Cached headers are invalidated if the parent changes or the
+ * route is removed.
+ *
+ * @param[in] iface     Interface the target is reached over.
+ * @param[in] target    The DAO target.
+ * @param[in] parent    The DAO parent of @p target, NULL if it is a child
+ *                      of the root.
+ * @param[in] lifetime  Lifetime of the route in ms, 0 to remove it.
+ *
+ * @return  0, on success.
+ * @return  -ENOBUFS, if the source routing table is full.
+ */
+int gnrc_rpl_srh_route_update(kernel_pid_t iface, const ipv6_addr_t *target,
+                              const ipv6_addr_t *parent, uint32_t lifetime);
+
+/**
+ * @brief   Get the source routing header for a destination.
+ *
+ * The header is built by following the DAO parents from @p dst up to the
+ * root on the first request and served from a cache afterwards, until it is
+ * invalidated with gnrc_rpl_srh_cache_invalidate() or
+ * gnrc_rpl_srh_route_update().
+ *
+ * @param[in] dst           The final destination.
+ * @param[out] iface        Interface to send over.
+ * @param[out] next_hop     The first hop of the route, i.e. the IPv6 destination.
+ * @param[out] rh           Buffer for the header.
+ * @param[in] size          Size of @p rh.
+ *
+ * @return  size of the header in @p rh, on success.
+ * @return  0, if @p dst is the next hop itself and needs no header.
+ * @return  -EHOSTUNREACH, if there is no source route to @p dst.
+ * @return  -ENOBUFS, if @p size is too small or the route is too long.
+ */
+int gnrc_rpl_srh_cache_get(const ipv6_addr_t *dst, kernel_pid_t *iface, ipv6_addr_t *next_hop,
+                           gnrc_rpl_srh_t *rh, size_t size);
+
+/**
+ * @brief   Invalidate cached source routing headers.
+ *
+ * @param[in] dst   Destination to invalidate, NULL for all.
+ */
+void gnrc_rpl_srh_cache_invalidate(const ipv6_addr_t *dst);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
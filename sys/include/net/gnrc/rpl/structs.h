@@ -29,6 +29,7 @@ extern "C" {
 
 #include "net/gnrc/ipv6/netif.h"
 #include "net/ipv6/addr.h"
+#include "priority_queue.h"
 #include "xtimer.h"
 #include "trickle.h"
 
@@ -68,6 +69,27 @@ extern "C" {
 #define GNRC_RPL_REQ_DIO_OPT_PREFIX_INFO            (1 << GNRC_RPL_REQ_DIO_OPT_PREFIX_INFO_SHIFT)
 /** @} */
 
+/**
+ * @anchor GNRC_RPL_DAO_FLAGS
+ * @name DAO state flags for gnrc_rpl_dodag_t::dao_flags
+ * @{
+ */
+#define GNRC_RPL_DAO_FLAG_FULL                      (1 << 0)    /**< next DAO must advertise all
+                                                                     targets */
+#define GNRC_RPL_DAO_FLAG_FULL_SENT                 (1 << 1)    /**< last DAO advertised all
+                                                                     targets */
+/** @} */
+
+/**
+ * @name States of a gnrc_rpl_dao_target_t
+ * @{
+ */
+#define GNRC_RPL_DAO_TARGET_UNUSED                  (0)     /**< entry is unused */
+#define GNRC_RPL_DAO_TARGET_ACKED                   (1)     /**< advertised and acknowledged */
+#define GNRC_RPL_DAO_TARGET_ADD                     (2)     /**< addition not yet acknowledged */
+#define GNRC_RPL_DAO_TARGET_REMOVE                  (3)     /**< removal not yet acknowledged */
+/** @} */
+
 /**
  * @brief RPL-Option Generic Format
  * @see <a href="https://tools.ietf.org/html/rfc6550#section-6.7.1">
@@ -214,11 +236,24 @@ struct gnrc_rpl_parent {
     uint8_t dtsn;                   /**< last seen dtsn of this parent */
     uint16_t rank;                  /**< rank of the parent */
     gnrc_rpl_dodag_t *dodag;        /**< DODAG the parent belongs to */
-    uint32_t lifetime;              /**< lifetime of this parent in seconds */
+    uint32_t lifetime;              /**< point in time (seconds) at which this parent expires */
+    priority_queue_node_t lt_node;  /**< node in the RPL lifetime queue */
     double  link_metric;            /**< metric of the link */
     uint8_t link_metric_type;       /**< type of the metric */
 };
 
+/**
+ * @brief Downward route target learned from a DAO, used to generate incremental DAOs
+ */
+typedef struct {
+    gnrc_rpl_dodag_t *dodag;        /**< DODAG the target belongs to */
+    ipv6_addr_t addr;               /**< IPv6 prefix or address of the target */
+    uint8_t prefix_length;          /**< prefix length of the target */
+    uint8_t state;                  /**< state of the target (GNRC_RPL_DAO_TARGET_*) */
+    bool sent;                      /**< true, if the pending state was sent upwards */
+    uint8_t dao_seq;                /**< sequence of the DAO the pending state was sent in */
+} gnrc_rpl_dao_target_t;
+
 /**
  * @brief Objective function representation
  */
@@ -258,8 +293,17 @@ struct gnrc_rpl_dodag {
     bool dao_ack_received;          /**< flag to check for DAO-ACK */
     uint8_t dio_opts;               /**< options in the next DIO
                                          (see @ref GNRC_RPL_REQ_DIO_OPTS "DIO Options") */
-    uint8_t dao_time;               /**< time to schedule a DAO in seconds */
+    uint32_t dao_time;              /**< point in time (seconds) to handle the next DAO,
+                                         0 if none is scheduled */
+    uint32_t dao_refresh;           /**< point in time (seconds) of the next periodic full DAO,
+                                         0 if none is scheduled */
+    priority_queue_node_t lt_node;  /**< node in the RPL lifetime queue */
+    uint8_t dao_flags;              /**< DAO state flags
+                                         (see @ref GNRC_RPL_DAO_FLAGS "DAO state flags") */
     trickle_t trickle;              /**< trickle representation */
+    bool dio_opts_cached;           /**< true, if gnrc_rpl_dodag_t::dio_opts_cache is valid */
+    uint8_t dio_opts_cache[sizeof(gnrc_rpl_opt_dodag_conf_t) +
+                           sizeof(gnrc_rpl_opt_prefix_info_t)]; /**< encoded DIO options */
 };
 
 /**
@@ -273,7 +317,8 @@ struct gnrc_rpl_instance {
     gnrc_rpl_of_t *of;              /**< configured Objective Function */
     uint16_t min_hop_rank_inc;      /**< minimum hop rank increase */
     uint16_t max_rank_inc;          /**< max increase in the rank */
-    int8_t cleanup;                 /**< cleanup time in seconds */
+    uint32_t cleanup;               /**< point in time (seconds) to remove this instance if it
+                                         has no parents, 0 if no cleanup is scheduled */
 };
 
 #ifdef __cplusplus
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Header definitions for TSCH
+ *
+ * Every TSCH frame starts with a @ref gnrc_tsch_hdr_t right after the
+ * IEEE 802.15.4 MAC header. The information IEEE 802.15.4e carries in
+ * information elements is carried here, as GNRC does not build information
+ * elements. Addresses are taken from the MAC header.
+ *
+ * @author      agent <agent@local>
+ */
+#ifndef GNRC_TSCH_HDR_H
+#define GNRC_TSCH_HDR_H
+
+#include <stdint.h>
+
+#include "byteorder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   TSCH frame types
+ */
+typedef enum {
+    GNRC_TSCH_FRAMETYPE_EB = 1,         /**< enhanced beacon */
+    GNRC_TSCH_FRAMETYPE_DATA,           /**< data */
+    GNRC_TSCH_FRAMETYPE_ACK,            /**< acknowledgement */
+} gnrc_tsch_frame_type_t;
+
+/**
+ * @brief   TSCH header
+ */
+typedef struct __attribute__((packed)) {
+    uint8_t type;                   /**< type of frame, see
+                                     *   @ref gnrc_tsch_frame_type_t */
+} gnrc_tsch_hdr_t;
+
+/**
+ * @brief   Enhanced beacon
+ */
+typedef struct __attribute__((packed)) {
+    gnrc_tsch_hdr_t header;         /**< EB header */
+    uint8_t asn[5];                 /**< absolute slot number of the slot the
+                                     *   beacon is sent in, big endian */
+    uint8_t join_priority;          /**< hops of the sender to the
+                                     *   coordinator */
+} gnrc_tsch_frame_eb_t;
+
+/**
+ * @brief   Data header
+ */
+typedef struct __attribute__((packed)) {
+    gnrc_tsch_hdr_t header;         /**< data header */
+    uint8_t seq;                    /**< sequence number, unchanged for
+                                     *   retransmissions */
+} gnrc_tsch_frame_data_t;
+
+/**
+ * @brief   Acknowledgement
+ */
+typedef struct __attribute__((packed)) {
+    gnrc_tsch_hdr_t header;         /**< ACK header */
+    uint8_t seq;                    /**< sequence number of the acknowledged
+                                     *   frame */
+    network_uint16_t correction;    /**< microseconds the frame arrived after
+                                     *   the receiver expected it, two's
+                                     *   complement */
+} gnrc_tsch_frame_ack_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_TSCH_HDR_H */
+/** @} */
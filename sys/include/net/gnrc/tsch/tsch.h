@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_tsch  TSCH
+ * @ingroup     net_gnrc
+ * @brief       Time-slotted channel hopping MAC of IEEE 802.15.4e
+ *
+ * Time is divided into slots of @ref GNRC_TSCH_SLOT_LEN_US, which repeat in a
+ * slotframe of @ref GNRC_TSCH_SLOTFRAME_LEN slots. Each cell of the schedule
+ * assigns a slot and a channel offset to transmission and/or reception. The
+ * channel of a cell changes in every slotframe:
+ *
+ *     channel = hopping_sequence[(ASN + channel_offset) % sequence length]
+ *
+ * where ASN is the absolute slot number, counted since the coordinator
+ * started the network. The radio is only switched on in slots with a cell
+ * that has something to do.
+ *
+ * The schedule starts with the minimal cell of 6TiSCH (RFC 8180): slot
+ * offset 0, channel offset 0, shared between all neighbors for transmission
+ * and reception. Further cells are added with gnrc_tsch_cell_add().
+ * Packets are queued in the first TX cell dedicated to their destination,
+ * or in the minimal cell. Every cell has its own queue.
+ *
+ * The coordinator (see gnrc_tsch_coordinator()) and all joined nodes send
+ * enhanced beacons (EB) in the minimal cell every
+ * @ref GNRC_TSCH_EB_PERIOD_US. A new node listens until it receives one,
+ * takes the ASN from it and synchronizes its slot timing to the sender,
+ * which becomes its time source. Afterwards every frame from the time source
+ * and every acknowledgement by it corrects the local slot timing. Slot
+ * boundaries are kept as absolute times and every timer is set relative to
+ * them, so timer latencies do not add up over slots.
+ *
+ * Unicast frames are acknowledged in the same slot and retransmitted in the
+ * next slot of their cell, up to @ref GNRC_TSCH_MAX_RETRIES times. After a
+ * failure in a shared cell the sender skips a random number of shared
+ * slots.
+ *
+ * TSCH runs in the thread of its interface instead of the one started by
+ * gnrc_netdev2_init(). It needs a device that supports the
+ * @ref NETOPT_STATE_SLEEP state and does not do CSMA/CA itself, e.g. the
+ * virtual medium of native.
+ * @{
+ *
+ * @file
+ * @brief       Interface definition for TSCH
+ *
+ * @author      agent <agent@local>
+ */
+#ifndef GNRC_TSCH_H
+#define GNRC_TSCH_H
+
+#include "kernel_types.h"
+#include "timex.h"
+#include "net/gnrc/netdev2.h"
+#include "net/gnrc/tsch/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Length of a slot in microseconds
+ */
+#ifndef GNRC_TSCH_SLOT_LEN_US
+#define GNRC_TSCH_SLOT_LEN_US           (10U * MS_IN_USEC)
+#endif
+
+/**
+ * @brief   Number of slots in the slotframe
+ */
+#ifndef GNRC_TSCH_SLOTFRAME_LEN
+#define GNRC_TSCH_SLOTFRAME_LEN         (11U)
+#endif
+
+/**
+ * @brief   Start of the frame transmission within a slot in microseconds
+ *
+ * macTsTxOffset of IEEE 802.15.4e
+ */
+#ifndef GNRC_TSCH_TX_OFFSET_US
+#define GNRC_TSCH_TX_OFFSET_US          (2120U)
+#endif
+
+/**
+ * @brief   Time a receiver listens before and after the expected start of a
+ *          frame in microseconds
+ *
+ * Half of macTsRxWait of IEEE 802.15.4e
+ */
+#ifndef GNRC_TSCH_RX_GUARD_US
+#define GNRC_TSCH_RX_GUARD_US           (1100U)
+#endif
+
+/**
+ * @brief   Time to wait for an acknowledgement after a frame in microseconds
+ *
+ * Longer than macTsAckWait as acknowledgements are sent in software.
+ */
+#ifndef GNRC_TSCH_ACK_WAIT_US
+#define GNRC_TSCH_ACK_WAIT_US           (2000U)
+#endif
+
+/**
+ * @brief   Air time of one byte in microseconds (2.4 GHz O-QPSK PHY)
+ */
+#ifndef GNRC_TSCH_BYTE_US
+#define GNRC_TSCH_BYTE_US               (32U)
+#endif
+
+/**
+ * @brief   Channels the cells hop over
+ *
+ * The default is the 2.4 GHz sequence of IEEE 802.15.4e.
+ */
+#ifndef GNRC_TSCH_HOPPING_SEQUENCE
+#define GNRC_TSCH_HOPPING_SEQUENCE      { 16, 17, 23, 18, 26, 15, 25, 22, \
+                                          19, 11, 12, 13, 24, 14, 20, 21 }
+#endif
+
+/**
+ * @brief   Average time between two enhanced beacons in microseconds
+ */
+#ifndef GNRC_TSCH_EB_PERIOD_US
+#define GNRC_TSCH_EB_PERIOD_US          (2U * SEC_IN_USEC)
+#endif
+
+/**
+ * @brief   Time without synchronization after which a node leaves the
+ *          network and scans again in microseconds
+ */
+#ifndef GNRC_TSCH_DESYNC_TIMEOUT_US
+#define GNRC_TSCH_DESYNC_TIMEOUT_US     (16U * SEC_IN_USEC)
+#endif
+
+/**
+ * @brief   Maximum number of retransmissions of a unicast frame
+ */
+#ifndef GNRC_TSCH_MAX_RETRIES
+#define GNRC_TSCH_MAX_RETRIES           (3U)
+#endif
+
+/**
+ * @brief   Maximum backoff exponent in shared cells
+ */
+#ifndef GNRC_TSCH_MAX_BE
+#define GNRC_TSCH_MAX_BE                (5U)
+#endif
+
+/**
+ * @brief   Message queue size of the TSCH thread
+ */
+#ifndef GNRC_TSCH_MSG_QUEUE_SIZE
+#define GNRC_TSCH_MSG_QUEUE_SIZE        (8U)
+#endif
+
+/**
+ * @brief   Starts the TSCH thread of an interface
+ *
+ * Use instead of gnrc_netdev2_init(). The interface scans for a network
+ * until gnrc_tsch_coordinator() is called.
+ *
+ * @param[in] stack         stack for the thread
+ * @param[in] stacksize     size of @p stack
+ * @param[in] priority      priority of the thread
+ * @param[in] name          name of the thread
+ * @param[in] gnrc_netdev2  the interface, set up by e.g.
+ *                          gnrc_netdev2_ieee802154_init()
+ *
+ * @return  PID of the thread
+ * @return  -ENODEV, if @p gnrc_netdev2 has no device
+ * @return  -EINVAL, if the thread could not be created
+ */
+kernel_pid_t gnrc_tsch_init(char *stack, int stacksize, char priority,
+                            const char *name, gnrc_netdev2_t *gnrc_netdev2);
+
+/**
+ * @brief   Starts a new network with the interface as coordinator
+ *
+ * @param[in] pid       PID of the TSCH thread
+ *
+ * @return  0 on success
+ */
+int gnrc_tsch_coordinator(kernel_pid_t pid);
+
+/**
+ * @brief   Adds a cell to the slotframe
+ *
+ * @param[in] pid       PID of the TSCH thread
+ * @param[in] cell      the cell
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if @p cell has no options or an invalid slot offset
+ * @return  -EEXIST, if the slotframe has a cell with the same slot and
+ *          channel offset
+ * @return  -ENOSPC, if the slotframe is full
+ */
+int gnrc_tsch_cell_add(kernel_pid_t pid, const gnrc_tsch_cell_t *cell);
+
+/**
+ * @brief   Removes a cell from the slotframe
+ *
+ * Packets queued in the cell are moved to the cell they would be queued in
+ * now. The minimal cell can not be removed.
+ *
+ * @param[in] pid       PID of the TSCH thread
+ * @param[in] cell      cell with the slot and channel offset to remove
+ *
+ * @return  0 on success
+ * @return  -ENOENT, if there is no such cell
+ */
+int gnrc_tsch_cell_remove(kernel_pid_t pid, const gnrc_tsch_cell_t *cell);
+
+/**
+ * @brief   Gets the status of an interface
+ *
+ * @param[in] pid       PID of the TSCH thread
+ * @param[out] status   the status
+ *
+ * @return  0 on success
+ */
+int gnrc_tsch_status(kernel_pid_t pid, gnrc_tsch_status_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_TSCH_H */
+/** @} */
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tsch
+ * @{
+ *
+ * @file
+ * @brief       Data types of TSCH
+ *
+ * @author      agent <agent@local>
+ */
+#ifndef GNRC_TSCH_TYPES_H
+#define GNRC_TSCH_TYPES_H
+
+#include <stdint.h>
+
+#include "msg.h"
+#include "net/gnrc/priority_pktqueue.h"
+#include "net/ieee802154.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    Message types of the TSCH thread
+ * @{
+ */
+#define GNRC_TSCH_MSG_TYPE_TIMER        (0x1238)    /**< slot timer */
+#define GNRC_TSCH_MSG_TYPE_COORDINATOR  (0x1239)    /**< start a network */
+#define GNRC_TSCH_MSG_TYPE_CELL_ADD     (0x123a)    /**< add a cell */
+#define GNRC_TSCH_MSG_TYPE_CELL_REMOVE  (0x123b)    /**< remove a cell */
+#define GNRC_TSCH_MSG_TYPE_STATUS       (0x123c)    /**< get the status */
+/** @} */
+
+/**
+ * @brief   Maximum number of cells in the slotframe, including the minimal
+ *          cell
+ */
+#ifndef GNRC_TSCH_CELLS_NUMOF
+#define GNRC_TSCH_CELLS_NUMOF           (8U)
+#endif
+
+/**
+ * @brief   Number of packets that can be queued in all cells together
+ */
+#ifndef GNRC_TSCH_TX_QUEUE_SIZE
+#define GNRC_TSCH_TX_QUEUE_SIZE         (8U)
+#endif
+
+/**
+ * @brief   Number of neighbors remembered to drop retransmitted frames
+ */
+#ifndef GNRC_TSCH_SEEN_NUMOF
+#define GNRC_TSCH_SEEN_NUMOF            (4U)
+#endif
+
+/**
+ * @name    Cell options
+ * @{
+ */
+#define GNRC_TSCH_CELL_TX               (0x01)  /**< transmit in the cell */
+#define GNRC_TSCH_CELL_RX               (0x02)  /**< receive in the cell */
+#define GNRC_TSCH_CELL_SHARED           (0x04)  /**< cell is contended, back
+                                                 *   off after failures */
+#define GNRC_TSCH_CELL_TIMEKEEPING      (0x08)  /**< synchronize to the time
+                                                 *   source in the cell */
+/** @} */
+
+/**
+ * @brief   Roles of a node
+ */
+typedef enum {
+    GNRC_TSCH_SCANNING = 0,             /**< waiting for an enhanced beacon */
+    GNRC_TSCH_JOINED,                   /**< synchronized to a time source */
+    GNRC_TSCH_COORDINATOR,              /**< started the network */
+} gnrc_tsch_role_t;
+
+/**
+ * @brief   A cell of the slotframe
+ */
+typedef struct {
+    uint16_t slot_offset;               /**< slot in the slotframe */
+    uint8_t channel_offset;             /**< offset in the hopping sequence */
+    uint8_t options;                    /**< GNRC_TSCH_CELL_* flags,
+                                         *   0 for an unused entry */
+    uint8_t addr[IEEE802154_LONG_ADDRESS_LEN];  /**< neighbor of the cell */
+    uint8_t addr_len;                   /**< length of gnrc_tsch_cell_t::addr,
+                                         *   0 for any neighbor */
+} gnrc_tsch_cell_t;
+
+/**
+ * @brief   Status of a TSCH interface
+ */
+typedef struct {
+    uint64_t asn;                       /**< absolute slot number */
+    uint8_t role;                       /**< see @ref gnrc_tsch_role_t */
+    uint8_t join_priority;              /**< hops to the coordinator */
+    uint8_t time_source[IEEE802154_LONG_ADDRESS_LEN];
+                                        /**< neighbor synchronized to */
+    uint8_t time_source_len;            /**< length of
+                                         *   gnrc_tsch_status_t::time_source */
+    uint8_t queued;                     /**< packets in all cell queues */
+    uint8_t cells;                      /**< cells in the slotframe */
+} gnrc_tsch_status_t;
+
+/**
+ * @brief   A cell with its TX queue
+ * @internal
+ */
+typedef struct {
+    gnrc_tsch_cell_t cell;              /**< the cell */
+    gnrc_priority_pktqueue_t queue;     /**< packets sent in this cell */
+    uint8_t backoff_exp;                /**< backoff exponent of shared cells */
+    uint8_t backoff;                    /**< shared cells left to skip */
+    uint8_t retries;                    /**< failed attempts of the head of
+                                         *   gnrc_tsch_cell_entry_t::queue */
+} gnrc_tsch_cell_entry_t;
+
+/**
+ * @brief   Last frame received from a neighbor
+ * @internal
+ */
+typedef struct {
+    uint8_t addr[IEEE802154_LONG_ADDRESS_LEN];  /**< neighbor */
+    uint8_t addr_len;                   /**< length of gnrc_tsch_seen_t::addr */
+    uint8_t seq;                        /**< sequence number */
+} gnrc_tsch_seen_t;
+
+/**
+ * @brief   TSCH state of an interface
+ * @internal
+ */
+typedef struct {
+    gnrc_tsch_cell_entry_t cells[GNRC_TSCH_CELLS_NUMOF];    /**< slotframe */
+    gnrc_priority_pktqueue_node_t _queue_nodes[GNRC_TSCH_TX_QUEUE_SIZE];
+                                        /**< nodes of the cell queues */
+    gnrc_tsch_seen_t seen[GNRC_TSCH_SEEN_NUMOF];    /**< for duplicate
+                                                     *   detection */
+    xtimer_t timer;                     /**< slot timer */
+    msg_t timer_msg;                    /**< message of gnrc_tsch_t::timer */
+    uint64_t asn;                       /**< absolute slot number of the
+                                         *   current slot */
+    uint32_t slot_start;                /**< start of the current slot */
+    uint32_t last_sync;                 /**< time of the last
+                                         *   synchronization */
+    uint32_t next_eb;                   /**< time the next enhanced beacon is
+                                         *   due */
+    gnrc_tsch_cell_entry_t *cell;       /**< cell of the current slot */
+    uint16_t timer_gen;                 /**< identifies the last armed timer
+                                         *   to ignore stale messages */
+    uint8_t role;                       /**< see @ref gnrc_tsch_role_t */
+    uint8_t state;                      /**< state within the current slot */
+    uint8_t radio_on;                   /**< radio is listening */
+    uint8_t join_priority;              /**< hops to the coordinator */
+    uint8_t time_source[IEEE802154_LONG_ADDRESS_LEN];   /**< neighbor
+                                                         *   synchronized to */
+    uint8_t time_source_len;            /**< length of
+                                         *   gnrc_tsch_t::time_source */
+    uint8_t seq;                        /**< next data sequence number */
+    uint8_t tx_seq;                     /**< sequence number of the frame
+                                         *   waiting for its ACK */
+    uint8_t tx_len;                     /**< length of the frame sent in the
+                                         *   current slot */
+    uint8_t seen_next;                  /**< next entry to overwrite in
+                                         *   gnrc_tsch_t::seen */
+} gnrc_tsch_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GNRC_TSCH_TYPES_H */
+/** @} */
@@ -222,6 +222,26 @@ int ieee802154_get_src(const uint8_t *mhr, uint8_t *src, le_uint16_t *src_pan);
  */
 int ieee802154_get_dst(const uint8_t *mhr, uint8_t *dst, le_uint16_t *dst_pan);
 
+/**
+ * @brief   Checks if a frame is addressed to a device.
+ *
+ * Accepts frames to the broadcast address, @p short_addr or @p long_addr
+ * within PAN @p pan or the broadcast PAN. Of the frames without destination
+ * address, only beacons and acknowledgements are accepted.
+ *
+ * @param[in] mhr           MAC header.
+ * @param[in] pan           PAN ID of the device in host byte order.
+ * @param[in] short_addr    Short address of the device in network byte
+ *                          order.
+ * @param[in] long_addr     Long address of the device in network byte order.
+ *
+ * @return  0, if the frame is addressed to the device.
+ * @return  1, if the frame is addressed to another device.
+ * @return  -EINVAL, if @p mhr contains unexpected flags.
+ */
+int ieee802154_dst_filter(const uint8_t *mhr, uint16_t pan,
+                          const uint8_t *short_addr, const uint8_t *long_addr);
+
 /**
  * @brief   Gets sequence number from MAC header.
  *
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_netstats_neighbor Per-neighbor link statistics
+ * @ingroup     net_netstats
+ * @brief       Link-quality estimation (ETX) per neighbor
+ *
+ * The link layer records the destination of each unicast frame before it
+ * is handed to the device (@ref netstats_nb_record()) and reports the
+ * outcome signalled by the device (@ref netstats_nb_update_tx()). From
+ * these samples an exponentially weighted moving average of the expected
+ * transmission count (ETX) is kept for every neighbor, which routing
+ * protocols can query with @ref netstats_nb_get_etx().
+ *
+ * ETX values are fixed point numbers with @ref NETSTATS_NB_ETX_DIVISOR
+ * representing an ETX of 1.
+ * @{
+ *
+ * @file
+ * @brief       Definitions for per-neighbor link statistics
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef NETSTATS_NEIGHBOR_H
+#define NETSTATS_NEIGHBOR_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of neighbors to keep statistics for
+ */
+#ifndef NETSTATS_NB_SIZE
+#define NETSTATS_NB_SIZE            (8)
+#endif
+
+/**
+ * @brief   Maximum length of a link-layer address
+ */
+#define NETSTATS_NB_L2ADDR_MAX_LEN  (8)
+
+/**
+ * @brief   Fixed point representation of an ETX of 1
+ */
+#define NETSTATS_NB_ETX_DIVISOR     (128)
+
+/**
+ * @brief   ETX assumed for a neighbor without any samples (in ETX units)
+ */
+#ifndef NETSTATS_NB_ETX_INIT
+#define NETSTATS_NB_ETX_INIT        (2)
+#endif
+
+/**
+ * @brief   ETX sample for a frame that was not delivered (in ETX units)
+ *
+ * The device already retried the transmission, so a failure weighs
+ * more than a single additional attempt.
+ */
+#ifndef NETSTATS_NB_ETX_FAILED
+#define NETSTATS_NB_ETX_FAILED      (8)
+#endif
+
+/**
+ * @brief   Weight of the old ETX value in the moving average (in percent)
+ */
+#ifndef NETSTATS_NB_EWMA_ALPHA
+#define NETSTATS_NB_EWMA_ALPHA      (90)
+#endif
+
+/**
+ * @brief   Outcome of a transmission as signalled by the device
+ */
+typedef enum {
+    NETSTATS_NB_SUCCESS,        /**< frame was sent (and acknowledged) */
+    NETSTATS_NB_NOACK,          /**< no acknowledgement was received */
+    NETSTATS_NB_BUSY,           /**< medium was busy, frame was not sent */
+} netstats_nb_result_t;
+
+/**
+ * @brief   Statistics of a single neighbor
+ */
+typedef struct {
+    uint8_t l2_addr[NETSTATS_NB_L2ADDR_MAX_LEN];    /**< link-layer address */
+    uint8_t l2_addr_len;        /**< length of netstats_nb_t::l2_addr, 0 if unused */
+    kernel_pid_t iface;         /**< interface the neighbor was seen on */
+    uint16_t etx;               /**< ETX (see @ref NETSTATS_NB_ETX_DIVISOR) */
+    uint16_t tx_count;          /**< number of transmissions to this neighbor */
+    uint16_t tx_failed;         /**< number of failed transmissions (no ACK) */
+    uint16_t tx_busy;           /**< number of transmissions aborted on a busy medium */
+    uint16_t last_used;         /**< age stamp to replace the least recently used entry */
+    uint16_t gen;               /**< changes whenever the entry is reused */
+} netstats_nb_t;
+
+/**
+ * @brief   Reference to the entry of the neighbor a frame was sent to
+ *
+ * The entry may be reused for another neighbor before the outcome of the
+ * transmission is known, netstats_nb_ref_t::gen detects that.
+ */
+typedef struct {
+    netstats_nb_t *nb;          /**< entry of the neighbor, NULL if none */
+    uint16_t gen;               /**< netstats_nb_t::gen when it was recorded */
+} netstats_nb_ref_t;
+
+/**
+ * @brief   Records the destination of a unicast frame about to be sent
+ *
+ * An entry for the neighbor is created if it does not exist yet, replacing
+ * the least recently used entry if necessary.
+ *
+ * @param[in] iface         interface the frame is sent on
+ * @param[in] l2_addr       link-layer destination address
+ * @param[in] l2_addr_len   length of @p l2_addr
+ *
+ * @return  reference to the entry of the neighbor, to be passed to
+ *          netstats_nb_update_tx()
+ * @return  a reference to NULL, if @p l2_addr_len is invalid
+ */
+netstats_nb_ref_t netstats_nb_record(kernel_pid_t iface, const uint8_t *l2_addr,
+                                     uint8_t l2_addr_len);
+
+/**
+ * @brief   Updates the ETX of a neighbor with the outcome of a transmission
+ *
+ * A busy medium is only counted, it does not change the ETX as it tells
+ * nothing about the link to the neighbor. The outcome is ignored if the
+ * entry was reused for another neighbor in the meantime.
+ *
+ * @param[in] ref       reference returned by netstats_nb_record()
+ * @param[in] result    outcome of the transmission
+ */
+void netstats_nb_update_tx(const netstats_nb_ref_t *ref, netstats_nb_result_t result);
+
+/**
+ * @brief   Gets the ETX of a neighbor
+ *
+ * @param[in] iface         interface the neighbor is reachable on
+ * @param[in] l2_addr       link-layer address of the neighbor
+ * @param[in] l2_addr_len   length of @p l2_addr
+ *
+ * @return  ETX of the neighbor (see @ref NETSTATS_NB_ETX_DIVISOR)
+ * @return  0, if there are no statistics for the neighbor
+ */
+uint16_t netstats_nb_get_etx(kernel_pid_t iface, const uint8_t *l2_addr,
+                             uint8_t l2_addr_len);
+
+/**
+ * @brief   Copies the statistics of all known neighbors
+ *
+ * @param[out] nbs  array of at least @ref NETSTATS_NB_SIZE entries
+ *
+ * @return  number of entries copied to @p nbs
+ */
+unsigned netstats_nb_get_all(netstats_nb_t *nbs);
+
+/**
+ * @brief   Removes all neighbor statistics
+ */
+void netstats_nb_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETSTATS_NEIGHBOR_H */
+/** @} */
@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_phydat_dsp Phydat DSP
+ * @ingroup     sys_phydat
+ * @brief       Fixed-point filters and conversions for arrays of phydat_t
+ *
+ * The filters work on the first `dim` dimensions of arrays of @ref phydat_t,
+ * in place and in blocks of any length. They keep their state between calls,
+ * so a stream of samples can be filtered as it arrives, e.g. every batch of
+ * the @ref sys_saul_sampler "SAUL sampler". Filters use the raw values and
+ * keep the unit and scale, so all samples of a stream have to use the same
+ * scale (see phydat_dsp_rescale()).
+ *
+ * Coefficients are Q15 and laid out as for CMSIS-DSP. On Cortex-M the FIR
+ * and IIR filters use the q15 kernels of the `cmsis-dsp` package (module
+ * `phydat_dsp_cmsis`, selected automatically), elsewhere portable C code
+ * with the same results.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Phydat DSP interface definition
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef PHYDAT_DSP_H
+#define PHYDAT_DSP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "phydat.h"
+
+#ifdef MODULE_PHYDAT_DSP_CMSIS
+#include "arm_math.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of samples the CMSIS-DSP kernels process per call
+ *
+ * Larger blocks are faster but need more stack and FIR state.
+ */
+#ifndef PHYDAT_DSP_BLOCK_LEN
+#define PHYDAT_DSP_BLOCK_LEN        (16U)
+#endif
+
+/**
+ * @brief   Length of the FIR state per dimension
+ *
+ * @param[in] taps  number of coefficients
+ */
+#ifdef MODULE_PHYDAT_DSP_CMSIS
+#define PHYDAT_DSP_FIR_STATE_LEN(taps)  ((taps) + PHYDAT_DSP_BLOCK_LEN - 1)
+#else
+#define PHYDAT_DSP_FIR_STATE_LEN(taps)  (taps)
+#endif
+
+/**
+ * @brief   Length of the IIR state per dimension
+ *
+ * @param[in] stages    number of biquad stages
+ */
+#define PHYDAT_DSP_IIR_STATE_LEN(stages)    (4 * (stages))
+
+/**
+ * @brief   Moving average
+ */
+typedef struct {
+    int16_t *hist;                  /**< last samples, len * dim */
+    int32_t sum[PHYDAT_DIM];        /**< sum of phydat_dsp_mavg_t::hist */
+    uint16_t len;                   /**< window length */
+    uint16_t pos;                   /**< oldest sample in the window */
+    uint16_t fill;                  /**< samples in the window */
+    uint8_t dim;                    /**< dimensions to filter */
+} phydat_dsp_mavg_t;
+
+/**
+ * @brief   FIR filter
+ */
+typedef struct {
+#ifdef MODULE_PHYDAT_DSP_CMSIS
+    arm_fir_instance_q15 inst[PHYDAT_DIM];  /**< one filter per dimension */
+#else
+    const int16_t *coeffs;          /**< coefficients, time reversed */
+    int16_t *state;                 /**< last samples, taps * dim */
+    uint16_t taps;                  /**< number of coefficients */
+    uint16_t pos;                   /**< newest sample in
+                                     *   phydat_dsp_fir_t::state */
+#endif
+    uint8_t dim;                    /**< dimensions to filter */
+} phydat_dsp_fir_t;
+
+/**
+ * @brief   IIR filter, a cascade of biquads in direct form I
+ */
+typedef struct {
+#ifdef MODULE_PHYDAT_DSP_CMSIS
+    arm_biquad_casd_df1_inst_q15 inst[PHYDAT_DIM];  /**< one filter per
+                                                     *   dimension */
+#else
+    const int16_t *coeffs;          /**< coefficients, 6 per stage */
+    int16_t *state;                 /**< x[n-1], x[n-2], y[n-1], y[n-2] per
+                                     *   stage and dimension */
+    uint8_t stages;                 /**< number of biquads */
+    int8_t post_shift;              /**< left shift of the accumulator */
+#endif
+    uint8_t dim;                    /**< dimensions to filter */
+} phydat_dsp_iir_t;
+
+/**
+ * @brief   Decimator
+ */
+typedef struct {
+    int32_t sum[PHYDAT_DIM];        /**< sum of the current group */
+    uint16_t factor;                /**< input samples per output sample */
+    uint16_t count;                 /**< samples in the current group */
+    uint8_t dim;                    /**< dimensions to decimate */
+} phydat_dsp_decim_t;
+
+/**
+ * @brief   Initializes a moving average
+ *
+ * @param[out] f        the filter
+ * @param[in] hist      memory for the window, @p len * @p dim values
+ * @param[in] len       window length
+ * @param[in] dim       dimensions to filter
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if @p len is 0 or @p dim is invalid
+ */
+int phydat_dsp_mavg_init(phydat_dsp_mavg_t *f, int16_t *hist, uint16_t len,
+                         uint8_t dim);
+
+/**
+ * @brief   Replaces samples by the average of the last samples
+ *
+ * Until the window is full, the average of the samples so far is used.
+ *
+ * @param[in,out] f     the filter
+ * @param[in,out] data  samples
+ * @param[in] n         number of samples in @p data
+ */
+void phydat_dsp_mavg(phydat_dsp_mavg_t *f, phydat_t *data, size_t n);
+
+/**
+ * @brief   Initializes a FIR filter
+ *
+ * The output is
+ *
+ *     y[n] = sum(b[k] * x[n - k]) >> 15
+ *
+ * saturated to 16 bit.
+ *
+ * @param[out] f        the filter
+ * @param[in] coeffs    Q15 coefficients in time reversed order,
+ *                      {b[taps - 1], ..., b[1], b[0]}
+ * @param[in] taps      number of coefficients, even and at least 4;
+ *                      pad odd filters with a zero
+ * @param[in] state     memory for the state,
+ *                      PHYDAT_DSP_FIR_STATE_LEN(@p taps) * @p dim values
+ * @param[in] dim       dimensions to filter
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if @p taps or @p dim is invalid
+ */
+int phydat_dsp_fir_init(phydat_dsp_fir_t *f, const int16_t *coeffs,
+                        uint16_t taps, int16_t *state, uint8_t dim);
+
+/**
+ * @brief   Filters samples with a FIR filter
+ *
+ * @param[in,out] f     the filter
+ * @param[in,out] data  samples
+ * @param[in] n         number of samples in @p data
+ */
+void phydat_dsp_fir(phydat_dsp_fir_t *f, phydat_t *data, size_t n);
+
+/**
+ * @brief   Initializes an IIR filter
+ *
+ * The output of every stage is
+ *
+ *     y[n] = (b0 * x[n] + b1 * x[n-1] + b2 * x[n-2]
+ *             + a1 * y[n-1] + a2 * y[n-2]) >> (15 - post_shift)
+ *
+ * saturated to 16 bit. Note the sign of a1 and a2: they are the negated
+ * feedback coefficients of e.g. MATLAB.
+ *
+ * @param[out] f            the filter
+ * @param[in] coeffs        Q15 coefficients, {b0, 0, b1, b2, a1, a2} per
+ *                          stage
+ * @param[in] stages        number of stages
+ * @param[in] post_shift    shift for coefficients scaled by
+ *                          2^-@p post_shift to fit into Q15
+ * @param[in] state         memory for the state,
+ *                          PHYDAT_DSP_IIR_STATE_LEN(@p stages) * @p dim
+ *                          values
+ * @param[in] dim           dimensions to filter
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if @p stages, @p post_shift or @p dim is invalid
+ */
+int phydat_dsp_iir_init(phydat_dsp_iir_t *f, const int16_t *coeffs,
+                        uint8_t stages, int8_t post_shift, int16_t *state,
+                        uint8_t dim);
+
+/**
+ * @brief   Filters samples with an IIR filter
+ *
+ * @param[in,out] f     the filter
+ * @param[in,out] data  samples
+ * @param[in] n         number of samples in @p data
+ */
+void phydat_dsp_iir(phydat_dsp_iir_t *f, phydat_t *data, size_t n);
+
+/**
+ * @brief   Initializes a decimator
+ *
+ * @param[out] d        the decimator
+ * @param[in] factor    input samples per output sample
+ * @param[in] dim       dimensions to decimate
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if @p factor is 0 or @p dim is invalid
+ */
+int phydat_dsp_decim_init(phydat_dsp_decim_t *d, uint16_t factor,
+                          uint8_t dim);
+
+/**
+ * @brief   Replaces every group of samples by their average
+ *
+ * Averaging suppresses aliasing of signals above the new sample rate; run
+ * a FIR filter before for a steeper cut-off. Groups may span calls.
+ *
+ * @param[in,out] d     the decimator
+ * @param[in,out] data  samples, the output is written to the front
+ * @param[in] n         number of samples in @p data
+ *
+ * @return  number of output samples in @p data
+ */
+size_t phydat_dsp_decimate(phydat_dsp_decim_t *d, phydat_t *data, size_t n);
+
+/**
+ * @brief   Brings samples to the same scale
+ *
+ * Values are rounded, or saturated if they do not fit.
+ *
+ * @param[in,out] data  samples
+ * @param[in] n         number of samples in @p data
+ * @param[in] dim       dimensions to convert
+ * @param[in] scale     new scale
+ */
+void phydat_dsp_rescale(phydat_t *data, size_t n, uint8_t dim, int8_t scale);
+
+/**
+ * @brief   Converts samples to another unit
+ *
+ * Supported are conversions between the temperature units, between bar and
+ * pascal, and between percent, per mill and ppm. The scale of every sample
+ * is kept unless the result does not fit, or is changed with the unit for
+ * conversions by powers of ten.
+ *
+ * @param[in,out] data  samples, all with the same unit
+ * @param[in] n         number of samples in @p data
+ * @param[in] dim       dimensions to convert
+ * @param[in] unit      new unit
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if the samples have different units
+ * @return  -ENOTSUP, if there is no conversion to @p unit
+ * @return  -ERANGE, if the scale of a sample is out of range; samples before
+ *          it are converted
+ */
+int phydat_dsp_convert(phydat_t *data, size_t n, uint8_t dim, uint8_t unit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PHYDAT_DSP_H */
+/** @} */
@@ -24,6 +24,11 @@
  *
  * In order to use this module, you'll need to implement pm_set().
  *
+ * With the pm_tickless module, the idle thread also takes the next xtimer
+ * deadline into account: a mode is only used if its wake-up latency (see
+ * @ref PM_WAKEUP_LATENCY_US) fits before the next timer is due, and xtimer
+ * is told to wake up early by that latency, so timers still fire on time.
+ *
  * @file
  * @brief       Layered low power mode infrastructure
  *
@@ -41,6 +46,17 @@
  extern "C" {
 #endif
 
+#if defined(DOXYGEN) || !defined(PM_WAKEUP_LATENCY_US)
+/**
+ * @brief   Wake-up latency of each power mode in microseconds
+ *
+ * Array initializer with PM_NUM_MODES entries, starting with mode 0. Only
+ * used by the pm_tickless module. Supposed to be defined in periph_cpu.h,
+ * the default assumes instant wake-up from all modes.
+ */
+#define PM_WAKEUP_LATENCY_US    { 0 }
+#endif
+
 /**
  * @brief   Block a power mode
  *
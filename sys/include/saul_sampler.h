@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_saul_sampler SAUL sampler
+ * @ingroup     sys
+ * @brief       Periodic sampling of SAUL devices into batches
+ *
+ * The sampler reads registered SAUL devices periodically from a single
+ * thread. Each schedule (@ref saul_sampler_entry_t) names a device, its
+ * sampling period and a ring buffer for the timestamped samples. Once a
+ * schedule has buffered @ref saul_sampler_entry_t::batch samples, its
+ * callback is called and the consumer takes the samples out with
+ * saul_sampler_read(), e.g. to send them in a single CoAP message. If the
+ * consumer does not keep up, the oldest samples are overwritten.
+ *
+ * All schedules that are due within @ref SAUL_SAMPLER_COALESCE_US of each
+ * other are read in one wake-up of the thread. Schedules with the same
+ * @ref saul_sampler_entry_t::bus are read back-to-back, so a bus (and the
+ * devices on it) is only busy once per wake-up.
+ *
+ * Example:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * static void _batch_ready(saul_sampler_entry_t *entry, void *arg)
+ * {
+ *     saul_sampler_sample_t samples[4];
+ *     unsigned n = saul_sampler_read(entry, samples, 4);
+ *     ...
+ * }
+ *
+ * static saul_sampler_sample_t _buf[8];
+ * static saul_sampler_entry_t _temp = {
+ *     .period = 1 * SEC_IN_USEC, .bus = 0,
+ *     .buf = _buf, .size = 8, .batch = 4, .cb = _batch_ready,
+ * };
+ *
+ * saul_sampler_init();
+ * _temp.dev = saul_reg_find_type(SAUL_SENSE_TEMP);
+ * saul_sampler_add(&_temp);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @{
+ *
+ * @file
+ * @brief       SAUL sampler interface definition
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef SAUL_SAMPLER_H
+#define SAUL_SAMPLER_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "phydat.h"
+#include "saul_reg.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Stack size of the sampler thread
+ */
+#ifndef SAUL_SAMPLER_STACKSIZE
+#define SAUL_SAMPLER_STACKSIZE      (THREAD_STACKSIZE_DEFAULT)
+#endif
+
+/**
+ * @brief   Priority of the sampler thread
+ */
+#ifndef SAUL_SAMPLER_PRIO
+#define SAUL_SAMPLER_PRIO           (THREAD_PRIORITY_MAIN - 1)
+#endif
+
+/**
+ * @brief   Schedules due within this many microseconds are read in the same
+ *          wake-up
+ */
+#ifndef SAUL_SAMPLER_COALESCE_US
+#define SAUL_SAMPLER_COALESCE_US    (1000U)
+#endif
+
+/**
+ * @brief   Bus identifier for devices that do not share a bus
+ */
+#define SAUL_SAMPLER_BUS_NONE       (0xff)
+
+/**
+ * @brief   A timestamped sample
+ */
+typedef struct {
+    uint32_t time;              /**< time of the read in microseconds, see
+                                 *   xtimer_now_usec() */
+    phydat_t data;              /**< the data read */
+} saul_sampler_sample_t;
+
+/**
+ * @brief   Schedule forward declaration
+ */
+typedef struct saul_sampler_entry saul_sampler_entry_t;
+
+/**
+ * @brief   Called in the sampler thread when a batch is ready
+ *
+ * @param[in] entry     the schedule
+ * @param[in] arg       saul_sampler_entry_t::arg
+ */
+typedef void (*saul_sampler_cb_t)(saul_sampler_entry_t *entry, void *arg);
+
+/**
+ * @brief   A sampling schedule
+ *
+ * All fields up to saul_sampler_entry_t::arg are set by the user before
+ * saul_sampler_add(), the others are maintained by the sampler.
+ */
+struct saul_sampler_entry {
+    saul_sampler_entry_t *next;     /**< next schedule, sorted by bus */
+    saul_reg_t *dev;                /**< device to read from */
+    uint32_t period;                /**< sampling period in microseconds */
+    saul_sampler_sample_t *buf;     /**< ring buffer for the samples */
+    uint16_t size;                  /**< capacity of
+                                     *   saul_sampler_entry_t::buf */
+    uint16_t batch;                 /**< samples per call of
+                                     *   saul_sampler_entry_t::cb */
+    uint8_t bus;                    /**< bus the device is attached to, or
+                                     *   @ref SAUL_SAMPLER_BUS_NONE */
+    saul_sampler_cb_t cb;           /**< batch callback, may be NULL */
+    void *arg;                      /**< argument for
+                                     *   saul_sampler_entry_t::cb */
+    uint32_t next_due;              /**< time of the next read */
+    uint16_t start;                 /**< oldest sample in
+                                     *   saul_sampler_entry_t::buf */
+    uint16_t avail;                 /**< samples in
+                                     *   saul_sampler_entry_t::buf */
+    uint16_t pending;               /**< samples since the last callback */
+    uint16_t lost;                  /**< samples overwritten or failed
+                                     *   reads since saul_sampler_add() */
+    uint8_t dim;                    /**< dimensions of the device */
+};
+
+/**
+ * @brief   Starts the sampler thread
+ *
+ * Calling it more than once has no effect.
+ *
+ * @return  PID of the sampler thread
+ * @return  KERNEL_PID_UNDEF, if the thread could not be started
+ */
+kernel_pid_t saul_sampler_init(void);
+
+/**
+ * @brief   Adds a schedule
+ *
+ * The first sample is taken after one period. A schedule with the same
+ * period as one that was added before is read in the same wake-ups as that
+ * one.
+ *
+ * May be called from the callback of a schedule. Callbacks must not remove
+ * other schedules than their own.
+ *
+ * @param[in] entry     schedule, must stay valid until
+ *                      saul_sampler_remove()
+ *
+ * @return  0 on success
+ * @return  -EINVAL, if @p entry has no device, period or buffer, or if its
+ *          batch is larger than its buffer
+ * @return  -EALREADY, if @p entry was added before
+ * @return  -ENODEV, if the sampler is not running
+ */
+int saul_sampler_add(saul_sampler_entry_t *entry);
+
+/**
+ * @brief   Removes a schedule
+ *
+ * After return the schedule is not read from anymore and its callback will
+ * not be called; samples left in its buffer can still be read.
+ *
+ * @param[in] entry     schedule to remove
+ *
+ * @return  0 on success
+ * @return  -ENOENT, if @p entry was not added
+ * @return  -ENODEV, if the sampler is not running
+ */
+int saul_sampler_remove(saul_sampler_entry_t *entry);
+
+/**
+ * @brief   Takes the oldest samples out of the buffer of a schedule
+ *
+ * Can be called from any thread.
+ *
+ * @param[in] entry     the schedule
+ * @param[out] samples  the samples, oldest first
+ * @param[in] max       maximum number of samples to take
+ *
+ * @return  number of samples written to @p samples
+ */
+unsigned saul_sampler_read(saul_sampler_entry_t *entry,
+                           saul_sampler_sample_t *samples, unsigned max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SAUL_SAMPLER_H */
+/** @} */
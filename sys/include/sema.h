@@ -22,6 +22,7 @@
 #ifndef SEM_H_
 #define SEM_H_
 
+#include "atomic.h"
 #include "msg.h"
 #include "priority_queue.h"
 #include "timex.h"
@@ -37,13 +38,13 @@ extern "C" {
  *
  * @return  Statically initialized semaphore.
  */
-#define SEMA_CREATE(value)      { (value), PRIORITY_QUEUE_INIT }
+#define SEMA_CREATE(value)      { ATOMIC_INIT(value), PRIORITY_QUEUE_INIT }
 
 /**
  * @brief A Semaphore.
  */
 typedef struct {
-    volatile unsigned int value;    /**< value of the semaphore */
+    atomic_int_t value;             /**< value of the semaphore */
     priority_queue_t queue;         /**< list of threads waiting for the semaphore */
 } sema_t;
 
@@ -58,7 +59,7 @@ typedef struct {
  * @param[in] value Initial value for the semaphore.
  *
  * @return  0 on success.
- * @return  -EINVAL, if semaphore is invalid.
+ * @return  -EINVAL, if semaphore is invalid or @p value exceeds INT_MAX.
  */
 int sema_create(sema_t *sema, unsigned int value);
 
@@ -76,6 +77,19 @@ int sema_create(sema_t *sema, unsigned int value);
  */
 int sema_destroy(sema_t *sema);
 
+/**
+ * @brief   Tries to take a semaphore without blocking.
+ *
+ * Uses a compare-and-swap on the semaphore value and does not disable
+ * interrupts on platforms providing an atomic compare-and-swap.
+ *
+ * @param[in] sema  A semaphore.
+ *
+ * @return  0 on success.
+ * @return  -EAGAIN, if the semaphore value is 0.
+ */
+int sema_try_wait(sema_t *sema);
+
 /**
  * @brief   Wait for a semaphore being posted.
  *
@@ -146,6 +146,46 @@ int tsrb_add_one(tsrb_t *rb, char c);
  */
 int tsrb_add(tsrb_t *rb, const char *src, size_t n);
 
+/**
+ * @brief       Get contiguous free space to write to in place
+ *
+ * Only the producer may call this. Write to the space, e.g. by DMA, then add
+ * the written bytes with tsrb_commit(). Free space that wraps around the end
+ * of the buffer is returned by a second call after committing the first part.
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[out]  ptr start of the free space
+ * @return      nr of bytes that can be written at @p ptr
+ */
+size_t tsrb_reserve(tsrb_t *rb, char **ptr);
+
+/**
+ * @brief       Add bytes written to space got with tsrb_reserve()
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes written, at most the size reserved
+ */
+void tsrb_commit(tsrb_t *rb, size_t n);
+
+/**
+ * @brief       Get contiguous bytes to read in place
+ *
+ * Only the consumer may call this. Read or parse the bytes, then remove them
+ * with tsrb_consume(). Bytes that wrap around the end of the buffer are
+ * returned by a second call after consuming the first part.
+ *
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[out]  ptr start of the oldest byte
+ * @return      nr of bytes that can be read at @p ptr
+ */
+size_t tsrb_peek_ptr(tsrb_t *rb, char **ptr);
+
+/**
+ * @brief       Remove bytes got with tsrb_peek_ptr()
+ * @param[in]   rb  Ringbuffer to operate on
+ * @param[in]   n   nr of bytes to remove, at most the size got
+ */
+void tsrb_consume(tsrb_t *rb, size_t n);
+
 #ifdef __cplusplus
 }
 #endif
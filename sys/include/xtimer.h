@@ -300,6 +300,29 @@ static inline void xtimer_set(xtimer_t *timer, uint32_t offset);
  */
 void xtimer_remove(xtimer_t *timer);
 
+/**
+ * @brief Get the time until the low-level timer fires next
+ *
+ * This is either the next timer that is due or the end of the current
+ * low-level timer period, whatever comes first. Meant to be called by the
+ * idle thread with interrupts disabled, e.g., to choose a power mode.
+ *
+ * @return time in microseconds until the next xtimer interrupt
+ */
+uint32_t xtimer_usec_until_next(void);
+
+/**
+ * @brief Make the low-level timer fire @p usec earlier than planned
+ *
+ * Used to compensate the wake-up latency of a power mode before going to
+ * sleep. The early interrupt only re-arms the low-level timer, the due timer
+ * still fires on time. Has no effect if no timer is due in the current
+ * low-level timer period or if the earlier target is already too close.
+ *
+ * @param[in] usec      time in microseconds to wake up early
+ */
+void xtimer_wakeup_early(uint32_t usec);
+
 /**
  * @brief receive a message blocking but with timeout
  *
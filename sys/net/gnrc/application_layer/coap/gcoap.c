@@ -29,6 +29,11 @@
 /** @brief Stack size for module thread */
 #define GCOAP_STACK_SIZE (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
 
+/** @brief Code 0.00 of an empty message */
+#ifndef COAP_CODE_EMPTY
+#define COAP_CODE_EMPTY  (0)
+#endif
+
 /* Internal functions */
 static void *_event_loop(void *arg);
 static int _register_port(gnrc_netreg_entry_t *netreg_port, uint16_t port);
@@ -37,11 +42,35 @@ static size_t _send(gnrc_pktsnip_t *coap_snip, ipv6_addr_t *addr, uint16_t port)
 static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len);
 static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len);
 static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len);
+static coap_resource_t *_find_resource(gcoap_listener_t *listener, const char *path,
+                                                              unsigned method_flag);
 static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len);
 static size_t _send_buf( uint8_t *buf, size_t len, ipv6_addr_t *src, uint16_t port);
-static void _expire_request(gcoap_request_memo_t *memo);
+static unsigned _token_slot(const uint8_t *token, unsigned token_len);
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                                                             uint8_t *buf, size_t len);
+static gcoap_request_memo_t *_find_req_memo_by_id(uint16_t id, ipv6_addr_t *addr);
+static unsigned _con_outstanding(ipv6_addr_t *addr);
+static void _req_set_timer(uint32_t deadline);
+static void _ack_memo(gcoap_request_memo_t *memo);
+static void _release_memo(gcoap_request_memo_t *memo);
+static void _check_requests(void);
+static void _handle_empty(coap_pkt_t *pdu, ipv6_addr_t *src, uint16_t port);
+static int _next_option(uint8_t **pos, uint8_t *end, unsigned *optnum,
+                                                    unsigned *opt_len);
+static int _get_option_uint(coap_pkt_t *pdu, uint8_t *end, unsigned optnum,
+                                                           uint32_t *value);
+static ssize_t _add_option_uint(coap_pkt_t *pdu, size_t len, size_t pdu_len,
+                                                unsigned optnum, uint32_t value);
+static unsigned _block_szx(coap_pkt_t *pdu);
+static gcoap_observe_memo_t *_obs_register(const coap_resource_t *resource,
+                                           coap_pkt_t *pdu);
+static void _obs_remove(const coap_resource_t *resource, ipv6_addr_t *addr,
+                                                         uint16_t port);
+static void _obs_reset(coap_pkt_t *pdu, ipv6_addr_t *addr, uint16_t port);
+static void _obs_set_timer(uint32_t delay);
+static void _obs_notify_pending(void);
+static void _obs_notify(gcoap_observe_memo_t *memo);
 
 /* Internal variables */
 const coap_resource_t _default_resources[] = {
@@ -57,11 +86,23 @@ static gcoap_listener_t _default_listener = {
 static gcoap_state_t _coap_state = {
     .netreg_port = GNRC_NETREG_ENTRY_INIT_PID(0, KERNEL_PID_UNDEF),
     .listeners   = &_default_listener,
+    .req_lock    = MUTEX_INIT,
+    .obs_lock    = MUTEX_INIT,
 };
 
 static kernel_pid_t _pid = KERNEL_PID_UNDEF;
 static char _msg_stack[GCOAP_STACK_SIZE];
 
+/* Requester of the request currently being handled, for gcoap_resp_defer() */
+static ipv6_addr_t *_req_addr = NULL;
+static uint16_t _req_port;
+/* End of the request currently being handled, for reading its options */
+static uint8_t *_req_end = NULL;
+/* Observe option of the request currently being handled, or -1 if none */
+static int _req_observe = -1;
+/* Registration the response currently being built is a notification for */
+static gcoap_observe_memo_t *_req_obs = NULL;
+
 
 /* Event/Message loop for gcoap _pid thread. */
 static void *_event_loop(void *arg)
@@ -103,7 +144,11 @@ static void *_event_loop(void *arg)
                 break;
 
             case GCOAP_NETAPI_MSG_TYPE_TIMEOUT:
-                _expire_request((gcoap_request_memo_t *)msg_rcvd.content.ptr);
+                _check_requests();
+                break;
+
+            case GCOAP_NETAPI_MSG_TYPE_OBS_NOTIFY:
+                _obs_notify_pending();
                 break;
 
             default:
@@ -135,14 +180,28 @@ static void _receive(gnrc_pktsnip_t *pkt, ipv6_addr_t *src, uint16_t port)
         goto exit;
     }
 
+    /* empty message (ACK or RST) */
+    if (coap_get_code(&pdu) == COAP_CODE_EMPTY) {
+        _handle_empty(&pdu, src, port);
+    }
     /* incoming request */
-    if (coap_get_code_class(&pdu) == COAP_CLASS_REQ) {
+    else if (coap_get_code_class(&pdu) == COAP_CLASS_REQ) {
         if (pkt->size > sizeof(buf)) {
             DEBUG("gcoap: request too big: %u\n", pkt->size);
             pdu_len = gcoap_response(&pdu, buf, sizeof(buf),
                                            COAP_CODE_REQUEST_ENTITY_TOO_LARGE);
         } else {
+            uint32_t observe;
+
+            _req_addr    = src;
+            _req_port    = port;
+            _req_end     = buf + pkt_size;
+            _req_observe = (_get_option_uint(&pdu, _req_end, COAP_OPT_OBSERVE,
+                                             &observe) == 0) ? (int)observe : -1;
             pdu_len = _handle_req(&pdu, buf, sizeof(buf));
+            _req_addr    = NULL;
+            _req_end     = NULL;
+            _req_observe = -1;
         }
         if (pdu_len > 0) {
             _send_buf(buf, pdu_len, src, port);
@@ -150,15 +209,31 @@ static void _receive(gnrc_pktsnip_t *pkt, ipv6_addr_t *src, uint16_t port)
     }
     /* incoming response */
     else {
+        gcoap_resp_handler_t resp_handler = NULL;
+        unsigned state = GCOAP_MEMO_RESP;
+
+        /* acknowledge a separate response */
+        if (coap_get_type(&pdu) == COAP_TYPE_CON) {
+            uint8_t ack[sizeof(coap_hdr_t)];
+            coap_build_hdr((coap_hdr_t *)ack, COAP_TYPE_ACK, NULL, 0,
+                                              COAP_CODE_EMPTY, coap_get_id(&pdu));
+            _send_buf(ack, sizeof(ack), src, port);
+        }
+
+        mutex_lock(&_coap_state.req_lock);
         _find_req_memo(&memo, &pdu, buf, sizeof(buf));
         if (memo) {
-            xtimer_remove(&memo->response_timer);
             if (pkt->size > sizeof(buf)) {
-                memo->state = GCOAP_MEMO_ERR;
+                state = GCOAP_MEMO_ERR;
                 DEBUG("gcoap: response too big: %u\n", pkt->size);
             }
-            memo->resp_handler(memo->state, &pdu);
-            memo->state = GCOAP_MEMO_UNUSED;
+            resp_handler = memo->resp_handler;
+            _release_memo(memo);
+        }
+        mutex_unlock(&_coap_state.req_lock);
+
+        if (resp_handler) {
+            resp_handler(state, &pdu);
         }
     }
 
@@ -174,40 +249,80 @@ exit:
 static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len)
 {
     unsigned method_flag = coap_method2flag(coap_get_code_detail(pdu));
+    coap_resource_t *resource = NULL;
 
     /* Find path for CoAP msg among listener resources and execute callback. */
     gcoap_listener_t *listener = _coap_state.listeners;
-    while (listener) {
-        coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
-            if (i) {
-                resource++;
-            }
-            if (! (resource->methods & method_flag)) {
-                continue;
-            }
+    while (listener && !resource) {
+        resource = _find_resource(listener, (char *)&pdu->url[0], method_flag);
+        listener = listener->next;
+    }
+    if (!resource) {
+        return gcoap_response(pdu, buf, len, COAP_CODE_PATH_NOT_FOUND);
+    }
 
-            int res = strcmp((char *)&pdu->url[0], resource->path);
-            if (res > 0) {
-                continue;
-            }
-            else if (res < 0) {
-                /* resources expected in alphabetical order */
-                break;
+    if (_req_observe == GCOAP_OBS_REGISTER && (method_flag & COAP_GET)) {
+        _req_obs = _obs_register(resource, pdu);
+    }
+    else if (_req_observe == GCOAP_OBS_DEREGISTER) {
+        _obs_remove(resource, _req_addr, _req_port);
+    }
+
+    ssize_t pdu_len = resource->handler(pdu, buf, len);
+    if (pdu_len < 0) {
+        _req_obs = NULL;
+        pdu_len = gcoap_response(pdu, buf, len, COAP_CODE_INTERNAL_SERVER_ERROR);
+    }
+    /* only a success response establishes the observation */
+    if (_req_obs && (coap_get_code_class(pdu) != COAP_CLASS_SUCCESS)) {
+        _obs_remove(resource, _req_addr, _req_port);
+    }
+    _req_obs = NULL;
+    return pdu_len;
+}
+
+/*
+ * Finds the resource for a path and method within a listener.
+ *
+ * Resources are sorted by path, so binary search for the path. Several
+ * resources may share a path with different methods, so then check the
+ * neighbors of the match for the method.
+ *
+ * Returns the resource, or NULL if not found.
+ */
+static coap_resource_t *_find_resource(gcoap_listener_t *listener, const char *path,
+                                                              unsigned method_flag)
+{
+    coap_resource_t *resources = listener->resources;
+    size_t lo = 0, hi = listener->resources_len;
+
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        int res = strcmp(path, resources[mid].path);
+
+        if (res > 0) {
+            lo = mid + 1;
+        }
+        else if (res < 0) {
+            hi = mid;
+        }
+        else {
+            /* rewind to the first resource for the path */
+            while ((mid > 0) && (strcmp(path, resources[mid - 1].path) == 0)) {
+                mid--;
             }
-            else {
-                ssize_t pdu_len = resource->handler(pdu, buf, len);
-                if (pdu_len < 0) {
-                    pdu_len = gcoap_response(pdu, buf, len,
-                                             COAP_CODE_INTERNAL_SERVER_ERROR);
+            for (; mid < listener->resources_len; mid++) {
+                if (strcmp(path, resources[mid].path) != 0) {
+                    break;
+                }
+                if (resources[mid].methods & method_flag) {
+                    return &resources[mid];
                 }
-                return pdu_len;
             }
+            return NULL;
         }
-        listener = listener->next;
     }
-    /* resource not found */
-    return gcoap_response(pdu, buf, len, COAP_CODE_PATH_NOT_FOUND);
+    return NULL;
 }
 
 /*
@@ -233,66 +348,607 @@ static ssize_t _finish_pdu(coap_pkt_t *pdu, uint8_t *buf, size_t len)
     }
 }
 
+/*
+ * Hashes a token to the slot of the open_reqs table to start searching at.
+ */
+static unsigned _token_slot(const uint8_t *token, unsigned token_len)
+{
+    uint32_t hash = 0;
+
+    for (unsigned i = 0; i < token_len; i++) {
+        hash = (hash * 31) + token[i];
+    }
+    return hash % GCOAP_REQ_WAITING_MAX;
+}
+
 /*
  * Finds the memo for an outstanding request within the _coap_state.open_reqs
- * array. Matches on token.
+ * array. Matches on token. A memo is stored at most req_probe_max slots after
+ * the slot for its token.
+ *
+ * Must hold req_lock.
  *
  * src_pdu Source for the match token
  */
 static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *src_pdu,
                                                             uint8_t *buf, size_t len)
 {
-    gcoap_request_memo_t *memo;
-    coap_pkt_t memo_pdu = { .token = NULL };
+    unsigned token_len = coap_get_token_len(src_pdu);
+    unsigned slot = _token_slot(src_pdu->token, token_len);
     (void) buf;
     (void) len;
 
+    for (unsigned i = 0; i <= _coap_state.req_probe_max; i++) {
+        gcoap_request_memo_t *memo = &_coap_state.open_reqs[slot];
+        coap_hdr_t *memo_hdr = (coap_hdr_t *) &memo->hdr_buf[0];
+
+        if ((memo->state != GCOAP_MEMO_UNUSED)
+                && ((memo_hdr->ver_t_tkl & 0x0F) == token_len)
+                && (memcmp(&memo_hdr->data[0], src_pdu->token, token_len) == 0)) {
+            *memo_ptr = memo;
+            return;
+        }
+        slot = (slot + 1) % GCOAP_REQ_WAITING_MAX;
+    }
+}
+
+/*
+ * Finds the memo for a confirmable request awaiting acknowledgement, by
+ * message ID and destination.
+ *
+ * Must hold req_lock.
+ */
+static gcoap_request_memo_t *_find_req_memo_by_id(uint16_t id, ipv6_addr_t *addr)
+{
+    coap_pkt_t memo_pdu;
+
     for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED)
-            continue;
+        gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
+        memo_pdu.hdr = (coap_hdr_t *) &memo->hdr_buf[0];
 
-        /* setup memo PDU from memo header */
-        memo                 = &_coap_state.open_reqs[i];
-        coap_hdr_t *memo_hdr = (coap_hdr_t *) &memo->hdr_buf[0];
-        memo_pdu.hdr         = memo_hdr;
-        if (coap_get_token_len(&memo_pdu)) {
-            memo_pdu.token = &memo_hdr->data[0];
-        }
-        /* match on token */
-        if (coap_get_token_len(src_pdu) == coap_get_token_len(&memo_pdu)) {
-            uint8_t *src_byte  = src_pdu->token;
-            uint8_t *memo_byte = memo_pdu.token;
-            size_t j;
-            for (j = 0; j < coap_get_token_len(src_pdu); j++) {
-                if (*src_byte++ != *memo_byte++) {
-                    break;      /* token mismatch */
+        if ((memo->state != GCOAP_MEMO_UNUSED) && memo->pdu_snip
+                && !memo->queued && (coap_get_id(&memo_pdu) == id)
+                && ipv6_addr_equal(&memo->addr, addr)) {
+            return memo;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Counts the outstanding confirmable requests to a destination, which have
+ * been sent but not acknowledged.
+ *
+ * Must hold req_lock.
+ */
+static unsigned _con_outstanding(ipv6_addr_t *addr)
+{
+    unsigned count = 0;
+
+    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
+        gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
+        if ((memo->state != GCOAP_MEMO_UNUSED) && memo->pdu_snip && !memo->queued
+                && ipv6_addr_equal(&memo->addr, addr)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/*
+ * Sets the shared request timer to expire at deadline, unless it expires
+ * earlier already.
+ *
+ * Must hold req_lock.
+ */
+static void _req_set_timer(uint32_t deadline)
+{
+    uint32_t now = xtimer_now_usec();
+
+    if (_coap_state.req_timer_set
+            && ((int32_t)(deadline - _coap_state.req_due) >= 0)) {
+        return;
+    }
+    _coap_state.req_timer_msg.type = GCOAP_NETAPI_MSG_TYPE_TIMEOUT;
+    _coap_state.req_due            = deadline;
+    _coap_state.req_timer_set      = 1;
+    xtimer_set_msg(&_coap_state.req_timer,
+                   ((int32_t)(deadline - now) > 0) ? deadline - now : 0,
+                   &_coap_state.req_timer_msg, _pid);
+}
+
+/*
+ * Ends the wait for an acknowledgement of a confirmable request, and sends the
+ * next request queued for its destination, if any.
+ *
+ * Must hold req_lock.
+ */
+static void _ack_memo(gcoap_request_memo_t *memo)
+{
+    gcoap_request_memo_t *next = NULL;
+
+    if (!memo->pdu_snip) {
+        return;
+    }
+    gnrc_pktbuf_release(memo->pdu_snip);
+    memo->pdu_snip = NULL;
+    if (memo->queued) {
+        memo->queued = 0;
+        return;
+    }
+
+    /* oldest request queued for the same destination */
+    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
+        gcoap_request_memo_t *queued = &_coap_state.open_reqs[i];
+        if ((queued->state != GCOAP_MEMO_UNUSED) && queued->queued
+                && ipv6_addr_equal(&queued->addr, &memo->addr)
+                && (!next || ((int32_t)(queued->deadline - next->deadline) < 0))) {
+            next = queued;
+        }
+    }
+    if (next) {
+        DEBUG("gcoap: sending queued request\n");
+        next->queued   = 0;
+        next->deadline = xtimer_now_usec() + next->timeout;
+        gnrc_pktbuf_hold(next->pdu_snip, 1);
+        _send(next->pdu_snip, &next->addr, next->port);
+        _req_set_timer(next->deadline);
+    }
+}
+
+/*
+ * Frees a memo.
+ *
+ * Must hold req_lock.
+ */
+static void _release_memo(gcoap_request_memo_t *memo)
+{
+    _ack_memo(memo);
+    memo->state = GCOAP_MEMO_UNUSED;
+
+    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
+        if (_coap_state.open_reqs[i].state != GCOAP_MEMO_UNUSED) {
+            return;
+        }
+    }
+    /* table is empty; no memo is displaced from its slot */
+    _coap_state.req_probe_max = 0;
+}
+
+/*
+ * Retransmits confirmable requests, and expires requests without response.
+ * Runs when the shared request timer expires.
+ */
+static void _check_requests(void)
+{
+    uint32_t now = xtimer_now_usec();
+
+    mutex_lock(&_coap_state.req_lock);
+    _coap_state.req_timer_set = 0;
+    while (1) {
+        gcoap_request_memo_t *expired = NULL;
+        uint32_t next = 0;
+        int pending = 0;
+
+        for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
+            gcoap_request_memo_t *memo = &_coap_state.open_reqs[i];
+            if ((memo->state != GCOAP_MEMO_WAIT) || memo->queued || !memo->timeout) {
+                continue;
+            }
+            if ((int32_t)(memo->deadline - now) <= 0) {
+                if (memo->pdu_snip && (memo->retransmits < GCOAP_MAX_RETRANSMIT)) {
+                    DEBUG("gcoap: retransmitting request\n");
+                    memo->retransmits++;
+                    memo->timeout  *= 2;
+                    memo->deadline  = now + memo->timeout;
+                    gnrc_pktbuf_hold(memo->pdu_snip, 1);
+                    _send(memo->pdu_snip, &memo->addr, memo->port);
+                }
+                else {
+                    expired = memo;
+                    break;
                 }
             }
-            if (j == coap_get_token_len(src_pdu)) {
-                *memo_ptr = memo;
+            if (!pending || ((int32_t)(memo->deadline - next) < 0)) {
+                next    = memo->deadline;
+                pending = 1;
             }
         }
+        if (!expired) {
+            if (pending) {
+                _req_set_timer(next);
+            }
+            break;
+        }
+
+        /* Pass request header to handler for reference; the handler may send
+         * another request, so release the lock meanwhile. */
+        DEBUG("gcoap: request timed out\n");
+        coap_pkt_t req;
+        uint8_t hdr_buf[GCOAP_HEADER_MAXLEN];
+        gcoap_resp_handler_t resp_handler = expired->resp_handler;
+
+        memcpy(hdr_buf, expired->hdr_buf, sizeof(hdr_buf));
+        req.hdr = (coap_hdr_t *)&hdr_buf[0];
+        _release_memo(expired);
+
+        mutex_unlock(&_coap_state.req_lock);
+        if (resp_handler) {
+            resp_handler(GCOAP_MEMO_TIMEOUT, &req);
+        }
+        mutex_lock(&_coap_state.req_lock);
     }
+    mutex_unlock(&_coap_state.req_lock);
 }
 
-/* Calls handler callback on receipt of a timeout message. */
-static void _expire_request(gcoap_request_memo_t *memo)
+/*
+ * Handles an empty message. An ACK stops retransmission of a confirmable
+ * request, and a RST ends it, or cancels an observation.
+ */
+static void _handle_empty(coap_pkt_t *pdu, ipv6_addr_t *src, uint16_t port)
 {
+    gcoap_resp_handler_t resp_handler = NULL;
     coap_pkt_t req;
+    uint8_t hdr_buf[GCOAP_HEADER_MAXLEN];
+
+    mutex_lock(&_coap_state.req_lock);
+    gcoap_request_memo_t *memo = _find_req_memo_by_id(coap_get_id(pdu), src);
+    if (memo && (coap_get_type(pdu) == COAP_TYPE_ACK)) {
+        /* wait for the separate response */
+        DEBUG("gcoap: request acknowledged\n");
+        _ack_memo(memo);
+        memo->timeout  = GCOAP_NON_TIMEOUT;
+        memo->deadline = xtimer_now_usec() + GCOAP_NON_TIMEOUT;
+        if (memo->timeout) {
+            _req_set_timer(memo->deadline);
+        }
+    }
+    else if (memo && (coap_get_type(pdu) == COAP_TYPE_RST)) {
+        memcpy(hdr_buf, memo->hdr_buf, sizeof(hdr_buf));
+        req.hdr = (coap_hdr_t *)&hdr_buf[0];
+        resp_handler = memo->resp_handler;
+        _release_memo(memo);
+    }
+    mutex_unlock(&_coap_state.req_lock);
+
+    if (resp_handler) {
+        resp_handler(GCOAP_MEMO_ERR, &req);
+    }
+    else if (coap_get_type(pdu) == COAP_TYPE_RST) {
+        _obs_reset(pdu, src, port);
+    }
+}
+
+/*
+ * Reads the header of the option at pos, and advances pos to its value.
+ *
+ * optnum Number of the previous option; updated to the number of this one
+ *
+ * Returns 0 on success, or -1 at the end of the options or on a malformed
+ * option
+ */
+static int _next_option(uint8_t **pos, uint8_t *end, unsigned *optnum,
+                                                    unsigned *opt_len)
+{
+    uint8_t *bufpos = *pos;
+
+    if ((bufpos >= end) || (*bufpos == GCOAP_PAYLOAD_MARKER)) {
+        return -1;
+    }
+    unsigned delta = *bufpos >> 4;
+    unsigned length = *bufpos & 0x0F;
+    bufpos++;
+
+    /* extended delta and length */
+    if (delta == 13) {
+        delta = 13 + *bufpos++;
+    }
+    else if (delta == 14) {
+        delta = 269 + ((bufpos[0] << 8) | bufpos[1]);
+        bufpos += 2;
+    }
+    if (length == 13) {
+        length = 13 + *bufpos++;
+    }
+    else if (length == 14) {
+        length = 269 + ((bufpos[0] << 8) | bufpos[1]);
+        bufpos += 2;
+    }
+    if ((delta == 15) || (length == 15) || (bufpos + length > end)) {
+        return -1;
+    }
+
+    *optnum += delta;
+    *opt_len = length;
+    *pos = bufpos;
+    return 0;
+}
+
+/*
+ * Reads an unsigned integer option from a PDU.
+ *
+ * end End of the PDU in the buffer
+ *
+ * Returns 0 on success, or -1 if the option is not present
+ */
+static int _get_option_uint(coap_pkt_t *pdu, uint8_t *end, unsigned optnum,
+                                                           uint32_t *value)
+{
+    uint8_t *pos = pdu->hdr->data + coap_get_token_len(pdu);
+    unsigned num = 0, opt_len;
+
+    while (_next_option(&pos, end, &num, &opt_len) == 0) {
+        if (num == optnum) {
+            *value = 0;
+            for (unsigned i = 0; (i < opt_len) && (i < 4); i++) {
+                *value = (*value << 8) | pos[i];
+            }
+            return 0;
+        }
+        else if (num > optnum) {
+            break;
+        }
+        pos += opt_len;
+    }
+    return -1;
+}
+
+/*
+ * Appends an unsigned integer option to a finished PDU, and moves the
+ * payload behind it. The option must not precede any option in the PDU.
+ *
+ * len Length of the buffer for the PDU
+ * pdu_len Length of the PDU
+ *
+ * Returns the new length of the PDU, or -ENOSPC if the option does not fit
+ */
+static ssize_t _add_option_uint(coap_pkt_t *pdu, size_t len, size_t pdu_len,
+                                                unsigned optnum, uint32_t value)
+{
+    uint8_t *buf = (uint8_t *)pdu->hdr;
+    uint8_t *end = buf + pdu_len;
+    uint8_t *pos = buf + coap_get_total_hdr_len(pdu);
+    unsigned last_optnum = 0, opt_len;
+
+    /* find end of options */
+    while (_next_option(&pos, end, &last_optnum, &opt_len) == 0) {
+        pos += opt_len;
+    }
+    assert(optnum >= last_optnum);
+
+    unsigned delta = optnum - last_optnum;
+    unsigned value_len = (value > 0xFFFF) ? 3 : (value > 0xFF) ? 2
+                                          : (value > 0) ? 1 : 0;
+    unsigned total = 1 + ((delta >= 13) ? 1 : 0) + value_len;
+    assert(delta < 269);
+
+    if (pdu_len + total > len) {
+        return -ENOSPC;
+    }
+    memmove(pos + total, pos, end - pos);
+
+    if (delta >= 13) {
+        *pos++ = (13 << 4) | value_len;
+        *pos++ = delta - 13;
+    }
+    else {
+        *pos++ = (delta << 4) | value_len;
+    }
+    for (unsigned i = value_len; i > 0; i--) {
+        *pos++ = (uint8_t)(value >> (8 * (i - 1)));
+    }
+
+    if (pdu->payload_len) {
+        pdu->payload = buf + pdu_len + total - pdu->payload_len;
+    }
+    return pdu_len + total;
+}
+
+/*
+ * Finds the largest block size exponent for the payload space of a response
+ * PDU, leaving room for a block option.
+ */
+static unsigned _block_szx(coap_pkt_t *pdu)
+{
+    unsigned szx = GCOAP_BLOCK_SZX_MAX;
 
-    DEBUG("coap: received timeout message\n");
-    if (memo->state == GCOAP_MEMO_WAIT) {
-        memo->state = GCOAP_MEMO_TIMEOUT;
-        /* Pass response to handler */
-        if (memo->resp_handler) {
-            req.hdr = (coap_hdr_t *)&memo->hdr_buf[0];   /* for reference */
-            memo->resp_handler(memo->state, &req);
+    /* one extra byte to detect more data when streaming */
+    while (szx && ((16U << szx) + GCOAP_BLOCK_OPTION_LEN + 1 > pdu->payload_len)) {
+        szx--;
+    }
+    return szx;
+}
+
+/*
+ * Registers the requester as observer of a resource, or updates the token of
+ * an existing registration.
+ *
+ * Returns the registration, or NULL if no space left
+ */
+static gcoap_observe_memo_t *_obs_register(const coap_resource_t *resource,
+                                           coap_pkt_t *pdu)
+{
+    gcoap_observe_memo_t *memo = NULL;
+
+    mutex_lock(&_coap_state.obs_lock);
+    for (int i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        gcoap_observe_memo_t *obs = &_coap_state.observers[i];
+
+        if (obs->resource == NULL) {
+            if (memo == NULL) {
+                memo = obs;
+            }
+        }
+        else if ((obs->resource == resource) && (obs->port == _req_port)
+                    && ipv6_addr_equal(&obs->addr, _req_addr)) {
+            memo = obs;
+            break;
         }
-        memo->state = GCOAP_MEMO_UNUSED;
+    }
+    if (memo) {
+        memo->resource    = resource;
+        memcpy(&memo->addr, _req_addr, sizeof(ipv6_addr_t));
+        memo->port        = _req_port;
+        memo->token_len   = coap_get_token_len(pdu);
+        memcpy(&memo->token[0], pdu->token, memo->token_len);
+        memo->pending     = 0;
+        /* the response counts as first notification */
+        memo->last_notify = xtimer_now_usec();
+        DEBUG("gcoap: registered observer for %s\n", resource->path);
     }
     else {
-        /* Response already handled; timeout must have fired while response */
-        /* was in queue. */
+        DEBUG("gcoap: no space for observer of %s\n", resource->path);
+    }
+    mutex_unlock(&_coap_state.obs_lock);
+    return memo;
+}
+
+/* Removes the registration of an observer for a resource, if any. */
+static void _obs_remove(const coap_resource_t *resource, ipv6_addr_t *addr,
+                                                         uint16_t port)
+{
+    mutex_lock(&_coap_state.obs_lock);
+    for (int i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        gcoap_observe_memo_t *obs = &_coap_state.observers[i];
+
+        if ((obs->resource == resource) && (obs->port == port)
+                && ipv6_addr_equal(&obs->addr, addr)) {
+            DEBUG("gcoap: removed observer for %s\n", resource->path);
+            obs->resource = NULL;
+        }
+    }
+    mutex_unlock(&_coap_state.obs_lock);
+}
+
+/* Removes the registration a Reset message answers a notification for. */
+static void _obs_reset(coap_pkt_t *pdu, ipv6_addr_t *addr, uint16_t port)
+{
+    mutex_lock(&_coap_state.obs_lock);
+    for (int i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        gcoap_observe_memo_t *obs = &_coap_state.observers[i];
+
+        if (obs->resource && (obs->last_mid == coap_get_id(pdu))
+                && (obs->port == port) && ipv6_addr_equal(&obs->addr, addr)) {
+            DEBUG("gcoap: observer reset for %s\n", obs->resource->path);
+            obs->resource = NULL;
+        }
+    }
+    mutex_unlock(&_coap_state.obs_lock);
+}
+
+/*
+ * Sets the timer to send pending notifications, unless it expires earlier
+ * already. Resets it also if its message seems lost.
+ *
+ * Must hold obs_lock.
+ */
+static void _obs_set_timer(uint32_t delay)
+{
+    uint32_t now = xtimer_now_usec();
+
+    if (_coap_state.obs_timer_set
+            && ((int32_t)(now + delay - _coap_state.obs_due) >= 0)
+            && ((int32_t)(now - _coap_state.obs_due)
+                        < (int32_t)GCOAP_OBS_NOTIFY_INTERVAL)) {
+        return;
+    }
+    _coap_state.obs_msg.type = GCOAP_NETAPI_MSG_TYPE_OBS_NOTIFY;
+    _coap_state.obs_due      = now + delay;
+    _coap_state.obs_timer_set = 1;
+    xtimer_set_msg(&_coap_state.obs_timer, delay, &_coap_state.obs_msg, _pid);
+}
+
+/*
+ * Sends the pending notifications that are due, and sets the timer for the
+ * remaining ones.
+ */
+static void _obs_notify_pending(void)
+{
+    gcoap_observe_memo_t memo;
+    uint32_t now = xtimer_now_usec();
+
+    mutex_lock(&_coap_state.obs_lock);
+    _coap_state.obs_timer_set = 0;
+    while (1) {
+        uint32_t delay = UINT32_MAX;
+        int due = -1;
+
+        for (int i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+            gcoap_observe_memo_t *obs = &_coap_state.observers[i];
+            if (!obs->resource || !obs->pending) {
+                continue;
+            }
+            uint32_t elapsed = now - obs->last_notify;
+            if (elapsed >= GCOAP_OBS_NOTIFY_INTERVAL) {
+                due = i;
+                break;
+            }
+            else if (GCOAP_OBS_NOTIFY_INTERVAL - elapsed < delay) {
+                delay = GCOAP_OBS_NOTIFY_INTERVAL - elapsed;
+            }
+        }
+        if (due < 0) {
+            if (delay != UINT32_MAX) {
+                _obs_set_timer(delay);
+            }
+            break;
+        }
+
+        gcoap_observe_memo_t *obs = &_coap_state.observers[due];
+        obs->pending     = 0;
+        obs->last_notify = now;
+        obs->last_mid    = ++_coap_state.last_message_id;
+        memo = *obs;
+
+        /* the resource handler may call gcoap_obs_send() */
+        mutex_unlock(&_coap_state.obs_lock);
+        _obs_notify(&memo);
+        mutex_lock(&_coap_state.obs_lock);
+    }
+    mutex_unlock(&_coap_state.obs_lock);
+}
+
+/* Builds a notification with the resource handler, and sends it. */
+static void _obs_notify(gcoap_observe_memo_t *memo)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    ssize_t hdrlen;
+
+    /* act as if the observer sent a GET request */
+    hdrlen = coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, &memo->token[0],
+                                               memo->token_len, COAP_METHOD_GET,
+                                               memo->last_mid);
+    if (hdrlen < 0) {
+        return;
+    }
+    pdu.hdr          = (coap_hdr_t *)buf;
+    pdu.token        = memo->token_len ? &pdu.hdr->data[0] : NULL;
+    pdu.payload      = buf + hdrlen;
+    pdu.payload_len  = 0;
+    pdu.content_type = COAP_FORMAT_NONE;
+    memset(pdu.url, 0, NANOCOAP_URL_MAX);
+    strncpy((char *)&pdu.url[0], memo->resource->path, NANOCOAP_URL_MAX - 1);
+
+    _req_addr = &memo->addr;
+    _req_port = memo->port;
+    _req_end  = pdu.payload;
+    _req_obs  = memo;
+    ssize_t pdu_len = memo->resource->handler(&pdu, buf, sizeof(buf));
+    _req_obs  = NULL;
+    _req_end  = NULL;
+    _req_addr = NULL;
+
+    if (pdu_len < 0) {
+        pdu_len = gcoap_response(&pdu, buf, sizeof(buf),
+                                 COAP_CODE_INTERNAL_SERVER_ERROR);
+    }
+    /* an error response ends the observation */
+    if (coap_get_code_class(&pdu) != COAP_CLASS_SUCCESS) {
+        _obs_remove(memo->resource, &memo->addr, memo->port);
+    }
+    if (pdu_len > 0) {
+        _send_buf(buf, pdu_len, &memo->addr, memo->port);
     }
 }
 
@@ -418,6 +1074,13 @@ static ssize_t _write_options(coap_pkt_t *pdu, uint8_t *buf, size_t len)
 
     uint8_t *bufpos = buf + coap_get_total_hdr_len(pdu);  /* position for write */
 
+    /* Observe for response, already written by gcoap_resp_init() */
+    if ((coap_get_code_class(pdu) != COAP_CLASS_REQ)
+            && (*bufpos != GCOAP_PAYLOAD_MARKER)) {
+        bufpos += 1 + (*bufpos & 0x0F);
+        last_optnum = COAP_OPT_OBSERVE;
+    }
+
     /* Uri-Path for request */
     if (coap_get_code_class(pdu) == COAP_CLASS_REQ) {
         size_t url_len = strlen((char *)pdu->url);
@@ -531,43 +1194,106 @@ size_t gcoap_req_send(uint8_t *buf, size_t len, ipv6_addr_t *addr, uint16_t port
                                                  gcoap_resp_handler_t resp_handler)
 {
     gcoap_request_memo_t *memo = NULL;
+    coap_hdr_t *hdr = (coap_hdr_t *)buf;
+    unsigned token_len = hdr->ver_t_tkl & 0x0F;
+    size_t res;
     assert(resp_handler != NULL);
 
-    /* Find empty slot in list of open requests. */
-    for (int i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
-        if (_coap_state.open_reqs[i].state == GCOAP_MEMO_UNUSED) {
-            memo = &_coap_state.open_reqs[i];
-            memo->state = GCOAP_MEMO_WAIT;
+    gnrc_pktsnip_t *snip = gnrc_pktbuf_add(NULL, buf, len, GNRC_NETTYPE_UNDEF);
+    if (!snip) {
+        return 0;
+    }
+
+    mutex_lock(&_coap_state.req_lock);
+    /* Find empty slot in list of open requests, starting at token's slot. */
+    unsigned slot = _token_slot(&hdr->data[0], token_len);
+    for (unsigned i = 0; i < GCOAP_REQ_WAITING_MAX; i++) {
+        if (_coap_state.open_reqs[slot].state == GCOAP_MEMO_UNUSED) {
+            memo = &_coap_state.open_reqs[slot];
+            if (i > _coap_state.req_probe_max) {
+                _coap_state.req_probe_max = i;
+            }
             break;
         }
+        slot = (slot + 1) % GCOAP_REQ_WAITING_MAX;
     }
-    if (memo) {
-        memcpy(&memo->hdr_buf[0], buf, GCOAP_HEADER_MAXLEN);
-        memo->resp_handler = resp_handler;
-
-        size_t res = _send_buf(buf, len, addr, port);
-        if (res && (GCOAP_NON_TIMEOUT > 0)) {
-            /* start response wait timer */
-            memo->timeout_msg.type        = GCOAP_NETAPI_MSG_TYPE_TIMEOUT;
-            memo->timeout_msg.content.ptr = (char *)memo;
-            xtimer_set_msg(&memo->response_timer, GCOAP_NON_TIMEOUT,
-                                                  &memo->timeout_msg, _pid);
-        }
-        else if (!res) {
-            memo->state = GCOAP_MEMO_UNUSED;
-        }
-        return res;
-    } else {
+    if (!memo) {
+        mutex_unlock(&_coap_state.req_lock);
+        gnrc_pktbuf_release(snip);
         DEBUG("gcoap: dropping request; no space for response tracking\n");
         return 0;
     }
+
+    memo->pdu_snip    = NULL;
+    memo->queued      = 0;
+    memo->retransmits = 0;
+    memo->state = GCOAP_MEMO_WAIT;
+    memcpy(&memo->hdr_buf[0], buf, GCOAP_HEADER_MAXLEN);
+    memo->resp_handler = resp_handler;
+    memcpy(&memo->addr, addr, sizeof(ipv6_addr_t));
+    memo->port        = port;
+
+    if (((hdr->ver_t_tkl & 0x30) >> 4) == COAP_TYPE_CON) {
+        unsigned outstanding = _con_outstanding(addr);
+
+        /* keep the PDU for retransmission */
+        memo->pdu_snip = snip;
+        memo->timeout  = random_uint32_range(GCOAP_ACK_TIMEOUT,
+                            GCOAP_ACK_TIMEOUT * GCOAP_ACK_RANDOM_FACTOR_1000 / 1000);
+
+        if (outstanding >= GCOAP_NSTART) {
+            /* send when an outstanding request is acknowledged; the deadline
+             * orders the queue meanwhile */
+            DEBUG("gcoap: queueing request\n");
+            memo->queued   = 1;
+            memo->deadline = xtimer_now_usec();
+            mutex_unlock(&_coap_state.req_lock);
+            return len;
+        }
+        gnrc_pktbuf_hold(snip, 1);
+    }
+    else {
+        memo->timeout = GCOAP_NON_TIMEOUT;
+    }
+    memo->deadline = xtimer_now_usec() + memo->timeout;
+
+    res = _send(snip, addr, port);
+    if (res && memo->timeout) {
+        /* start response wait timer */
+        _req_set_timer(memo->deadline);
+    }
+    else if (!res) {
+        _release_memo(memo);
+    }
+    mutex_unlock(&_coap_state.req_lock);
+    return res;
 }
 
 int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
 {
-    /* Assume NON type request, so response type is the same. */
+    uint8_t *bufpos = buf + coap_get_total_hdr_len(pdu);
+
+    /* Piggyback the response on the ACK for a CON request. Otherwise assume
+     * NON type request, so response type is the same. */
     coap_hdr_set_code(pdu->hdr, code);
-    /* Create message ID since NON? */
+    if (coap_get_type(pdu) == COAP_TYPE_CON) {
+        gcoap_hdr_set_type(pdu->hdr, COAP_TYPE_ACK);
+    }
+
+    /* Observe for a notification, or the response to a registration; written
+     * now because it precedes all options gcoap_finish() writes */
+    if (_req_obs && (thread_getpid() == _pid)
+                 && (coap_get_code_class(pdu) == COAP_CLASS_SUCCESS)) {
+        uint32_t seq = ++_coap_state.obs_seq & 0xFFFFFF;
+        unsigned seq_len = (seq > 0xFFFF) ? 3 : (seq > 0xFF) ? 2 : 1;
+
+        *bufpos++ = (COAP_OPT_OBSERVE << 4) | seq_len;
+        for (unsigned i = seq_len; i > 0; i--) {
+            *bufpos++ = (uint8_t)(seq >> (8 * (i - 1)));
+        }
+    }
+    /* marks the end of options written so far */
+    *bufpos = GCOAP_PAYLOAD_MARKER;
 
     /* Reserve some space between the header and payload to write options later */
     pdu->payload      = buf + coap_get_total_hdr_len(pdu) + GCOAP_RESP_OPTIONS_BUF;
@@ -579,6 +1305,152 @@ int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
     return 0;
 }
 
+ssize_t gcoap_resp_defer(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                                          gcoap_deferred_t *deferred)
+{
+    if (_req_addr == NULL) {
+        return -EINVAL;
+    }
+    memcpy(&deferred->addr, _req_addr, sizeof(ipv6_addr_t));
+    deferred->port      = _req_port;
+    deferred->token_len = coap_get_token_len(pdu);
+    memcpy(&deferred->token[0], pdu->token, deferred->token_len);
+
+    if (coap_get_type(pdu) == COAP_TYPE_CON) {
+        /* empty ACK, so the requester does not retransmit meanwhile */
+        (void)len;
+        return coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_ACK, NULL, 0,
+                              COAP_CODE_EMPTY, coap_get_id(pdu));
+    }
+    return 0;
+}
+
+int gcoap_deferred_init(gcoap_deferred_t *deferred, coap_pkt_t *pdu,
+                        uint8_t *buf, size_t len, unsigned code)
+{
+    ssize_t hdrlen;
+
+    if (len < sizeof(coap_hdr_t) + deferred->token_len) {
+        return -ENOSPC;
+    }
+    pdu->hdr = (coap_hdr_t *)buf;
+    hdrlen = coap_build_hdr(pdu->hdr, COAP_TYPE_NON, &deferred->token[0],
+                                                     deferred->token_len, code,
+                                                   ++_coap_state.last_message_id);
+    if (hdrlen < 0) {
+        return -1;
+    }
+    pdu->token = deferred->token_len ? &pdu->hdr->data[0] : NULL;
+
+    return gcoap_resp_init(pdu, buf, len, code);
+}
+
+size_t gcoap_deferred_send(gcoap_deferred_t *deferred, uint8_t *buf, size_t len)
+{
+    return _send_buf(buf, len, &deferred->addr, deferred->port);
+}
+
+int gcoap_block1_get(coap_pkt_t *pdu, gcoap_block_t *block)
+{
+    uint32_t value;
+
+    if ((_req_end == NULL)
+            || (_get_option_uint(pdu, _req_end, COAP_OPT_BLOCK1, &value) < 0)) {
+        return -1;
+    }
+    block->num    = value >> 4;
+    block->more   = (value >> 3) & 1;
+    block->szx    = value & 0x07;
+    block->offset = block->num << (block->szx + 4);
+    return 0;
+}
+
+ssize_t gcoap_block1_finish(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            gcoap_block_t *block, unsigned code)
+{
+    uint32_t value = (block->num << 4) | (block->more << 3) | block->szx;
+
+    gcoap_resp_init(pdu, buf, len, block->more ? COAP_CODE_CONTINUE : code);
+    ssize_t pdu_len = gcoap_finish(pdu, 0, COAP_FORMAT_NONE);
+    if (pdu_len < 0) {
+        return pdu_len;
+    }
+    return _add_option_uint(pdu, len, pdu_len, COAP_OPT_BLOCK1, value);
+}
+
+ssize_t gcoap_block2_stream(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                            unsigned format, gcoap_stream_handler_t stream,
+                            void *arg)
+{
+    uint32_t value = 0;
+    size_t offset = 0;
+    int requested = 0;
+
+    /* read the request before it is overwritten */
+    if (_req_end && (_get_option_uint(pdu, _req_end, COAP_OPT_BLOCK2, &value) == 0)) {
+        offset    = (value >> 4) << ((value & 0x07) + 4);
+        requested = 1;
+    }
+
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    unsigned szx = _block_szx(pdu);
+    if (requested && ((value & 0x07) < szx)) {
+        szx = value & 0x07;
+    }
+    size_t block_size = 16U << szx;
+    /* a smaller block size than requested may misalign the offset */
+    uint32_t num = offset >> (szx + 4);
+    offset = num << (szx + 4);
+
+    /* ask for one more byte to tell if there is more data */
+    ssize_t payload_len = stream(pdu->payload, offset, block_size + 1, arg);
+    if (payload_len < 0) {
+        return payload_len;
+    }
+    int more = ((size_t)payload_len > block_size);
+    if (more) {
+        payload_len = block_size;
+    }
+
+    ssize_t pdu_len = gcoap_finish(pdu, payload_len, format);
+    if ((pdu_len < 0) || (!requested && !more)) {
+        /* whole representation fits */
+        return pdu_len;
+    }
+    value = (num << 4) | (more << 3) | szx;
+    return _add_option_uint(pdu, len, pdu_len, COAP_OPT_BLOCK2, value);
+}
+
+unsigned gcoap_obs_send(const coap_resource_t *resource)
+{
+    uint32_t now = xtimer_now_usec();
+    uint32_t delay = GCOAP_OBS_NOTIFY_INTERVAL;
+    unsigned count = 0;
+
+    mutex_lock(&_coap_state.obs_lock);
+    for (int i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        gcoap_observe_memo_t *obs = &_coap_state.observers[i];
+        if (obs->resource != resource) {
+            continue;
+        }
+        obs->pending = 1;
+        count++;
+
+        uint32_t elapsed = now - obs->last_notify;
+        if (elapsed >= GCOAP_OBS_NOTIFY_INTERVAL) {
+            delay = 0;
+        }
+        else if (GCOAP_OBS_NOTIFY_INTERVAL - elapsed < delay) {
+            delay = GCOAP_OBS_NOTIFY_INTERVAL - elapsed;
+        }
+    }
+    if (count) {
+        _obs_set_timer(delay);
+    }
+    mutex_unlock(&_coap_state.obs_lock);
+    return count;
+}
+
 void gcoap_op_state(uint8_t *open_reqs)
 {
     uint8_t count = 0;
@@ -0,0 +1,702 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_gnrc_lwmac
+ * @file
+ * @brief       Implementation of LWMAC
+ *
+ * @author      agent <agent@local>
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "net/gnrc.h"
+#include "net/gnrc/mac/internal.h"
+#include "net/gnrc/lwmac/hdr.h"
+#include "net/gnrc/lwmac/lwmac.h"
+#include "net/netdev2/ieee802154.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#if (GNRC_MAC_TX_QUEUE_SIZE == 0) || (GNRC_MAC_NEIGHBOR_COUNT == 0) || \
+    (GNRC_MAC_RX_QUEUE_SIZE == 0) || (GNRC_MAC_DISPATCH_BUFFER_SIZE == 0)
+#error "gnrc_lwmac: needs neighbor TX queues and RX queues of gnrc_mac"
+#endif
+
+/**
+ * @brief   Time the wake-up requests to a neighbor with known phase are
+ *          started before it wakes up
+ */
+#define LWMAC_WR_GUARD_US       (GNRC_LWMAC_TIME_BETWEEN_WR_US)
+
+static void _tx_start(gnrc_netdev2_t *gnrc_netdev2);
+
+static void _radio(gnrc_netdev2_t *gnrc_netdev2, bool on)
+{
+    netdev2_t *dev = gnrc_netdev2->dev;
+    netopt_state_t state = (on) ? NETOPT_STATE_IDLE : NETOPT_STATE_SLEEP;
+
+    if (gnrc_netdev2->lwmac.radio_on == on) {
+        return;
+    }
+    if (dev->driver->set(dev, NETOPT_STATE, &state, sizeof(state)) < 0) {
+        DEBUG("gnrc_lwmac: unable to switch radio %s\n", (on) ? "on" : "off");
+    }
+    gnrc_netdev2->lwmac.radio_on = on;
+}
+
+static void _arm(gnrc_netdev2_t *gnrc_netdev2, uint32_t usec)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+
+    lwmac->timer_msg.type = GNRC_LWMAC_MSG_TYPE_TIMEOUT;
+    lwmac->timer_msg.content.value = ++lwmac->timer_gen;
+    xtimer_set_msg(&lwmac->timer, usec, &lwmac->timer_msg, gnrc_netdev2->pid);
+}
+
+static void _disarm(gnrc_netdev2_t *gnrc_netdev2)
+{
+    xtimer_remove(&gnrc_netdev2->lwmac.timer);
+    gnrc_netdev2->lwmac.timer_gen++;
+}
+
+static inline bool _passed(uint32_t time)
+{
+    return ((int32_t)(xtimer_now_usec() - time)) >= 0;
+}
+
+/**
+ * @brief   Returns the current time modulo the wake-up interval
+ *
+ * The 32-bit time wraps at a value that is no multiple of the interval, so
+ * phases taken from it would jump on every wrap.
+ */
+static inline uint32_t _phase_now(void)
+{
+    return xtimer_now_usec64() % GNRC_LWMAC_WAKEUP_INTERVAL_US;
+}
+
+static bool _addr_equal(const uint8_t *a, size_t a_len,
+                        const uint8_t *b, size_t b_len)
+{
+    return (a_len == b_len) && (memcmp(a, b, a_len) == 0);
+}
+
+static bool _for_us(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
+{
+    netdev2_ieee802154_t *dev = (netdev2_ieee802154_t *)gnrc_netdev2->dev;
+    uint8_t *dst;
+    int dst_len = gnrc_netif_hdr_get_dstaddr(pkt, &dst);
+
+    return _addr_equal(dst, dst_len, dev->short_addr, sizeof(dev->short_addr)) ||
+           _addr_equal(dst, dst_len, dev->long_addr, sizeof(dev->long_addr));
+}
+
+/**
+ * @brief   Removes the LWMAC header from the payload of a received packet
+ */
+static bool _strip(gnrc_pktsnip_t *pkt, size_t hdr_len)
+{
+    if (pkt->size <= hdr_len) {
+        return false;
+    }
+    memmove(pkt->data, ((uint8_t *)pkt->data) + hdr_len, pkt->size - hdr_len);
+    return gnrc_pktbuf_realloc_data(pkt, pkt->size - hdr_len) == 0;
+}
+
+/**
+ * @brief   Passes @p pkt to the device, which releases it
+ *
+ * The device rejects a malformed packet with -EBADMSG or -EINVAL before
+ * taking it, so release it here then.
+ */
+static int _netdev_send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
+{
+    int res = gnrc_netdev2->send(gnrc_netdev2, pkt);
+
+    if ((res == -EBADMSG) || (res == -EINVAL)) {
+        gnrc_pktbuf_release(pkt);
+    }
+    return res;
+}
+
+static void _send_ctrl(gnrc_netdev2_t *gnrc_netdev2, const uint8_t *dst,
+                       size_t dst_len, void *frame, size_t frame_len)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+
+    pkt = gnrc_pktbuf_add(NULL, frame, frame_len, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        DEBUG("gnrc_lwmac: no space left in packet buffer\n");
+        return;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, (uint8_t *)dst, dst_len);
+    if (netif == NULL) {
+        DEBUG("gnrc_lwmac: no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    netif->next = pkt;
+    _netdev_send(gnrc_netdev2, netif);
+}
+
+/**
+ * @brief   Inserts the LWMAC header between netif header and payload and
+ *          sends the packet
+ *
+ * If sending fails, the header is removed again and @p pkt is still owned
+ * by the caller.
+ */
+static int _send_data(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt,
+                      void *hdr, size_t hdr_len)
+{
+    gnrc_pktsnip_t *lwmac_hdr = gnrc_pktbuf_add(pkt->next, hdr, hdr_len,
+                                                GNRC_NETTYPE_UNDEF);
+    int res;
+
+    if (lwmac_hdr == NULL) {
+        DEBUG("gnrc_lwmac: no space left in packet buffer\n");
+        return -ENOBUFS;
+    }
+    pkt->next = lwmac_hdr;
+    /* keep the packet in case the device does not take it */
+    gnrc_pktbuf_hold(pkt, 1);
+    res = _netdev_send(gnrc_netdev2, pkt);
+    if (res < 0) {
+        pkt->next = lwmac_hdr->next;
+        lwmac_hdr->next = NULL;
+        gnrc_pktbuf_release(lwmac_hdr);
+    }
+    else {
+        gnrc_pktbuf_release(pkt);
+    }
+    return res;
+}
+
+static void _dispatch(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_mac_rx_t *rx = &gnrc_netdev2->rx;
+    gnrc_pktsnip_t *pkt;
+
+    do {
+        unsigned i = 0;
+
+        while ((i < GNRC_MAC_DISPATCH_BUFFER_SIZE) &&
+               (pkt = gnrc_priority_pktqueue_pop(&rx->queue))) {
+            rx->dispatch_buffer[i++] = pkt;
+        }
+        gnrc_mac_dispatch(rx);
+    } while (gnrc_priority_pktqueue_length(&rx->queue) > 0);
+}
+
+static void _queue_rx(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
+{
+    if (!gnrc_mac_queue_rx_packet(&gnrc_netdev2->rx, 0, pkt)) {
+        DEBUG("gnrc_lwmac: RX queue full, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+/**
+ * @brief   Ends the current activity and switches the radio off
+ *
+ * Received packets are only passed up here, so the upper layers can not
+ * delay the handshakes.
+ */
+static void _sleep(gnrc_netdev2_t *gnrc_netdev2)
+{
+    _disarm(gnrc_netdev2);
+    _radio(gnrc_netdev2, false);
+    gnrc_netdev2->lwmac.state = GNRC_LWMAC_SLEEPING;
+    _dispatch(gnrc_netdev2);
+}
+
+static void _sleep_or_tx(gnrc_netdev2_t *gnrc_netdev2)
+{
+    _sleep(gnrc_netdev2);
+    _tx_start(gnrc_netdev2);
+}
+
+static void _send_wr(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_mac_tx_neighbor_t *neighbor = gnrc_netdev2->tx.current_neighbor;
+    gnrc_lwmac_hdr_t wr = { GNRC_LWMAC_FRAMETYPE_WR };
+
+    _send_ctrl(gnrc_netdev2, neighbor->l2_addr, neighbor->l2_addr_len,
+               &wr, sizeof(wr));
+}
+
+static void _tx_wr_start(gnrc_netdev2_t *gnrc_netdev2, uint32_t duration)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+
+    _radio(gnrc_netdev2, true);
+    lwmac->state = GNRC_LWMAC_TX_WR;
+    lwmac->deadline = xtimer_now_usec() + duration;
+    _send_wr(gnrc_netdev2);
+    _arm(gnrc_netdev2, GNRC_LWMAC_TIME_BETWEEN_WR_US);
+}
+
+static void _tx_broadcast(gnrc_netdev2_t *gnrc_netdev2)
+{
+    /* keep the packet for the next repetition */
+    gnrc_pktbuf_hold(gnrc_netdev2->tx.packet, 1);
+    _netdev_send(gnrc_netdev2, gnrc_netdev2->tx.packet);
+    _arm(gnrc_netdev2, GNRC_LWMAC_TIME_BETWEEN_BROADCAST_US);
+}
+
+static void _tx_done(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_netdev2->tx.packet = NULL;
+    gnrc_netdev2->tx.current_neighbor = NULL;
+    gnrc_netdev2->lwmac.tx_retries = 0;
+}
+
+/**
+ * @brief   Counts a failed attempt to send the current packet and drops it
+ *          after @ref GNRC_LWMAC_MAX_TX_RETRIES attempts
+ */
+static void _tx_retry(gnrc_netdev2_t *gnrc_netdev2)
+{
+    if (++gnrc_netdev2->lwmac.tx_retries >= GNRC_LWMAC_MAX_TX_RETRIES) {
+        DEBUG("gnrc_lwmac: giving up, dropping packet\n");
+        gnrc_pktbuf_release(gnrc_netdev2->tx.packet);
+        _tx_done(gnrc_netdev2);
+    }
+}
+
+/**
+ * @brief   Sends all packets queued for the neighbor that just answered
+ */
+static void _tx_burst(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_mac_tx_t *tx = &gnrc_netdev2->tx;
+    gnrc_mac_tx_neighbor_t *neighbor = tx->current_neighbor;
+
+    _disarm(gnrc_netdev2);
+    while (tx->packet != NULL) {
+        bool more = (gnrc_priority_pktqueue_length(&neighbor->queue) > 0);
+        gnrc_lwmac_hdr_t hdr = {
+            (more) ? GNRC_LWMAC_FRAMETYPE_DATA_PENDING : GNRC_LWMAC_FRAMETYPE_DATA
+        };
+
+        if (_send_data(gnrc_netdev2, tx->packet, &hdr, sizeof(hdr)) < 0) {
+            DEBUG("gnrc_lwmac: unable to send data\n");
+            break;
+        }
+        gnrc_netdev2->lwmac.tx_retries = 0;
+        tx->packet = (more) ? gnrc_priority_pktqueue_pop(&neighbor->queue) : NULL;
+    }
+    if (tx->packet == NULL) {
+        _tx_done(gnrc_netdev2);
+    }
+    else {
+        /* the rest is sent at the neighbor's next wake-up */
+        _tx_retry(gnrc_netdev2);
+    }
+    _sleep_or_tx(gnrc_netdev2);
+}
+
+static void _tx_start(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+    gnrc_mac_tx_t *tx = &gnrc_netdev2->tx;
+    gnrc_mac_tx_neighbor_t *neighbor;
+
+    if (tx->packet == NULL) {
+        /* neighbor 0 holds the broadcasts, so they go first */
+        for (unsigned i = 0; i <= GNRC_MAC_NEIGHBOR_COUNT; i++) {
+            if (gnrc_priority_pktqueue_length(&tx->neighbors[i].queue) > 0) {
+                tx->current_neighbor = &tx->neighbors[i];
+                tx->packet = gnrc_priority_pktqueue_pop(&tx->neighbors[i].queue);
+                lwmac->tx_retries = 0;
+                break;
+            }
+        }
+        if (tx->packet == NULL) {
+            return;
+        }
+        if (tx->current_neighbor == &tx->neighbors[0]) {
+            gnrc_lwmac_frame_broadcast_t hdr = {
+                { GNRC_LWMAC_FRAMETYPE_BROADCAST }, lwmac->bcast_seq++
+            };
+            gnrc_pktsnip_t *lwmac_hdr = gnrc_pktbuf_add(tx->packet->next, &hdr,
+                                                        sizeof(hdr),
+                                                        GNRC_NETTYPE_UNDEF);
+            if (lwmac_hdr == NULL) {
+                DEBUG("gnrc_lwmac: no space left in packet buffer\n");
+                gnrc_pktbuf_release(tx->packet);
+                _tx_done(gnrc_netdev2);
+                return;
+            }
+            tx->packet->next = lwmac_hdr;
+        }
+    }
+    neighbor = tx->current_neighbor;
+    if (neighbor == &tx->neighbors[0]) {
+        _radio(gnrc_netdev2, true);
+        lwmac->state = GNRC_LWMAC_TX_BROADCAST;
+        lwmac->deadline = xtimer_now_usec() + GNRC_LWMAC_BROADCAST_DURATION_US;
+        _tx_broadcast(gnrc_netdev2);
+    }
+    else if (neighbor->phase >= GNRC_LWMAC_WAKEUP_INTERVAL_US) {
+        /* phase unknown: wake-up requests for a whole interval */
+        _tx_wr_start(gnrc_netdev2, GNRC_LWMAC_WAKEUP_INTERVAL_US +
+                                   GNRC_LWMAC_WAKEUP_DURATION_US);
+    }
+    else {
+        uint32_t wait = (neighbor->phase + (2 * GNRC_LWMAC_WAKEUP_INTERVAL_US) -
+                         LWMAC_WR_GUARD_US - _phase_now()) %
+                        GNRC_LWMAC_WAKEUP_INTERVAL_US;
+
+        DEBUG("gnrc_lwmac: waiting %" PRIu32 " us for neighbor to wake up\n", wait);
+        _radio(gnrc_netdev2, false);
+        lwmac->state = GNRC_LWMAC_TX_WAIT_PHASE;
+        _arm(gnrc_netdev2, wait);
+    }
+}
+
+static void _tx_failed(gnrc_netdev2_t *gnrc_netdev2)
+{
+    /* the neighbor's clock may have drifted, search for it again */
+    gnrc_netdev2->tx.current_neighbor->phase = GNRC_MAC_PHASE_MAX;
+    _tx_retry(gnrc_netdev2);
+    /* try again after the next wake-up */
+    _sleep(gnrc_netdev2);
+}
+
+static bool _bcast_seen(gnrc_lwmac_t *lwmac, const uint8_t *src, int src_len,
+                        uint8_t seq_nr)
+{
+    gnrc_lwmac_bcast_seen_t *entry;
+
+    for (unsigned i = 0; i < GNRC_LWMAC_BROADCAST_SEEN_NUMOF; i++) {
+        entry = &lwmac->bcast_seen[i];
+        if (_addr_equal(entry->addr, entry->addr_len, src, src_len)) {
+            if (entry->seq_nr == seq_nr) {
+                return true;
+            }
+            entry->seq_nr = seq_nr;
+            return false;
+        }
+    }
+    entry = &lwmac->bcast_seen[lwmac->bcast_seen_next];
+    lwmac->bcast_seen_next = (lwmac->bcast_seen_next + 1) %
+                             GNRC_LWMAC_BROADCAST_SEEN_NUMOF;
+    memcpy(entry->addr, src, src_len);
+    entry->addr_len = src_len;
+    entry->seq_nr = seq_nr;
+    return false;
+}
+
+static void _rx(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+    gnrc_mac_tx_neighbor_t *neighbor = gnrc_netdev2->tx.current_neighbor;
+    gnrc_lwmac_hdr_t *hdr = pkt->data;
+    uint8_t *src;
+    int src_len = gnrc_netif_hdr_get_srcaddr(pkt, &src);
+
+    if ((pkt->size < sizeof(gnrc_lwmac_hdr_t)) || (src_len <= 0) ||
+        (src_len > (int)IEEE802154_LONG_ADDRESS_LEN)) {
+        DEBUG("gnrc_lwmac: dropping invalid frame\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    switch (hdr->type) {
+        case GNRC_LWMAC_FRAMETYPE_WR:
+            if (_for_us(gnrc_netdev2, pkt) &&
+                ((lwmac->state == GNRC_LWMAC_LISTENING) ||
+                 ((lwmac->state == GNRC_LWMAC_RECEIVING) &&
+                  _addr_equal(lwmac->peer, lwmac->peer_len, src, src_len)))) {
+                gnrc_lwmac_frame_wa_t wa;
+
+                wa.header.type = GNRC_LWMAC_FRAMETYPE_WA;
+                wa.phase = byteorder_htonl(xtimer_now_usec() - lwmac->wakeup_start);
+                memcpy(lwmac->peer, src, src_len);
+                lwmac->peer_len = src_len;
+                lwmac->state = GNRC_LWMAC_RECEIVING;
+                _send_ctrl(gnrc_netdev2, src, src_len, &wa, sizeof(wa));
+                _arm(gnrc_netdev2, GNRC_LWMAC_DATA_DELAY_US);
+            }
+            break;
+        case GNRC_LWMAC_FRAMETYPE_WA:
+            if ((lwmac->state == GNRC_LWMAC_TX_WR) &&
+                (pkt->size >= sizeof(gnrc_lwmac_frame_wa_t)) &&
+                _for_us(gnrc_netdev2, pkt) &&
+                _addr_equal(neighbor->l2_addr, neighbor->l2_addr_len,
+                            src, src_len)) {
+                gnrc_lwmac_frame_wa_t *wa = pkt->data;
+                uint32_t offset = byteorder_ntohl(wa->phase) %
+                                  GNRC_LWMAC_WAKEUP_INTERVAL_US;
+
+                neighbor->phase = (_phase_now() + GNRC_LWMAC_WAKEUP_INTERVAL_US -
+                                   offset) % GNRC_LWMAC_WAKEUP_INTERVAL_US;
+                gnrc_pktbuf_release(pkt);
+                _tx_burst(gnrc_netdev2);
+                return;
+            }
+            break;
+        case GNRC_LWMAC_FRAMETYPE_DATA:
+        case GNRC_LWMAC_FRAMETYPE_DATA_PENDING:
+            if ((lwmac->state == GNRC_LWMAC_RECEIVING) &&
+                _addr_equal(lwmac->peer, lwmac->peer_len, src, src_len)) {
+                bool pending = (hdr->type == GNRC_LWMAC_FRAMETYPE_DATA_PENDING);
+
+                if (_strip(pkt, sizeof(gnrc_lwmac_hdr_t))) {
+                    _queue_rx(gnrc_netdev2, pkt);
+                    pkt = NULL;
+                }
+                if (pending) {
+                    _arm(gnrc_netdev2, GNRC_LWMAC_DATA_DELAY_US);
+                }
+                else {
+                    _sleep_or_tx(gnrc_netdev2);
+                }
+            }
+            break;
+        case GNRC_LWMAC_FRAMETYPE_BROADCAST:
+            if (pkt->size >= sizeof(gnrc_lwmac_frame_broadcast_t)) {
+                gnrc_lwmac_frame_broadcast_t *bcast = pkt->data;
+
+                if (!_bcast_seen(lwmac, src, src_len, bcast->seq_nr) &&
+                    _strip(pkt, sizeof(gnrc_lwmac_frame_broadcast_t))) {
+                    _queue_rx(gnrc_netdev2, pkt);
+                    pkt = NULL;
+                }
+            }
+            break;
+        default:
+            DEBUG("gnrc_lwmac: unknown frame type %u\n", hdr->type);
+            break;
+    }
+    if (pkt != NULL) {
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static void _wakeup(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+    uint32_t now = xtimer_now_usec();
+
+    lwmac->next_wakeup += GNRC_LWMAC_WAKEUP_INTERVAL_US;
+    if (_passed(lwmac->next_wakeup)) {
+        /* we were held up for longer than an interval */
+        lwmac->next_wakeup = now + GNRC_LWMAC_WAKEUP_INTERVAL_US;
+    }
+    xtimer_set_msg(&lwmac->wakeup_timer, lwmac->next_wakeup - now,
+                   &lwmac->wakeup_msg, gnrc_netdev2->pid);
+    if (lwmac->state == GNRC_LWMAC_SLEEPING) {
+        lwmac->wakeup_start = now;
+        lwmac->state = GNRC_LWMAC_LISTENING;
+        _radio(gnrc_netdev2, true);
+        _arm(gnrc_netdev2, GNRC_LWMAC_WAKEUP_DURATION_US);
+    }
+}
+
+static void _timeout(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+
+    switch (lwmac->state) {
+        case GNRC_LWMAC_LISTENING:
+        case GNRC_LWMAC_RECEIVING:
+            _sleep_or_tx(gnrc_netdev2);
+            break;
+        case GNRC_LWMAC_TX_WAIT_PHASE:
+            _tx_wr_start(gnrc_netdev2, (2 * LWMAC_WR_GUARD_US) +
+                                       GNRC_LWMAC_WAKEUP_DURATION_US);
+            break;
+        case GNRC_LWMAC_TX_WR:
+            if (_passed(lwmac->deadline)) {
+                _tx_failed(gnrc_netdev2);
+            }
+            else {
+                _send_wr(gnrc_netdev2);
+                _arm(gnrc_netdev2, GNRC_LWMAC_TIME_BETWEEN_WR_US);
+            }
+            break;
+        case GNRC_LWMAC_TX_BROADCAST:
+            if (_passed(lwmac->deadline)) {
+                gnrc_pktbuf_release(gnrc_netdev2->tx.packet);
+                _tx_done(gnrc_netdev2);
+                _sleep_or_tx(gnrc_netdev2);
+            }
+            else {
+                _tx_broadcast(gnrc_netdev2);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void _event_cb(netdev2_t *dev, netdev2_event_t event)
+{
+    gnrc_netdev2_t *gnrc_netdev2 = (gnrc_netdev2_t *) dev->context;
+
+    if (event == NETDEV2_EVENT_ISR) {
+        msg_t msg;
+
+        msg.type = NETDEV2_MSG_TYPE_EVENT;
+        msg.content.ptr = gnrc_netdev2;
+
+        if (msg_send(&msg, gnrc_netdev2->pid) <= 0) {
+            puts("gnrc_lwmac: possibly lost interrupt.");
+        }
+    }
+    else {
+        DEBUG("gnrc_lwmac: event triggered -> %i\n", event);
+#ifdef MODULE_GNRC_NETDEV2_IEEE802154_TX
+        if ((event >= NETDEV2_EVENT_TX_STARTED) &&
+            (event <= NETDEV2_EVENT_TX_MEDIUM_BUSY) &&
+            gnrc_netdev2_ieee802154_tx_ignore_event(gnrc_netdev2)) {
+            return;
+        }
+#endif
+        switch (event) {
+            case NETDEV2_EVENT_RX_STARTED:
+                gnrc_netdev2_set_rx_started(gnrc_netdev2, true);
+                break;
+            case NETDEV2_EVENT_RX_COMPLETE: {
+                gnrc_pktsnip_t *pkt = gnrc_netdev2->recv(gnrc_netdev2);
+
+                gnrc_netdev2_set_rx_started(gnrc_netdev2, false);
+                if (pkt) {
+                    _rx(gnrc_netdev2, pkt);
+                }
+                break;
+            }
+            case NETDEV2_EVENT_TX_COMPLETE:
+                gnrc_netdev2_set_tx_feedback(gnrc_netdev2, TX_FEEDBACK_SUCCESS);
+                break;
+            case NETDEV2_EVENT_TX_NOACK:
+                gnrc_netdev2_set_tx_feedback(gnrc_netdev2, TX_FEEDBACK_NOACK);
+                break;
+            case NETDEV2_EVENT_TX_MEDIUM_BUSY:
+                gnrc_netdev2_set_tx_feedback(gnrc_netdev2, TX_FEEDBACK_BUSY);
+                break;
+            default:
+                DEBUG("gnrc_lwmac: warning: unhandled event %u.\n", event);
+        }
+    }
+}
+
+static void *_lwmac_thread(void *args)
+{
+    gnrc_netdev2_t *gnrc_netdev2 = (gnrc_netdev2_t *) args;
+    gnrc_lwmac_t *lwmac = &gnrc_netdev2->lwmac;
+    netdev2_t *dev = gnrc_netdev2->dev;
+    netopt_enable_t disable = NETOPT_DISABLE;
+    gnrc_netapi_opt_t *opt;
+    int res;
+    msg_t msg, reply, msg_queue[GNRC_LWMAC_MSG_QUEUE_SIZE];
+
+    DEBUG("gnrc_lwmac: starting thread\n");
+
+    gnrc_netdev2->pid = thread_getpid();
+    msg_init_queue(msg_queue, GNRC_LWMAC_MSG_QUEUE_SIZE);
+
+    dev->event_callback = _event_cb;
+    dev->context = (void *) gnrc_netdev2;
+
+    gnrc_netif_add(thread_getpid());
+
+    dev->driver->init(dev);
+    /* the wake-up answer replaces link-layer acknowledgements */
+    dev->driver->set(dev, NETOPT_ACK_REQ, &disable, sizeof(disable));
+
+    lwmac->wakeup_msg.type = GNRC_LWMAC_MSG_TYPE_WAKEUP;
+    lwmac->radio_on = true;
+    _sleep(gnrc_netdev2);
+    lwmac->next_wakeup = xtimer_now_usec() - GNRC_LWMAC_WAKEUP_INTERVAL_US;
+    _wakeup(gnrc_netdev2);
+
+    while (1) {
+        msg_receive(&msg);
+        switch (msg.type) {
+            case NETDEV2_MSG_TYPE_EVENT:
+                dev->driver->isr(dev);
+                break;
+            case GNRC_LWMAC_MSG_TYPE_WAKEUP:
+                _wakeup(gnrc_netdev2);
+                break;
+            case GNRC_LWMAC_MSG_TYPE_TIMEOUT:
+                if (msg.content.value == lwmac->timer_gen) {
+                    _timeout(gnrc_netdev2);
+                }
+                break;
+#ifdef MODULE_GNRC_NETDEV2_IEEE802154_TX
+            case GNRC_NETDEV2_IEEE802154_TX_MSG_TYPE:
+                gnrc_netdev2_ieee802154_tx_timeout(gnrc_netdev2, &msg);
+                break;
+#endif
+            case GNRC_NETAPI_MSG_TYPE_SND: {
+                gnrc_pktsnip_t *pkt = msg.content.ptr;
+                gnrc_netif_hdr_t *hdr = pkt->data;
+
+                /* multicast is done by broadcast on this link layer */
+                if (hdr->flags & GNRC_NETIF_HDR_FLAGS_MULTICAST) {
+                    hdr->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+                }
+                if (!gnrc_mac_queue_tx_packet(&gnrc_netdev2->tx, 0, pkt)) {
+                    DEBUG("gnrc_lwmac: TX queue full, dropping packet\n");
+                    gnrc_pktbuf_release(pkt);
+                }
+                else if (lwmac->state == GNRC_LWMAC_SLEEPING) {
+                    _tx_start(gnrc_netdev2);
+                }
+                break;
+            }
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                opt = msg.content.ptr;
+                res = dev->driver->set(dev, opt->opt, opt->data, opt->data_len);
+                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+                reply.content.value = (uint32_t)res;
+                msg_reply(&msg, &reply);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_GET:
+                opt = msg.content.ptr;
+                res = dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
+                reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+                reply.content.value = (uint32_t)res;
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                DEBUG("gnrc_lwmac: Unknown command %" PRIu16 "\n", msg.type);
+                break;
+        }
+    }
+    /* never reached */
+    return NULL;
+}
+
+kernel_pid_t gnrc_lwmac_init(char *stack, int stacksize, char priority,
+                             const char *name, gnrc_netdev2_t *gnrc_netdev2)
+{
+    kernel_pid_t res;
+
+    if ((gnrc_netdev2 == NULL) || (gnrc_netdev2->dev == NULL)) {
+        return -ENODEV;
+    }
+    res = thread_create(stack, stacksize, priority, THREAD_CREATE_STACKTEST,
+                        _lwmac_thread, (void *)gnrc_netdev2, name);
+    if (res <= 0) {
+        return -EINVAL;
+    }
+    return res;
+}
@@ -62,6 +62,14 @@ static void _event_cb(netdev2_t *dev, netdev2_event_t event)
     }
     else {
         DEBUG("gnrc_netdev2: event triggered -> %i\n", event);
+#ifdef MODULE_GNRC_NETDEV2_IEEE802154_TX
+        if ((event >= NETDEV2_EVENT_TX_STARTED) &&
+            (event <= NETDEV2_EVENT_TX_MEDIUM_BUSY) &&
+            gnrc_netdev2_ieee802154_tx_ignore_event(gnrc_netdev2)) {
+            /* the software TX engine reports the outcome itself */
+            return;
+        }
+#endif
         switch(event) {
             case NETDEV2_EVENT_RX_COMPLETE:
                 {
@@ -73,12 +81,27 @@ static void _event_cb(netdev2_t *dev, netdev2_event_t event)
 
                     break;
                 }
-#ifdef MODULE_NETSTATS_L2
+#if defined(MODULE_NETSTATS_L2) || defined(MODULE_NETSTATS_NEIGHBOR)
             case NETDEV2_EVENT_TX_MEDIUM_BUSY:
+#ifdef MODULE_NETSTATS_L2
                 dev->stats.tx_failed++;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                netstats_nb_update_tx(&gnrc_netdev2->nb_tx, NETSTATS_NB_BUSY);
+#endif
                 break;
             case NETDEV2_EVENT_TX_COMPLETE:
+#ifdef MODULE_NETSTATS_L2
                 dev->stats.tx_success++;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                netstats_nb_update_tx(&gnrc_netdev2->nb_tx, NETSTATS_NB_SUCCESS);
+#endif
+                break;
+#endif
+#ifdef MODULE_NETSTATS_NEIGHBOR
+            case NETDEV2_EVENT_TX_NOACK:
+                netstats_nb_update_tx(&gnrc_netdev2->nb_tx, NETSTATS_NB_NOACK);
                 break;
 #endif
             default:
@@ -87,6 +110,31 @@ static void _event_cb(netdev2_t *dev, netdev2_event_t event)
     }
 }
 
+#ifdef MODULE_NETSTATS_NEIGHBOR
+/**
+ * @brief   Remembers the neighbor a frame is sent to for the TX events
+ *
+ * @param[in] gnrc_netdev2  the sending interface
+ * @param[in] pkt           the frame, starting with its netif header
+ */
+static void _record_nb(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *hdr;
+
+    gnrc_netdev2->nb_tx.nb = NULL;
+    if ((pkt == NULL) || (pkt->type != GNRC_NETTYPE_NETIF)) {
+        return;
+    }
+    hdr = pkt->data;
+    if (hdr->flags & (GNRC_NETIF_HDR_FLAGS_BROADCAST | GNRC_NETIF_HDR_FLAGS_MULTICAST)) {
+        return;
+    }
+    gnrc_netdev2->nb_tx = netstats_nb_record(gnrc_netdev2->pid,
+                                             gnrc_netif_hdr_get_dst_addr(hdr),
+                                             hdr->dst_l2addr_len);
+}
+#endif
+
 static void _pass_on_packet(gnrc_pktsnip_t *pkt)
 {
     /* throw away packet if no one is interested */
@@ -143,8 +191,16 @@ static void *_gnrc_netdev2_thread(void *args)
             case GNRC_NETAPI_MSG_TYPE_SND:
                 DEBUG("gnrc_netdev2: GNRC_NETAPI_MSG_TYPE_SND received\n");
                 gnrc_pktsnip_t *pkt = msg.content.ptr;
+#ifdef MODULE_NETSTATS_NEIGHBOR
+                _record_nb(gnrc_netdev2, pkt);
+#endif
                 gnrc_netdev2->send(gnrc_netdev2, pkt);
                 break;
+#ifdef MODULE_GNRC_NETDEV2_IEEE802154_TX
+            case GNRC_NETDEV2_IEEE802154_TX_MSG_TYPE:
+                gnrc_netdev2_ieee802154_tx_timeout(gnrc_netdev2, &msg);
+                break;
+#endif
             case GNRC_NETAPI_MSG_TYPE_SET:
                 /* read incoming options */
                 opt = msg.content.ptr;
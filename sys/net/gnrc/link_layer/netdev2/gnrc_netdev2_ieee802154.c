@@ -14,6 +14,7 @@
  */
 
 #include <stddef.h>
+#include <string.h>
 
 #include "od.h"
 #include "net/gnrc.h"
@@ -78,6 +79,8 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
         pkt = gnrc_pktbuf_add(NULL, NULL, bytes_expected, GNRC_NETTYPE_UNDEF);
         if (pkt == NULL) {
             DEBUG("_recv_ieee802154: cannot allocate pktsnip.\n");
+            /* drop the frame */
+            netdev->driver->recv(netdev, NULL, bytes_expected, NULL);
             return NULL;
         }
         nread = netdev->driver->recv(netdev, pkt->data, bytes_expected, &rx_info);
@@ -85,28 +88,28 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
             gnrc_pktbuf_release(pkt);
             return NULL;
         }
+#ifdef MODULE_GNRC_NETDEV2_IEEE802154_TX
+        if (gnrc_netdev2_ieee802154_tx_recv(gnrc_netdev2, pkt->data, nread)) {
+            /* acknowledgements are consumed by the TX engine */
+            gnrc_pktbuf_release(pkt);
+            return NULL;
+        }
+#endif
         if (!(state->flags & NETDEV2_IEEE802154_RAW)) {
-            gnrc_pktsnip_t *ieee802154_hdr, *netif_hdr;
+            gnrc_pktsnip_t *netif_hdr;
             gnrc_netif_hdr_t *hdr;
 #if ENABLE_DEBUG
             char src_str[GNRC_NETIF_HDR_L2ADDR_PRINT_LEN];
 #endif
             size_t mhr_len = ieee802154_get_frame_hdr_len(pkt->data);
 
-            if (mhr_len == 0) {
+            if ((mhr_len == 0) || (mhr_len > (size_t)nread)) {
                 DEBUG("_recv_ieee802154: illegally formatted frame received\n");
                 gnrc_pktbuf_release(pkt);
                 return NULL;
             }
             nread -= mhr_len;
-            /* mark IEEE 802.15.4 header */
-            ieee802154_hdr = gnrc_pktbuf_mark(pkt, mhr_len, GNRC_NETTYPE_UNDEF);
-            if (ieee802154_hdr == NULL) {
-                DEBUG("_recv_ieee802154: no space left in packet buffer\n");
-                gnrc_pktbuf_release(pkt);
-                return NULL;
-            }
-            netif_hdr = _make_netif_hdr(ieee802154_hdr->data);
+            netif_hdr = _make_netif_hdr(pkt->data);
             if (netif_hdr == NULL) {
                 DEBUG("_recv_ieee802154: no space left in packet buffer\n");
                 gnrc_pktbuf_release(pkt);
@@ -116,6 +119,9 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
             hdr->lqi = rx_info.lqi;
             hdr->rssi = rx_info.rssi;
             hdr->if_pid = thread_getpid();
+            /* strip the MAC header in place instead of marking it, which
+             * would copy the payload into a new snip */
+            memmove(pkt->data, ((uint8_t *)pkt->data) + mhr_len, nread);
             pkt->type = state->proto;
 #if ENABLE_DEBUG
             DEBUG("_recv_ieee802154: received packet from %s of length %u\n",
@@ -127,7 +133,6 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
             od_hex_dump(pkt->data, nread, OD_WIDTH_DEFAULT);
 #endif
 #endif
-            gnrc_pktbuf_remove_snip(pkt, ieee802154_hdr);
             LL_APPEND(pkt, netif_hdr);
         }
 
@@ -138,9 +143,15 @@ static gnrc_pktsnip_t *_recv(gnrc_netdev2_t *gnrc_netdev2)
     return pkt;
 }
 
+/*
+ * Releases pkt, unless it is rejected with -EBADMSG or -EINVAL before it
+ * reaches the device.
+ */
 static int _send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
 {
+#ifndef MODULE_GNRC_NETDEV2_IEEE802154_TX
     netdev2_t *netdev = gnrc_netdev2->dev;
+#endif
     netdev2_ieee802154_t *state = (netdev2_ieee802154_t *)gnrc_netdev2->dev;
     gnrc_netif_hdr_t *netif_hdr;
     gnrc_pktsnip_t *vec_snip;
@@ -208,9 +219,16 @@ static int _send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
             gnrc_netdev2->dev->stats.tx_unicast_count++;
         }
 #endif
+#ifdef MODULE_GNRC_NETDEV2_IEEE802154_TX
+        /* takes care of releasing the packet */
+        return gnrc_netdev2_ieee802154_tx_send(gnrc_netdev2, pkt);
+#else
         res = netdev->driver->send(netdev, vector, n);
+#endif
     }
     else {
+        /* dropped, like a frame the TX engine has no space for */
+        gnrc_pktbuf_release(pkt);
         return -ENOBUFS;
     }
     /* release old data */
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_gnrc_netdev2_ieee802154_tx
+ * @file
+ * @brief       IEEE 802.15.4 software TX engine
+ *
+ * @author      agent <agent@local>
+ * @}
+ */
+
+#ifdef MODULE_GNRC_NETDEV2_IEEE802154_TX
+
+#include <errno.h>
+#include <string.h>
+
+#include "random.h"
+#include "net/csma_sender.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netdev2.h"
+#include "net/gnrc/netdev2/ieee802154_tx.h"
+#include "net/netdev2/ieee802154.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @brief   States of the frame at the head of the queue
+ */
+enum {
+    TX_STATE_IDLE = 0,          /**< queue is empty */
+    TX_STATE_BACKOFF,           /**< waiting for the next CCA */
+    TX_STATE_WAIT_ACK,          /**< waiting for the acknowledgement */
+};
+
+#define TX_FLAG_SW          (0x01)  /**< device does no CSMA/CA and
+                                     *   retransmissions itself */
+#define TX_FLAG_SW_ACK      (0x02)  /**< device sends no ACKs itself */
+#define TX_FLAG_REPORTING   (0x04)  /**< engine reports an outcome */
+#define TX_FLAG_SENDING_ACK (0x08)  /**< engine sends an ACK */
+
+#define ACK_FRAME_LEN       (3U)    /**< FCF and sequence number, w/o FCS */
+
+static bool _dev_enabled(netdev2_t *dev, netopt_t opt)
+{
+    netopt_enable_t enable = NETOPT_DISABLE;
+
+    return (dev->driver->get(dev, opt, &enable, sizeof(enable)) >= 0) &&
+           (enable == NETOPT_ENABLE);
+}
+
+static void _update_flags(gnrc_netdev2_ieee802154_tx_t *tx, netdev2_t *dev)
+{
+    uint8_t retrans;
+
+    tx->flags &= ~(TX_FLAG_SW | TX_FLAG_SW_ACK);
+    /* devices that report a retransmission limit retransmit in hardware */
+    if (!_dev_enabled(dev, NETOPT_CSMA) &&
+        (dev->driver->get(dev, NETOPT_RETRANS, &retrans, sizeof(retrans)) < 0)) {
+        tx->flags |= TX_FLAG_SW;
+    }
+    if (!_dev_enabled(dev, NETOPT_AUTOACK)) {
+        tx->flags |= TX_FLAG_SW_ACK;
+    }
+}
+
+static void _arm(gnrc_netdev2_t *gnrc_netdev2, uint32_t usec)
+{
+    gnrc_netdev2_ieee802154_tx_t *tx = &gnrc_netdev2->ieee802154_tx;
+
+    tx->timer_msg.type = GNRC_NETDEV2_IEEE802154_TX_MSG_TYPE;
+    tx->timer_msg.content.value = ++tx->timer_gen;
+    xtimer_set_msg(&tx->timer, usec, &tx->timer_msg, gnrc_netdev2->pid);
+}
+
+static void _backoff(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_netdev2_ieee802154_tx_t *tx = &gnrc_netdev2->ieee802154_tx;
+    const csma_sender_conf_t *conf = &CSMA_SENDER_CONF_DEFAULT;
+
+    tx->state = TX_STATE_BACKOFF;
+    /* random(2^BE - 1) unit backoff periods, IEEE 802.15.4-2011, 5.1.1.4 */
+    _arm(gnrc_netdev2, (random_uint32() & ((1U << tx->be) - 1)) *
+         conf->backoff_period);
+}
+
+static void _attempt(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_netdev2_ieee802154_tx_t *tx = &gnrc_netdev2->ieee802154_tx;
+
+    tx->nb = 0;
+    tx->be = CSMA_SENDER_CONF_DEFAULT.min_be;
+    _backoff(gnrc_netdev2);
+}
+
+static void _finish(gnrc_netdev2_t *gnrc_netdev2, netdev2_event_t event)
+{
+    gnrc_netdev2_ieee802154_tx_t *tx = &gnrc_netdev2->ieee802154_tx;
+    gnrc_netdev2_ieee802154_tx_frame_t *frame = &tx->queue[tx->head];
+    netdev2_t *dev = gnrc_netdev2->dev;
+
+    xtimer_remove(&tx->timer);
+    /* invalidate a timer message that might already be queued */
+    tx->timer_gen++;
+    gnrc_pktbuf_release(frame->vec);
+    frame->vec = NULL;
+#ifdef MODULE_NETSTATS_NEIGHBOR
+    gnrc_netdev2->nb_tx = frame->nb;
+#endif
+    tx->head = (tx->head + 1) % GNRC_NETDEV2_IEEE802154_TX_QUEUE_SIZE;
+    tx->len--;
+    tx->state = TX_STATE_IDLE;
+    DEBUG("ieee802154_tx: frame done (event %u), %u left in queue\n",
+          (unsigned)event, (unsigned)tx->len);
+    if (dev->event_callback) {
+        tx->flags |= TX_FLAG_REPORTING;
+        dev->event_callback(dev, event);
+        tx->flags &= ~TX_FLAG_REPORTING;
+    }
+    if (tx->len > 0) {
+        tx->retrans = 0;
+        _attempt(gnrc_netdev2);
+    }
+}
+
+static void _transmit(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_netdev2_ieee802154_tx_t *tx = &gnrc_netdev2->ieee802154_tx;
+    gnrc_netdev2_ieee802154_tx_frame_t *frame = &tx->queue[tx->head];
+    const csma_sender_conf_t *conf = &CSMA_SENDER_CONF_DEFAULT;
+    netdev2_t *dev = gnrc_netdev2->dev;
+    netopt_enable_t clear = NETOPT_ENABLE;
+    int res;
+
+    /* devices without CCA are assumed to always find the channel clear */
+    dev->driver->get(dev, NETOPT_IS_CHANNEL_CLR, &clear, sizeof(clear));
+    if (clear != NETOPT_ENABLE) {
+        DEBUG("ieee802154_tx: channel busy\n");
+        if (++tx->nb > conf->max_backoffs) {
+            _finish(gnrc_netdev2, NETDEV2_EVENT_TX_MEDIUM_BUSY);
+            return;
+        }
+        if (tx->be < conf->max_be) {
+            tx->be++;
+        }
+        _backoff(gnrc_netdev2);
+        return;
+    }
+    res = dev->driver->send(dev, frame->vec->data,
+                            frame->vec->size / sizeof(struct iovec));
+    if (res < 0) {
+        DEBUG("ieee802154_tx: device failed to send (%d)\n", res);
+        _finish(gnrc_netdev2, NETDEV2_EVENT_TX_MEDIUM_BUSY);
+    }
+    else if (frame->mhr[0] & IEEE802154_FCF_ACK_REQ) {
+        tx->state = TX_STATE_WAIT_ACK;
+        _arm(gnrc_netdev2, GNRC_NETDEV2_IEEE802154_TX_ACK_TIMEOUT);
+    }
+    else {
+        _finish(gnrc_netdev2, NETDEV2_EVENT_TX_COMPLETE);
+    }
+}
+
+int gnrc_netdev2_ieee802154_tx_send(gnrc_netdev2_t *gnrc_netdev2,
+                                    gnrc_pktsnip_t *vec)
+{
+    gnrc_netdev2_ieee802154_tx_t *tx = &gnrc_netdev2->ieee802154_tx;
+    gnrc_netdev2_ieee802154_tx_frame_t *frame;
+    netdev2_t *dev = gnrc_netdev2->dev;
+    struct iovec *vector = vec->data;
+    unsigned n = vec->size / sizeof(struct iovec);
+    int res = 0;
+
+    /* the mode of the device can only change with an empty queue */
+    if (tx->len == 0) {
+        _update_flags(tx, dev);
+    }
+    if (!(tx->flags & TX_FLAG_SW)) {
+        res = dev->driver->send(dev, vector, n);
+        gnrc_pktbuf_release(vec);
+        return res;
+    }
+    if (tx->len >= GNRC_NETDEV2_IEEE802154_TX_QUEUE_SIZE) {
+        DEBUG("ieee802154_tx: queue full, dropping frame\n");
+        gnrc_pktbuf_release(vec);
+        return -ENOBUFS;
+    }
+    frame = &tx->queue[(tx->head + tx->len) % GNRC_NETDEV2_IEEE802154_TX_QUEUE_SIZE];
+    memcpy(frame->mhr, vector[0].iov_base, vector[0].iov_len);
+    vector[0].iov_base = frame->mhr;
+    frame->vec = vec;
+#ifdef MODULE_NETSTATS_NEIGHBOR
+    frame->nb = gnrc_netdev2->nb_tx;
+#endif
+    for (unsigned i = 0; i < n; i++) {
+        res += vector[i].iov_len;
+    }
+    if (tx->len++ == 0) {
+        tx->retrans = 0;
+        _attempt(gnrc_netdev2);
+    }
+    return res;
+}
+
+void gnrc_netdev2_ieee802154_tx_timeout(gnrc_netdev2_t *gnrc_netdev2,
+                                        msg_t *msg)
+{
+    gnrc_netdev2_ieee802154_tx_t *tx = &gnrc_netdev2->ieee802154_tx;
+
+    if ((uint16_t)msg->content.value != tx->timer_gen) {
+        DEBUG("ieee802154_tx: ignoring stale timer message\n");
+        return;
+    }
+    switch (tx->state) {
+        case TX_STATE_BACKOFF:
+            _transmit(gnrc_netdev2);
+            break;
+        case TX_STATE_WAIT_ACK:
+            if (tx->retrans >= GNRC_NETDEV2_IEEE802154_TX_MAX_RETRANS) {
+                _finish(gnrc_netdev2, NETDEV2_EVENT_TX_NOACK);
+                break;
+            }
+            tx->retrans++;
+            DEBUG("ieee802154_tx: no ACK, retransmission %u\n",
+                  (unsigned)tx->retrans);
+            _attempt(gnrc_netdev2);
+            break;
+        default:
+            break;
+    }
+}
+
+static void _send_ack(gnrc_netdev2_t *gnrc_netdev2, uint8_t seq)
+{
+    gnrc_netdev2_ieee802154_tx_t *tx = &gnrc_netdev2->ieee802154_tx;
+    netdev2_t *dev = gnrc_netdev2->dev;
+    uint8_t ack[ACK_FRAME_LEN] = { IEEE802154_FCF_TYPE_ACK, 0, seq };
+    struct iovec vector = { ack, sizeof(ack) };
+
+    /* sent right away without CSMA/CA, IEEE 802.15.4-2011, 5.1.6.4.2;
+     * the TX event of the device must not be taken as the outcome of a
+     * queued frame */
+    tx->flags |= TX_FLAG_SENDING_ACK;
+    dev->driver->send(dev, &vector, 1);
+    tx->flags &= ~TX_FLAG_SENDING_ACK;
+}
+
+bool gnrc_netdev2_ieee802154_tx_recv(gnrc_netdev2_t *gnrc_netdev2,
+                                     const uint8_t *frame, size_t len)
+{
+    gnrc_netdev2_ieee802154_tx_t *tx = &gnrc_netdev2->ieee802154_tx;
+    netdev2_ieee802154_t *dev = (netdev2_ieee802154_t *)gnrc_netdev2->dev;
+    uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];
+    le_uint16_t dst_pan;
+    size_t mhr_len;
+    int dst_len;
+
+    if (len < ACK_FRAME_LEN) {
+        return false;
+    }
+    if ((frame[0] & IEEE802154_FCF_TYPE_MASK) == IEEE802154_FCF_TYPE_ACK) {
+        if ((tx->state == TX_STATE_WAIT_ACK) &&
+            (ieee802154_get_seq(frame) ==
+             ieee802154_get_seq(tx->queue[tx->head].mhr))) {
+            _finish(gnrc_netdev2, NETDEV2_EVENT_TX_COMPLETE);
+        }
+        return true;
+    }
+    if (tx->len == 0) {
+        _update_flags(tx, gnrc_netdev2->dev);
+    }
+    if (!(tx->flags & TX_FLAG_SW_ACK) || !(frame[0] & IEEE802154_FCF_ACK_REQ)) {
+        return false;
+    }
+    mhr_len = ieee802154_get_frame_hdr_len(frame);
+    if ((mhr_len == 0) || (mhr_len > len)) {
+        return false;
+    }
+    /* only unicast frames to us are acknowledged */
+    dst_len = ieee802154_get_dst(frame, dst, &dst_pan);
+    if ((dst_len <= 0) ||
+        ((dst_len == IEEE802154_ADDR_BCAST_LEN) &&
+         (memcmp(dst, ieee802154_addr_bcast, IEEE802154_ADDR_BCAST_LEN) == 0)) ||
+        (ieee802154_dst_filter(frame, dev->pan, dev->short_addr,
+                               dev->long_addr) != 0)) {
+        return false;
+    }
+    _send_ack(gnrc_netdev2, ieee802154_get_seq(frame));
+    return false;
+}
+
+bool gnrc_netdev2_ieee802154_tx_ignore_event(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_netdev2_ieee802154_tx_t *tx = &gnrc_netdev2->ieee802154_tx;
+
+    if (tx->flags & TX_FLAG_REPORTING) {
+        return false;
+    }
+    if (tx->flags & TX_FLAG_SENDING_ACK) {
+        return true;
+    }
+    return (tx->flags & TX_FLAG_SW);
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_GNRC_NETDEV2_IEEE802154_TX */
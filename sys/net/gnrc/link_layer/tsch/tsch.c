@@ -0,0 +1,892 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_gnrc_tsch
+ * @file
+ * @brief       Implementation of TSCH
+ *
+ * @author      agent <agent@local>
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "msg.h"
+#include "random.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "net/gnrc.h"
+#include "net/gnrc/tsch/hdr.h"
+#include "net/gnrc/tsch/tsch.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @brief   States within a slot
+ */
+enum {
+    TSCH_SLOT_IDLE = 0,         /**< waiting for the next slot */
+    TSCH_SLOT_TX,               /**< waiting for the TX offset */
+    TSCH_SLOT_TX_ACK,           /**< waiting for the acknowledgement */
+    TSCH_SLOT_RX_WAIT,          /**< waiting for the RX guard time */
+    TSCH_SLOT_RX,               /**< listening for a frame */
+};
+
+/**
+ * @brief   Length of synchronization and PHY header
+ */
+#define TSCH_SHR_PHR_LEN        (6U)
+
+/**
+ * @brief   MAC header without addresses: frame control, sequence number and
+ *          one PAN ID
+ */
+#define TSCH_MHR_BASE_LEN       (5U)
+
+/**
+ * @brief   Longest time a frame can be on air
+ */
+#define TSCH_MAX_AIRTIME_US     ((IEEE802154_FRAME_LEN_MAX + TSCH_SHR_PHR_LEN) * \
+                                 GNRC_TSCH_BYTE_US)
+
+static const uint8_t _hopping[] = GNRC_TSCH_HOPPING_SEQUENCE;
+
+static void _next_slot(gnrc_netdev2_t *gnrc_netdev2);
+
+static inline bool _passed(uint32_t time)
+{
+    return ((int32_t)(xtimer_now_usec() - time)) >= 0;
+}
+
+static bool _addr_equal(const uint8_t *a, size_t a_len,
+                        const uint8_t *b, size_t b_len)
+{
+    return (a_len == b_len) && (memcmp(a, b, a_len) == 0);
+}
+
+static inline uint32_t _airtime(size_t psdu_len)
+{
+    return (psdu_len + TSCH_SHR_PHR_LEN) * GNRC_TSCH_BYTE_US;
+}
+
+/**
+ * @brief   Length of a frame on air, from a received packet or one to send
+ *
+ * The sender's source address is not known before the MAC header is built,
+ * so the long address is assumed for sent packets.
+ */
+static size_t _psdu_len(gnrc_pktsnip_t *pkt)
+{
+    gnrc_pktsnip_t *netif = gnrc_pktsnip_search_type(pkt, GNRC_NETTYPE_NETIF);
+    gnrc_netif_hdr_t *hdr = netif->data;
+    size_t len = TSCH_MHR_BASE_LEN + hdr->dst_l2addr_len + IEEE802154_FCS_LEN;
+
+    if (pkt == netif) {
+        len += gnrc_pkt_len(pkt->next) + IEEE802154_LONG_ADDRESS_LEN;
+        if (hdr->dst_l2addr_len == 0) {
+            len += IEEE802154_SHORT_ADDRESS_LEN;    /* broadcast address */
+        }
+    }
+    else {
+        len += pkt->size + hdr->src_l2addr_len;
+    }
+    return len;
+}
+
+static void _arm_at(gnrc_netdev2_t *gnrc_netdev2, uint32_t time)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev2->tsch;
+    int32_t offset = (int32_t)(time - xtimer_now_usec());
+
+    tsch->timer_msg.type = GNRC_TSCH_MSG_TYPE_TIMER;
+    tsch->timer_msg.content.value = ++tsch->timer_gen;
+    xtimer_set_msg(&tsch->timer, (offset > 0) ? (uint32_t)offset : 0,
+                   &tsch->timer_msg, gnrc_netdev2->pid);
+}
+
+static void _disarm(gnrc_netdev2_t *gnrc_netdev2)
+{
+    xtimer_remove(&gnrc_netdev2->tsch.timer);
+    gnrc_netdev2->tsch.timer_gen++;
+}
+
+static void _radio(gnrc_netdev2_t *gnrc_netdev2, bool on)
+{
+    netdev2_t *dev = gnrc_netdev2->dev;
+    netopt_state_t state = (on) ? NETOPT_STATE_IDLE : NETOPT_STATE_SLEEP;
+
+    if (gnrc_netdev2->tsch.radio_on == on) {
+        return;
+    }
+    if (dev->driver->set(dev, NETOPT_STATE, &state, sizeof(state)) < 0) {
+        DEBUG("gnrc_tsch: unable to switch radio %s\n", (on) ? "on" : "off");
+    }
+    gnrc_netdev2->tsch.radio_on = on;
+}
+
+static void _set_channel(gnrc_netdev2_t *gnrc_netdev2, uint16_t chan)
+{
+    netdev2_t *dev = gnrc_netdev2->dev;
+
+    if (dev->driver->set(dev, NETOPT_CHANNEL, &chan, sizeof(chan)) < 0) {
+        DEBUG("gnrc_tsch: unable to set channel %u\n", chan);
+    }
+}
+
+/**
+ * @brief   Switches the radio on, on the channel of the current cell
+ */
+static void _radio_on(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev2->tsch;
+    unsigned idx = (tsch->asn + tsch->cell->cell.channel_offset) %
+                   sizeof(_hopping);
+
+    _radio(gnrc_netdev2, true);
+    _set_channel(gnrc_netdev2, _hopping[idx]);
+}
+
+static bool _is_time_source(gnrc_tsch_t *tsch, const uint8_t *addr, int len)
+{
+    return (tsch->role == GNRC_TSCH_JOINED) &&
+           _addr_equal(tsch->time_source, tsch->time_source_len, addr, len);
+}
+
+/**
+ * @brief   Moves the slot boundaries by the time a frame arrived late
+ */
+static void _sync(gnrc_tsch_t *tsch, int32_t late)
+{
+    DEBUG("gnrc_tsch: correcting slot start by %" PRIi32 " us\n", late);
+    tsch->slot_start += late;
+    tsch->last_sync = xtimer_now_usec();
+}
+
+/**
+ * @brief   Time a frame received now arrived after it was expected
+ */
+static int32_t _late(gnrc_tsch_t *tsch, gnrc_pktsnip_t *pkt, uint32_t now)
+{
+    uint32_t expected = tsch->slot_start + GNRC_TSCH_TX_OFFSET_US +
+                        _airtime(_psdu_len(pkt));
+
+    return (int32_t)(now - expected);
+}
+
+static void _send_ctrl(gnrc_netdev2_t *gnrc_netdev2, const uint8_t *dst,
+                       size_t dst_len, void *frame, size_t frame_len)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+
+    pkt = gnrc_pktbuf_add(NULL, frame, frame_len, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        DEBUG("gnrc_tsch: no space left in packet buffer\n");
+        return;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, (uint8_t *)dst, dst_len);
+    if (netif == NULL) {
+        DEBUG("gnrc_tsch: no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    if (dst_len == 0) {
+        ((gnrc_netif_hdr_t *)netif->data)->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    }
+    netif->next = pkt;
+    gnrc_netdev2->send(gnrc_netdev2, netif);
+}
+
+static uint32_t _eb_delay(void)
+{
+    return ((GNRC_TSCH_EB_PERIOD_US / 4) * 3) +
+           (random_uint32() % (GNRC_TSCH_EB_PERIOD_US / 2));
+}
+
+static void _send_eb(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev2->tsch;
+    gnrc_tsch_frame_eb_t eb;
+
+    eb.header.type = GNRC_TSCH_FRAMETYPE_EB;
+    for (unsigned i = 0; i < sizeof(eb.asn); i++) {
+        eb.asn[i] = (uint8_t)(tsch->asn >> (8 * (sizeof(eb.asn) - 1 - i)));
+    }
+    eb.join_priority = tsch->join_priority;
+    _send_ctrl(gnrc_netdev2, NULL, 0, &eb, sizeof(eb));
+    tsch->next_eb = xtimer_now_usec() + _eb_delay();
+}
+
+static bool _eb_due(gnrc_tsch_t *tsch, gnrc_tsch_cell_entry_t *entry)
+{
+    return (entry == &tsch->cells[0]) && (tsch->role != GNRC_TSCH_SCANNING) &&
+           _passed(tsch->next_eb);
+}
+
+static gnrc_tsch_cell_entry_t *_tx_cell(gnrc_tsch_t *tsch, gnrc_pktsnip_t *pkt)
+{
+    uint8_t *dst;
+    int dst_len;
+
+    if (gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_BROADCAST) {
+        return &tsch->cells[0];
+    }
+    dst_len = gnrc_netif_hdr_get_dstaddr(pkt, &dst);
+    for (unsigned i = 1; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        gnrc_tsch_cell_t *cell = &tsch->cells[i].cell;
+
+        if ((cell->options & GNRC_TSCH_CELL_TX) &&
+            _addr_equal(cell->addr, cell->addr_len, dst, dst_len)) {
+            return &tsch->cells[i];
+        }
+    }
+    /* the minimal cell */
+    return &tsch->cells[0];
+}
+
+static bool _queue(gnrc_tsch_t *tsch, gnrc_tsch_cell_entry_t *entry,
+                   gnrc_pktsnip_t *pkt)
+{
+    for (unsigned i = 0; i < GNRC_TSCH_TX_QUEUE_SIZE; i++) {
+        gnrc_priority_pktqueue_node_t *node = &tsch->_queue_nodes[i];
+
+        if ((node->pkt == NULL) && (node->next == NULL)) {
+            gnrc_priority_pktqueue_node_init(node, 0, pkt);
+            gnrc_priority_pktqueue_push(&entry->queue, node);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void _send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev2->tsch;
+    gnrc_netif_hdr_t *netif = pkt->data;
+    gnrc_tsch_frame_data_t data = { { GNRC_TSCH_FRAMETYPE_DATA }, tsch->seq++ };
+    gnrc_pktsnip_t *tsch_hdr;
+
+    /* multicast is done by broadcast on this link layer */
+    if (netif->flags & GNRC_NETIF_HDR_FLAGS_MULTICAST) {
+        netif->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    }
+    /* retransmissions keep the header and with it the sequence number */
+    tsch_hdr = gnrc_pktbuf_add(pkt->next, &data, sizeof(data),
+                               GNRC_NETTYPE_UNDEF);
+    if (tsch_hdr == NULL) {
+        DEBUG("gnrc_tsch: no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    pkt->next = tsch_hdr;
+    if (!_queue(tsch, _tx_cell(tsch, pkt), pkt)) {
+        DEBUG("gnrc_tsch: TX queue full, dropping packet\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static void _end_slot(gnrc_netdev2_t *gnrc_netdev2)
+{
+    _radio(gnrc_netdev2, false);
+    gnrc_netdev2->tsch.cell = NULL;
+    _next_slot(gnrc_netdev2);
+}
+
+static void _tx_done(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_tsch_cell_entry_t *entry = gnrc_netdev2->tsch.cell;
+
+    gnrc_pktbuf_release(gnrc_priority_pktqueue_pop(&entry->queue));
+    entry->retries = 0;
+}
+
+static void _tx_success(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_tsch_cell_entry_t *entry = gnrc_netdev2->tsch.cell;
+
+    _tx_done(gnrc_netdev2);
+    entry->backoff_exp = 0;
+    entry->backoff = 0;
+    _end_slot(gnrc_netdev2);
+}
+
+static void _tx_failure(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_tsch_cell_entry_t *entry = gnrc_netdev2->tsch.cell;
+
+    if (++entry->retries > GNRC_TSCH_MAX_RETRIES) {
+        DEBUG("gnrc_tsch: no ACK, dropping packet\n");
+        _tx_done(gnrc_netdev2);
+    }
+    if (entry->cell.options & GNRC_TSCH_CELL_SHARED) {
+        if (entry->backoff_exp < GNRC_TSCH_MAX_BE) {
+            entry->backoff_exp++;
+        }
+        entry->backoff = random_uint32() % (1U << entry->backoff_exp);
+    }
+    _end_slot(gnrc_netdev2);
+}
+
+/**
+ * @brief   Checks if a TX cell has something to send in this slot
+ */
+static bool _tx_ready(gnrc_tsch_t *tsch, gnrc_tsch_cell_entry_t *entry)
+{
+    if (!(entry->cell.options & GNRC_TSCH_CELL_TX) ||
+        ((gnrc_priority_pktqueue_length(&entry->queue) == 0) &&
+         !_eb_due(tsch, entry))) {
+        return false;
+    }
+    if ((entry->cell.options & GNRC_TSCH_CELL_SHARED) && (entry->backoff > 0)) {
+        entry->backoff--;
+        return false;
+    }
+    return true;
+}
+
+static void _scan(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev2->tsch;
+
+    DEBUG("gnrc_tsch: scanning for enhanced beacons\n");
+    _disarm(gnrc_netdev2);
+    tsch->role = GNRC_TSCH_SCANNING;
+    tsch->state = TSCH_SLOT_IDLE;
+    tsch->cell = NULL;
+    tsch->time_source_len = 0;
+    _radio(gnrc_netdev2, true);
+    _set_channel(gnrc_netdev2, _hopping[0]);
+}
+
+static void _slot_start(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev2->tsch;
+    uint16_t slot = tsch->asn % GNRC_TSCH_SLOTFRAME_LEN;
+    gnrc_tsch_cell_entry_t *rx_cell = NULL;
+
+    if ((tsch->role == GNRC_TSCH_JOINED) &&
+        _passed(tsch->last_sync + GNRC_TSCH_DESYNC_TIMEOUT_US)) {
+        DEBUG("gnrc_tsch: lost time source\n");
+        _scan(gnrc_netdev2);
+        return;
+    }
+    tsch->cell = NULL;
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        gnrc_tsch_cell_entry_t *entry = &tsch->cells[i];
+
+        if ((entry->cell.options == 0) || (entry->cell.slot_offset != slot)) {
+            continue;
+        }
+        if (_tx_ready(tsch, entry)) {
+            tsch->cell = entry;
+            break;
+        }
+        if ((rx_cell == NULL) && (entry->cell.options & GNRC_TSCH_CELL_RX)) {
+            rx_cell = entry;
+        }
+    }
+    if (tsch->cell != NULL) {
+        tsch->state = TSCH_SLOT_TX;
+        _arm_at(gnrc_netdev2, tsch->slot_start + GNRC_TSCH_TX_OFFSET_US);
+    }
+    else if (rx_cell != NULL) {
+        tsch->cell = rx_cell;
+        tsch->state = TSCH_SLOT_RX_WAIT;
+        _arm_at(gnrc_netdev2, tsch->slot_start + GNRC_TSCH_TX_OFFSET_US -
+                              GNRC_TSCH_RX_GUARD_US);
+    }
+    else {
+        _next_slot(gnrc_netdev2);
+    }
+}
+
+static void _slot_tx(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev2->tsch;
+    gnrc_tsch_cell_entry_t *entry = tsch->cell;
+    gnrc_pktsnip_t *pkt;
+
+    _radio_on(gnrc_netdev2);
+    if (_eb_due(tsch, entry)) {
+        _send_eb(gnrc_netdev2);
+        _end_slot(gnrc_netdev2);
+        return;
+    }
+    pkt = gnrc_priority_pktqueue_head(&entry->queue);
+    tsch->tx_seq = ((gnrc_tsch_frame_data_t *)pkt->next->data)->seq;
+    tsch->tx_len = _psdu_len(pkt);
+    /* the queue keeps its reference for retransmissions */
+    gnrc_pktbuf_hold(pkt, 1);
+    gnrc_netdev2->send(gnrc_netdev2, pkt);
+    if (gnrc_netif_hdr_get_flag(pkt) & GNRC_NETIF_HDR_FLAGS_BROADCAST) {
+        _tx_success(gnrc_netdev2);
+        return;
+    }
+    tsch->state = TSCH_SLOT_TX_ACK;
+    _arm_at(gnrc_netdev2, tsch->slot_start + GNRC_TSCH_TX_OFFSET_US +
+                          _airtime(tsch->tx_len) + GNRC_TSCH_ACK_WAIT_US);
+}
+
+static void _next_slot(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev2->tsch;
+
+    tsch->state = TSCH_SLOT_IDLE;
+    do {
+        uint16_t slot = tsch->asn % GNRC_TSCH_SLOTFRAME_LEN;
+        unsigned skip;
+
+        /* the minimal cell ends the search after one slotframe */
+        for (skip = 1; skip < GNRC_TSCH_SLOTFRAME_LEN; skip++) {
+            uint16_t next = (slot + skip) % GNRC_TSCH_SLOTFRAME_LEN;
+            bool used = false;
+
+            for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+                if (tsch->cells[i].cell.options &&
+                    (tsch->cells[i].cell.slot_offset == next)) {
+                    used = true;
+                    break;
+                }
+            }
+            if (used) {
+                break;
+            }
+        }
+        tsch->asn += skip;
+        tsch->slot_start += skip * GNRC_TSCH_SLOT_LEN_US;
+        /* skip slots that started too long ago to be used */
+    } while (_passed(tsch->slot_start + GNRC_TSCH_TX_OFFSET_US -
+                     GNRC_TSCH_RX_GUARD_US));
+    _arm_at(gnrc_netdev2, tsch->slot_start);
+}
+
+static bool _seen(gnrc_tsch_t *tsch, const uint8_t *src, int src_len,
+                  uint8_t seq)
+{
+    gnrc_tsch_seen_t *entry;
+
+    for (unsigned i = 0; i < GNRC_TSCH_SEEN_NUMOF; i++) {
+        entry = &tsch->seen[i];
+        if (_addr_equal(entry->addr, entry->addr_len, src, src_len)) {
+            if (entry->seq == seq) {
+                return true;
+            }
+            entry->seq = seq;
+            return false;
+        }
+    }
+    entry = &tsch->seen[tsch->seen_next];
+    tsch->seen_next = (tsch->seen_next + 1) % GNRC_TSCH_SEEN_NUMOF;
+    memcpy(entry->addr, src, src_len);
+    entry->addr_len = src_len;
+    entry->seq = seq;
+    return false;
+}
+
+static void _join(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt,
+                  uint32_t now, const uint8_t *src, int src_len)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev2->tsch;
+    gnrc_tsch_frame_eb_t *eb = pkt->data;
+
+    tsch->asn = 0;
+    for (unsigned i = 0; i < sizeof(eb->asn); i++) {
+        tsch->asn = (tsch->asn << 8) | eb->asn[i];
+    }
+    tsch->slot_start = now - GNRC_TSCH_TX_OFFSET_US - _airtime(_psdu_len(pkt));
+    tsch->join_priority = eb->join_priority + 1;
+    memcpy(tsch->time_source, src, src_len);
+    tsch->time_source_len = src_len;
+    tsch->role = GNRC_TSCH_JOINED;
+    tsch->last_sync = now;
+    tsch->next_eb = now + _eb_delay();
+    DEBUG("gnrc_tsch: joined at ASN %" PRIu32 ", join priority %u\n",
+          (uint32_t)tsch->asn, tsch->join_priority);
+    _radio(gnrc_netdev2, false);
+    _next_slot(gnrc_netdev2);
+}
+
+static void _rx(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev2->tsch;
+    gnrc_tsch_hdr_t *hdr = pkt->data;
+    uint32_t now = xtimer_now_usec();
+    uint8_t *src;
+    int src_len = gnrc_netif_hdr_get_srcaddr(pkt, &src);
+    bool in_slot = (tsch->state == TSCH_SLOT_RX_WAIT) ||
+                   (tsch->state == TSCH_SLOT_RX);
+
+    if ((pkt->size < sizeof(gnrc_tsch_hdr_t)) || (src_len <= 0) ||
+        (src_len > (int)IEEE802154_LONG_ADDRESS_LEN)) {
+        DEBUG("gnrc_tsch: dropping invalid frame\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    switch (hdr->type) {
+        case GNRC_TSCH_FRAMETYPE_EB:
+            if (pkt->size < sizeof(gnrc_tsch_frame_eb_t)) {
+                break;
+            }
+            if (tsch->role == GNRC_TSCH_SCANNING) {
+                _join(gnrc_netdev2, pkt, now, src, src_len);
+            }
+            else if (in_slot) {
+                if (_is_time_source(tsch, src, src_len)) {
+                    _sync(tsch, _late(tsch, pkt, now));
+                }
+                _end_slot(gnrc_netdev2);
+            }
+            break;
+        case GNRC_TSCH_FRAMETYPE_DATA:
+            if (in_slot && (pkt->size > sizeof(gnrc_tsch_frame_data_t))) {
+                gnrc_tsch_frame_data_t *data = pkt->data;
+                bool unicast = !(gnrc_netif_hdr_get_flag(pkt) &
+                                 (GNRC_NETIF_HDR_FLAGS_BROADCAST |
+                                  GNRC_NETIF_HDR_FLAGS_MULTICAST));
+                int32_t late = _late(tsch, pkt, now);
+                uint8_t seq = data->seq;
+
+                if (unicast) {
+                    gnrc_tsch_frame_ack_t ack;
+
+                    ack.header.type = GNRC_TSCH_FRAMETYPE_ACK;
+                    ack.seq = seq;
+                    ack.correction = byteorder_htons((uint16_t)(int16_t)late);
+                    _send_ctrl(gnrc_netdev2, src, src_len, &ack, sizeof(ack));
+                }
+                if (_is_time_source(tsch, src, src_len) &&
+                    (tsch->cell->cell.options & GNRC_TSCH_CELL_TIMEKEEPING)) {
+                    _sync(tsch, late);
+                }
+                if (!(unicast && _seen(tsch, src, src_len, seq))) {
+                    memmove(pkt->data, data + 1, pkt->size - sizeof(*data));
+                    if (gnrc_pktbuf_realloc_data(pkt, pkt->size - sizeof(*data)) == 0) {
+                        /* TSCH does not leave time to queue received
+                         * packets, they are passed on directly */
+                        if (!gnrc_netapi_dispatch_receive(pkt->type,
+                                                          GNRC_NETREG_DEMUX_CTX_ALL,
+                                                          pkt)) {
+                            gnrc_pktbuf_release(pkt);
+                        }
+                        pkt = NULL;
+                    }
+                }
+                _end_slot(gnrc_netdev2);
+            }
+            break;
+        case GNRC_TSCH_FRAMETYPE_ACK:
+            if ((tsch->state == TSCH_SLOT_TX_ACK) &&
+                (pkt->size >= sizeof(gnrc_tsch_frame_ack_t))) {
+                gnrc_tsch_frame_ack_t *ack = pkt->data;
+                gnrc_pktsnip_t *sent = gnrc_priority_pktqueue_head(&tsch->cell->queue);
+                uint8_t *dst;
+                int dst_len = gnrc_netif_hdr_get_dstaddr(sent, &dst);
+
+                if ((ack->seq != tsch->tx_seq) ||
+                    !_addr_equal(dst, dst_len, src, src_len)) {
+                    break;
+                }
+                if (_is_time_source(tsch, src, src_len)) {
+                    /* the time source saw our frame late, so we are late */
+                    _sync(tsch, -(int16_t)byteorder_ntohs(ack->correction));
+                }
+                _tx_success(gnrc_netdev2);
+            }
+            break;
+        default:
+            DEBUG("gnrc_tsch: unknown frame type %u\n", hdr->type);
+            break;
+    }
+    if (pkt != NULL) {
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+static void _timeout(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev2->tsch;
+
+    switch (tsch->state) {
+        case TSCH_SLOT_IDLE:
+            _slot_start(gnrc_netdev2);
+            break;
+        case TSCH_SLOT_TX:
+            _slot_tx(gnrc_netdev2);
+            break;
+        case TSCH_SLOT_TX_ACK:
+            _tx_failure(gnrc_netdev2);
+            break;
+        case TSCH_SLOT_RX_WAIT:
+            _radio_on(gnrc_netdev2);
+            tsch->state = TSCH_SLOT_RX;
+            _arm_at(gnrc_netdev2, tsch->slot_start + GNRC_TSCH_TX_OFFSET_US +
+                                  GNRC_TSCH_RX_GUARD_US + TSCH_MAX_AIRTIME_US);
+            break;
+        case TSCH_SLOT_RX:
+            _end_slot(gnrc_netdev2);
+            break;
+        default:
+            break;
+    }
+}
+
+static void _coordinator(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev2->tsch;
+
+    _disarm(gnrc_netdev2);
+    _radio(gnrc_netdev2, false);
+    tsch->role = GNRC_TSCH_COORDINATOR;
+    tsch->join_priority = 0;
+    tsch->time_source_len = 0;
+    tsch->cell = NULL;
+    tsch->state = TSCH_SLOT_IDLE;
+    tsch->asn = 0;
+    tsch->slot_start = xtimer_now_usec() + GNRC_TSCH_SLOT_LEN_US;
+    tsch->next_eb = tsch->slot_start;
+    _arm_at(gnrc_netdev2, tsch->slot_start);
+}
+
+static int _cell_add(gnrc_tsch_t *tsch, const gnrc_tsch_cell_t *cell)
+{
+    gnrc_tsch_cell_entry_t *unused = NULL;
+
+    if ((cell->options == 0) || (cell->slot_offset >= GNRC_TSCH_SLOTFRAME_LEN) ||
+        (cell->addr_len > sizeof(cell->addr))) {
+        return -EINVAL;
+    }
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        gnrc_tsch_cell_entry_t *entry = &tsch->cells[i];
+
+        if (entry->cell.options == 0) {
+            if (unused == NULL) {
+                unused = entry;
+            }
+        }
+        else if ((entry->cell.slot_offset == cell->slot_offset) &&
+                 (entry->cell.channel_offset == cell->channel_offset)) {
+            return -EEXIST;
+        }
+    }
+    if (unused == NULL) {
+        return -ENOSPC;
+    }
+    memset(unused, 0, sizeof(*unused));
+    unused->cell = *cell;
+    return 0;
+}
+
+static int _cell_remove(gnrc_netdev2_t *gnrc_netdev2, const gnrc_tsch_cell_t *cell)
+{
+    gnrc_tsch_t *tsch = &gnrc_netdev2->tsch;
+
+    /* the minimal cell at index 0 stays */
+    for (unsigned i = 1; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        gnrc_tsch_cell_entry_t *entry = &tsch->cells[i];
+        gnrc_pktsnip_t *pkt;
+
+        if ((entry->cell.options == 0) ||
+            (entry->cell.slot_offset != cell->slot_offset) ||
+            (entry->cell.channel_offset != cell->channel_offset)) {
+            continue;
+        }
+        if ((tsch->cell == entry) && (tsch->state != TSCH_SLOT_IDLE)) {
+            _disarm(gnrc_netdev2);
+            _end_slot(gnrc_netdev2);
+        }
+        entry->cell.options = 0;
+        while ((pkt = gnrc_priority_pktqueue_pop(&entry->queue)) != NULL) {
+            _queue(tsch, _tx_cell(tsch, pkt), pkt);
+        }
+        return 0;
+    }
+    return -ENOENT;
+}
+
+static void _status(gnrc_tsch_t *tsch, gnrc_tsch_status_t *status)
+{
+    memset(status, 0, sizeof(*status));
+    status->asn = tsch->asn;
+    status->role = tsch->role;
+    status->join_priority = tsch->join_priority;
+    memcpy(status->time_source, tsch->time_source, tsch->time_source_len);
+    status->time_source_len = tsch->time_source_len;
+    for (unsigned i = 0; i < GNRC_TSCH_CELLS_NUMOF; i++) {
+        if (tsch->cells[i].cell.options) {
+            status->cells++;
+            status->queued += gnrc_priority_pktqueue_length(&tsch->cells[i].queue);
+        }
+    }
+}
+
+static void _event_cb(netdev2_t *dev, netdev2_event_t event)
+{
+    gnrc_netdev2_t *gnrc_netdev2 = (gnrc_netdev2_t *) dev->context;
+
+    if (event == NETDEV2_EVENT_ISR) {
+        msg_t msg;
+
+        msg.type = NETDEV2_MSG_TYPE_EVENT;
+        msg.content.ptr = gnrc_netdev2;
+
+        if (msg_send(&msg, gnrc_netdev2->pid) <= 0) {
+            puts("gnrc_tsch: possibly lost interrupt.");
+        }
+    }
+    else if (event == NETDEV2_EVENT_RX_COMPLETE) {
+        gnrc_pktsnip_t *pkt = gnrc_netdev2->recv(gnrc_netdev2);
+
+        if (pkt) {
+            _rx(gnrc_netdev2, pkt);
+        }
+    }
+    else {
+        DEBUG("gnrc_tsch: event triggered -> %i\n", event);
+    }
+}
+
+static void *_tsch_thread(void *args)
+{
+    gnrc_netdev2_t *gnrc_netdev2 = (gnrc_netdev2_t *) args;
+    gnrc_tsch_t *tsch = &gnrc_netdev2->tsch;
+    gnrc_tsch_cell_t minimal = {
+        .options = GNRC_TSCH_CELL_TX | GNRC_TSCH_CELL_RX |
+                   GNRC_TSCH_CELL_SHARED | GNRC_TSCH_CELL_TIMEKEEPING,
+    };
+    netdev2_t *dev = gnrc_netdev2->dev;
+    netopt_enable_t disable = NETOPT_DISABLE;
+    uint8_t retrans = 0;
+    gnrc_netapi_opt_t *opt;
+    int res;
+    msg_t msg, reply, msg_queue[GNRC_TSCH_MSG_QUEUE_SIZE];
+
+    DEBUG("gnrc_tsch: starting thread\n");
+
+    gnrc_netdev2->pid = thread_getpid();
+    msg_init_queue(msg_queue, GNRC_TSCH_MSG_QUEUE_SIZE);
+
+    dev->event_callback = _event_cb;
+    dev->context = (void *) gnrc_netdev2;
+
+    gnrc_netif_add(thread_getpid());
+
+    dev->driver->init(dev);
+    /* TSCH acknowledges in its own frames and must send exactly at the
+     * TX offset, so the device must neither wait for acknowledgements nor
+     * back off; devices that can not be told so ignore these */
+    dev->driver->set(dev, NETOPT_ACK_REQ, &disable, sizeof(disable));
+    dev->driver->set(dev, NETOPT_CSMA, &disable, sizeof(disable));
+    dev->driver->set(dev, NETOPT_RETRANS, &retrans, sizeof(retrans));
+
+    _cell_add(tsch, &minimal);
+    tsch->radio_on = false;
+    _scan(gnrc_netdev2);
+
+    while (1) {
+        msg_receive(&msg);
+        reply.type = GNRC_NETAPI_MSG_TYPE_ACK;
+        switch (msg.type) {
+            case NETDEV2_MSG_TYPE_EVENT:
+                dev->driver->isr(dev);
+                break;
+            case GNRC_TSCH_MSG_TYPE_TIMER:
+                if (msg.content.value == tsch->timer_gen) {
+                    _timeout(gnrc_netdev2);
+                }
+                break;
+            case GNRC_NETAPI_MSG_TYPE_SND:
+                _send(gnrc_netdev2, msg.content.ptr);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_SET:
+                opt = msg.content.ptr;
+                res = dev->driver->set(dev, opt->opt, opt->data, opt->data_len);
+                reply.content.value = (uint32_t)res;
+                msg_reply(&msg, &reply);
+                break;
+            case GNRC_NETAPI_MSG_TYPE_GET:
+                opt = msg.content.ptr;
+                res = dev->driver->get(dev, opt->opt, opt->data, opt->data_len);
+                reply.content.value = (uint32_t)res;
+                msg_reply(&msg, &reply);
+                break;
+            case GNRC_TSCH_MSG_TYPE_COORDINATOR:
+                _coordinator(gnrc_netdev2);
+                reply.content.value = 0;
+                msg_reply(&msg, &reply);
+                break;
+            case GNRC_TSCH_MSG_TYPE_CELL_ADD:
+                reply.content.value = (uint32_t)_cell_add(tsch, msg.content.ptr);
+                msg_reply(&msg, &reply);
+                break;
+            case GNRC_TSCH_MSG_TYPE_CELL_REMOVE:
+                reply.content.value = (uint32_t)_cell_remove(gnrc_netdev2,
+                                                             msg.content.ptr);
+                msg_reply(&msg, &reply);
+                break;
+            case GNRC_TSCH_MSG_TYPE_STATUS:
+                _status(tsch, msg.content.ptr);
+                reply.content.value = 0;
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                DEBUG("gnrc_tsch: Unknown command %" PRIu16 "\n", msg.type);
+                break;
+        }
+    }
+    /* never reached */
+    return NULL;
+}
+
+kernel_pid_t gnrc_tsch_init(char *stack, int stacksize, char priority,
+                            const char *name, gnrc_netdev2_t *gnrc_netdev2)
+{
+    kernel_pid_t res;
+
+    if ((gnrc_netdev2 == NULL) || (gnrc_netdev2->dev == NULL)) {
+        return -ENODEV;
+    }
+    res = thread_create(stack, stacksize, priority, THREAD_CREATE_STACKTEST,
+                        _tsch_thread, (void *)gnrc_netdev2, name);
+    if (res <= 0) {
+        return -EINVAL;
+    }
+    return res;
+}
+
+static int _request(kernel_pid_t pid, uint16_t type, void *ptr)
+{
+    msg_t msg, reply;
+
+    msg.type = type;
+    msg.content.ptr = ptr;
+    msg_send_receive(&msg, &reply, pid);
+    return (int)reply.content.value;
+}
+
+int gnrc_tsch_coordinator(kernel_pid_t pid)
+{
+    return _request(pid, GNRC_TSCH_MSG_TYPE_COORDINATOR, NULL);
+}
+
+int gnrc_tsch_cell_add(kernel_pid_t pid, const gnrc_tsch_cell_t *cell)
+{
+    return _request(pid, GNRC_TSCH_MSG_TYPE_CELL_ADD, (void *)cell);
+}
+
+int gnrc_tsch_cell_remove(kernel_pid_t pid, const gnrc_tsch_cell_t *cell)
+{
+    return _request(pid, GNRC_TSCH_MSG_TYPE_CELL_REMOVE, (void *)cell);
+}
+
+int gnrc_tsch_status(kernel_pid_t pid, gnrc_tsch_status_t *status)
+{
+    return _request(pid, GNRC_TSCH_MSG_TYPE_STATUS, status);
+}
@@ -36,6 +36,10 @@
 
 #include "net/gnrc/ipv6.h"
 
+#if defined(MODULE_GNRC_RPL_SRH) && defined(MODULE_FIB)
+#include "net/gnrc/rpl/srh.h"
+#endif
+
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
@@ -509,6 +513,51 @@ static int _fill_ipv6_hdr(kernel_pid_t iface, gnrc_pktsnip_t *ipv6,
     return 0;
 }
 
+#if defined(MODULE_GNRC_RPL_SRH) && defined(MODULE_FIB)
+/* Source routes the packet down the DODAG if this node is a RPL root with a
+ * route to its destination. The upper layer checksum covers the final
+ * destination, so the header is filled before the first hop replaces it.
+ * Returns 1 if the routing header was inserted and the IPv6 header filled,
+ * 0 if the packet is not source routed and < 0 on error */
+static int _insert_srh(kernel_pid_t *iface, gnrc_pktsnip_t *ipv6, gnrc_pktsnip_t *payload)
+{
+    uint8_t buf[GNRC_RPL_SRH_CACHE_HDR_MAX];
+    ipv6_hdr_t *hdr = ipv6->data;
+    ipv6_addr_t next_hop;
+    kernel_pid_t sr_iface;
+    gnrc_pktsnip_t *srh;
+    int res;
+
+    if (hdr->nh != PROTNUM_RESERVED) {
+        /* extension headers are already present */
+        return 0;
+    }
+    res = gnrc_rpl_srh_cache_get(&hdr->dst, &sr_iface, &next_hop, (gnrc_rpl_srh_t *)buf,
+                                 sizeof(buf));
+    if ((res <= 0) || ((*iface != KERNEL_PID_UNDEF) && (*iface != sr_iface))) {
+        /* no source route, the FIB decides */
+        return 0;
+    }
+    *iface = sr_iface;
+    if (_fill_ipv6_hdr(*iface, ipv6, payload) < 0) {
+        return -EINVAL;
+    }
+    srh = gnrc_pktbuf_add(payload, buf, res, GNRC_NETTYPE_IPV6_EXT);
+    if (srh == NULL) {
+        DEBUG("ipv6: no space left for the source routing header\n");
+        return -ENOBUFS;
+    }
+    ((gnrc_rpl_srh_t *)srh->data)->nh = hdr->nh;
+    hdr->nh = PROTNUM_IPV6_EXT_RH;
+    hdr->len = byteorder_htons(byteorder_ntohs(hdr->len) + srh->size);
+    hdr->dst = next_hop;
+    ipv6->next = srh;
+    DEBUG("ipv6: source routed over %s\n",
+          ipv6_addr_to_str(addr_str, &next_hop, sizeof(addr_str)));
+    return 1;
+}
+#endif
+
 static inline void _send_multicast_over_iface(kernel_pid_t iface, gnrc_pktsnip_t *pkt)
 {
     DEBUG("ipv6: send multicast over interface %" PRIkernel_pid "\n", iface);
@@ -747,6 +796,18 @@ static void _send(gnrc_pktsnip_t *pkt, bool prep_hdr)
         uint8_t l2addr_len = GNRC_IPV6_NC_L2_ADDR_MAX;
         uint8_t l2addr[l2addr_len];
 
+#if defined(MODULE_GNRC_RPL_SRH) && defined(MODULE_FIB)
+        if (prep_hdr) {
+            int res = _insert_srh(&iface, ipv6, payload);
+
+            if (res < 0) {
+                gnrc_pktbuf_release(pkt);
+                return;
+            }
+            prep_hdr = (res == 0);
+        }
+#endif
+
         iface = _next_hop_l2addr(l2addr, &l2addr_len, iface, &hdr->dst, pkt);
 
         if (iface == KERNEL_PID_UNDEF) {
@@ -20,7 +20,7 @@
 #include <string.h>
 
 #include "kernel_types.h"
-#include "mutex.h"
+#include "rwlock.h"
 #include "bitfield.h"
 
 #include "net/eui64.h"
@@ -92,9 +92,9 @@ static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr
         (entry->flags & GNRC_IPV6_NETIF_FLAGS_SIXLOWPAN)) {
         ipv6_addr_t *router = gnrc_ndp_internal_default_router();
         if (router != NULL) {
-            mutex_unlock(&entry->mutex);    /* function below relocks mutex */
+            rwlock_unlock(&entry->mutex);    /* function below relocks mutex */
             gnrc_ndp_internal_send_nbr_sol(entry->pid, &tmp_addr->addr, router, router);
-            mutex_lock(&entry->mutex);      /* relock mutex */
+            rwlock_wrlock(&entry->mutex);      /* relock mutex */
         }
         /* otherwise there is no default router to register to */
     }
@@ -109,9 +109,9 @@ static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr
             tmp_addr->valid = UINT32_MAX;
             tmp_addr->preferred = UINT32_MAX;
             gnrc_sixlowpan_nd_router_abr_t *abr = gnrc_sixlowpan_nd_router_abr_get();
-            mutex_unlock(&entry->mutex);
+            rwlock_unlock(&entry->mutex);
             gnrc_ipv6_netif_set_rtr_adv(entry, true);
-            mutex_lock(&entry->mutex);
+            rwlock_wrlock(&entry->mutex);
             if (gnrc_sixlowpan_nd_router_abr_add_prf(abr, entry, tmp_addr) < 0) {
                 DEBUG("ipv6_netif: error adding prefix to 6LoWPAN-ND management\n");
             }
@@ -119,7 +119,7 @@ static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr
 #if defined(MODULE_GNRC_NDP_ROUTER) || defined(MODULE_GNRC_SIXLOWPAN_ND_ROUTER)
             if ((entry->flags & GNRC_IPV6_NETIF_FLAGS_ROUTER) &&
                 (entry->flags & GNRC_IPV6_NETIF_FLAGS_RTR_ADV)) {
-                mutex_unlock(&entry->mutex);    /* function below relocks mutex */
+                rwlock_unlock(&entry->mutex);    /* function below relocks mutex */
 #ifdef MODULE_GNRC_SIXLOWPAN_ND_ROUTER
                 if (entry->flags & GNRC_IPV6_NETIF_FLAGS_SIXLOWPAN) {
                     gnrc_ndp_internal_send_rtr_adv(entry->pid, NULL, NULL, false);
@@ -134,7 +134,7 @@ static ipv6_addr_t *_add_addr_to_entry(gnrc_ipv6_netif_t *entry, const ipv6_addr
                     gnrc_ndp_router_retrans_rtr_adv(entry);
                 }
 #endif
-                mutex_lock(&entry->mutex);      /* relock mutex */
+                rwlock_wrlock(&entry->mutex);      /* relock mutex */
             }
 #endif
         }
@@ -177,7 +177,7 @@ static void _ipv6_netif_remove(gnrc_ipv6_netif_t *entry)
     gnrc_ndp_netif_remove(entry);
 #endif
 
-    mutex_lock(&entry->mutex);
+    rwlock_wrlock(&entry->mutex);
     xtimer_remove(&entry->rtr_sol_timer);
 #ifdef MODULE_GNRC_NDP_ROUTER
     xtimer_remove(&entry->rtr_adv_timer);
@@ -187,13 +187,13 @@ static void _ipv6_netif_remove(gnrc_ipv6_netif_t *entry)
     entry->pid = KERNEL_PID_UNDEF;
     entry->flags = 0;
 
-    mutex_unlock(&entry->mutex);
+    rwlock_unlock(&entry->mutex);
 }
 
 void gnrc_ipv6_netif_init(void)
 {
     for (int i = 0; i < GNRC_NETIF_NUMOF; i++) {
-        mutex_init(&(ipv6_ifs[i].mutex));
+        rwlock_init(&(ipv6_ifs[i].mutex));
         _ipv6_netif_remove(&ipv6_ifs[i]);
     }
 }
@@ -221,7 +221,7 @@ void gnrc_ipv6_netif_add(kernel_pid_t pid)
 
     /* Otherwise, fill the free entry */
 
-    mutex_lock(&free_entry->mutex);
+    rwlock_wrlock(&free_entry->mutex);
 
     DEBUG("ipv6 netif: Add IPv6 interface %" PRIkernel_pid " (i = %d)\n", pid,
           free_entry - ipv6_ifs);
@@ -233,7 +233,7 @@ void gnrc_ipv6_netif_add(kernel_pid_t pid)
     _add_addr_to_entry(free_entry, &ipv6_addr_all_nodes_link_local,
                        IPV6_ADDR_BIT_LEN, 0);
 
-    mutex_unlock(&free_entry->mutex);
+    rwlock_unlock(&free_entry->mutex);
 
 #ifdef MODULE_GNRC_NDP
     gnrc_ndp_netif_add(free_entry);
@@ -303,18 +303,18 @@ ipv6_addr_t *gnrc_ipv6_netif_add_addr(kernel_pid_t pid, const ipv6_addr_t *addr,
         return NULL;
     }
 
-    mutex_lock(&entry->mutex);
+    rwlock_wrlock(&entry->mutex);
 
     res = _add_addr_to_entry(entry, addr, prefix_len, flags);
 
-    mutex_unlock(&entry->mutex);
+    rwlock_unlock(&entry->mutex);
 
     return res;
 }
 
 static void _remove_addr_from_entry(gnrc_ipv6_netif_t *entry, ipv6_addr_t *addr)
 {
-    mutex_lock(&entry->mutex);
+    rwlock_wrlock(&entry->mutex);
 
     for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
         if (ipv6_addr_equal(&(entry->addrs[i].addr), addr)) {
@@ -331,7 +331,7 @@ static void _remove_addr_from_entry(gnrc_ipv6_netif_t *entry, ipv6_addr_t *addr)
                 (!ipv6_addr_is_multicast(addr) &&
                  !ipv6_addr_is_link_local(addr))) {
                 entry->rtr_adv_count = GNRC_NDP_MAX_INIT_RTR_ADV_NUMOF;
-                mutex_unlock(&entry->mutex);    /* function below relocks the mutex */
+                rwlock_unlock(&entry->mutex);    /* function below relocks the mutex */
                 gnrc_ndp_router_retrans_rtr_adv(entry);
                 return;
             }
@@ -341,12 +341,12 @@ static void _remove_addr_from_entry(gnrc_ipv6_netif_t *entry, ipv6_addr_t *addr)
             gnrc_sixlowpan_nd_router_abr_rem_prf(abr, entry, &entry->addrs[i]);
 #endif
 
-            mutex_unlock(&entry->mutex);
+            rwlock_unlock(&entry->mutex);
             return;
         }
     }
 
-    mutex_unlock(&entry->mutex);
+    rwlock_unlock(&entry->mutex);
 }
 
 void gnrc_ipv6_netif_remove_addr(kernel_pid_t pid, ipv6_addr_t *addr)
@@ -375,11 +375,11 @@ void gnrc_ipv6_netif_reset_addr(kernel_pid_t pid)
         return;
     }
 
-    mutex_lock(&entry->mutex);
+    rwlock_wrlock(&entry->mutex);
 
     _reset_addr_from_entry(entry);
 
-    mutex_unlock(&entry->mutex);
+    rwlock_unlock(&entry->mutex);
 }
 
 kernel_pid_t gnrc_ipv6_netif_find_by_addr(ipv6_addr_t **out, const ipv6_addr_t *addr)
@@ -419,11 +419,11 @@ ipv6_addr_t *gnrc_ipv6_netif_find_addr(kernel_pid_t pid, const ipv6_addr_t *addr
         return NULL;
     }
 
-    mutex_lock(&entry->mutex);
+    rwlock_rdlock(&entry->mutex);
 
     for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
         if (ipv6_addr_equal(&(entry->addrs[i].addr), addr)) {
-            mutex_unlock(&entry->mutex);
+            rwlock_unlock(&entry->mutex);
             DEBUG("ipv6 netif: Found %s on interface %" PRIkernel_pid "\n",
                   ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)),
                   pid);
@@ -431,7 +431,7 @@ ipv6_addr_t *gnrc_ipv6_netif_find_addr(kernel_pid_t pid, const ipv6_addr_t *addr
         }
     }
 
-    mutex_unlock(&entry->mutex);
+    rwlock_unlock(&entry->mutex);
 
     return NULL;
 }
@@ -502,7 +502,7 @@ kernel_pid_t gnrc_ipv6_netif_find_by_prefix(ipv6_addr_t **out, const ipv6_addr_t
     for (int i = 0; i < GNRC_NETIF_NUMOF; i++) {
         uint8_t match;
 
-        mutex_lock(&(ipv6_ifs[i].mutex));
+        rwlock_rdlock(&(ipv6_ifs[i].mutex));
 
         match = _find_by_prefix_unsafe(&tmp_res, ipv6_ifs + i, prefix, NULL);
 
@@ -512,7 +512,7 @@ kernel_pid_t gnrc_ipv6_netif_find_by_prefix(ipv6_addr_t **out, const ipv6_addr_t
             best_match = match;
         }
 
-        mutex_unlock(&(ipv6_ifs[i].mutex));
+        rwlock_unlock(&(ipv6_ifs[i].mutex));
     }
 
 #if ENABLE_DEBUG
@@ -606,14 +606,14 @@ ipv6_addr_t *gnrc_ipv6_netif_match_prefix(kernel_pid_t pid, const ipv6_addr_t *p
     ipv6_addr_t *res = NULL;
     gnrc_ipv6_netif_t *iface = gnrc_ipv6_netif_get(pid);
 
-    mutex_lock(&(iface->mutex));
+    rwlock_rdlock(&(iface->mutex));
 
     if (_find_by_prefix_unsafe(&res, iface, prefix, NULL) > 0) {
-        mutex_unlock(&(iface->mutex));
+        rwlock_unlock(&(iface->mutex));
         return res;
     }
 
-    mutex_unlock(&(iface->mutex));
+    rwlock_unlock(&(iface->mutex));
 
     return NULL;
 }
@@ -771,7 +771,7 @@ ipv6_addr_t *gnrc_ipv6_netif_find_best_src_addr(kernel_pid_t pid, const ipv6_add
 {
     gnrc_ipv6_netif_t *iface = gnrc_ipv6_netif_get(pid);
     ipv6_addr_t *best_src = NULL;
-    mutex_lock(&(iface->mutex));
+    rwlock_rdlock(&(iface->mutex));
     BITFIELD(candidate_set, GNRC_IPV6_NETIF_ADDR_NUMOF);
     memset(candidate_set, 0, sizeof(candidate_set));
 
@@ -782,7 +782,7 @@ ipv6_addr_t *gnrc_ipv6_netif_find_best_src_addr(kernel_pid_t pid, const ipv6_add
             best_src = &(iface->addrs[first_candidate].addr);
         }
     }
-    mutex_unlock(&(iface->mutex));
+    rwlock_unlock(&(iface->mutex));
 
     return best_src;
 }
@@ -805,7 +805,7 @@ void gnrc_ipv6_netif_init_by_dev(void)
             continue;
         }
 
-        mutex_lock(&ipv6_if->mutex);
+        rwlock_wrlock(&ipv6_if->mutex);
 
 #ifdef MODULE_GNRC_SIXLOWPAN
         gnrc_nettype_t if_type = GNRC_NETTYPE_UNDEF;
@@ -870,7 +870,7 @@ void gnrc_ipv6_netif_init_by_dev(void)
             ipv6_if->flags &= ~GNRC_IPV6_NETIF_FLAGS_IS_WIRED;
         }
 
-        mutex_unlock(&ipv6_if->mutex);
+        rwlock_unlock(&ipv6_if->mutex);
 #if (defined(MODULE_GNRC_NDP_ROUTER) || defined(MODULE_GNRC_SIXLOWPAN_ND_ROUTER))
         gnrc_ipv6_netif_set_router(ipv6_if, true);
 #endif
@@ -554,7 +554,7 @@ void gnrc_ndp_rtr_adv_handle(kernel_pid_t iface, gnrc_pktsnip_t *pkt, ipv6_hdr_t
     if (rtr_adv->retrans_timer.u32 != 0) {
         if_entry->retrans_timer = byteorder_ntohl(rtr_adv->retrans_timer);
     }
-    mutex_unlock(&if_entry->mutex);
+    rwlock_unlock(&if_entry->mutex);
     sicmpv6_size -= sizeof(ndp_rtr_adv_t);
     /* parse options */
     while (sicmpv6_size > 0) {
@@ -683,10 +683,10 @@ void gnrc_ndp_retrans_nbr_sol(gnrc_ipv6_nc_t *nc_entry)
 
                 gnrc_ndp_internal_send_nbr_sol(nc_entry->iface, NULL, &nc_entry->ipv6_addr, &dst);
 
-                mutex_lock(&ipv6_iface->mutex);
+                rwlock_wrlock(&ipv6_iface->mutex);
                 gnrc_ndp_internal_reset_nbr_sol_timer(nc_entry, ipv6_iface->retrans_timer,
                                                       GNRC_NDP_MSG_NBR_SOL_RETRANS, gnrc_ipv6_pid);
-                mutex_unlock(&ipv6_iface->mutex);
+                rwlock_unlock(&ipv6_iface->mutex);
             }
         }
         else if (nc_entry->probes_remaining <= 1) {
@@ -729,10 +729,10 @@ void gnrc_ndp_state_timeout(gnrc_ipv6_nc_t *nc_entry)
 void gnrc_ndp_netif_add(gnrc_ipv6_netif_t *iface)
 {
     /* set default values */
-    mutex_lock(&iface->mutex);
+    rwlock_wrlock(&iface->mutex);
     _set_reach_time(iface, GNRC_NDP_REACH_TIME);
     iface->retrans_timer = GNRC_NDP_RETRANS_TIMER;
-    mutex_unlock(&iface->mutex);
+    rwlock_unlock(&iface->mutex);
 }
 
 void gnrc_ndp_netif_remove(gnrc_ipv6_netif_t *iface)
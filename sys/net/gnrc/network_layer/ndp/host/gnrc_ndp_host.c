@@ -35,22 +35,22 @@ static inline void _reschedule_rtr_sol(gnrc_ipv6_netif_t *iface, uint32_t delay)
 void gnrc_ndp_host_init(gnrc_ipv6_netif_t *iface)
 {
     uint32_t interval = random_uint32_range(0, GNRC_NDP_MAX_RTR_SOL_DELAY * SEC_IN_USEC);
-    mutex_lock(&iface->mutex);
+    rwlock_wrlock(&iface->mutex);
     iface->rtr_sol_count = GNRC_NDP_MAX_RTR_SOL_NUMOF;
     DEBUG("ndp host: delayed initial router solicitation by %" PRIu32 " usec.\n", interval);
     _reschedule_rtr_sol(iface, interval);
-    mutex_unlock(&iface->mutex);
+    rwlock_unlock(&iface->mutex);
 }
 
 void gnrc_ndp_host_retrans_rtr_sol(gnrc_ipv6_netif_t *iface)
 {
-    mutex_lock(&iface->mutex);
+    rwlock_wrlock(&iface->mutex);
     if (iface->rtr_sol_count > 1) { /* regard off-by-one error */
         DEBUG("ndp hst: retransmit rtr sol in %d sec\n", GNRC_NDP_MAX_RTR_SOL_INT);
         iface->rtr_sol_count--;
         _reschedule_rtr_sol(iface, GNRC_NDP_MAX_RTR_SOL_INT * SEC_IN_USEC);
     }
-    mutex_unlock(&iface->mutex);
+    rwlock_unlock(&iface->mutex);
     gnrc_ndp_internal_send_rtr_sol(iface->pid, NULL);
 }
 
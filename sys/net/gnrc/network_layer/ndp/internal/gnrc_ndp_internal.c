@@ -127,10 +127,10 @@ void gnrc_ndp_internal_set_state(gnrc_ipv6_nc_t *nc_entry, uint8_t state)
             gnrc_ndp_internal_send_nbr_sol(nc_entry->iface, NULL, &nc_entry->ipv6_addr,
                                            &nc_entry->ipv6_addr);
 
-            mutex_lock(&ipv6_iface->mutex);
+            rwlock_wrlock(&ipv6_iface->mutex);
             gnrc_ndp_internal_reset_nbr_sol_timer(nc_entry, ipv6_iface->retrans_timer,
                                                   GNRC_NDP_MSG_NBR_SOL_RETRANS, gnrc_ipv6_pid);
-            mutex_unlock(&ipv6_iface->mutex);
+            rwlock_unlock(&ipv6_iface->mutex);
             break;
 
 #ifdef ENABLE_DEBUG
@@ -434,13 +434,13 @@ void gnrc_ndp_internal_send_rtr_adv(kernel_pid_t iface, ipv6_addr_t *src, ipv6_a
     }
     DEBUG("ndp internal: send router advertisement (iface: %" PRIkernel_pid ", dst: %s%s\n",
           iface, ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)), fin ? ", final" : "");
-    mutex_lock(&ipv6_iface->mutex);
+    rwlock_wrlock(&ipv6_iface->mutex);
 #ifdef MODULE_GNRC_SIXLOWPAN_ND_ROUTER
     if (!(ipv6_iface->flags & GNRC_IPV6_NETIF_FLAGS_SIXLOWPAN)) {
 #endif
     if (!_add_pios(&hdr, ipv6_iface, pkt)) {
         /* pkt already released in _add_pios */
-        mutex_unlock(&ipv6_iface->mutex);
+        rwlock_unlock(&ipv6_iface->mutex);
         return;
     }
     pkt = hdr;
@@ -478,7 +478,7 @@ void gnrc_ndp_internal_send_rtr_adv(kernel_pid_t iface, ipv6_addr_t *src, ipv6_a
                     else {
                         DEBUG("ndp rtr: error allocating PIO\n");
                         gnrc_pktbuf_release(pkt);
-                        mutex_unlock(&ipv6_iface->mutex);
+                        rwlock_unlock(&ipv6_iface->mutex);
                         return;
                     }
                 }
@@ -494,7 +494,7 @@ void gnrc_ndp_internal_send_rtr_adv(kernel_pid_t iface, ipv6_addr_t *src, ipv6_a
                                                        &ctx->prefix, pkt);
                 if (hdr == NULL) {
                     DEBUG("ndp rtr: error allocating 6CO\n");
-                    mutex_unlock(&ipv6_iface->mutex);
+                    rwlock_unlock(&ipv6_iface->mutex);
                     gnrc_pktbuf_release(pkt);
                     return;
                 }
@@ -503,7 +503,7 @@ void gnrc_ndp_internal_send_rtr_adv(kernel_pid_t iface, ipv6_addr_t *src, ipv6_a
             hdr = gnrc_sixlowpan_nd_opt_abr_build(abr->version, abr->ltime, &abr->addr, pkt);
             if (hdr == NULL) {
                 DEBUG("ndp internal: error allocating ABRO.\n");
-                mutex_unlock(&ipv6_iface->mutex);
+                rwlock_unlock(&ipv6_iface->mutex);
                 gnrc_pktbuf_release(pkt);
                 return;
             }
@@ -514,18 +514,18 @@ void gnrc_ndp_internal_send_rtr_adv(kernel_pid_t iface, ipv6_addr_t *src, ipv6_a
     if (ipv6_iface->flags & GNRC_IPV6_NETIF_FLAGS_ADV_MTU) {
         if ((hdr = gnrc_ndp_opt_mtu_build(ipv6_iface->mtu, pkt)) == NULL) {
             DEBUG("ndp rtr: no space left in packet buffer\n");
-            mutex_unlock(&ipv6_iface->mutex);
+            rwlock_unlock(&ipv6_iface->mutex);
             gnrc_pktbuf_release(pkt);
             return;
         }
         pkt = hdr;
     }
     if (src == NULL) {
-        mutex_unlock(&ipv6_iface->mutex);
+        rwlock_unlock(&ipv6_iface->mutex);
         /* get address from source selection algorithm.
          * Only link local addresses may be used (RFC 4861 section 4.1) */
         src = gnrc_ipv6_netif_find_best_src_addr(iface, dst, true);
-        mutex_lock(&ipv6_iface->mutex);
+        rwlock_wrlock(&ipv6_iface->mutex);
     }
     /* add SL2A for source address */
     if (src != NULL) {
@@ -542,7 +542,7 @@ void gnrc_ndp_internal_send_rtr_adv(kernel_pid_t iface, ipv6_addr_t *src, ipv6_a
 
             if (hdr == NULL) {
                 DEBUG("ndp internal: error allocating Source Link-layer address option.\n");
-                mutex_unlock(&ipv6_iface->mutex);
+                rwlock_unlock(&ipv6_iface->mutex);
                 gnrc_pktbuf_release(pkt);
                 return;
             }
@@ -567,7 +567,7 @@ void gnrc_ndp_internal_send_rtr_adv(kernel_pid_t iface, ipv6_addr_t *src, ipv6_a
     if (!fin) {
         adv_ltime = ipv6_iface->adv_ltime;
     }
-    mutex_unlock(&ipv6_iface->mutex);
+    rwlock_unlock(&ipv6_iface->mutex);
     hdr = gnrc_ndp_rtr_adv_build(cur_hl,
                                  (ipv6_iface->flags & (GNRC_IPV6_NETIF_FLAGS_OTHER_CONF |
                                                        GNRC_IPV6_NETIF_FLAGS_MANAGED)) >> 8,
@@ -727,9 +727,9 @@ bool gnrc_ndp_internal_mtu_opt_handle(kernel_pid_t iface, uint8_t icmpv6_type,
         /* else discard silently */
         return true;
     }
-    mutex_lock(&if_entry->mutex);
+    rwlock_wrlock(&if_entry->mutex);
     if_entry->mtu = byteorder_ntohl(mtu_opt->mtu);
-    mutex_unlock(&if_entry->mutex);
+    rwlock_unlock(&if_entry->mutex);
     return true;
 }
 
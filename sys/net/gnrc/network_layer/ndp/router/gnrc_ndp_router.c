@@ -30,12 +30,12 @@ void gnrc_ndp_router_set_router(gnrc_ipv6_netif_t *iface, bool enable)
     if (enable && !(iface->flags & GNRC_IPV6_NETIF_FLAGS_ROUTER)) {
         gnrc_ipv6_netif_add_addr(iface->pid, &ipv6_addr_all_routers_link_local,
                                  128, GNRC_IPV6_NETIF_ADDR_FLAGS_NON_UNICAST);
-        mutex_lock(&iface->mutex);
+        rwlock_wrlock(&iface->mutex);
         iface->flags |= GNRC_IPV6_NETIF_FLAGS_ROUTER;
         iface->max_adv_int = GNRC_IPV6_NETIF_DEFAULT_MAX_ADV_INT;
         iface->min_adv_int = GNRC_IPV6_NETIF_DEFAULT_MIN_ADV_INT;
         iface->adv_ltime = GNRC_IPV6_NETIF_DEFAULT_ROUTER_LTIME;
-        mutex_unlock(&iface->mutex);
+        rwlock_unlock(&iface->mutex);
         gnrc_ndp_router_set_rtr_adv(iface, enable);
     }
     else if (!enable && (iface->flags & GNRC_IPV6_NETIF_FLAGS_ROUTER)) {
@@ -47,21 +47,21 @@ void gnrc_ndp_router_set_router(gnrc_ipv6_netif_t *iface, bool enable)
 void gnrc_ndp_router_set_rtr_adv(gnrc_ipv6_netif_t *iface, bool enable)
 {
     if (enable && !(iface->flags & GNRC_IPV6_NETIF_FLAGS_RTR_ADV)) {
-        mutex_lock(&iface->mutex);
+        rwlock_wrlock(&iface->mutex);
         iface->flags |= GNRC_IPV6_NETIF_FLAGS_RTR_ADV;
         iface->rtr_adv_count = GNRC_NDP_MAX_INIT_RTR_ADV_NUMOF;
-        mutex_unlock(&iface->mutex);
+        rwlock_unlock(&iface->mutex);
         _send_rtr_adv(iface, NULL);
     }
     else if (!enable && (iface->flags & GNRC_IPV6_NETIF_FLAGS_RTR_ADV)) {
-        mutex_lock(&iface->mutex);
+        rwlock_wrlock(&iface->mutex);
         iface->rtr_adv_count = GNRC_NDP_MAX_FIN_RTR_ADV_NUMOF;
         iface->flags &= ~GNRC_IPV6_NETIF_FLAGS_RTR_ADV;
         iface->adv_ltime = 0;
 #ifdef MODULE_GNRC_NDP_HOST
         iface->rtr_sol_count = GNRC_NDP_MAX_RTR_SOL_NUMOF;
 #endif
-        mutex_unlock(&iface->mutex);
+        rwlock_unlock(&iface->mutex);
         _send_rtr_adv(iface, NULL);
 #ifdef MODULE_GNRC_NDP_HOST
         gnrc_ndp_host_retrans_rtr_sol(iface);
@@ -86,7 +86,7 @@ static void _send_rtr_adv(gnrc_ipv6_netif_t *iface, ipv6_addr_t *dst)
     bool fin;
     uint32_t interval;
 
-    mutex_lock(&iface->mutex);
+    rwlock_wrlock(&iface->mutex);
     fin = (iface->adv_ltime == 0);
     assert((iface->min_adv_int != 0) && (iface->max_adv_int != 0));
     interval = random_uint32_range(iface->min_adv_int, iface->max_adv_int);
@@ -110,7 +110,7 @@ static void _send_rtr_adv(gnrc_ipv6_netif_t *iface, ipv6_addr_t *dst)
         xtimer_set_msg(&iface->rtr_adv_timer, interval * SEC_IN_USEC, &iface->rtr_adv_msg,
                        gnrc_ipv6_pid);
     }
-    mutex_unlock(&iface->mutex);
+    rwlock_unlock(&iface->mutex);
     for (int i = 0; i < GNRC_IPV6_NETIF_ADDR_NUMOF; i++) {
         ipv6_addr_t *src = &iface->addrs[i].addr;
 
@@ -48,14 +48,14 @@ static inline void _revert_iid(uint8_t *iid)
 void gnrc_sixlowpan_nd_init(gnrc_ipv6_netif_t *iface)
 {
     assert(iface->flags & GNRC_IPV6_NETIF_FLAGS_SIXLOWPAN);
-    mutex_lock(&iface->mutex);
+    rwlock_wrlock(&iface->mutex);
     iface->rtr_sol_count = 0;   /* first will be sent immediately */
 
     DEBUG("6lo nd: retransmit multicast rtr sol in 10 sec\n");
 #ifndef MODULE_GNRC_SIXLOWPAN_ND_BORDER_ROUTER
     _rtr_sol_reschedule(iface, GNRC_SIXLOWPAN_ND_RTR_SOL_INT);
 #endif
-    mutex_unlock(&iface->mutex);
+    rwlock_unlock(&iface->mutex);
 #ifndef MODULE_GNRC_SIXLOWPAN_ND_BORDER_ROUTER
     gnrc_ndp_internal_send_rtr_sol(iface->pid, NULL);
 #endif
@@ -65,7 +65,7 @@ void gnrc_sixlowpan_nd_mc_rtr_sol(gnrc_ipv6_netif_t *iface)
 {
     uint32_t interval;
     assert(iface->flags & GNRC_IPV6_NETIF_FLAGS_SIXLOWPAN);
-    mutex_lock(&iface->mutex);
+    rwlock_wrlock(&iface->mutex);
     if (iface->rtr_sol_count < GNRC_NDP_MAX_RTR_SOL_NUMOF) {
         DEBUG("6lo nd: retransmit multicast rtr sol in 10 sec\n");
         iface->rtr_sol_count++;
@@ -97,7 +97,7 @@ void gnrc_sixlowpan_nd_mc_rtr_sol(gnrc_ipv6_netif_t *iface)
         DEBUG("6lo nd: retransmit multicast rtr sol in %" PRIu32 " sec\n", interval);
     }
     _rtr_sol_reschedule(iface, interval);
-    mutex_unlock(&iface->mutex);
+    rwlock_unlock(&iface->mutex);
     gnrc_ndp_internal_send_rtr_sol(iface->pid, NULL);
 }
 
@@ -290,14 +290,14 @@ uint8_t gnrc_sixlowpan_nd_opt_ar_handle(kernel_pid_t iface, ipv6_hdr_t *ipv6,
             switch (ar_opt->status) {
                 case SIXLOWPAN_ND_STATUS_SUCCESS:
                     DEBUG("6lo nd: address registration successful\n");
-                    mutex_lock(&ipv6_iface->mutex);
+                    rwlock_wrlock(&ipv6_iface->mutex);
                     /* reschedule 1 minute before lifetime expires */
                     gnrc_ndp_internal_reset_nbr_sol_timer(nc_entry, SEC_IN_USEC * 60 *
                                                           (uint32_t)(byteorder_ntohs(ar_opt->ltime)
                                                           -1),
                                                           GNRC_NDP_MSG_NBR_SOL_RETRANS,
                                                           gnrc_ipv6_pid);
-                    mutex_unlock(&ipv6_iface->mutex);
+                    rwlock_unlock(&ipv6_iface->mutex);
                     break;
                 case SIXLOWPAN_ND_STATUS_DUP:
                     DEBUG("6lo nd: address registration determined duplicated\n");
@@ -114,7 +114,7 @@ void gnrc_sixlowpan_nd_router_set_rtr_adv(gnrc_ipv6_netif_t *netif, bool enable)
 {
     if (enable && (gnrc_ipv6_netif_add_addr(netif->pid, &ipv6_addr_all_routers_link_local, 128,
                                             GNRC_IPV6_NETIF_ADDR_FLAGS_NON_UNICAST) != NULL)) {
-        mutex_lock(&netif->mutex);
+        rwlock_wrlock(&netif->mutex);
         netif->flags |= GNRC_IPV6_NETIF_FLAGS_RTR_ADV;
         netif->adv_ltime = GNRC_IPV6_NETIF_DEFAULT_ROUTER_LTIME;
 #ifdef MODULE_GNRC_NDP_ROUTER
@@ -122,7 +122,7 @@ void gnrc_sixlowpan_nd_router_set_rtr_adv(gnrc_ipv6_netif_t *netif, bool enable)
         netif->max_adv_int = GNRC_IPV6_NETIF_DEFAULT_MAX_ADV_INT;
         netif->min_adv_int = GNRC_IPV6_NETIF_DEFAULT_MIN_ADV_INT;
 #endif
-        mutex_unlock(&netif->mutex);
+        rwlock_unlock(&netif->mutex);
     }
     else {
         netif->flags &= ~GNRC_IPV6_NETIF_FLAGS_RTR_ADV;
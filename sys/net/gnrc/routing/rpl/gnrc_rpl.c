@@ -18,7 +18,9 @@
 #include "net/ipv6.h"
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc.h"
+#include "kernel_defines.h"
 #include "mutex.h"
+#include "priority_queue.h"
 
 #include "net/gnrc/rpl.h"
 #ifdef MODULE_GNRC_RPL_P2P
@@ -32,9 +34,15 @@
 static char _stack[GNRC_RPL_STACK_SIZE];
 kernel_pid_t gnrc_rpl_pid = KERNEL_PID_UNDEF;
 const ipv6_addr_t ipv6_addr_all_rpl_nodes = GNRC_RPL_ALL_NODES_ADDR;
-static uint32_t _lt_time = GNRC_RPL_LIFETIME_UPDATE_STEP * SEC_IN_USEC;
 static xtimer_t _lt_timer;
 static msg_t _lt_msg = { .type = GNRC_RPL_MSG_TYPE_LIFETIME_UPDATE };
+/* lifetime events of parents and DODAGs, sorted by their deadline in seconds */
+static priority_queue_t _lt_queue = PRIORITY_QUEUE_INIT;
+static mutex_t _lt_mutex = MUTEX_INIT;
+static uint32_t _lt_next;
+#ifdef MODULE_GNRC_RPL_P2P
+static uint32_t _lt_p2p_next;
+#endif
 static msg_t _msg_q[GNRC_RPL_MSG_QUEUE_SIZE];
 static gnrc_netreg_entry_t _me_reg;
 static mutex_t _inst_id_mutex = MUTEX_INIT;
@@ -42,16 +50,26 @@ static uint8_t _instance_id;
 
 gnrc_rpl_instance_t gnrc_rpl_instances[GNRC_RPL_INSTANCES_NUMOF];
 gnrc_rpl_parent_t gnrc_rpl_parents[GNRC_RPL_PARENTS_NUMOF];
+gnrc_rpl_dao_target_t gnrc_rpl_dao_targets[GNRC_RPL_DAO_TARGETS_NUMOF];
 
 #ifdef MODULE_NETSTATS_RPL
 netstats_rpl_t gnrc_rpl_netstats;
 #endif
 
 static void _update_lifetime(void);
+static void _lt_timer_set(void);
 static void _dao_handle_send(gnrc_rpl_dodag_t *dodag);
 static void _receive(gnrc_pktsnip_t *pkt);
 static void *_event_loop(void *args);
 
+/**
+ * @name    Types of nodes in the lifetime queue (priority_queue_node_t::data)
+ * @{
+ */
+#define GNRC_RPL_LT_PARENT  (0)
+#define GNRC_RPL_LT_DODAG   (1)
+/** @} */
+
 kernel_pid_t gnrc_rpl_init(kernel_pid_t if_pid)
 {
     /* check if RPL was initialized before */
@@ -73,7 +91,10 @@ kernel_pid_t gnrc_rpl_init(kernel_pid_t if_pid)
         gnrc_netreg_register(GNRC_NETTYPE_ICMPV6, &_me_reg);
 
         gnrc_rpl_of_manager_init();
-        xtimer_set_msg(&_lt_timer, _lt_time, &_lt_msg, gnrc_rpl_pid);
+#ifdef MODULE_GNRC_RPL_P2P
+        _lt_p2p_next = gnrc_rpl_now_sec() + GNRC_RPL_LIFETIME_UPDATE_STEP;
+        _lt_timer_set();
+#endif
 
 #ifdef MODULE_NETSTATS_RPL
         memset(&gnrc_rpl_netstats, 0, sizeof(gnrc_rpl_netstats));
@@ -119,6 +140,7 @@ gnrc_rpl_instance_t *gnrc_rpl_root_init(uint8_t instance_id, ipv6_addr_t *dodag_
 #ifndef GNRC_RPL_WITHOUT_PIO
     dodag->dio_opts |= GNRC_RPL_REQ_DIO_OPT_PREFIX_INFO;
 #endif
+    gnrc_rpl_dodag_dio_cache_invalidate(dodag);
 
     trickle_start(gnrc_rpl_pid, &dodag->trickle, GNRC_RPL_MSG_TYPE_TRICKLE_INTERVAL,
                   GNRC_RPL_MSG_TYPE_TRICKLE_CALLBACK, (1 << dodag->dio_min),
@@ -250,70 +272,192 @@ static void *_event_loop(void *args)
     return NULL;
 }
 
-void _update_lifetime(void)
+/* needs _lt_mutex */
+static void _lt_timer_set(void)
 {
-    uint32_t now = xtimer_now_usec();
-    uint16_t now_sec = now / SEC_IN_USEC;
-
-    gnrc_rpl_parent_t *parent;
-    gnrc_rpl_instance_t *inst;
-
-    for (uint8_t i = 0; i < GNRC_RPL_PARENTS_NUMOF; ++i) {
-        parent = &gnrc_rpl_parents[i];
-        if (parent->state != 0) {
-            if ((int32_t)(parent->lifetime - now_sec) <= GNRC_RPL_LIFETIME_UPDATE_STEP) {
-                gnrc_rpl_dodag_t *dodag = parent->dodag;
-                gnrc_rpl_parent_remove(parent);
-                gnrc_rpl_parent_update(dodag, NULL);
-                continue;
-            }
-            else if ((int32_t)(parent->lifetime - now_sec) <= (GNRC_RPL_LIFETIME_UPDATE_STEP * 2)) {
-                gnrc_rpl_send_DIS(parent->dodag->instance, &parent->addr);
-            }
+    priority_queue_node_t *head = _lt_queue.first;
+    uint32_t next = 0;
+
+    if (head != NULL) {
+        next = head->priority;
+    }
+#ifdef MODULE_GNRC_RPL_P2P
+    /* P2P-RPL still counts down its lifetimes in fixed steps */
+    if ((head == NULL) || ((int32_t)(_lt_p2p_next - next) < 0)) {
+        next = _lt_p2p_next;
+    }
+#else
+    if (head == NULL) {
+        xtimer_remove(&_lt_timer);
+        _lt_next = 0;
+        return;
+    }
+#endif
+
+    /* the timer is still programmed for the earliest event */
+    if (next == _lt_next) {
+        return;
+    }
+    _lt_next = next;
+
+    uint64_t now = xtimer_now_usec64();
+    uint64_t deadline = ((uint64_t) next) * SEC_IN_USEC;
+    xtimer_set_msg64(&_lt_timer, (deadline > now) ? (deadline - now) : 0, &_lt_msg,
+                     gnrc_rpl_pid);
+}
+
+/* needs _lt_mutex */
+static void _lt_schedule(priority_queue_node_t *node, uint32_t deadline, unsigned type)
+{
+    priority_queue_remove(&_lt_queue, node);
+    if (deadline != 0) {
+        node->priority = deadline;
+        node->data = type;
+        priority_queue_add(&_lt_queue, node);
+    }
+    _lt_timer_set();
+}
+
+void gnrc_rpl_lifetime_parent_update(gnrc_rpl_parent_t *parent)
+{
+    mutex_lock(&_lt_mutex);
+    /* probe the parent with a DIS before it expires */
+    _lt_schedule(&parent->lt_node, parent->lifetime - (GNRC_RPL_LIFETIME_UPDATE_STEP * 2),
+                 GNRC_RPL_LT_PARENT);
+    mutex_unlock(&_lt_mutex);
+}
+
+void gnrc_rpl_lifetime_dodag_update(gnrc_rpl_dodag_t *dodag)
+{
+    uint32_t next = dodag->dao_time;
+
+    if ((dodag->dao_refresh != 0) && (dodag->node_status != GNRC_RPL_ROOT_NODE) &&
+        ((next == 0) || ((int32_t)(dodag->dao_refresh - next) < 0))) {
+        next = dodag->dao_refresh;
+    }
+    if ((dodag->instance->cleanup != 0) &&
+        ((next == 0) || ((int32_t)(dodag->instance->cleanup - next) < 0))) {
+        next = dodag->instance->cleanup;
+    }
+
+    mutex_lock(&_lt_mutex);
+    _lt_schedule(&dodag->lt_node, next, GNRC_RPL_LT_DODAG);
+    mutex_unlock(&_lt_mutex);
+}
+
+void gnrc_rpl_lifetime_remove(priority_queue_node_t *node)
+{
+    mutex_lock(&_lt_mutex);
+    _lt_schedule(node, 0, 0);
+    mutex_unlock(&_lt_mutex);
+}
+
+void gnrc_rpl_cleanup_start(gnrc_rpl_instance_t *inst)
+{
+    inst->cleanup = gnrc_rpl_now_sec() + GNRC_RPL_CLEANUP_TIME;
+    gnrc_rpl_lifetime_dodag_update(&inst->dodag);
+}
+
+static void _parent_timeout(gnrc_rpl_parent_t *parent, uint32_t now)
+{
+    if ((int32_t)(parent->lifetime - now) <= GNRC_RPL_LIFETIME_UPDATE_STEP) {
+        gnrc_rpl_dodag_t *dodag = parent->dodag;
+        gnrc_rpl_parent_remove(parent);
+        gnrc_rpl_parent_update(dodag, NULL);
+        return;
+    }
+
+    gnrc_rpl_send_DIS(parent->dodag->instance, &parent->addr);
+
+    mutex_lock(&_lt_mutex);
+    _lt_schedule(&parent->lt_node, parent->lifetime - GNRC_RPL_LIFETIME_UPDATE_STEP,
+                 GNRC_RPL_LT_PARENT);
+    mutex_unlock(&_lt_mutex);
+}
+
+static void _dodag_timeout(gnrc_rpl_dodag_t *dodag, uint32_t now)
+{
+    gnrc_rpl_instance_t *inst = dodag->instance;
+
+    if ((inst->cleanup != 0) && ((int32_t)(inst->cleanup - now) <= 0)) {
+        inst->cleanup = 0;
+        if ((dodag->parents == NULL) && (dodag->my_rank == GNRC_RPL_INFINITE_RANK)) {
+            /* no parents - delete this instance and DODAG */
+            gnrc_rpl_instance_remove(inst);
+            return;
         }
     }
 
-    for (int i = 0; i < GNRC_RPL_INSTANCES_NUMOF; ++i) {
-        inst = &gnrc_rpl_instances[i];
-        if (inst->state != 0) {
-            if ((inst->cleanup > 0) && (inst->dodag.parents == NULL) &&
-                (inst->dodag.my_rank == GNRC_RPL_INFINITE_RANK)) {
-                inst->cleanup -= GNRC_RPL_LIFETIME_UPDATE_STEP;
-                if (inst->cleanup <= 0) {
-                    /* no parents - delete this instance and DODAG */
-                    gnrc_rpl_instance_remove(inst);
-                    continue;
-                }
-            }
+    if ((dodag->dao_refresh != 0) && (dodag->node_status != GNRC_RPL_ROOT_NODE) &&
+        ((int32_t)(dodag->dao_refresh - now) <= 0)) {
+        /* refresh all downward routes of the parent */
+        gnrc_rpl_delay_dao(dodag);
+    }
 
-            if (inst->dodag.dao_time > GNRC_RPL_LIFETIME_UPDATE_STEP) {
-                inst->dodag.dao_time -= GNRC_RPL_LIFETIME_UPDATE_STEP;
-            }
-            else {
-                _dao_handle_send(&inst->dodag);
-            }
+    if ((dodag->dao_time != 0) && ((int32_t)(dodag->dao_time - now) <= 0)) {
+        dodag->dao_time = 0;
+        _dao_handle_send(dodag);
+    }
+
+    gnrc_rpl_lifetime_dodag_update(dodag);
+}
+
+void _update_lifetime(void)
+{
+    uint32_t now = gnrc_rpl_now_sec();
+    priority_queue_node_t *node;
+
+    mutex_lock(&_lt_mutex);
+    /* the timer fired */
+    _lt_next = 0;
+    while (((node = _lt_queue.first) != NULL) && ((int32_t)(node->priority - now) <= 0)) {
+        priority_queue_remove_head(&_lt_queue);
+        /* the handlers reschedule their nodes themselves */
+        mutex_unlock(&_lt_mutex);
+        if (node->data == GNRC_RPL_LT_PARENT) {
+            _parent_timeout(container_of(node, gnrc_rpl_parent_t, lt_node), now);
+        }
+        else {
+            _dodag_timeout(container_of(node, gnrc_rpl_dodag_t, lt_node), now);
         }
+        mutex_lock(&_lt_mutex);
     }
 
 #ifdef MODULE_GNRC_RPL_P2P
-    gnrc_rpl_p2p_update();
+    if ((int32_t)(_lt_p2p_next - now) <= 0) {
+        _lt_p2p_next = now + GNRC_RPL_LIFETIME_UPDATE_STEP;
+        mutex_unlock(&_lt_mutex);
+        gnrc_rpl_p2p_update();
+        mutex_lock(&_lt_mutex);
+    }
 #endif
 
-    xtimer_set_msg(&_lt_timer, _lt_time, &_lt_msg, gnrc_rpl_pid);
+    _lt_timer_set();
+    mutex_unlock(&_lt_mutex);
 }
 
 void gnrc_rpl_delay_dao(gnrc_rpl_dodag_t *dodag)
 {
-    dodag->dao_time = GNRC_RPL_DEFAULT_DAO_DELAY;
+    dodag->dao_flags |= GNRC_RPL_DAO_FLAG_FULL;
+    dodag->dao_refresh = gnrc_rpl_now_sec() + GNRC_RPL_REGULAR_DAO_INTERVAL;
+    gnrc_rpl_delay_dao_incremental(dodag);
+}
+
+void gnrc_rpl_delay_dao_incremental(gnrc_rpl_dodag_t *dodag)
+{
+    dodag->dao_time = gnrc_rpl_now_sec() + GNRC_RPL_DEFAULT_DAO_DELAY;
     dodag->dao_counter = 0;
     dodag->dao_ack_received = false;
+    gnrc_rpl_lifetime_dodag_update(dodag);
 }
 
 void gnrc_rpl_long_delay_dao(gnrc_rpl_dodag_t *dodag)
 {
-    dodag->dao_time = GNRC_RPL_REGULAR_DAO_INTERVAL;
+    dodag->dao_flags |= GNRC_RPL_DAO_FLAG_FULL;
+    dodag->dao_time = gnrc_rpl_now_sec() + GNRC_RPL_REGULAR_DAO_INTERVAL;
     dodag->dao_counter = 0;
     dodag->dao_ack_received = false;
+    gnrc_rpl_lifetime_dodag_update(dodag);
 }
 
 void _dao_handle_send(gnrc_rpl_dodag_t *dodag)
@@ -323,10 +467,15 @@ void _dao_handle_send(gnrc_rpl_dodag_t *dodag)
         return;
     }
 #endif
+    if (!(dodag->dao_flags & GNRC_RPL_DAO_FLAG_FULL) && !gnrc_rpl_dao_targets_pending(dodag)) {
+        /* nothing changed since the last DAO-ACK */
+        dodag->dao_ack_received = true;
+        return;
+    }
     if ((dodag->dao_ack_received == false) && (dodag->dao_counter < GNRC_RPL_DAO_SEND_RETRIES)) {
         dodag->dao_counter++;
         gnrc_rpl_send_DAO(dodag->instance, NULL, dodag->default_lifetime);
-        dodag->dao_time = GNRC_RPL_DEFAULT_WAIT_FOR_DAO_ACK;
+        dodag->dao_time = gnrc_rpl_now_sec() + GNRC_RPL_DEFAULT_WAIT_FOR_DAO_ACK;
     }
     else if (dodag->dao_ack_received == false) {
         gnrc_rpl_long_delay_dao(dodag);
@@ -32,6 +32,10 @@
 #include "gnrc_rpl_internal/validation.h"
 #endif
 
+#ifdef MODULE_GNRC_RPL_SRH
+#include "net/gnrc/rpl/srh.h"
+#endif
+
 #ifdef MODULE_GNRC_RPL_P2P
 #include "net/gnrc/rpl/p2p_structs.h"
 #include "net/gnrc/rpl/p2p_dodag.h"
@@ -53,6 +57,30 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #define GNRC_RPL_PRF_MASK                   (0x7)
 #define GNRC_RPL_PREFIX_AUTO_ADDRESS_BIT    (1 << 6)
 
+#if defined(MODULE_GNRC_RPL_SRH) && defined(MODULE_FIB)
+/* keep the root's source routes in sync with the DAO parents */
+static void _srh_route_update(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *target, ipv6_addr_t *src,
+                              gnrc_rpl_opt_transit_t *transit)
+{
+    ipv6_addr_t *parent = src;
+
+    /* a non-storing DAO carries the parent, a storing one is sent by the next
+     * hop towards the target */
+    if (transit->length >= (sizeof(*transit) - sizeof(gnrc_rpl_opt_t) + sizeof(ipv6_addr_t))) {
+        parent = (ipv6_addr_t *) (transit + 1);
+        if (ipv6_addr_equal(parent, &dodag->dodag_id)) {
+            parent = NULL;
+        }
+    }
+
+    if (gnrc_rpl_srh_route_update(dodag->iface, target, parent,
+                                  (uint32_t) transit->path_lifetime * dodag->lifetime_unit *
+                                  SEC_IN_MS) < 0) {
+        DEBUG("RPL: no space left for the source route\n");
+    }
+}
+#endif
+
 void gnrc_rpl_send(gnrc_pktsnip_t *pkt, kernel_pid_t iface, ipv6_addr_t *src, ipv6_addr_t *dst,
                    ipv6_addr_t *dodag_id)
 {
@@ -101,17 +129,8 @@ void gnrc_rpl_send(gnrc_pktsnip_t *pkt, kernel_pid_t iface, ipv6_addr_t *src, ip
     }
 }
 
-gnrc_pktsnip_t *_dio_dodag_conf_build(gnrc_pktsnip_t *pkt, gnrc_rpl_dodag_t *dodag)
+static void _dio_dodag_conf_build(gnrc_rpl_opt_dodag_conf_t *dodag_conf, gnrc_rpl_dodag_t *dodag)
 {
-    gnrc_rpl_opt_dodag_conf_t *dodag_conf;
-    gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_dodag_conf_t),
-                                    GNRC_NETTYPE_UNDEF)) == NULL) {
-        DEBUG("RPL: BUILD DODAG CONF - no space left in packet buffer\n");
-        gnrc_pktbuf_release(pkt);
-        return NULL;
-    }
-    dodag_conf = opt_snip->data;
     dodag_conf->type = GNRC_RPL_OPT_DODAG_CONF;
     dodag_conf->length = GNRC_RPL_OPT_DODAG_CONF_LEN;
     dodag_conf->flags_a_pcs = 0;
@@ -124,36 +143,50 @@ gnrc_pktsnip_t *_dio_dodag_conf_build(gnrc_pktsnip_t *pkt, gnrc_rpl_dodag_t *dod
     dodag_conf->reserved = 0;
     dodag_conf->default_lifetime = dodag->default_lifetime;
     dodag_conf->lifetime_unit = byteorder_htons(dodag->lifetime_unit);
-    return opt_snip;
 }
 
 #ifndef GNRC_RPL_WITHOUT_PIO
-gnrc_pktsnip_t *_dio_prefix_info_build(gnrc_pktsnip_t *pkt, gnrc_rpl_dodag_t *dodag)
+static void _dio_prefix_info_build(gnrc_rpl_opt_prefix_info_t *prefix_info,
+                                   gnrc_rpl_dodag_t *dodag)
 {
-    gnrc_rpl_opt_prefix_info_t *prefix_info;
-    gnrc_pktsnip_t *opt_snip;
-    if ((opt_snip = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_opt_prefix_info_t),
-                                    GNRC_NETTYPE_UNDEF)) == NULL) {
-        DEBUG("RPL: BUILD PREFIX INFO - no space left in packet buffer\n");
-        gnrc_pktbuf_release(pkt);
-        return NULL;
-    }
-    prefix_info = opt_snip->data;
     prefix_info->type = GNRC_RPL_OPT_PREFIX_INFO;
     prefix_info->length = GNRC_RPL_OPT_PREFIX_INFO_LEN;
     /* auto-address configuration */
     prefix_info->LAR_flags = GNRC_RPL_PREFIX_AUTO_ADDRESS_BIT;
-    prefix_info->valid_lifetime = dodag->netif_addr->valid;
-    prefix_info->pref_lifetime = dodag->netif_addr->preferred;
+    /* the lifetimes change with every router advertisement, so they are
+     * filled in by gnrc_rpl_send_DIO() */
     prefix_info->prefix_len = dodag->netif_addr->prefix_len;
     prefix_info->reserved = 0;
 
     memset(&prefix_info->prefix, 0, sizeof(prefix_info->prefix));
     ipv6_addr_init_prefix(&prefix_info->prefix, &dodag->dodag_id, dodag->netif_addr->prefix_len);
-    return opt_snip;
 }
 #endif
 
+/**
+ * @brief   Encode the DIO options of @p dodag into gnrc_rpl_dodag_t::dio_opts_cache
+ *
+ * The cache holds the DODAG configuration option followed by the prefix
+ * information option without its lifetimes and is only rebuilt after
+ * gnrc_rpl_dodag_dio_cache_invalidate() was called.
+ */
+static void _dio_opts_cache_build(gnrc_rpl_dodag_t *dodag)
+{
+    if (dodag->dio_opts_cached) {
+        return;
+    }
+
+    _dio_dodag_conf_build((gnrc_rpl_opt_dodag_conf_t *) dodag->dio_opts_cache, dodag);
+#ifndef GNRC_RPL_WITHOUT_PIO
+    if (dodag->netif_addr != NULL) {
+        _dio_prefix_info_build((gnrc_rpl_opt_prefix_info_t *)
+                               (dodag->dio_opts_cache + sizeof(gnrc_rpl_opt_dodag_conf_t)),
+                               dodag);
+    }
+#endif
+    dodag->dio_opts_cached = true;
+}
+
 void gnrc_rpl_send_DIO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination)
 {
     if (inst == NULL) {
@@ -164,6 +197,9 @@ void gnrc_rpl_send_DIO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination)
     gnrc_rpl_dodag_t *dodag = &inst->dodag;
     gnrc_pktsnip_t *pkt = NULL, *tmp;
     gnrc_rpl_dio_t *dio;
+    uint8_t *opts;
+    size_t size = sizeof(icmpv6_hdr_t) + sizeof(gnrc_rpl_dio_t);
+    bool conf = false, pio = false;
 
 #ifdef MODULE_GNRC_RPL_P2P
     gnrc_rpl_p2p_ext_t *p2p_ext = gnrc_rpl_p2p_ext_get(dodag);
@@ -177,28 +213,29 @@ void gnrc_rpl_send_DIO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination)
     }
 #endif
 
-#ifndef GNRC_RPL_WITHOUT_PIO
-    if (dodag->dio_opts & GNRC_RPL_REQ_DIO_OPT_PREFIX_INFO) {
-        if ((pkt = _dio_prefix_info_build(pkt, dodag)) == NULL) {
-            return;
-        }
-    }
-#endif
+    _dio_opts_cache_build(dodag);
 
     if (dodag->dio_opts & GNRC_RPL_REQ_DIO_OPT_DODAG_CONF) {
-        if ((pkt = _dio_dodag_conf_build(pkt, dodag)) == NULL) {
-            return;
-        }
+        size += sizeof(gnrc_rpl_opt_dodag_conf_t);
+        conf = true;
         dodag->dio_opts &= ~GNRC_RPL_REQ_DIO_OPT_DODAG_CONF;
     }
 
-    if ((tmp = gnrc_pktbuf_add(pkt, NULL, sizeof(gnrc_rpl_dio_t), GNRC_NETTYPE_UNDEF)) == NULL) {
+#ifndef GNRC_RPL_WITHOUT_PIO
+    if ((dodag->dio_opts & GNRC_RPL_REQ_DIO_OPT_PREFIX_INFO) && (dodag->netif_addr != NULL)) {
+        size += sizeof(gnrc_rpl_opt_prefix_info_t);
+        pio = true;
+    }
+#endif
+
+    /* DIO base object and options share one snip, so only one allocation is needed */
+    if ((tmp = gnrc_icmpv6_build(pkt, ICMPV6_RPL_CTRL, GNRC_RPL_ICMPV6_CODE_DIO, size)) == NULL) {
         DEBUG("RPL: Send DIO - no space left in packet buffer\n");
         gnrc_pktbuf_release(pkt);
         return;
     }
     pkt = tmp;
-    dio = pkt->data;
+    dio = (gnrc_rpl_dio_t *)(((icmpv6_hdr_t *) pkt->data) + 1);
     dio->instance_id = inst->id;
     dio->version_number = dodag->version;
     /* a leaf node announces an INFINITE_RANK */
@@ -211,13 +248,19 @@ void gnrc_rpl_send_DIO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination)
     dio->reserved = 0;
     dio->dodag_id = dodag->dodag_id;
 
-    if ((tmp = gnrc_icmpv6_build(pkt, ICMPV6_RPL_CTRL, GNRC_RPL_ICMPV6_CODE_DIO,
-                                 sizeof(icmpv6_hdr_t))) == NULL) {
-        DEBUG("RPL: Send DIO - no space left in packet buffer\n");
-        gnrc_pktbuf_release(pkt);
-        return;
+    opts = (uint8_t *)(dio + 1);
+    if (conf) {
+        memcpy(opts, dodag->dio_opts_cache, sizeof(gnrc_rpl_opt_dodag_conf_t));
+        opts += sizeof(gnrc_rpl_opt_dodag_conf_t);
+    }
+    if (pio) {
+        gnrc_rpl_opt_prefix_info_t *prefix_info = (gnrc_rpl_opt_prefix_info_t *) opts;
+
+        memcpy(opts, dodag->dio_opts_cache + sizeof(gnrc_rpl_opt_dodag_conf_t),
+               sizeof(gnrc_rpl_opt_prefix_info_t));
+        prefix_info->valid_lifetime = dodag->netif_addr->valid;
+        prefix_info->pref_lifetime = dodag->netif_addr->preferred;
     }
-    pkt = tmp;
 
 #ifdef MODULE_NETSTATS_RPL
     gnrc_rpl_netstats_tx_DIO(&gnrc_rpl_netstats, gnrc_pkt_len(pkt),
@@ -362,6 +405,7 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                 dodag->trickle.Imin = (1 << dodag->dio_min);
                 dodag->trickle.Imax = dodag->dio_interval_doubl;
                 dodag->trickle.k = dodag->dio_redun;
+                gnrc_rpl_dodag_dio_cache_invalidate(dodag);
                 break;
 
             case (GNRC_RPL_OPT_PREFIX_INFO):
@@ -380,6 +424,7 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                 me = gnrc_ipv6_netif_add_addr(dodag->iface, &pi->prefix, pi->prefix_len, 0);
                 if (me) {
                     dodag->netif_addr = gnrc_ipv6_netif_addr_get(me);
+                    gnrc_rpl_dodag_dio_cache_invalidate(dodag);
                 }
 
                 break;
@@ -426,6 +471,12 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                           ipv6_addr_to_str(addr_str, &(first_target->target), sizeof(addr_str)),
                           first_target->prefix_length);
 
+#if defined(MODULE_GNRC_RPL_SRH) && defined(MODULE_FIB)
+                    if (dodag->node_status == GNRC_RPL_ROOT_NODE) {
+                        _srh_route_update(dodag, &first_target->target, src, transit);
+                    }
+#endif
+
                     fib_update_entry(&gnrc_ipv6_fib_table,
                                      first_target->target.u8,
                                      sizeof(ipv6_addr_t), src->u8,
@@ -434,6 +485,13 @@ bool _parse_options(int msg_type, gnrc_rpl_instance_t *inst, gnrc_rpl_opt_t *opt
                                       0x0 : FIB_FLAG_RPL_ROUTE),
                                      (transit->path_lifetime *
                                       dodag->lifetime_unit * SEC_IN_MS));
+
+                    /* the root does not forward DAOs */
+                    if (dodag->node_status != GNRC_RPL_ROOT_NODE) {
+                        gnrc_rpl_dao_target_update(dodag, &first_target->target,
+                                                   first_target->prefix_length,
+                                                   (transit->path_lifetime == 0));
+                    }
                     first_target = (gnrc_rpl_opt_target_t *) (((uint8_t *) (first_target)) +
                                    sizeof(gnrc_rpl_opt_t) + first_target->length);
                 }
@@ -548,6 +606,7 @@ void gnrc_rpl_recv_DIO(gnrc_rpl_dio_t *dio, kernel_pid_t iface, ipv6_addr_t *src
                 gnrc_rpl_instance_remove(inst);
                 return;
             }
+            gnrc_rpl_dodag_dio_cache_invalidate(dodag);
         }
 
         gnrc_rpl_delay_dao(dodag);
@@ -697,6 +756,121 @@ gnrc_pktsnip_t *_dao_transit_build(gnrc_pktsnip_t *pkt, uint8_t lifetime, bool e
     return opt_snip;
 }
 
+/**
+ * @brief   Prepend all tracked targets of @p dodag in @p state followed by a transit option
+ *
+ * @return  false, if the packet buffer is full. @p pkt is released in this case.
+ * @return  true, otherwise.
+ */
+static bool _dao_tracked_targets_build(gnrc_pktsnip_t **pkt, gnrc_rpl_dodag_t *dodag,
+                                       uint8_t state, uint8_t lifetime)
+{
+    bool transit = false;
+
+    for (uint8_t i = 0; i < GNRC_RPL_DAO_TARGETS_NUMOF; ++i) {
+        gnrc_rpl_dao_target_t *elt = &gnrc_rpl_dao_targets[i];
+        if ((elt->dodag != dodag) || (elt->state != state)) {
+            continue;
+        }
+        if (!transit) {
+            if ((*pkt = _dao_transit_build(*pkt, lifetime, false)) == NULL) {
+                return false;
+            }
+            transit = true;
+        }
+        DEBUG("RPL: Send DAO - building tracked target %s/%d\n",
+              ipv6_addr_to_str(addr_str, &elt->addr, sizeof(addr_str)), elt->prefix_length);
+        if ((*pkt = _dao_target_build(*pkt, &elt->addr, elt->prefix_length)) == NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief   Prepend all targets of the FIB, grouped by internal and external transit
+ *
+ * @return  false, if the packet buffer is full. @p pkt is released in this case.
+ * @return  true, otherwise.
+ */
+static bool _dao_fib_targets_build(gnrc_pktsnip_t **pkt, uint8_t lifetime)
+{
+    gnrc_pktsnip_t *pkt_int = NULL, *pkt_ext = NULL, *tr_int = NULL, *tr_ext = NULL, **ptr;
+    bool res = true;
+
+    rwlock_rdlock(&(gnrc_ipv6_fib_table.mtx_access));
+
+    uint64_t now = xtimer_now_usec64();
+
+    /* add external and RPL FIB entries */
+    for (size_t i = 0; i < gnrc_ipv6_fib_table.size; ++i) {
+        fib_entry_t *fentry = &gnrc_ipv6_fib_table.data.entries[i];
+        if (fentry->lifetime == 0) {
+            continue;
+        }
+        /* readers cannot purge expired entries, so skip them */
+        if ((fentry->lifetime != FIB_LIFETIME_NO_EXPIRE) && (fentry->lifetime < now)) {
+            continue;
+        }
+        ipv6_addr_t *addr = (ipv6_addr_t *) fentry->global->address;
+        if (!ipv6_addr_is_global(addr)) {
+            continue;
+        }
+        if (!(fentry->next_hop_flags & FIB_FLAG_RPL_ROUTE)) {
+            ptr = &pkt_ext;
+            if (tr_ext == NULL) {
+                DEBUG("RPL: Send DAO - building external transit\n");
+                if ((tr_ext = pkt_ext = _dao_transit_build(NULL, lifetime, true)) == NULL) {
+                    res = false;
+                    break;
+                }
+            }
+        }
+        else {
+            ptr = &pkt_int;
+            if (tr_int == NULL) {
+                DEBUG("RPL: Send DAO - building internal transit\n");
+                if ((tr_int = pkt_int = _dao_transit_build(NULL, lifetime, false)) == NULL) {
+                    res = false;
+                    break;
+                }
+            }
+        }
+
+        size_t prefix_length = (fentry->global_flags >> FIB_FLAG_NET_PREFIX_SHIFT);
+
+        DEBUG("RPL: Send DAO - building target %s/%d\n",
+              ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), (int) prefix_length);
+
+        if ((*ptr = _dao_target_build(*ptr, addr, (uint8_t) prefix_length)) == NULL) {
+            res = false;
+            break;
+        }
+    }
+
+    rwlock_unlock(&(gnrc_ipv6_fib_table.mtx_access));
+
+    if (!res) {
+        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+        gnrc_pktbuf_release(pkt_int);
+        gnrc_pktbuf_release(pkt_ext);
+        gnrc_pktbuf_release(*pkt);
+        *pkt = NULL;
+        return false;
+    }
+
+    /* chain: internal targets, internal transit, external targets, external transit, rest */
+    if (tr_ext != NULL) {
+        tr_ext->next = *pkt;
+        *pkt = pkt_ext;
+    }
+    if (tr_int != NULL) {
+        tr_int->next = *pkt;
+        *pkt = pkt_int;
+    }
+    return true;
+}
+
 void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint8_t lifetime)
 {
     gnrc_rpl_dodag_t *dodag;
@@ -718,6 +892,10 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     }
 #endif
 
+    /* only DAOs to the preferred parent are acknowledged and tracked */
+    bool to_parent = (destination == NULL);
+    bool full = !to_parent || (dodag->dao_flags & GNRC_RPL_DAO_FLAG_FULL);
+
     if (destination == NULL) {
         if (dodag->parents == NULL) {
             DEBUG("RPL: dodag has no preferred parent\n");
@@ -727,9 +905,13 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
         destination = &(dodag->parents->addr);
     }
 
-    gnrc_pktsnip_t *pkt = NULL, **ptr = NULL,  *tmp = NULL, *tr_int = NULL;
+    if (!full && !gnrc_rpl_dao_targets_pending(dodag)) {
+        DEBUG("RPL: Send DAO - no target changes to advertise\n");
+        return;
+    }
+
+    gnrc_pktsnip_t *pkt = NULL, *tmp = NULL;
     gnrc_rpl_dao_t *dao;
-    bool ext_processed = false, int_processed = false;
 
     /* find my address */
     ipv6_addr_t *me = NULL;
@@ -739,66 +921,26 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
         return;
     }
 
-    mutex_lock(&(gnrc_ipv6_fib_table.mtx_access));
-
-    /* add external and RPL FIB entries */
-    for (size_t i = 0; i < gnrc_ipv6_fib_table.size; ++i) {
-        fib_entry_t *fentry = &gnrc_ipv6_fib_table.data.entries[i];
-        if (fentry->lifetime != 0) {
-            if (!(fentry->next_hop_flags & FIB_FLAG_RPL_ROUTE)) {
-                ptr = &tmp;
-                if (!ext_processed) {
-                    DEBUG("RPL: Send DAO - building external transit\n");
-                    if ((tmp = _dao_transit_build(NULL, lifetime, true)) == NULL) {
-                        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-                        mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
-                        return;
-                    }
-                    ext_processed = true;
-                }
-            }
-            else {
-                ptr = &pkt;
-                if (!int_processed) {
-                    DEBUG("RPL: Send DAO - building internal transit\n");
-                    if ((tr_int = pkt = _dao_transit_build(NULL, lifetime, false)) == NULL) {
-                        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-                        mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
-                        return;
-                    }
-                    int_processed = true;
-                }
-            }
-            ipv6_addr_t *addr = (ipv6_addr_t *) fentry->global->address;
-            if (ipv6_addr_is_global(addr)) {
-                size_t prefix_length = (fentry->global_flags >> FIB_FLAG_NET_PREFIX_SHIFT);
-
-                DEBUG("RPL: Send DAO - building target %s/%d\n",
-                      ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)),
-                      (int) prefix_length);
-
-                if ((*ptr = _dao_target_build(*ptr, addr, (uint8_t) prefix_length)) == NULL) {
-                    DEBUG("RPL: Send DAO - no space left in packet buffer\n");
-                    mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
-                    return;
-                }
-            }
-        }
+    /* removed targets are announced with a zero lifetime (No-Path) */
+    if (to_parent && !_dao_tracked_targets_build(&pkt, dodag, GNRC_RPL_DAO_TARGET_REMOVE, 0)) {
+        DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+        return;
     }
 
-    mutex_unlock(&(gnrc_ipv6_fib_table.mtx_access));
+    if (full) {
+        if (!_dao_fib_targets_build(&pkt, lifetime)) {
+            return;
+        }
 
-    if (tr_int) {
-        tr_int->next = tmp;
-    }
-    else {
-        pkt = tmp;
+        /* add own address */
+        DEBUG("RPL: Send DAO - building target %s/128\n",
+              ipv6_addr_to_str(addr_str, me, sizeof(addr_str)));
+        if ((pkt = _dao_target_build(pkt, me, IPV6_ADDR_BIT_LEN)) == NULL) {
+            DEBUG("RPL: Send DAO - no space left in packet buffer\n");
+            return;
+        }
     }
-
-    /* add own address */
-    DEBUG("RPL: Send DAO - building target %s/128\n",
-          ipv6_addr_to_str(addr_str, me, sizeof(addr_str)));
-    if ((pkt = _dao_target_build(pkt, me, IPV6_ADDR_BIT_LEN)) == NULL) {
+    else if (!_dao_tracked_targets_build(&pkt, dodag, GNRC_RPL_DAO_TARGET_ADD, lifetime)) {
         DEBUG("RPL: Send DAO - no space left in packet buffer\n");
         return;
     }
@@ -821,6 +963,7 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
         return;
     }
     pkt = tmp;
+    dodag->dao_seq = GNRC_RPL_COUNTER_INCREMENT(dodag->dao_seq);
     dao = pkt->data;
     dao->instance_id = inst->id;
     if (local_instance) {
@@ -844,14 +987,31 @@ void gnrc_rpl_send_DAO(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint
     }
     pkt = tmp;
 
+    if (to_parent) {
+        /* remember which changes are acknowledged by a DAO-ACK with this sequence */
+        for (uint8_t i = 0; i < GNRC_RPL_DAO_TARGETS_NUMOF; ++i) {
+            gnrc_rpl_dao_target_t *elt = &gnrc_rpl_dao_targets[i];
+            if ((elt->dodag == dodag) && (elt->state > GNRC_RPL_DAO_TARGET_ACKED)) {
+                elt->sent = true;
+                elt->dao_seq = dodag->dao_seq;
+            }
+        }
+    }
+
+    /* only a DAO-ACK of a full DAO to the preferred parent completes a full refresh */
+    if (to_parent && full) {
+        dodag->dao_flags |= GNRC_RPL_DAO_FLAG_FULL_SENT;
+    }
+    else {
+        dodag->dao_flags &= ~GNRC_RPL_DAO_FLAG_FULL_SENT;
+    }
+
 #ifdef MODULE_NETSTATS_RPL
     gnrc_rpl_netstats_tx_DAO(&gnrc_rpl_netstats, gnrc_pkt_len(pkt),
                              (destination && !ipv6_addr_is_multicast(destination)));
 #endif
 
     gnrc_rpl_send(pkt, dodag->iface, NULL, destination, &dodag->dodag_id);
-
-    GNRC_RPL_COUNTER_INCREMENT(dodag->dao_seq);
 }
 
 void gnrc_rpl_send_DAO_ACK(gnrc_rpl_instance_t *inst, ipv6_addr_t *destination, uint8_t seq)
@@ -967,7 +1127,7 @@ void gnrc_rpl_recv_DAO(gnrc_rpl_dao_t *dao, kernel_pid_t iface, ipv6_addr_t *src
         gnrc_rpl_send_DAO_ACK(inst, src, dao->dao_sequence);
     }
 
-    gnrc_rpl_delay_dao(dodag);
+    gnrc_rpl_delay_dao_incremental(dodag);
 }
 
 void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, ipv6_addr_t *src,
@@ -1007,14 +1167,26 @@ void gnrc_rpl_recv_DAO_ACK(gnrc_rpl_dao_ack_t *dao_ack, kernel_pid_t iface, ipv6
         }
     }
 
-    if ((dao_ack->status != 0) && (dao_ack->dao_sequence != dodag->dao_seq)) {
+    if (dao_ack->dao_sequence != dodag->dao_seq) {
         DEBUG("RPL: DAO-ACK sequence (%d) does not match expected sequence (%d)\n",
                 dao_ack->dao_sequence, dodag->dao_seq);
         return;
     }
 
+    gnrc_rpl_dao_targets_ack(dodag, dao_ack->dao_sequence);
+    if (dodag->dao_flags & GNRC_RPL_DAO_FLAG_FULL_SENT) {
+        dodag->dao_flags &= ~(GNRC_RPL_DAO_FLAG_FULL | GNRC_RPL_DAO_FLAG_FULL_SENT);
+    }
+
+    /* changes that arrived while waiting for this DAO-ACK */
+    if (gnrc_rpl_dao_targets_pending(dodag)) {
+        gnrc_rpl_delay_dao_incremental(dodag);
+        return;
+    }
+
     dodag->dao_ack_received = true;
-    gnrc_rpl_long_delay_dao(dodag);
+    dodag->dao_time = 0;
+    gnrc_rpl_lifetime_dodag_update(dodag);
 }
 
 /**
@@ -115,7 +115,9 @@ bool gnrc_rpl_instance_remove(gnrc_rpl_instance_t *inst)
     gnrc_rpl_p2p_ext_remove(dodag);
 #endif
     gnrc_rpl_dodag_remove_all_parents(dodag);
+    gnrc_rpl_dao_targets_remove_all(dodag);
     trickle_stop(&dodag->trickle);
+    gnrc_rpl_lifetime_remove(&dodag->lt_node);
     memset(inst, 0, sizeof(gnrc_rpl_instance_t));
     return true;
 }
@@ -153,9 +155,15 @@ bool gnrc_rpl_dodag_init(gnrc_rpl_instance_t *instance, ipv6_addr_t *dodag_id, k
     dodag->dtsn = 0;
     dodag->dao_ack_received = false;
     dodag->dao_counter = 0;
+    dodag->dao_time = 0;
+    dodag->dao_refresh = gnrc_rpl_now_sec() + GNRC_RPL_REGULAR_DAO_INTERVAL;
+    dodag->dao_flags = GNRC_RPL_DAO_FLAG_FULL;
     dodag->instance = instance;
     dodag->iface = iface;
     dodag->netif_addr = netif_addr;
+    gnrc_rpl_dodag_dio_cache_invalidate(dodag);
+    instance->cleanup = 0;
+    gnrc_rpl_lifetime_dodag_update(dodag);
 
 #ifdef MODULE_GNRC_RPL_P2P
     if ((instance->mop == GNRC_RPL_P2P_MOP) && (gnrc_rpl_p2p_ext_new(dodag) == NULL)) {
@@ -225,7 +233,7 @@ bool gnrc_rpl_parent_remove(gnrc_rpl_parent_t *parent)
 
         /* set the default route to the next parent for now */
         if (parent->next) {
-            uint32_t now = xtimer_now_usec() / SEC_IN_USEC;
+            uint32_t now = gnrc_rpl_now_sec();
             fib_add_entry(&gnrc_ipv6_fib_table,
                           dodag->iface,
                           (uint8_t *) ipv6_addr_unspecified.u8,
@@ -238,10 +246,97 @@ bool gnrc_rpl_parent_remove(gnrc_rpl_parent_t *parent)
         }
     }
     LL_DELETE(dodag->parents, parent);
+    gnrc_rpl_lifetime_remove(&parent->lt_node);
     memset(parent, 0, sizeof(gnrc_rpl_parent_t));
     return true;
 }
 
+bool gnrc_rpl_dao_target_update(gnrc_rpl_dodag_t *dodag, ipv6_addr_t *addr,
+                                uint8_t prefix_length, bool remove)
+{
+    gnrc_rpl_dao_target_t *target = NULL, *acked = NULL;
+    uint8_t state = remove ? GNRC_RPL_DAO_TARGET_REMOVE : GNRC_RPL_DAO_TARGET_ADD;
+
+    for (uint8_t i = 0; i < GNRC_RPL_DAO_TARGETS_NUMOF; ++i) {
+        gnrc_rpl_dao_target_t *elt = &gnrc_rpl_dao_targets[i];
+        if (elt->state == GNRC_RPL_DAO_TARGET_UNUSED) {
+            if (target == NULL) {
+                target = elt;
+            }
+            continue;
+        }
+        if ((elt->dodag == dodag) && (elt->prefix_length == prefix_length) &&
+            ipv6_addr_equal(&elt->addr, addr)) {
+            /* a refresh of an acknowledged target does not need to be advertised */
+            if ((elt->state == state) ||
+                (!remove && (elt->state == GNRC_RPL_DAO_TARGET_ACKED))) {
+                return false;
+            }
+            elt->state = state;
+            elt->sent = false;
+            return true;
+        }
+        if ((acked == NULL) && (elt->state == GNRC_RPL_DAO_TARGET_ACKED)) {
+            acked = elt;
+        }
+    }
+
+    /* acknowledged targets are only book-keeping and can be replaced */
+    if (target == NULL) {
+        target = acked;
+    }
+
+    if (target == NULL) {
+        DEBUG("RPL: no space left for DAO target - request full DAO\n");
+        dodag->dao_flags |= GNRC_RPL_DAO_FLAG_FULL;
+        return true;
+    }
+
+    target->dodag = dodag;
+    target->addr = *addr;
+    target->prefix_length = prefix_length;
+    target->state = state;
+    target->sent = false;
+    return true;
+}
+
+bool gnrc_rpl_dao_targets_pending(gnrc_rpl_dodag_t *dodag)
+{
+    for (uint8_t i = 0; i < GNRC_RPL_DAO_TARGETS_NUMOF; ++i) {
+        if ((gnrc_rpl_dao_targets[i].dodag == dodag) &&
+            (gnrc_rpl_dao_targets[i].state > GNRC_RPL_DAO_TARGET_ACKED)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void gnrc_rpl_dao_targets_ack(gnrc_rpl_dodag_t *dodag, uint8_t seq)
+{
+    for (uint8_t i = 0; i < GNRC_RPL_DAO_TARGETS_NUMOF; ++i) {
+        gnrc_rpl_dao_target_t *elt = &gnrc_rpl_dao_targets[i];
+        if ((elt->dodag != dodag) || (elt->state <= GNRC_RPL_DAO_TARGET_ACKED) ||
+            !elt->sent || (elt->dao_seq != seq)) {
+            continue;
+        }
+        if (elt->state == GNRC_RPL_DAO_TARGET_REMOVE) {
+            memset(elt, 0, sizeof(gnrc_rpl_dao_target_t));
+        }
+        else {
+            elt->state = GNRC_RPL_DAO_TARGET_ACKED;
+        }
+    }
+}
+
+void gnrc_rpl_dao_targets_remove_all(gnrc_rpl_dodag_t *dodag)
+{
+    for (uint8_t i = 0; i < GNRC_RPL_DAO_TARGETS_NUMOF; ++i) {
+        if (gnrc_rpl_dao_targets[i].dodag == dodag) {
+            memset(&gnrc_rpl_dao_targets[i], 0, sizeof(gnrc_rpl_dao_target_t));
+        }
+    }
+}
+
 void gnrc_rpl_local_repair(gnrc_rpl_dodag_t *dodag)
 {
     DEBUG("RPL: [INFO] Local Repair started\n");
@@ -258,7 +353,7 @@ void gnrc_rpl_local_repair(gnrc_rpl_dodag_t *dodag)
     if (dodag->my_rank != GNRC_RPL_INFINITE_RANK) {
         dodag->my_rank = GNRC_RPL_INFINITE_RANK;
         trickle_reset_timer(&dodag->trickle);
-        dodag->instance->cleanup = GNRC_RPL_CLEANUP_TIME;
+        gnrc_rpl_cleanup_start(dodag->instance);
     }
 }
 
@@ -266,8 +361,8 @@ void gnrc_rpl_parent_update(gnrc_rpl_dodag_t *dodag, gnrc_rpl_parent_t *parent)
 {
     /* update Parent lifetime */
     if (parent != NULL) {
-        uint32_t now = xtimer_now_usec();
-        parent->lifetime = (now / SEC_IN_USEC) + (dodag->default_lifetime * dodag->lifetime_unit);
+        parent->lifetime = gnrc_rpl_now_sec() + (dodag->default_lifetime * dodag->lifetime_unit);
+        gnrc_rpl_lifetime_parent_update(parent);
 #ifdef MODULE_GNRC_RPL_P2P
         if (dodag->instance->mop != GNRC_RPL_P2P_MOP) {
 #endif
@@ -348,7 +443,9 @@ static gnrc_rpl_parent_t *_gnrc_rpl_find_preferred_parent(gnrc_rpl_dodag_t *doda
     }
 
     dodag->my_rank = dodag->instance->of->calc_rank(dodag->parents, 0);
-    if (dodag->my_rank != old_rank) {
+    /* link metrics change the rank slightly all the time, only announce a new DAGRank */
+    if (DAGRANK(dodag->my_rank, dodag->instance->min_hop_rank_inc) !=
+        DAGRANK(old_rank, dodag->instance->min_hop_rank_inc)) {
         trickle_reset_timer(&dodag->trickle);
     }
 
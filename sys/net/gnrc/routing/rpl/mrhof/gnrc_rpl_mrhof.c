@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_gnrc_rpl_mrhof
+ * @file
+ * @brief       Minimum Rank with Hysteresis Objective Function
+ *
+ * @author      agent <agent@local>
+ * @}
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "net/eui64.h"
+#include "net/gnrc/ipv6/nc.h"
+#include "net/gnrc/rpl.h"
+#include "net/gnrc/rpl/mrhof.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static uint16_t calc_rank(gnrc_rpl_parent_t *, uint16_t);
+static gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *, gnrc_rpl_parent_t *);
+static gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *, gnrc_rpl_dodag_t *);
+static void reset(gnrc_rpl_dodag_t *);
+
+static gnrc_rpl_of_t gnrc_rpl_mrhof = {
+    GNRC_RPL_MRHOF_OCP,
+    calc_rank,
+    which_parent,
+    which_dodag,
+    reset,
+    NULL,
+    NULL,
+    NULL
+};
+
+gnrc_rpl_of_t *gnrc_rpl_get_of_mrhof(void)
+{
+    return &gnrc_rpl_mrhof;
+}
+
+uint16_t gnrc_rpl_mrhof_etx(gnrc_rpl_parent_t *parent)
+{
+    gnrc_ipv6_nc_t *nce = gnrc_ipv6_nc_get(parent->dodag->iface, &parent->addr);
+    uint16_t etx = 0;
+
+    if ((nce != NULL) && (nce->l2_addr_len != 0)) {
+        etx = netstats_nb_get_etx(parent->dodag->iface, nce->l2_addr, nce->l2_addr_len);
+    }
+    else if (ipv6_addr_is_link_local(&parent->addr)) {
+        /* no address resolution on 6LoWPAN: the EUI-64 is in the IID */
+        eui64_t l2addr;
+        memcpy(&l2addr, &parent->addr.u8[8], sizeof(l2addr));
+        l2addr.uint8[0] ^= 0x02;
+        etx = netstats_nb_get_etx(parent->dodag->iface, l2addr.uint8, sizeof(l2addr));
+    }
+
+    return (etx == 0) ? (NETSTATS_NB_ETX_INIT * NETSTATS_NB_ETX_DIVISOR) : etx;
+}
+
+void reset(gnrc_rpl_dodag_t *dodag)
+{
+    /* Nothing to do in MRHOF */
+    (void) dodag;
+}
+
+/* rank through the parent: its rank plus the ETX of the link scaled to MinHopRankIncrease */
+uint16_t calc_rank(gnrc_rpl_parent_t *parent, uint16_t base_rank)
+{
+    if (base_rank == 0) {
+        if (parent == NULL) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+
+        base_rank = parent->rank;
+    }
+
+    uint32_t add;
+
+    if (parent != NULL) {
+        uint16_t min_hop_rank_inc = parent->dodag->instance->min_hop_rank_inc;
+        uint16_t etx = gnrc_rpl_mrhof_etx(parent);
+
+        if (etx > GNRC_RPL_MRHOF_MAX_LINK_METRIC) {
+            return GNRC_RPL_INFINITE_RANK;
+        }
+
+        add = ((uint32_t) etx * min_hop_rank_inc) / NETSTATS_NB_ETX_DIVISOR;
+        if (add < min_hop_rank_inc) {
+            add = min_hop_rank_inc;
+        }
+    }
+    else {
+        add = GNRC_RPL_DEFAULT_MIN_HOP_RANK_INCREASE;
+    }
+
+    if ((base_rank + add) >= GNRC_RPL_INFINITE_RANK) {
+        return GNRC_RPL_INFINITE_RANK;
+    }
+
+    return base_rank + add;
+}
+
+/* The preferred parent is kept unless the other one is better by the switch threshold */
+gnrc_rpl_parent_t *which_parent(gnrc_rpl_parent_t *p1, gnrc_rpl_parent_t *p2)
+{
+    gnrc_rpl_parent_t *preferred = p1->dodag->parents;
+    uint32_t c1 = calc_rank(p1, 0);
+    uint32_t c2 = calc_rank(p2, 0);
+    uint32_t threshold = ((uint32_t) GNRC_RPL_MRHOF_PARENT_SWITCH_THRESHOLD *
+                          p1->dodag->instance->min_hop_rank_inc) / NETSTATS_NB_ETX_DIVISOR;
+
+    if ((p1 == preferred) && (c1 != GNRC_RPL_INFINITE_RANK)) {
+        c1 = (c1 > threshold) ? (c1 - threshold) : 0;
+    }
+    else if ((p2 == preferred) && (c2 != GNRC_RPL_INFINITE_RANK)) {
+        c2 = (c2 > threshold) ? (c2 - threshold) : 0;
+    }
+
+    DEBUG("RPL: MRHOF path costs %" PRIu32 " vs %" PRIu32 "\n", c1, c2);
+
+    if (c1 <= c2) {
+        return p1;
+    }
+
+    return p2;
+}
+
+/* Not used yet */
+gnrc_rpl_dodag_t *which_dodag(gnrc_rpl_dodag_t *d1, gnrc_rpl_dodag_t *d2)
+{
+    (void) d2;
+    return d1;
+}
@@ -12,6 +12,7 @@
  * @file
  */
 
+#include <errno.h>
 #include <string.h>
 #include "net/gnrc/ipv6/netif.h"
 #include "net/gnrc/rpl/srh.h"
@@ -27,6 +28,14 @@ static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 #define GNRC_RPL_SRH_COMPRE(X)      (X & 0x0F)
 #define GNRC_RPL_SRH_COMPRI(X)      ((X & 0xF0) >> 4)
 
+/* number of leading octets two addresses share, at most 15 */
+static inline uint8_t _common_octets(const ipv6_addr_t *a, const ipv6_addr_t *b)
+{
+    uint8_t octets = ipv6_addr_match_prefix(a, b) >> 3;
+
+    return (octets < sizeof(ipv6_addr_t)) ? octets : (sizeof(ipv6_addr_t) - 1);
+}
+
 int gnrc_rpl_srh_process(ipv6_hdr_t *ipv6, gnrc_rpl_srh_t *rh)
 {
     if (rh->seg_left == 0) {
@@ -93,4 +102,62 @@ int gnrc_rpl_srh_process(ipv6_hdr_t *ipv6, gnrc_rpl_srh_t *rh)
     return EXT_RH_CODE_FORWARD;
 }
 
+int gnrc_rpl_srh_build(gnrc_rpl_srh_t *rh, size_t size, const ipv6_addr_t *route,
+                       unsigned route_len)
+{
+    uint8_t compri, compre, pad, n;
+    uint8_t *addr_vec = (uint8_t *) (rh + 1);
+    size_t vec_len;
+
+    if (route_len < 2) {
+        return -EINVAL;
+    }
+
+    n = route_len - 1;
+    /* every hop restores all addresses from its own one (and writes it back
+     * into the header), so the elided prefixes have to be shared by all hops */
+    compri = sizeof(ipv6_addr_t) - 1;
+    compre = _common_octets(&route[n], &route[0]);
+    for (unsigned k = 1; k < n; k++) {
+        uint8_t common = _common_octets(&route[k], &route[0]);
+        if (common < compri) {
+            compri = common;
+        }
+        common = _common_octets(&route[n], &route[k]);
+        if (common < compre) {
+            compre = common;
+        }
+    }
+    if (n == 1) {
+        compri = compre;
+    }
+
+    vec_len = ((n - 1) * (sizeof(ipv6_addr_t) - compri)) + (sizeof(ipv6_addr_t) - compre);
+    pad = (8 - (vec_len & 0x7)) & 0x7;
+
+    if (size < (sizeof(gnrc_rpl_srh_t) + vec_len + pad)) {
+        return -ENOBUFS;
+    }
+
+    rh->nh = 0;
+    rh->len = (vec_len + pad) / 8;
+    rh->type = GNRC_RPL_SRH_TYPE;
+    rh->seg_left = n;
+    rh->compr = (compri << 4) | compre;
+    rh->pad_resv = pad << 4;
+    rh->resv = 0;
+
+    for (unsigned k = 1; k < n; k++) {
+        memcpy(addr_vec, &route[k].u8[compri], sizeof(ipv6_addr_t) - compri);
+        addr_vec += sizeof(ipv6_addr_t) - compri;
+    }
+    memcpy(addr_vec, &route[n].u8[compre], sizeof(ipv6_addr_t) - compre);
+    memset(addr_vec + sizeof(ipv6_addr_t) - compre, 0, pad);
+
+    DEBUG("RPL SRH: built header for %u addresses (CmprI: %u, CmprE: %u, Pad: %u)\n",
+          (unsigned) n, (unsigned) compri, (unsigned) compre, (unsigned) pad);
+
+    return sizeof(gnrc_rpl_srh_t) + vec_len + pad;
+}
+
 /** @} */
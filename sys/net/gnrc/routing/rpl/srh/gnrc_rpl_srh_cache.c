@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief   Cache of encoded source routing headers for the DODAG root
+ */
+
+#ifdef MODULE_FIB
+
+#include <errno.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/fib/table.h"
+#include "net/gnrc/rpl/srh.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+typedef struct {
+    ipv6_addr_t dst;            /**< final destination */
+    ipv6_addr_t next_hop;       /**< first hop, i.e. IPv6 destination of the packet */
+    fib_sr_t *sr;               /**< source route of the destination, to notice its expiry */
+    kernel_pid_t iface;         /**< interface to send over */
+    uint8_t len;                /**< length of the header, 0 if the entry is unused */
+    uint8_t hdr[GNRC_RPL_SRH_CACHE_HDR_MAX]; /**< the encoded header */
+} _srh_cache_t;
+
+static _srh_cache_t _cache[GNRC_RPL_SRH_CACHE_SIZE];
+static unsigned _cache_next;
+/* bumped by every invalidation, so a header built from a route that changed
+ * meanwhile is not cached */
+static unsigned _cache_gen;
+static mutex_t _cache_mutex = MUTEX_INIT;
+
+/* one source route per DAO target: [parent, target] or [target] */
+static fib_sr_t _sr_headers[GNRC_RPL_SRH_ROUTES_NUMOF];
+static fib_sr_entry_t _sr_entries[2 * GNRC_RPL_SRH_ROUTES_NUMOF];
+static fib_sr_meta_t _sr_meta = {
+    .headers = _sr_headers,
+    .entry_pool = _sr_entries,
+    .entry_pool_size = 2 * GNRC_RPL_SRH_ROUTES_NUMOF,
+};
+/* initialized statically: fib_init() would reset the universal address pool
+ * shared with gnrc_ipv6_fib_table */
+static fib_table_t _routes = {
+    .data.source_routes = &_sr_meta,
+    .table_type = FIB_TABLE_TYPE_SR,
+    .size = GNRC_RPL_SRH_ROUTES_NUMOF,
+    .mtx_access = RWLOCK_INIT,
+};
+
+static fib_sr_t *_find(const ipv6_addr_t *target)
+{
+    for (unsigned i = 0; i < GNRC_RPL_SRH_ROUTES_NUMOF; i++) {
+        ipv6_addr_t dst;
+        size_t dst_size = sizeof(dst);
+
+        if ((fib_sr_read_destination(&_routes, &_sr_headers[i], dst.u8, &dst_size) == 0) &&
+            ipv6_addr_equal(&dst, target)) {
+            return &_sr_headers[i];
+        }
+    }
+    return NULL;
+}
+
+/* returns 1 and the parent of target, 0 if target is a child of the root */
+static int _parent(fib_sr_t *sr, const ipv6_addr_t *target, ipv6_addr_t *parent)
+{
+    fib_sr_entry_t *entry = NULL;
+    size_t size = sizeof(ipv6_addr_t);
+
+    if ((fib_sr_next(&_routes, sr, &entry) != 0) ||
+        (fib_sr_entry_get_address(&_routes, sr, entry, parent->u8, &size) < 0)) {
+        return -ENOENT;
+    }
+    return !ipv6_addr_equal(parent, target);
+}
+
+/* follows the DAO parents from dst up to the root */
+static int _route(const ipv6_addr_t *dst, kernel_pid_t *iface, fib_sr_t **dst_sr,
+                  ipv6_addr_t *route)
+{
+    ipv6_addr_t hop = *dst;
+    unsigned len = 0;
+    int res;
+
+    do {
+        fib_sr_t *sr;
+
+        if (len == GNRC_RPL_SRH_CACHE_MAX_HOPS) {
+            /* too long, or the DAO parents form a loop */
+            return -ENOBUFS;
+        }
+        if ((sr = _find(&hop)) == NULL) {
+            return -EHOSTUNREACH;
+        }
+        if (len == 0) {
+            uint32_t flags, lifetime;
+
+            if (fib_sr_read_head(&_routes, sr, iface, &flags, &lifetime) < 0) {
+                return -EHOSTUNREACH;
+            }
+            *dst_sr = sr;
+        }
+        route[len++] = hop;
+        if ((res = _parent(sr, &route[len - 1], &hop)) < 0) {
+            return -EHOSTUNREACH;
+        }
+    } while (res);
+
+    /* the hops were collected from the destination upwards */
+    for (unsigned i = 0; i < (len / 2); i++) {
+        hop = route[i];
+        route[i] = route[len - 1 - i];
+        route[len - 1 - i] = hop;
+    }
+    return len;
+}
+
+int gnrc_rpl_srh_route_update(kernel_pid_t iface, const ipv6_addr_t *target,
+                              const ipv6_addr_t *parent, uint32_t lifetime)
+{
+    fib_sr_t *sr = _find(target);
+
+    if ((parent != NULL) && ipv6_addr_equal(parent, target)) {
+        parent = NULL;
+    }
+    if (sr != NULL) {
+        ipv6_addr_t old;
+        int res = _parent(sr, target, &old);
+
+        if ((lifetime != 0) && (res >= 0) && (res == (parent != NULL)) &&
+            ((parent == NULL) || ipv6_addr_equal(&old, parent))) {
+            /* only a refresh, the cached headers stay valid */
+            return fib_sr_set(&_routes, sr, &iface, NULL, &lifetime);
+        }
+        fib_sr_delete(&_routes, sr);
+    }
+
+    /* every route through target changes */
+    DEBUG("RPL SRH: topology changed, invalidating cached source routes\n");
+    gnrc_rpl_srh_cache_invalidate(NULL);
+
+    if (lifetime == 0) {
+        return 0;
+    }
+    if (fib_sr_create(&_routes, &sr, iface, 0, lifetime) < 0) {
+        return -ENOBUFS;
+    }
+    if (((parent != NULL) &&
+         (fib_sr_entry_append(&_routes, sr, (uint8_t *) parent->u8, sizeof(ipv6_addr_t)) < 0)) ||
+        (fib_sr_entry_append(&_routes, sr, (uint8_t *) target->u8, sizeof(ipv6_addr_t)) < 0)) {
+        fib_sr_delete(&_routes, sr);
+        return -ENOBUFS;
+    }
+    return 0;
+}
+
+static int _copy(_srh_cache_t *entry, kernel_pid_t *iface, ipv6_addr_t *next_hop,
+                 gnrc_rpl_srh_t *rh, size_t size)
+{
+    if (size < entry->len) {
+        return -ENOBUFS;
+    }
+    *iface = entry->iface;
+    *next_hop = entry->next_hop;
+    memcpy(rh, entry->hdr, entry->len);
+    return entry->len;
+}
+
+int gnrc_rpl_srh_cache_get(const ipv6_addr_t *dst, kernel_pid_t *iface, ipv6_addr_t *next_hop,
+                           gnrc_rpl_srh_t *rh, size_t size)
+{
+    ipv6_addr_t route[GNRC_RPL_SRH_CACHE_MAX_HOPS];
+    fib_sr_t *sr = NULL;
+    unsigned gen;
+    int res;
+
+    mutex_lock(&_cache_mutex);
+    for (unsigned i = 0; i < GNRC_RPL_SRH_CACHE_SIZE; i++) {
+        if ((_cache[i].len != 0) && ipv6_addr_equal(&_cache[i].dst, dst)) {
+            uint32_t flags, lifetime;
+
+            if (fib_sr_read_head(&_routes, _cache[i].sr, iface, &flags, &lifetime) < 0) {
+                /* the route to dst expired */
+                _cache[i].len = 0;
+                break;
+            }
+            res = _copy(&_cache[i], iface, next_hop, rh, size);
+            mutex_unlock(&_cache_mutex);
+            return res;
+        }
+    }
+    gen = _cache_gen;
+    mutex_unlock(&_cache_mutex);
+
+    /* not cached: walk the DAO parents once */
+    if ((res = _route(dst, iface, &sr, route)) < 0) {
+        return res;
+    }
+    *next_hop = route[0];
+    if (res == 1) {
+        return 0;
+    }
+    if ((res = gnrc_rpl_srh_build(rh, size, route, res)) < 0) {
+        return res;
+    }
+
+    mutex_lock(&_cache_mutex);
+    if ((gen == _cache_gen) && ((size_t)res <= sizeof(_cache[0].hdr))) {
+        _srh_cache_t *entry = &_cache[_cache_next];
+
+        _cache_next = (_cache_next + 1) % GNRC_RPL_SRH_CACHE_SIZE;
+        entry->dst = *dst;
+        entry->next_hop = route[0];
+        entry->sr = sr;
+        entry->iface = *iface;
+        entry->len = res;
+        memcpy(entry->hdr, rh, res);
+        DEBUG("RPL SRH: cached header of %d bytes\n", res);
+    }
+    mutex_unlock(&_cache_mutex);
+
+    return res;
+}
+
+void gnrc_rpl_srh_cache_invalidate(const ipv6_addr_t *dst)
+{
+    mutex_lock(&_cache_mutex);
+    for (unsigned i = 0; i < GNRC_RPL_SRH_CACHE_SIZE; i++) {
+        if ((dst == NULL) || ipv6_addr_equal(&_cache[i].dst, dst)) {
+            _cache[i].len = 0;
+        }
+    }
+    _cache_gen++;
+    mutex_unlock(&_cache_mutex);
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_FIB */
+
+/** @} */
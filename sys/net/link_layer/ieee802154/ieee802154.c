@@ -241,4 +241,44 @@ int ieee802154_get_dst(const uint8_t *mhr, uint8_t *dst, le_uint16_t *dst_pan)
     return 0;
 }
 
+int ieee802154_dst_filter(const uint8_t *mhr, uint16_t pan,
+                          const uint8_t *short_addr, const uint8_t *long_addr)
+{
+    uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];
+    le_uint16_t dst_pan;
+    uint16_t pan_tmp;
+    int dst_len = ieee802154_get_dst(mhr, dst, &dst_pan);
+
+    switch (dst_len) {
+        case IEEE802154_SHORT_ADDRESS_LEN:
+            if ((memcmp(dst, ieee802154_addr_bcast, dst_len) != 0) &&
+                (memcmp(dst, short_addr, dst_len) != 0)) {
+                return 1;
+            }
+            break;
+        case IEEE802154_LONG_ADDRESS_LEN:
+            if (memcmp(dst, long_addr, dst_len) != 0) {
+                return 1;
+            }
+            break;
+        case 0:
+            /* beacons and acknowledgements never carry a destination */
+            switch (mhr[0] & IEEE802154_FCF_TYPE_MASK) {
+                case IEEE802154_FCF_TYPE_BEACON:
+                case IEEE802154_FCF_TYPE_ACK:
+                    return 0;
+                default:
+                    return 1;
+            }
+        default:
+            return dst_len;
+    }
+    pan_tmp = byteorder_ntohs(byteorder_ltobs(dst_pan));
+    if ((pan_tmp != pan) && (pan_tmp != 0xffff)) {
+        return 1;
+    }
+
+    return 0;
+}
+
 /** @} */
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ * @ingroup     net_netstats_neighbor
+ * @file
+ * @brief       Per-neighbor link statistics
+ *
+ * @author      agent <agent@local>
+ * @}
+ */
+
+#include <string.h>
+
+#include "mutex.h"
+#include "net/netstats/neighbor.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+static netstats_nb_t _nbs[NETSTATS_NB_SIZE];
+static mutex_t _mutex = MUTEX_INIT;
+static uint16_t _age;
+static uint16_t _gen;
+
+/* needs _mutex */
+static netstats_nb_t *_find(kernel_pid_t iface, const uint8_t *l2_addr, uint8_t l2_addr_len)
+{
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+        if ((_nbs[i].l2_addr_len == l2_addr_len) && (_nbs[i].iface == iface) &&
+            (memcmp(_nbs[i].l2_addr, l2_addr, l2_addr_len) == 0)) {
+            return &_nbs[i];
+        }
+    }
+    return NULL;
+}
+
+netstats_nb_ref_t netstats_nb_record(kernel_pid_t iface, const uint8_t *l2_addr,
+                                     uint8_t l2_addr_len)
+{
+    netstats_nb_ref_t ref = { NULL, 0 };
+    netstats_nb_t *nb;
+
+    if ((l2_addr_len == 0) || (l2_addr_len > NETSTATS_NB_L2ADDR_MAX_LEN)) {
+        return ref;
+    }
+
+    mutex_lock(&_mutex);
+    if ((nb = _find(iface, l2_addr, l2_addr_len)) == NULL) {
+        /* take a free entry or replace the least recently used one */
+        nb = &_nbs[0];
+        for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+            if (_nbs[i].l2_addr_len == 0) {
+                nb = &_nbs[i];
+                break;
+            }
+            if ((uint16_t)(_age - _nbs[i].last_used) > (uint16_t)(_age - nb->last_used)) {
+                nb = &_nbs[i];
+            }
+        }
+        memset(nb, 0, sizeof(*nb));
+        memcpy(nb->l2_addr, l2_addr, l2_addr_len);
+        nb->l2_addr_len = l2_addr_len;
+        nb->iface = iface;
+        nb->etx = NETSTATS_NB_ETX_INIT * NETSTATS_NB_ETX_DIVISOR;
+        nb->gen = ++_gen;
+        DEBUG("netstats_nb: new neighbor on interface %d\n", (int) iface);
+    }
+    nb->last_used = ++_age;
+    ref.nb = nb;
+    ref.gen = nb->gen;
+    mutex_unlock(&_mutex);
+
+    return ref;
+}
+
+void netstats_nb_update_tx(const netstats_nb_ref_t *ref, netstats_nb_result_t result)
+{
+    netstats_nb_t *nb = ref->nb;
+    uint32_t sample;
+
+    if (nb == NULL) {
+        return;
+    }
+
+    mutex_lock(&_mutex);
+    if ((nb->l2_addr_len == 0) || (nb->gen != ref->gen)) {
+        /* entry was reset or reused for another neighbor in the meantime */
+        mutex_unlock(&_mutex);
+        return;
+    }
+    switch (result) {
+        case NETSTATS_NB_SUCCESS:
+            sample = NETSTATS_NB_ETX_DIVISOR;
+            break;
+        case NETSTATS_NB_NOACK:
+            sample = NETSTATS_NB_ETX_FAILED * NETSTATS_NB_ETX_DIVISOR;
+            nb->tx_failed++;
+            break;
+        default:
+            nb->tx_busy++;
+            mutex_unlock(&_mutex);
+            return;
+    }
+    nb->tx_count++;
+    nb->etx = (uint16_t) (((uint32_t) nb->etx * NETSTATS_NB_EWMA_ALPHA +
+                           sample * (100 - NETSTATS_NB_EWMA_ALPHA)) / 100);
+    DEBUG("netstats_nb: ETX updated to %u/%u\n", (unsigned) nb->etx,
+          (unsigned) NETSTATS_NB_ETX_DIVISOR);
+    mutex_unlock(&_mutex);
+}
+
+uint16_t netstats_nb_get_etx(kernel_pid_t iface, const uint8_t *l2_addr,
+                             uint8_t l2_addr_len)
+{
+    netstats_nb_t *nb;
+    uint16_t etx = 0;
+
+    if (l2_addr_len == 0) {
+        return 0;
+    }
+
+    mutex_lock(&_mutex);
+    if ((nb = _find(iface, l2_addr, l2_addr_len)) != NULL) {
+        etx = nb->etx;
+    }
+    mutex_unlock(&_mutex);
+
+    return etx;
+}
+
+unsigned netstats_nb_get_all(netstats_nb_t *nbs)
+{
+    unsigned num = 0;
+
+    mutex_lock(&_mutex);
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+        if (_nbs[i].l2_addr_len != 0) {
+            nbs[num++] = _nbs[i];
+        }
+    }
+    mutex_unlock(&_mutex);
+
+    return num;
+}
+
+void netstats_nb_reset(void)
+{
+    mutex_lock(&_mutex);
+    memset(_nbs, 0, sizeof(_nbs));
+    mutex_unlock(&_mutex);
+}
@@ -25,7 +25,7 @@
 #include <inttypes.h>
 #include <errno.h>
 #include "thread.h"
-#include "mutex.h"
+#include "rwlock.h"
 #include "msg.h"
 #include "xtimer.h"
 #include "timex.h"
@@ -74,13 +74,16 @@ static void fib_lifetime_to_absolute(uint32_t ms, uint64_t *target)
  * @param[out] entry_arr           the array to scribe the found match
  * @param[in, out] entry_arr_size  the number of entries provided by entry_arr (should be always 1)
  *                                 this value is overwritten with the actual found number
+ * @param[in] purge                remove expired entries, requires the table
+ *                                 to be locked for writing
  *
  * @return 0 if we found a next-hop prefix
  *         1 if we found the exact address next-hop
  *         -EHOSTUNREACH if no fitting next-hop is available
  */
 static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
-                          fib_entry_t **entry_arr, size_t *entry_arr_size) {
+                          fib_entry_t **entry_arr, size_t *entry_arr_size,
+                          bool purge) {
     uint64_t now = xtimer_now_usec64();
 
     size_t count = 0;
@@ -111,6 +114,10 @@ static int fib_find_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 
             /* check if the lifetime expired */
             if (table->data.entries[i].lifetime < now) {
+                if (!purge) {
+                    /* readers must not modify the table, just skip it */
+                    continue;
+                }
                 /* remove this entry if its lifetime expired */
                 table->data.entries[i].lifetime = 0;
                 table->data.entries[i].global_flags = 0;
@@ -388,18 +395,18 @@ int fib_add_entry(fib_table_t *table,
                   uint32_t dst_flags, uint8_t *next_hop, size_t next_hop_size,
                   uint32_t next_hop_flags, uint32_t lifetime)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     DEBUG("[fib_add_entry]\n");
     size_t count = 1;
     fib_entry_t *entry[count];
 
     /* check if dst and next_hop are valid pointers */
     if ((dst == NULL) || (next_hop == NULL)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
-    int ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count);
+    int ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count, true);
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
@@ -410,7 +417,7 @@ int fib_add_entry(fib_table_t *table,
                                next_hop, next_hop_size, next_hop_flags, lifetime);
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return ret;
 }
 
@@ -418,7 +425,7 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
                      uint8_t *next_hop, size_t next_hop_size,
                      uint32_t next_hop_flags, uint32_t lifetime)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     DEBUG("[fib_update_entry]\n");
     size_t count = 1;
     fib_entry_t *entry[count];
@@ -426,11 +433,11 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
 
     /* check if dst and next_hop are valid pointers */
     if ((dst == NULL) || (next_hop == NULL)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
-    if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count) == 1) {
+    if (fib_find_entry(table, dst, dst_size, &(entry[0]), &count, true) == 1) {
         DEBUG("[fib_update_entry] found entry: %p\n", (void *)(entry[0]));
         /* we must take the according entry and update the values */
         ret = fib_upd_entry(entry[0], next_hop, next_hop_size, next_hop_flags, lifetime);
@@ -442,18 +449,18 @@ int fib_update_entry(fib_table_t *table, uint8_t *dst, size_t dst_size,
         DEBUG("[fib_update_entry] ambigious entries detected!!!\n");
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return ret;
 }
 
 void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     DEBUG("[fib_remove_entry]\n");
     size_t count = 1;
     fib_entry_t *entry[count];
 
-    int ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count);
+    int ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count, true);
 
     if (ret == 1) {
         /* we must take the according entry and update the values */
@@ -466,12 +473,12 @@ void fib_remove_entry(fib_table_t *table, uint8_t *dst, size_t dst_size)
         DEBUG("[fib_update_entry] ambigious entries detected!!!\n");
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
 }
 
 void fib_flush(fib_table_t *table, kernel_pid_t interface)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     DEBUG("[fib_flush]\n");
 
     for (size_t i = 0; i < table->size; ++i) {
@@ -481,7 +488,7 @@ void fib_flush(fib_table_t *table, kernel_pid_t interface)
         }
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
 }
 
 int fib_get_next_hop(fib_table_t *table, kernel_pid_t *iface_id,
@@ -489,7 +496,7 @@ int fib_get_next_hop(fib_table_t *table, kernel_pid_t *iface_id,
                      uint32_t *next_hop_flags, uint8_t *dst, size_t dst_size,
                      uint32_t dst_flags)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_rdlock(&(table->mtx_access));
     DEBUG("[fib_get_next_hop]\n");
     size_t count = 1;
     fib_entry_t *entry[count];
@@ -497,23 +504,23 @@ int fib_get_next_hop(fib_table_t *table, kernel_pid_t *iface_id,
     if ((iface_id == NULL)
         || (next_hop_size == NULL)
         || (next_hop_flags == NULL)) {
-            mutex_unlock(&(table->mtx_access));
+            rwlock_unlock(&(table->mtx_access));
             return -EINVAL;
         }
 
     if ((dst == NULL) || (next_hop == NULL)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
-    int ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count);
+    int ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count, false);
     if (!(ret == 0 || ret == 1)) {
         /* notify all responsible RPs for unknown  next-hop for the destination address */
         if (fib_signal_rp(table, FIB_MSG_RP_SIGNAL_UNREACHABLE_DESTINATION,
                           dst, dst_size, dst_flags) == 0) {
             count = 1;
             /* now lets see if the RRPs have found a valid next-hop */
-            ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count);
+            ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count, false);
         }
     }
 
@@ -523,18 +530,18 @@ int fib_get_next_hop(fib_table_t *table, kernel_pid_t *iface_id,
                                next_hop, next_hop_size);
 
         if (address_ret == NULL) {
-            mutex_unlock(&(table->mtx_access));
+            rwlock_unlock(&(table->mtx_access));
             return -ENOBUFS;
         }
     }
     else {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EHOSTUNREACH;
     }
 
     *iface_id = entry[0]->iface_id;
     *next_hop_flags = entry[0]->next_hop_flags;
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return 0;
 }
 
@@ -543,7 +550,7 @@ int fib_get_destination_set(fib_table_t *table, uint8_t *prefix,
                             fib_destination_set_entry_t *dst_set,
                             size_t* dst_set_size)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_rdlock(&(table->mtx_access));
     int ret = -EHOSTUNREACH;
     size_t found_entries = 0;
 
@@ -570,7 +577,7 @@ int fib_get_destination_set(fib_table_t *table, uint8_t *prefix,
 
     *dst_set_size = found_entries;
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
 
     return ret;
 }
@@ -578,8 +585,8 @@ int fib_get_destination_set(fib_table_t *table, uint8_t *prefix,
 void fib_init(fib_table_t *table)
 {
     DEBUG("[fib_init] hello. Initializing some stuff.\n");
-    mutex_init(&(table->mtx_access));
-    mutex_lock(&(table->mtx_access));
+    rwlock_init(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
 
     for (size_t i = 0; i < FIB_MAX_REGISTERED_RP; ++i) {
         table->notify_rp[i] = KERNEL_PID_UNDEF;
@@ -598,13 +605,13 @@ void fib_init(fib_table_t *table)
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
     universal_address_init();
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
 }
 
 void fib_deinit(fib_table_t *table)
 {
     DEBUG("[fib_deinit] hello. De-Initializing stuff.\n");
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
 
     for (size_t i = 0; i < FIB_MAX_REGISTERED_RP; ++i) {
         table->notify_rp[i] = KERNEL_PID_UNDEF;
@@ -623,20 +630,20 @@ void fib_deinit(fib_table_t *table)
         memset(table->data.entries, 0, (table->size * sizeof(fib_entry_t)));
     }
     universal_address_reset();
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
 }
 
 int fib_register_rp(fib_table_t *table, uint8_t *prefix, size_t prefix_addr_type_size)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
 
     if (table->notify_rp_pos >= FIB_MAX_REGISTERED_RP) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -ENOMEM;
     }
 
     if ((prefix == NULL) || (prefix_addr_type_size == 0)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EINVAL;
     }
 
@@ -648,20 +655,20 @@ int fib_register_rp(fib_table_t *table, uint8_t *prefix, size_t prefix_addr_type
         table->notify_rp_pos++;
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return 0;
 }
 
 int fib_get_num_used_entries(fib_table_t *table)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_rdlock(&(table->mtx_access));
     size_t used_entries = 0;
 
     for (size_t i = 0; i < table->size; ++i) {
         used_entries += (size_t)(table->data.entries[i].global != NULL);
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return used_entries;
 }
 
@@ -669,9 +676,9 @@ int fib_get_num_used_entries(fib_table_t *table)
 int fib_sr_create(fib_table_t *table, fib_sr_t **fib_sr, kernel_pid_t sr_iface_id,
                   uint32_t sr_flags, uint32_t sr_lifetime)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     if ((fib_sr == NULL) || (sr_lifetime == 0)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
@@ -689,12 +696,12 @@ int fib_sr_create(fib_table_t *table, fib_sr_t **fib_sr, kernel_pid_t sr_iface_i
                 table->data.source_routes->headers[i].sr_lifetime = FIB_LIFETIME_NO_EXPIRE;
             }
             *fib_sr = &table->data.source_routes->headers[i];
-            mutex_unlock(&(table->mtx_access));
+            rwlock_unlock(&(table->mtx_access));
             return 0;
         }
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return -ENOBUFS;
 }
 
@@ -764,15 +771,15 @@ static int fib_is_sr_in_table(fib_table_t *table, fib_sr_t *fib_sr)
 int fib_sr_read_head(fib_table_t *table, fib_sr_t *fib_sr, kernel_pid_t *iface_id,
                      uint32_t *sr_flags, uint32_t *sr_lifetime)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     if ((fib_sr == NULL) || (iface_id == NULL) || (sr_flags == NULL)
         || (sr_lifetime == NULL) || (fib_is_sr_in_table(table, fib_sr) == -ENOENT) ) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
     if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -ENOENT;
     }
 
@@ -780,50 +787,50 @@ int fib_sr_read_head(fib_table_t *table, fib_sr_t *fib_sr, kernel_pid_t *iface_i
     *sr_flags = fib_sr->sr_flags;
     *sr_lifetime = fib_sr->sr_lifetime - xtimer_now_usec64();
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return 0;
 }
 
 int fib_sr_read_destination(fib_table_t *table, fib_sr_t *fib_sr,
                             uint8_t *dst, size_t *dst_size)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     if ((fib_sr == NULL) || (dst == NULL) || (dst_size == NULL)
         || (fib_is_sr_in_table(table, fib_sr) == -ENOENT)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
     if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -ENOENT;
     }
 
     if (fib_sr->sr_dest == NULL) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EHOSTUNREACH;
     }
 
     if (universal_address_get_address(fib_sr->sr_dest->address, dst, dst_size) == NULL) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -ENOBUFS;
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return 0;
 }
 
 int fib_sr_set(fib_table_t *table, fib_sr_t *fib_sr, kernel_pid_t *sr_iface_id,
                uint32_t *sr_flags, uint32_t *sr_lifetime)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     if ((fib_sr == NULL) || (fib_is_sr_in_table(table, fib_sr) == -ENOENT)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
     if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -ENOENT;
     }
 
@@ -839,15 +846,15 @@ int fib_sr_set(fib_table_t *table, fib_sr_t *fib_sr, kernel_pid_t *sr_iface_id,
         fib_lifetime_to_absolute(*sr_lifetime, &(fib_sr->sr_lifetime));
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return 0;
 }
 
 int fib_sr_delete(fib_table_t *table, fib_sr_t *fib_sr)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     if ((fib_sr == NULL) || (fib_is_sr_in_table(table, fib_sr) == -ENOENT)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
@@ -863,32 +870,32 @@ int fib_sr_delete(fib_table_t *table, fib_sr_t *fib_sr)
         fib_sr->sr_path = NULL;
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return 0;
 }
 
 int fib_sr_next(fib_table_t *table, fib_sr_t *fib_sr, fib_sr_entry_t **sr_path_entry)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     if ((fib_sr == NULL) || (sr_path_entry == NULL)
         || (fib_is_sr_in_table(table, fib_sr) == -ENOENT)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
     if (fib_sr->sr_path == NULL) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
     if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -ENOENT;
     }
 
     /* if we reach the destination entry, i.e. the last entry we just return 1 */
     if (*sr_path_entry == fib_sr->sr_dest) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return 1;
     }
 
@@ -901,22 +908,22 @@ int fib_sr_next(fib_table_t *table, fib_sr_t *fib_sr, fib_sr_entry_t **sr_path_e
         *sr_path_entry = (*sr_path_entry)->next;
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return 0;
 }
 
 int fib_sr_search(fib_table_t *table, fib_sr_t *fib_sr, uint8_t *addr, size_t addr_size,
                   fib_sr_entry_t **sr_path_entry)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     if ((fib_sr == NULL) || (addr == NULL) || (sr_path_entry == NULL)
         || (fib_is_sr_in_table(table, fib_sr) == -ENOENT)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
     if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -ENOENT;
     }
 
@@ -929,27 +936,27 @@ int fib_sr_search(fib_table_t *table, fib_sr_t *fib_sr, uint8_t *addr, size_t ad
             (void)sr_path_entry;
 
             *sr_path_entry = elt;
-            mutex_unlock(&(table->mtx_access));
+            rwlock_unlock(&(table->mtx_access));
             return 0;
         }
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return -EHOSTUNREACH;
 }
 
 int fib_sr_entry_append(fib_table_t *table, fib_sr_t *fib_sr,
                         uint8_t *addr, size_t addr_size)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     if ((fib_sr == NULL) || (addr == NULL)
         || (fib_is_sr_in_table(table, fib_sr) == -ENOENT)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
     if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -ENOENT;
     }
 
@@ -957,7 +964,7 @@ int fib_sr_entry_append(fib_table_t *table, fib_sr_t *fib_sr,
     LL_FOREACH(fib_sr->sr_path, elt) {
         size_t addr_size_match = addr_size << 3;
         if (universal_address_compare(elt->address, addr, &addr_size_match) == UNIVERSAL_ADDRESS_EQUAL) {
-            mutex_unlock(&(table->mtx_access));
+            rwlock_unlock(&(table->mtx_access));
             return -EINVAL;
         }
     }
@@ -978,7 +985,7 @@ int fib_sr_entry_append(fib_table_t *table, fib_sr_t *fib_sr,
         fib_sr->sr_dest = new_entry[0];
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return ret;
 }
 
@@ -986,15 +993,15 @@ int fib_sr_entry_add(fib_table_t *table, fib_sr_t *fib_sr,
                      fib_sr_entry_t *sr_path_entry, uint8_t *addr, size_t addr_size,
                      bool keep_remaining_route)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     if ((fib_sr == NULL) || (sr_path_entry == NULL) || (addr == NULL)
         || (fib_is_sr_in_table(table, fib_sr) == -ENOENT)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
     if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -ENOENT;
     }
 
@@ -1003,7 +1010,7 @@ int fib_sr_entry_add(fib_table_t *table, fib_sr_t *fib_sr,
     LL_FOREACH(fib_sr->sr_path, elt) {
         size_t addr_size_match = addr_size << 3;
         if (universal_address_compare(elt->address, addr, &addr_size_match) == UNIVERSAL_ADDRESS_EQUAL) {
-            mutex_unlock(&(table->mtx_access));
+            rwlock_unlock(&(table->mtx_access));
             return -EINVAL;
         }
         if (sr_path_entry == elt) {
@@ -1035,21 +1042,21 @@ int fib_sr_entry_add(fib_table_t *table, fib_sr_t *fib_sr,
         }
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return ret;
 }
 
 int fib_sr_entry_delete(fib_table_t *table, fib_sr_t *fib_sr, uint8_t *addr, size_t addr_size,
                         bool keep_remaining_route)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     if ((fib_sr == NULL) || (fib_is_sr_in_table(table, fib_sr) == -ENOENT)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
     if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -ENOENT;
     }
 
@@ -1079,7 +1086,7 @@ int fib_sr_entry_delete(fib_table_t *table, fib_sr_t *fib_sr, uint8_t *addr, siz
                 /* if we remove the last entry we must adjust the destination */
                 fib_sr->sr_dest = tmp;
             }
-            mutex_unlock(&(table->mtx_access));
+            rwlock_unlock(&(table->mtx_access));
             return 0;
         }
         tmp = elt;
@@ -1092,15 +1099,15 @@ int fib_sr_entry_overwrite(fib_table_t *table, fib_sr_t *fib_sr,
                            uint8_t *addr_old, size_t addr_old_size,
                            uint8_t *addr_new, size_t addr_new_size)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     if ((fib_sr == NULL) || (addr_old == NULL) || (addr_new == NULL)
         || (fib_is_sr_in_table(table, fib_sr) == -ENOENT)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
     if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -ENOENT;
     }
 
@@ -1114,7 +1121,7 @@ int fib_sr_entry_overwrite(fib_table_t *table, fib_sr_t *fib_sr,
         }
 
         if (universal_address_compare(elt->address, addr_new, &addr_new_size_match) == UNIVERSAL_ADDRESS_EQUAL) {
-            mutex_unlock(&(table->mtx_access));
+            rwlock_unlock(&(table->mtx_access));
             return -EINVAL;
         }
     }
@@ -1129,27 +1136,27 @@ int fib_sr_entry_overwrite(fib_table_t *table, fib_sr_t *fib_sr,
              * so we add back the old entry, i.e. increasing the usecount
              */
             universal_address_add(addr_old, addr_old_size);
-            mutex_unlock(&(table->mtx_access));
+            rwlock_unlock(&(table->mtx_access));
             return -ENOMEM;
         }
         elt_repl->address = add;
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return 0;
 }
 
 int fib_sr_entry_get_address(fib_table_t *table, fib_sr_t *fib_sr, fib_sr_entry_t *sr_entry,
                              uint8_t *addr, size_t *addr_size)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     if ((fib_sr == NULL) || (fib_is_sr_in_table(table, fib_sr) == -ENOENT)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
     if (fib_sr_check_lifetime(fib_sr) == -ENOENT) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -ENOENT;
     }
 
@@ -1157,16 +1164,16 @@ int fib_sr_entry_get_address(fib_table_t *table, fib_sr_t *fib_sr, fib_sr_entry_
     LL_FOREACH(fib_sr->sr_path, elt) {
         if (elt == sr_entry) {
             if (universal_address_get_address(elt->address, addr, addr_size) != NULL) {
-                mutex_unlock(&(table->mtx_access));
+                rwlock_unlock(&(table->mtx_access));
                 return 0;
             }
             else {
-                mutex_unlock(&(table->mtx_access));
+                rwlock_unlock(&(table->mtx_access));
                 return -ENOMEM;
             }
         }
     }
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
     return -ENOENT;
 }
 
@@ -1287,11 +1294,11 @@ int fib_sr_get_route(fib_table_t *table, uint8_t *dst, size_t dst_size, kernel_p
                      uint8_t *addr_list, size_t *addr_list_elements, size_t *element_size,
                      bool reverse, fib_sr_t **fib_sr)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
 
     if ((dst == NULL) || (sr_iface_id == NULL) || (sr_flags == NULL)
         || (addr_list == NULL) || (addr_list_elements == NULL) || (element_size == NULL)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EFAULT;
     }
 
@@ -1374,7 +1381,7 @@ int fib_sr_get_route(fib_table_t *table, uint8_t *dst, size_t dst_size, kernel_p
                     hit->sr_path = NULL;
                 }
             }
-            mutex_unlock(&(table->mtx_access));
+            rwlock_unlock(&(table->mtx_access));
             return error;
         }
     }
@@ -1396,7 +1403,7 @@ int fib_sr_get_route(fib_table_t *table, uint8_t *dst, size_t dst_size, kernel_p
             || (sizeof(hit->sr_path->address->address) > *element_size)) {
             *addr_list_elements = count;
             *element_size = sizeof(hit->sr_path->address->address);
-            mutex_unlock(&(table->mtx_access));
+            rwlock_unlock(&(table->mtx_access));
             return -ENOBUFS;
         }
 
@@ -1427,11 +1434,11 @@ int fib_sr_get_route(fib_table_t *table, uint8_t *dst, size_t dst_size, kernel_p
         /* trigger RPs for route discovery */
         fib_signal_rp(table, FIB_MSG_RP_SIGNAL_UNREACHABLE_DESTINATION, dst, dst_size, *sr_flags);
 
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return -EHOSTUNREACH;
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
 
     if (tmp_hit == NULL) {
         return 0;
@@ -1445,18 +1452,18 @@ int fib_sr_get_route(fib_table_t *table, uint8_t *dst, size_t dst_size, kernel_p
 
 void fib_print_notify_rp(fib_table_t *table)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_rdlock(&(table->mtx_access));
 
     for (size_t i = 0; i < FIB_MAX_REGISTERED_RP; ++i) {
         printf("[fib_print_notify_rp] pid[%d]: %d\n", (int)i, (int)(table->notify_rp[i]));
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
 }
 
 void fib_print_fib_table(fib_table_t *table)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_rdlock(&(table->mtx_access));
 
     for (size_t i = 0; i < table->size; ++i) {
         printf("[fib_print_table] %d) iface_id: %d, global: %p, next hop: %p, lifetime: %"PRIu32"\n",
@@ -1466,15 +1473,15 @@ void fib_print_fib_table(fib_table_t *table)
                (uint32_t)(table->data.entries[i].lifetime / 1000));
     }
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
 }
 
 void fib_print_sr(fib_table_t *table, fib_sr_t *sr)
 {
     /* does not adjust the lifetime */
-    mutex_lock(&(table->mtx_access));
+    rwlock_wrlock(&(table->mtx_access));
     if ((sr == NULL) || (fib_is_sr_in_table(table, sr) == -ENOENT)) {
-        mutex_unlock(&(table->mtx_access));
+        rwlock_unlock(&(table->mtx_access));
         return;
     }
 
@@ -1494,7 +1501,7 @@ void fib_print_sr(fib_table_t *table, fib_sr_t *sr)
     }
     printf("-= END (%p) =-\n", (void *)sr);
 
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
 }
 
 static void fib_print_address(universal_address_container_t *entry)
@@ -1530,7 +1537,7 @@ static void fib_print_address(universal_address_container_t *entry)
 
 void fib_print_routes(fib_table_t *table)
 {
-    mutex_lock(&(table->mtx_access));
+    rwlock_rdlock(&(table->mtx_access));
     uint64_t now = xtimer_now_usec64();
 
     if (table->table_type == FIB_TABLE_TYPE_SH) {
@@ -1602,7 +1609,7 @@ void fib_print_routes(fib_table_t *table)
             }
         }
     }
-    mutex_unlock(&(table->mtx_access));
+    rwlock_unlock(&(table->mtx_access));
 }
 
 #if FIB_DEVEL_HELPER
@@ -1613,7 +1620,7 @@ int fib_devel_get_lifetime(fib_table_t *table, uint64_t *lifetime, uint8_t *dst,
         size_t count = 1;
         fib_entry_t *entry[count];
 
-        int ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count);
+        int ret = fib_find_entry(table, dst, dst_size, &(entry[0]), &count, true);
         if (ret == 1 ) {
             /* only return lifetime of exact matches */
             *lifetime = entry[0]->lifetime;
@@ -0,0 +1,452 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_phydat_dsp
+ * @{
+ *
+ * @file
+ * @brief       Phydat DSP implementation
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdint.h>
+
+#include "phydat_dsp.h"
+
+/**
+ * @brief   Conversion between units
+ *
+ * value_to = ((value_from + pre) * mul / div + post) * 10^dscale, with
+ * pre and post at scale oscale
+ */
+typedef struct {
+    uint8_t from;       /**< unit to convert from */
+    uint8_t to;         /**< unit to convert to */
+    uint8_t mul;        /**< multiplier */
+    uint8_t div;        /**< divisor */
+    int32_t pre;        /**< offset before the multiplication */
+    int32_t post;       /**< offset after the division */
+    int8_t oscale;      /**< scale of the offsets */
+    int8_t dscale;      /**< change of scale */
+} _conv_t;
+
+static const _conv_t _convs[] = {
+    { UNIT_TEMP_C,  UNIT_TEMP_F,   9, 5,      0,     32,  0,  0 },
+    { UNIT_TEMP_F,  UNIT_TEMP_C,   5, 9,    -32,      0,  0,  0 },
+    { UNIT_TEMP_C,  UNIT_TEMP_K,   1, 1,      0,  27315, -2,  0 },
+    { UNIT_TEMP_K,  UNIT_TEMP_C,   1, 1,      0, -27315, -2,  0 },
+    { UNIT_TEMP_F,  UNIT_TEMP_K,   5, 9,  45967,      0, -2,  0 },
+    { UNIT_TEMP_K,  UNIT_TEMP_F,   9, 5,      0, -45967, -2,  0 },
+    { UNIT_BAR,     UNIT_PA,       1, 1,      0,      0,  0,  5 },
+    { UNIT_PA,      UNIT_BAR,      1, 1,      0,      0,  0, -5 },
+    { UNIT_PERCENT, UNIT_PERMILL,  1, 1,      0,      0,  0,  1 },
+    { UNIT_PERMILL, UNIT_PERCENT,  1, 1,      0,      0,  0, -1 },
+    { UNIT_PERCENT, UNIT_PPM,      1, 1,      0,      0,  0,  4 },
+    { UNIT_PPM,     UNIT_PERCENT,  1, 1,      0,      0,  0, -4 },
+    { UNIT_PERMILL, UNIT_PPM,      1, 1,      0,      0,  0,  3 },
+    { UNIT_PPM,     UNIT_PERMILL,  1, 1,      0,      0,  0, -3 },
+};
+
+/**
+ * @brief   Largest power of ten used in conversions
+ */
+#define POW10_MAX       (12)
+
+static int64_t _pow10(unsigned exp)
+{
+    int64_t res = 1;
+
+    while (exp--) {
+        res *= 10;
+    }
+    return res;
+}
+
+static int64_t _div_round(int64_t num, int64_t den)
+{
+    return (num >= 0) ? ((num + (den / 2)) / den) : ((num - (den / 2)) / den);
+}
+
+static int16_t _sat16(int64_t val)
+{
+    if (val > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (val < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)val;
+}
+
+int phydat_dsp_mavg_init(phydat_dsp_mavg_t *f, int16_t *hist, uint16_t len,
+                         uint8_t dim)
+{
+    if ((len == 0) || (dim == 0) || (dim > PHYDAT_DIM)) {
+        return -EINVAL;
+    }
+    f->hist = hist;
+    f->len = len;
+    f->pos = 0;
+    f->fill = 0;
+    f->dim = dim;
+    for (unsigned d = 0; d < PHYDAT_DIM; d++) {
+        f->sum[d] = 0;
+    }
+    return 0;
+}
+
+void phydat_dsp_mavg(phydat_dsp_mavg_t *f, phydat_t *data, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        int16_t *slot = &f->hist[f->pos * f->dim];
+
+        if (f->fill < f->len) {
+            f->fill++;
+        }
+        else {
+            /* window is full, the slot holds the oldest sample */
+            for (unsigned d = 0; d < f->dim; d++) {
+                f->sum[d] -= slot[d];
+            }
+        }
+        for (unsigned d = 0; d < f->dim; d++) {
+            slot[d] = data[i].val[d];
+            f->sum[d] += slot[d];
+            data[i].val[d] = (int16_t)_div_round(f->sum[d], f->fill);
+        }
+        if (++f->pos == f->len) {
+            f->pos = 0;
+        }
+    }
+}
+
+#ifdef MODULE_PHYDAT_DSP_CMSIS
+int phydat_dsp_fir_init(phydat_dsp_fir_t *f, const int16_t *coeffs,
+                        uint16_t taps, int16_t *state, uint8_t dim)
+{
+    if ((taps < 4) || (taps & 1) || (dim == 0) || (dim > PHYDAT_DIM)) {
+        return -EINVAL;
+    }
+    f->dim = dim;
+    for (unsigned d = 0; d < dim; d++) {
+        if (arm_fir_init_q15(&f->inst[d], taps, (q15_t *)coeffs,
+                             &state[d * PHYDAT_DSP_FIR_STATE_LEN(taps)],
+                             PHYDAT_DSP_BLOCK_LEN) != ARM_MATH_SUCCESS) {
+            return -EINVAL;
+        }
+    }
+    return 0;
+}
+
+void phydat_dsp_fir(phydat_dsp_fir_t *f, phydat_t *data, size_t n)
+{
+    q15_t in[PHYDAT_DSP_BLOCK_LEN], out[PHYDAT_DSP_BLOCK_LEN];
+
+    while (n > 0) {
+        size_t len = (n < PHYDAT_DSP_BLOCK_LEN) ? n : PHYDAT_DSP_BLOCK_LEN;
+
+        for (unsigned d = 0; d < f->dim; d++) {
+            for (size_t i = 0; i < len; i++) {
+                in[i] = data[i].val[d];
+            }
+            arm_fir_q15(&f->inst[d], in, out, len);
+            for (size_t i = 0; i < len; i++) {
+                data[i].val[d] = out[i];
+            }
+        }
+        data += len;
+        n -= len;
+    }
+}
+
+int phydat_dsp_iir_init(phydat_dsp_iir_t *f, const int16_t *coeffs,
+                        uint8_t stages, int8_t post_shift, int16_t *state,
+                        uint8_t dim)
+{
+    if ((stages == 0) || (post_shift < 0) || (post_shift > 15) ||
+        (dim == 0) || (dim > PHYDAT_DIM)) {
+        return -EINVAL;
+    }
+    f->dim = dim;
+    for (unsigned d = 0; d < dim; d++) {
+        arm_biquad_cascade_df1_init_q15(&f->inst[d], stages, (q15_t *)coeffs,
+                                        &state[d * PHYDAT_DSP_IIR_STATE_LEN(stages)],
+                                        post_shift);
+    }
+    return 0;
+}
+
+void phydat_dsp_iir(phydat_dsp_iir_t *f, phydat_t *data, size_t n)
+{
+    q15_t in[PHYDAT_DSP_BLOCK_LEN], out[PHYDAT_DSP_BLOCK_LEN];
+
+    while (n > 0) {
+        size_t len = (n < PHYDAT_DSP_BLOCK_LEN) ? n : PHYDAT_DSP_BLOCK_LEN;
+
+        for (unsigned d = 0; d < f->dim; d++) {
+            for (size_t i = 0; i < len; i++) {
+                in[i] = data[i].val[d];
+            }
+            arm_biquad_cascade_df1_q15(&f->inst[d], in, out, len);
+            for (size_t i = 0; i < len; i++) {
+                data[i].val[d] = out[i];
+            }
+        }
+        data += len;
+        n -= len;
+    }
+}
+#else
+int phydat_dsp_fir_init(phydat_dsp_fir_t *f, const int16_t *coeffs,
+                        uint16_t taps, int16_t *state, uint8_t dim)
+{
+    /* same restrictions as arm_fir_init_q15() */
+    if ((taps < 4) || (taps & 1) || (dim == 0) || (dim > PHYDAT_DIM)) {
+        return -EINVAL;
+    }
+    f->coeffs = coeffs;
+    f->state = state;
+    f->taps = taps;
+    f->pos = 0;
+    f->dim = dim;
+    for (unsigned i = 0; i < (unsigned)(taps * dim); i++) {
+        state[i] = 0;
+    }
+    return 0;
+}
+
+void phydat_dsp_fir(phydat_dsp_fir_t *f, phydat_t *data, size_t n)
+{
+    const unsigned taps = f->taps;
+
+    for (size_t i = 0; i < n; i++) {
+        if (++f->pos == taps) {
+            f->pos = 0;
+        }
+        for (unsigned d = 0; d < f->dim; d++) {
+            int16_t *hist = &f->state[d * taps];
+            const int16_t *c = f->coeffs;
+            int64_t acc = 0;
+
+            hist[f->pos] = data[i].val[d];
+            /* the oldest sample follows the newest one and goes with the
+             * first of the time reversed coefficients */
+            for (unsigned k = f->pos + 1; k < taps; k++) {
+                acc += (int32_t)*(c++) * hist[k];
+            }
+            for (unsigned k = 0; k <= f->pos; k++) {
+                acc += (int32_t)*(c++) * hist[k];
+            }
+            data[i].val[d] = _sat16(acc >> 15);
+        }
+    }
+}
+
+int phydat_dsp_iir_init(phydat_dsp_iir_t *f, const int16_t *coeffs,
+                        uint8_t stages, int8_t post_shift, int16_t *state,
+                        uint8_t dim)
+{
+    if ((stages == 0) || (post_shift < 0) || (post_shift > 15) ||
+        (dim == 0) || (dim > PHYDAT_DIM)) {
+        return -EINVAL;
+    }
+    f->coeffs = coeffs;
+    f->state = state;
+    f->stages = stages;
+    f->post_shift = post_shift;
+    f->dim = dim;
+    for (unsigned i = 0; i < (unsigned)(PHYDAT_DSP_IIR_STATE_LEN(stages) * dim);
+         i++) {
+        state[i] = 0;
+    }
+    return 0;
+}
+
+void phydat_dsp_iir(phydat_dsp_iir_t *f, phydat_t *data, size_t n)
+{
+    const unsigned shift = 15 - f->post_shift;
+
+    for (size_t i = 0; i < n; i++) {
+        for (unsigned d = 0; d < f->dim; d++) {
+            int16_t *s = &f->state[d * PHYDAT_DSP_IIR_STATE_LEN(f->stages)];
+            const int16_t *c = f->coeffs;
+            int16_t x = data[i].val[d];
+
+            for (unsigned st = 0; st < f->stages; st++, s += 4, c += 6) {
+                /* c[1] is padding of the CMSIS-DSP layout */
+                int64_t acc = (int64_t)c[0] * x + (int64_t)c[2] * s[0] +
+                              (int64_t)c[3] * s[1] + (int64_t)c[4] * s[2] +
+                              (int64_t)c[5] * s[3];
+                int16_t y = _sat16(acc >> shift);
+
+                s[1] = s[0];
+                s[0] = x;
+                s[3] = s[2];
+                s[2] = y;
+                x = y;
+            }
+            data[i].val[d] = x;
+        }
+    }
+}
+#endif
+
+int phydat_dsp_decim_init(phydat_dsp_decim_t *d, uint16_t factor,
+                          uint8_t dim)
+{
+    if ((factor == 0) || (dim == 0) || (dim > PHYDAT_DIM)) {
+        return -EINVAL;
+    }
+    d->factor = factor;
+    d->count = 0;
+    d->dim = dim;
+    for (unsigned i = 0; i < PHYDAT_DIM; i++) {
+        d->sum[i] = 0;
+    }
+    return 0;
+}
+
+size_t phydat_dsp_decimate(phydat_dsp_decim_t *d, phydat_t *data, size_t n)
+{
+    size_t out = 0;
+
+    for (size_t i = 0; i < n; i++) {
+        for (unsigned k = 0; k < d->dim; k++) {
+            d->sum[k] += data[i].val[k];
+        }
+        if (++d->count == d->factor) {
+            /* out <= i, so the output never overwrites unread input */
+            data[out] = data[i];
+            for (unsigned k = 0; k < d->dim; k++) {
+                data[out].val[k] = (int16_t)_div_round(d->sum[k], d->factor);
+                d->sum[k] = 0;
+            }
+            d->count = 0;
+            out++;
+        }
+    }
+    return out;
+}
+
+void phydat_dsp_rescale(phydat_t *data, size_t n, uint8_t dim, int8_t scale)
+{
+    for (size_t i = 0; i < n; i++) {
+        int diff = scale - data[i].scale;
+
+        for (unsigned d = 0; d < dim; d++) {
+            int64_t val = data[i].val[d];
+
+            if (diff > 0) {
+                /* anything beyond 10^5 rounds to zero */
+                val = (diff > 5) ? 0 : _div_round(val, _pow10(diff));
+            }
+            else if ((diff < 0) && (val != 0)) {
+                /* anything beyond 10^5 saturates */
+                val = (diff < -5) ? val * _pow10(5) : val * _pow10(-diff);
+            }
+            data[i].val[d] = _sat16(val);
+        }
+        data[i].scale = scale;
+    }
+}
+
+static int _convert(phydat_t *data, uint8_t dim, const _conv_t *conv)
+{
+    int8_t scale = data->scale;
+    int8_t work = scale;
+    int64_t val[PHYDAT_DIM];
+    int fits;
+
+    if (conv->div != 1) {
+        /* two more digits, so the division does not lose what the input
+         * resolution has */
+        work -= 2;
+    }
+    if (((conv->pre != 0) || (conv->post != 0)) && (conv->oscale < work)) {
+        work = conv->oscale;
+    }
+    if ((scale - work) > POW10_MAX) {
+        return -ERANGE;
+    }
+    int64_t pre = 0, post = 0;
+    if ((conv->pre != 0) || (conv->post != 0)) {
+        if ((conv->oscale - work) > POW10_MAX) {
+            return -ERANGE;
+        }
+        pre = conv->pre * _pow10(conv->oscale - work);
+        post = conv->post * _pow10(conv->oscale - work);
+    }
+    for (unsigned d = 0; d < dim; d++) {
+        val[d] = (data->val[d] * _pow10(scale - work) + pre) * conv->mul;
+        /* back to the scale of the input */
+        val[d] = _div_round(val[d] + (post * conv->div),
+                            conv->div * _pow10(scale - work));
+    }
+    do {
+        fits = 1;
+        for (unsigned d = 0; d < dim; d++) {
+            if ((val[d] > INT16_MAX) || (val[d] < INT16_MIN)) {
+                fits = 0;
+            }
+        }
+        if (!fits) {
+            for (unsigned d = 0; d < dim; d++) {
+                val[d] = _div_round(val[d], 10);
+            }
+            scale++;
+        }
+    } while (!fits);
+    if (((scale + conv->dscale) > INT8_MAX) ||
+        ((scale + conv->dscale) < INT8_MIN)) {
+        return -ERANGE;
+    }
+    for (unsigned d = 0; d < dim; d++) {
+        data->val[d] = (int16_t)val[d];
+    }
+    data->unit = conv->to;
+    data->scale = scale + conv->dscale;
+    return 0;
+}
+
+int phydat_dsp_convert(phydat_t *data, size_t n, uint8_t dim, uint8_t unit)
+{
+    const _conv_t *conv = NULL;
+
+    if (n == 0) {
+        return 0;
+    }
+    for (size_t i = 1; i < n; i++) {
+        if (data[i].unit != data[0].unit) {
+            return -EINVAL;
+        }
+    }
+    if (data[0].unit == unit) {
+        return 0;
+    }
+    for (unsigned i = 0; i < (sizeof(_convs) / sizeof(_convs[0])); i++) {
+        if ((_convs[i].from == data[0].unit) && (_convs[i].to == unit)) {
+            conv = &_convs[i];
+            break;
+        }
+    }
+    if (conv == NULL) {
+        return -ENOTSUP;
+    }
+    for (size_t i = 0; i < n; i++) {
+        int res = _convert(&data[i], dim, conv);
+        if (res < 0) {
+            return res;
+        }
+    }
+    return 0;
+}
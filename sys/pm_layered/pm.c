@@ -33,6 +33,15 @@
 #define PM_BLOCKER_INITIAL { .val_u32=0x01010101 }
 #endif
 
+#ifdef MODULE_PM_TICKLESS
+#include "xtimer.h"
+
+/**
+ * @brief Time it takes to wake up from each mode
+ */
+static const uint32_t _wakeup_latency[PM_NUM_MODES] = PM_WAKEUP_LATENCY_US;
+#endif
+
 /**
  * @brief Power Management mode typedef
  */
@@ -46,6 +55,26 @@ typedef union {
  */
 volatile pm_blocker_t pm_blocker = PM_BLOCKER_INITIAL;
 
+#ifdef MODULE_PM_TICKLESS
+/**
+ * @brief Go up from @p mode until the wake-up latency fits before the next
+ *        timer, and have xtimer wake up early by that latency
+ */
+static unsigned _tickless_mode(unsigned mode)
+{
+    uint32_t budget = xtimer_usec_until_next();
+
+    while ((mode < PM_NUM_MODES) && (_wakeup_latency[mode] > budget)) {
+        mode++;
+    }
+    if (mode < PM_NUM_MODES) {
+        xtimer_wakeup_early(_wakeup_latency[mode]);
+    }
+
+    return mode;
+}
+#endif
+
 void pm_set_lowest(void)
 {
     pm_blocker_t blocker = (pm_blocker_t) pm_blocker;
@@ -60,6 +89,9 @@ void pm_set_lowest(void)
     /* set lowest mode if blocker is still the same */
     unsigned state = irq_disable();
     if (blocker.val_u32 == pm_blocker.val_u32) {
+#ifdef MODULE_PM_TICKLESS
+        mode = _tickless_mode(mode);
+#endif
         DEBUG("pm: setting mode %u\n", mode);
         pm_set(mode);
     }
@@ -275,7 +275,7 @@ int sem_trywait(sem_t *sem);
 static inline int sem_getvalue(sem_t *sem, int *sval)
 {
     if (sem != NULL) {
-        *sval = (int)sem->value;
+        *sval = ATOMIC_VALUE(sem->value);
         return 0;
     }
     errno = EINVAL;
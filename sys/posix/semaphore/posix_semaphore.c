@@ -19,7 +19,6 @@
 #include <errno.h>
 #include <inttypes.h>
 
-#include "irq.h"
 #include "sched.h"
 #include "sema.h"
 #include "timex.h"
@@ -51,25 +50,15 @@ int sem_timedwait(sem_t *sem, const struct timespec *abstime)
 
 int sem_trywait(sem_t *sem)
 {
-    unsigned int old_state, value;
-    int result;
     if (sem == NULL) {
         errno = EINVAL;
         return -1;
     }
-    old_state = irq_disable();
-    value = sem->value;
-    if (value == 0) {
+    if (sema_try_wait((sema_t *)sem) < 0) {
         errno = EAGAIN;
-        result = -1;
-    }
-    else {
-        result = 0;
-        sem->value = value - 1;
+        return -1;
     }
-
-    irq_restore(old_state);
-    return result;
+    return 0;
 }
 
 /** @} */
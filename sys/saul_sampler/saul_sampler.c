@@ -0,0 +1,291 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_saul_sampler
+ * @{
+ *
+ * @file
+ * @brief       SAUL sampler implementation
+ *
+ * The list of schedules is only touched by the sampler thread; other threads
+ * add and remove schedules by messages. The ring buffers are shared with the
+ * consumers and protected by a mutex.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdint.h>
+
+#include "msg.h"
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "saul_sampler.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/**
+ * @name    Message types of the sampler thread
+ * @{
+ */
+#define MSG_TYPE_TIMER      (0x3a01)
+#define MSG_TYPE_ADD        (0x3a02)
+#define MSG_TYPE_REMOVE     (0x3a03)
+/** @} */
+
+#define MSG_QUEUE_SIZE      (4U)
+
+static char _stack[SAUL_SAMPLER_STACKSIZE];
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+static saul_sampler_entry_t *_entries;
+static xtimer_t _timer;
+static msg_t _timer_msg;
+static uint16_t _timer_gen;
+static mutex_t _lock = MUTEX_INIT;
+
+static void _push(saul_sampler_entry_t *entry, const saul_sampler_sample_t *s)
+{
+    mutex_lock(&_lock);
+    if (entry->avail == entry->size) {
+        /* consumer is too slow: drop the oldest sample */
+        entry->start = (entry->start + 1) % entry->size;
+        entry->avail--;
+        entry->lost++;
+    }
+    entry->buf[(entry->start + entry->avail) % entry->size] = *s;
+    entry->avail++;
+    mutex_unlock(&_lock);
+}
+
+static void _read(saul_sampler_entry_t *entry, uint32_t now)
+{
+    saul_sampler_sample_t s;
+    int dim = saul_reg_read(entry->dev, &s.data);
+
+    s.time = xtimer_now_usec();
+    if (dim > 0) {
+        entry->dim = (uint8_t)dim;
+        _push(entry, &s);
+        entry->pending++;
+    }
+    else {
+        DEBUG("saul_sampler: reading %s failed (%d)\n", entry->dev->name, dim);
+        entry->lost++;
+    }
+    /* skip whole periods if we fell behind to stay aligned with schedules
+     * of the same period */
+    uint32_t late = now - entry->next_due;
+    if ((int32_t)late >= 0) {
+        entry->next_due += ((late / entry->period) + 1) * entry->period;
+    }
+    else {
+        /* read early in a coalesced wake-up */
+        entry->next_due += entry->period;
+    }
+}
+
+static void _sample(void)
+{
+    uint32_t now = xtimer_now_usec();
+    saul_sampler_entry_t *entry, *next;
+
+    /* schedules are sorted by bus, so devices on the same bus are read
+     * back-to-back */
+    for (entry = _entries; entry != NULL; entry = entry->next) {
+        if ((int32_t)(entry->next_due - now) <= (int32_t)SAUL_SAMPLER_COALESCE_US) {
+            _read(entry, now);
+        }
+    }
+    /* deliver after all reads so the bus phase is not interrupted */
+    for (entry = _entries; entry != NULL; entry = next) {
+        next = entry->next;
+        if ((entry->pending >= entry->batch) && (entry->cb != NULL)) {
+            entry->pending = 0;
+            entry->cb(entry, entry->arg);
+        }
+    }
+}
+
+static void _arm(void)
+{
+    saul_sampler_entry_t *entry = _entries;
+
+    xtimer_remove(&_timer);
+    _timer_gen++;
+    if (entry == NULL) {
+        return;
+    }
+    uint32_t next_due = entry->next_due;
+    for (entry = entry->next; entry != NULL; entry = entry->next) {
+        if ((int32_t)(entry->next_due - next_due) < 0) {
+            next_due = entry->next_due;
+        }
+    }
+    int32_t offset = (int32_t)(next_due - xtimer_now_usec());
+    if (offset < 0) {
+        offset = 0;
+    }
+    _timer_msg.type = MSG_TYPE_TIMER;
+    _timer_msg.content.value = _timer_gen;
+    xtimer_set_msg(&_timer, (uint32_t)offset, &_timer_msg, _pid);
+}
+
+static int _add(saul_sampler_entry_t *entry)
+{
+    saul_sampler_entry_t *tmp, *last = NULL, *last_on_bus = NULL;
+
+    if ((entry->dev == NULL) || (entry->period == 0) || (entry->buf == NULL) ||
+        (entry->size == 0) || (entry->batch > entry->size)) {
+        return -EINVAL;
+    }
+    for (tmp = _entries; tmp != NULL; tmp = tmp->next) {
+        if (tmp == entry) {
+            return -EALREADY;
+        }
+    }
+    entry->next_due = xtimer_now_usec() + entry->period;
+    for (tmp = _entries; tmp != NULL; tmp = tmp->next) {
+        if (tmp->period == entry->period) {
+            entry->next_due = tmp->next_due;
+        }
+        if (tmp->bus == entry->bus) {
+            last_on_bus = tmp;
+        }
+        last = tmp;
+    }
+    entry->start = 0;
+    entry->avail = 0;
+    entry->pending = 0;
+    entry->lost = 0;
+    entry->dim = 0;
+    /* keep schedules on the same bus together */
+    if (last_on_bus != NULL) {
+        last = last_on_bus;
+    }
+    if (last == NULL) {
+        entry->next = NULL;
+        _entries = entry;
+    }
+    else {
+        entry->next = last->next;
+        last->next = entry;
+    }
+    DEBUG("saul_sampler: added %s every %" PRIu32 " us on bus %u\n",
+          entry->dev->name, entry->period, (unsigned)entry->bus);
+    return 0;
+}
+
+static int _remove(saul_sampler_entry_t *entry)
+{
+    saul_sampler_entry_t **tmp;
+
+    for (tmp = &_entries; *tmp != NULL; tmp = &(*tmp)->next) {
+        if (*tmp == entry) {
+            *tmp = entry->next;
+            return 0;
+        }
+    }
+    return -ENOENT;
+}
+
+static void *_event_loop(void *arg)
+{
+    msg_t msg, reply;
+
+    (void)arg;
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    reply.type = MSG_TYPE_ADD;
+
+    while (1) {
+        msg_receive(&msg);
+        switch (msg.type) {
+            case MSG_TYPE_TIMER:
+                if ((uint16_t)msg.content.value != _timer_gen) {
+                    /* timer was re-armed after this message was queued */
+                    continue;
+                }
+                _sample();
+                break;
+            case MSG_TYPE_ADD:
+                reply.content.value = (uint32_t)_add(msg.content.ptr);
+                msg_reply(&msg, &reply);
+                break;
+            case MSG_TYPE_REMOVE:
+                reply.content.value = (uint32_t)_remove(msg.content.ptr);
+                msg_reply(&msg, &reply);
+                break;
+            default:
+                DEBUG("saul_sampler: unknown message type 0x%04x\n", msg.type);
+                continue;
+        }
+        _arm();
+    }
+    return NULL;
+}
+
+kernel_pid_t saul_sampler_init(void)
+{
+    if (_pid == KERNEL_PID_UNDEF) {
+        _pid = thread_create(_stack, sizeof(_stack), SAUL_SAMPLER_PRIO,
+                             THREAD_CREATE_STACKTEST, _event_loop, NULL,
+                             "saul_sampler");
+    }
+    return _pid;
+}
+
+static int _request(uint16_t type, saul_sampler_entry_t *entry)
+{
+    msg_t msg, reply;
+    int res;
+
+    if (_pid == KERNEL_PID_UNDEF) {
+        return -ENODEV;
+    }
+    if (thread_getpid() == _pid) {
+        /* called from a callback */
+        res = (type == MSG_TYPE_ADD) ? _add(entry) : _remove(entry);
+        _arm();
+        return res;
+    }
+    msg.type = type;
+    msg.content.ptr = entry;
+    msg_send_receive(&msg, &reply, _pid);
+    return (int)reply.content.value;
+}
+
+int saul_sampler_add(saul_sampler_entry_t *entry)
+{
+    return _request(MSG_TYPE_ADD, entry);
+}
+
+int saul_sampler_remove(saul_sampler_entry_t *entry)
+{
+    return _request(MSG_TYPE_REMOVE, entry);
+}
+
+unsigned saul_sampler_read(saul_sampler_entry_t *entry,
+                           saul_sampler_sample_t *samples, unsigned max)
+{
+    unsigned n;
+
+    mutex_lock(&_lock);
+    for (n = 0; (n < max) && (entry->avail > 0); n++) {
+        samples[n] = entry->buf[entry->start];
+        entry->start = (entry->start + 1) % entry->size;
+        entry->avail--;
+    }
+    mutex_unlock(&_lock);
+    return n;
+}
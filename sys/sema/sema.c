@@ -35,10 +35,10 @@
 
 int sema_create(sema_t *sema, unsigned int value)
 {
-    if (sema == NULL) {
+    if ((sema == NULL) || (value > INT_MAX)) {
         return -EINVAL;
     }
-    sema->value = value;
+    ATOMIC_VALUE(sema->value) = value;
     /* waiters for the mutex */
     sema->queue.first = NULL;
     return 0;
@@ -64,6 +64,20 @@ int sema_destroy(sema_t *sema)
     return 0;
 }
 
+int sema_try_wait(sema_t *sema)
+{
+    int value;
+
+    do {
+        value = ATOMIC_VALUE(sema->value);
+        if (value == 0) {
+            return -EAGAIN;
+        }
+    } while (!atomic_cas(&sema->value, value, value - 1));
+
+    return 0;
+}
+
 int sema_wait_timed_msg(sema_t *sema, uint64_t timeout, msg_t *msg)
 {
     unsigned old_state;
@@ -73,6 +87,10 @@ int sema_wait_timed_msg(sema_t *sema, uint64_t timeout, msg_t *msg)
     if (sema == NULL) {
         return -EINVAL;
     }
+    /* uncontended case: no need to set up a timeout */
+    if (sema_try_wait(sema) == 0) {
+        return 0;
+    }
     if (timeout != 0) {
         old_state = irq_disable();
         timeout_timer.target = 0, timeout_timer.long_target = 0;
@@ -84,12 +102,12 @@ int sema_wait_timed_msg(sema_t *sema, uint64_t timeout, msg_t *msg)
     }
     while (1) {
         priority_queue_node_t n;
-        unsigned value;
+        int value;
 
         old_state = irq_disable();
-        value = sema->value;
+        value = ATOMIC_VALUE(sema->value);
         if (value != 0) {
-            sema->value = value - 1;
+            ATOMIC_VALUE(sema->value) = value - 1;
             irq_restore(old_state);
             return 0;
         }
@@ -143,26 +161,34 @@ int sema_wait_timed(sema_t *sema, uint64_t timeout)
 
 int sema_post(sema_t *sema)
 {
-    unsigned int old_state, value;
+    unsigned int old_state;
     priority_queue_node_t *next;
+    int value;
 
     if (sema == NULL) {
         return -EINVAL;
     }
-    old_state = irq_disable();
-    value = sema->value;
-    if (value == UINT_MAX) {
-        irq_restore(old_state);
-        return -EOVERFLOW;
+    do {
+        value = ATOMIC_VALUE(sema->value);
+        if (value == INT_MAX) {
+            return -EOVERFLOW;
+        }
+    } while (!atomic_cas(&sema->value, value, value + 1));
+
+    /* Waiters check the value and enqueue themselves with interrupts
+     * disabled, so a waiter either sees the new value or is queued already */
+    if (sema->queue.first == NULL) {
+        return 0;
     }
-    ++sema->value;
+
+    old_state = irq_disable();
     next = priority_queue_remove_head(&sema->queue);
     if (next) {
         uint16_t prio = (uint16_t)next->priority;
         kernel_pid_t pid = (kernel_pid_t) next->data;
         msg_t msg;
         DEBUG("sema_post: %" PRIkernel_pid ": waking up %" PRIkernel_pid "\n",
-              sched_active_thread->pid, next_process->pid);
+              sched_active_thread->pid, pid);
         msg.type = MSG_SIGNAL;
         msg.content.ptr = sema;
         msg_send_int(&msg, pid);
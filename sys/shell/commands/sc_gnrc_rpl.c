@@ -259,8 +259,9 @@ int _gnrc_rpl_dodag_show(void)
 
     gnrc_rpl_dodag_t *dodag = NULL;
     char addr_str[IPV6_ADDR_MAX_STR_LEN];
-    int8_t cleanup;
+    int32_t cleanup;
     uint64_t tc, ti, xnow = xtimer_now_usec64();
+    uint32_t now_sec = gnrc_rpl_now_sec();
 
     for (uint8_t i = 0; i < GNRC_RPL_INSTANCES_NUMOF; ++i) {
         if (gnrc_rpl_instances[i].state == 0) {
@@ -282,7 +283,9 @@ int _gnrc_rpl_dodag_show(void)
                 | dodag->trickle.msg_interval_timer.target) - xnow;
         ti = (int64_t) ti < 0 ? 0 : ti / SEC_IN_USEC;
 
-        cleanup = dodag->instance->cleanup < 0 ? 0 : dodag->instance->cleanup;
+        cleanup = (dodag->instance->cleanup == 0) ? 0 :
+                  (int32_t) (dodag->instance->cleanup - now_sec);
+        cleanup = cleanup < 0 ? 0 : cleanup;
 
         printf("\tdodag [%s | R: %d | OP: %s | PIO: %s | CL: %ds | "
                "TR(I=[%d,%d], k=%d, c=%d, TC=%" PRIu32 "s, TI=%" PRIu32 "s)]\n",
@@ -306,8 +309,8 @@ int _gnrc_rpl_dodag_show(void)
         LL_FOREACH(gnrc_rpl_instances[i].dodag.parents, parent) {
             printf("\t\tparent [addr: %s | rank: %d | lifetime: %" PRIu32 "s]\n",
                     ipv6_addr_to_str(addr_str, &parent->addr, sizeof(addr_str)),
-                    parent->rank, ((int32_t) (parent->lifetime - (((uint32_t) xnow / SEC_IN_USEC))))
-                    < 0 ? 0 : (parent->lifetime - ((uint32_t) xnow / SEC_IN_USEC)));
+                    parent->rank, ((int32_t) (parent->lifetime - now_sec))
+                    < 0 ? 0 : (parent->lifetime - now_sec));
         }
     }
     return 0;
@@ -17,6 +17,8 @@
  * @}
  */
 
+#include <string.h>
+
 #include "tsrb.h"
 
 static void _push(tsrb_t *rb, char c)
@@ -41,12 +43,24 @@ int tsrb_get_one(tsrb_t *rb)
 
 int tsrb_get(tsrb_t *rb, char *dst, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_empty(rb)) {
-        *dst++ = _pop(rb);
-        tmp--;
+    size_t avail = tsrb_avail(rb);
+    if (n > avail) {
+        n = avail;
+    }
+
+    /* copy up to the end of the buffer, then the rest from its start */
+    size_t read = 0;
+    while (read < n) {
+        char *ptr;
+        size_t len = tsrb_peek_ptr(rb, &ptr);
+        if (len > n - read) {
+            len = n - read;
+        }
+        memcpy(dst + read, ptr, len);
+        rb->reads += len;
+        read += len;
     }
-    return (n - tmp);
+    return n;
 }
 
 int tsrb_add_one(tsrb_t *rb, char c)
@@ -62,10 +76,47 @@ int tsrb_add_one(tsrb_t *rb, char c)
 
 int tsrb_add(tsrb_t *rb, const char *src, size_t n)
 {
-    size_t tmp = n;
-    while (tmp && !tsrb_full(rb)) {
-        _push(rb, *src++);
-        tmp--;
+    size_t free = tsrb_free(rb);
+    if (n > free) {
+        n = free;
+    }
+
+    size_t written = 0;
+    while (written < n) {
+        char *ptr;
+        size_t len = tsrb_reserve(rb, &ptr);
+        if (len > n - written) {
+            len = n - written;
+        }
+        memcpy(ptr, src + written, len);
+        rb->writes += len;
+        written += len;
     }
-    return (n - tmp);
+    return n;
+}
+
+size_t tsrb_reserve(tsrb_t *rb, char **ptr)
+{
+    unsigned pos = rb->writes & (rb->size - 1);
+    size_t free = tsrb_free(rb);
+    *ptr = rb->buf + pos;
+    return (free < rb->size - pos) ? free : rb->size - pos;
+}
+
+void tsrb_commit(tsrb_t *rb, size_t n)
+{
+    rb->writes += n;
+}
+
+size_t tsrb_peek_ptr(tsrb_t *rb, char **ptr)
+{
+    unsigned pos = rb->reads & (rb->size - 1);
+    size_t avail = tsrb_avail(rb);
+    *ptr = rb->buf + pos;
+    return (avail < rb->size - pos) ? avail : rb->size - pos;
+}
+
+void tsrb_consume(tsrb_t *rb, size_t n)
+{
+    rb->reads += n;
 }
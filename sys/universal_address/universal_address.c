@@ -24,6 +24,9 @@
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
 #endif
+#ifdef MODULE_GNRC_RPL_SRH
+#include "net/gnrc/rpl/srh.h"
+#endif
 #endif
 #include "mutex.h"
 
@@ -43,7 +46,13 @@
 #       define UA_ADD0  (0)
 #   endif
 
-#   define UNIVERSAL_ADDRESS_MAX_ENTRIES    (UA_ADD0)
+#   if defined(MODULE_FIB) && defined(MODULE_GNRC_RPL_SRH)
+#       define UA_ADD1 (2 * GNRC_RPL_SRH_ROUTES_NUMOF)
+#   else
+#       define UA_ADD1  (0)
+#   endif
+
+#   define UNIVERSAL_ADDRESS_MAX_ENTRIES    (UA_ADD0 + UA_ADD1)
 #endif
 
 /**
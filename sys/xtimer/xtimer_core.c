@@ -285,6 +285,47 @@ void xtimer_remove(xtimer_t *timer)
     irq_restore(state);
 }
 
+uint32_t xtimer_usec_until_next(void)
+{
+    uint32_t target;
+    unsigned state = irq_disable();
+    uint32_t now = _xtimer_lltimer_now();
+
+    if (timer_list_head) {
+        target = _xtimer_lltimer_mask(timer_list_head->target - XTIMER_OVERHEAD);
+    }
+    else {
+        /* only the period tick is pending */
+        target = _xtimer_lltimer_mask(0xFFFFFFFF);
+    }
+    irq_restore(state);
+
+    return (target > now) ? _xtimer_usec_from_ticks(target - now) : 0;
+}
+
+void xtimer_wakeup_early(uint32_t usec)
+{
+    uint32_t early = _xtimer_ticks_from_usec(usec);
+
+    if (!early) {
+        return;
+    }
+
+    unsigned state = irq_disable();
+    /* an early period tick would be taken for an overflow, so only move
+     * the interrupt of a timer that is due in this period */
+    if (timer_list_head && !_in_handler) {
+        uint32_t now = _xtimer_lltimer_now();
+        uint32_t target = _xtimer_lltimer_mask(timer_list_head->target - XTIMER_OVERHEAD);
+
+        if ((target > now) && ((target - now) > (early + XTIMER_ISR_BACKOFF))) {
+            DEBUG("xtimer_wakeup_early(): %" PRIu32 " ticks early\n", early);
+            _lltimer_set(target - early);
+        }
+    }
+    irq_restore(state);
+}
+
 static uint32_t _time_left(uint32_t target, uint32_t reference)
 {
     uint32_t now = _xtimer_lltimer_now();
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief Bloom filter variants benchmark
+ *
+ * Runs the workload of tests/bloom_bytes against the classic filter with
+ * one hash function per index, the double hashing filter, the counting
+ * filter and the scalable filter.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "xtimer.h"
+
+#include "hashes.h"
+#include "bloom.h"
+#include "random.h"
+#include "bitfield.h"
+
+#define BLOOM_BITS (1UL << 12)
+#define BLOOM_HASHF (8)
+#define lenB 512
+#define lenA (10 * 1000)
+
+#define MAGIC_A 0xafafafaf
+#define MAGIC_B 0x0c0c0c0c
+
+#define myseed 0x83d385c0 /* random number */
+
+#define BUF_SIZE 50
+
+/* first filter of the scalable filter, it grows to BLOOM_BITS / 4,
+ * BLOOM_BITS / 2 and BLOOM_BITS bits */
+#define SCALABLE_BITS (BLOOM_BITS / 8)
+#define SCALABLE_HASHF (5)
+#define SCALABLE_BYTES ((SCALABLE_BITS / 8) * 15)
+
+typedef void (*add_t)(void *filter, const uint8_t *buf, size_t len);
+typedef bool (*check_t)(void *filter, const uint8_t *buf, size_t len);
+
+static uint32_t buf[BUF_SIZE];
+
+static bloom_t bloom;
+static bloom_t bloom_dh;
+static bloom_counting_t bloom_cnt;
+static bloom_scalable_t bloom_sc;
+
+BITFIELD(bf, BLOOM_BITS);
+static uint8_t counters[BLOOM_COUNTING_BYTES(BLOOM_BITS)];
+static uint8_t scalable[SCALABLE_BYTES];
+
+hashfp_t hashes[BLOOM_HASHF] = {
+    (hashfp_t) fnv_hash, (hashfp_t) sax_hash, (hashfp_t) sdbm_hash,
+    (hashfp_t) djb2_hash, (hashfp_t) kr_hash, (hashfp_t) dek_hash,
+    (hashfp_t) rotating_hash, (hashfp_t) one_at_a_time_hash,
+};
+
+hashfp_t dh_hashes[2] = {
+    (hashfp_t) fnv_hash, (hashfp_t) one_at_a_time_hash,
+};
+
+static void buf_fill(uint32_t *buf, int len)
+{
+    for (int k = 0; k < len; k++) {
+        buf[k] = random_uint32();
+    }
+}
+
+static void _add(void *filter, const uint8_t *buf, size_t len)
+{
+    bloom_add(filter, buf, len);
+}
+
+static bool _check(void *filter, const uint8_t *buf, size_t len)
+{
+    return bloom_check(filter, buf, len);
+}
+
+static void _counting_add(void *filter, const uint8_t *buf, size_t len)
+{
+    bloom_counting_add(filter, buf, len);
+}
+
+static bool _counting_check(void *filter, const uint8_t *buf, size_t len)
+{
+    return bloom_counting_check(filter, buf, len);
+}
+
+static void _scalable_add(void *filter, const uint8_t *buf, size_t len)
+{
+    bloom_scalable_add(filter, buf, len);
+}
+
+static bool _scalable_check(void *filter, const uint8_t *buf, size_t len)
+{
+    return bloom_scalable_check(filter, buf, len);
+}
+
+static void _none_add(void *filter, const uint8_t *buf, size_t len)
+{
+    (void)filter;
+    (void)buf;
+    (void)len;
+}
+
+static bool _none_check(void *filter, const uint8_t *buf, size_t len)
+{
+    (void)filter;
+    (void)buf;
+    (void)len;
+    return false;
+}
+
+static uint32_t fill_add, fill_check;
+
+static void run(const char *name, void *filter, add_t add, check_t check)
+{
+    random_init(myseed);
+
+    uint32_t t1 = xtimer_now_usec();
+
+    for (int i = 0; i < lenB; i++) {
+        buf_fill(buf, BUF_SIZE);
+        buf[0] = MAGIC_B;
+        add(filter, (uint8_t *) buf, sizeof(buf));
+    }
+
+    uint32_t t2 = xtimer_now_usec();
+
+    int in = 0;
+
+    for (int i = 0; i < lenA; i++) {
+        buf_fill(buf, BUF_SIZE);
+        buf[0] = MAGIC_A;
+
+        if (check(filter, (uint8_t *) buf, sizeof(buf))) {
+            in++;
+        }
+    }
+
+    uint32_t t3 = xtimer_now_usec();
+
+    if (!filter) {
+        /* time spent generating the elements, subtracted from the others */
+        fill_add = t2 - t1;
+        fill_check = t3 - t2;
+        return;
+    }
+
+    printf("%-10s add: %6" PRIi32 "us check: %7" PRIi32 "us "
+           "false positives: %5d (%" PRIu32 " ppm)\n", name,
+           (int32_t)((t2 - t1) - fill_add), (int32_t)((t3 - t2) - fill_check), in,
+           (uint32_t)((in * 1000000ULL) / lenA));
+}
+
+int main(void)
+{
+    xtimer_init();
+
+    printf("Bloom filter benchmark\n\n");
+    printf("adding %d elements, checking %d elements\n\n", lenB, lenA);
+
+    run(NULL, NULL, _none_add, _none_check);
+
+    bloom_init(&bloom, BLOOM_BITS, bf, hashes, BLOOM_HASHF);
+    run("classic", &bloom, _add, _check);
+    bloom_del(&bloom);
+
+    bloom_init_double(&bloom_dh, BLOOM_BITS, bf, dh_hashes, BLOOM_HASHF);
+    run("double", &bloom_dh, _add, _check);
+    bloom_del(&bloom_dh);
+
+    bloom_counting_init(&bloom_cnt, BLOOM_BITS, counters, dh_hashes,
+                        BLOOM_HASHF);
+    run("counting", &bloom_cnt, _counting_add, _counting_check);
+
+    bloom_scalable_init(&bloom_sc, scalable, sizeof(scalable), SCALABLE_BITS,
+                        dh_hashes, SCALABLE_HASHF);
+    run("scalable", &bloom_sc, _scalable_add, _scalable_check);
+    printf("scalable filter grew to %u filters, %u bytes\n",
+           bloom_sc.numof, (unsigned)bloom_sc.buf_used);
+
+    printf("\nAll done!\n");
+    return 0;
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2016 Kaspar Schleiser <kaspar@schleiser.de>
+ *               2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Event queue ISR to thread latency and loss test application
+ *
+ * Posts events from xtimer callbacks (ISR context) and measures the time
+ * until the handler runs in the event thread. A burst of events posted from
+ * a single ISR is compared to the same burst sent with msg_send_int().
+ *
+ * @author  Kaspar Schleiser <kaspar@schleiser.de>
+ * @author  agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "event.h"
+#include "msg.h"
+#include "thread.h"
+#include "thread_flags.h"
+#include "xtimer.h"
+
+#ifndef NUMOF
+#define NUMOF           (1000U)
+#endif
+
+#ifndef INTERVAL
+#define INTERVAL        (1000U)
+#endif
+
+#define BURST           (16U)
+#define MSG_QUEUE_SIZE  (8U)
+#define FLAG_DONE       (0x2)
+
+typedef struct {
+    event_t super;
+    uint32_t posted;
+    unsigned handled;
+} timed_event_t;
+
+static char _event_stack[THREAD_STACKSIZE_DEFAULT];
+static char _msg_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+
+static event_queue_t _queue;
+static kernel_pid_t _msg_pid;
+static thread_t *_main;
+
+static timed_event_t _events[BURST];
+static xtimer_t _timer;
+
+static volatile unsigned _expected;
+static volatile unsigned _handled;
+static volatile unsigned _msg_handled;
+static unsigned _posted;
+static unsigned _coalesced;
+static unsigned _msg_lost;
+
+static uint32_t _lat_min = UINT32_MAX;
+static uint32_t _lat_max;
+static uint64_t _lat_sum;
+
+static void _handler(event_t *event)
+{
+    timed_event_t *ev = container_of(event, timed_event_t, super);
+    uint32_t latency = xtimer_now_usec() - ev->posted;
+
+    if (latency < _lat_min) {
+        _lat_min = latency;
+    }
+    if (latency > _lat_max) {
+        _lat_max = latency;
+    }
+    _lat_sum += latency;
+    ev->handled++;
+
+    if (++_handled == _expected) {
+        thread_flags_set(_main, FLAG_DONE);
+    }
+}
+
+static void *_event_thread(void *arg)
+{
+    (void)arg;
+
+    event_queue_init(&_queue);
+    thread_flags_set(_main, FLAG_DONE);
+    event_loop(&_queue);
+
+    return NULL;
+}
+
+static void *_msg_thread(void *arg)
+{
+    (void)arg;
+    msg_t msg;
+
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    while (1) {
+        msg_receive(&msg);
+        _msg_handled++;
+    }
+
+    return NULL;
+}
+
+static void _post(timed_event_t *ev)
+{
+    if (event_is_queued(&ev->super)) {
+        _coalesced++;
+    }
+    ev->posted = xtimer_now_usec();
+    event_post(&_queue, &ev->super);
+    _posted++;
+}
+
+static void _periodic_cb(void *arg)
+{
+    unsigned *remaining = arg;
+
+    _post(&_events[0]);
+    if (--(*remaining)) {
+        xtimer_set(&_timer, INTERVAL);
+    }
+}
+
+static void _burst_cb(void *arg)
+{
+    (void)arg;
+
+    for (unsigned i = 0; i < BURST; i++) {
+        msg_t msg = { .type = i };
+
+        _post(&_events[i]);
+        if (msg_send_int(&msg, _msg_pid) != 1) {
+            _msg_lost++;
+        }
+    }
+    /* posting again before the event thread ran must not queue twice */
+    _post(&_events[0]);
+}
+
+static void _reset(unsigned expected)
+{
+    _lat_min = UINT32_MAX;
+    _lat_max = 0;
+    _lat_sum = 0;
+    _handled = 0;
+    _posted = 0;
+    _coalesced = 0;
+    _expected = expected;
+    for (unsigned i = 0; i < BURST; i++) {
+        _events[i].handled = 0;
+    }
+}
+
+static void _print_latency(void)
+{
+    printf("latency (us): min=%" PRIu32 " max=%" PRIu32 " avg=%" PRIu32 "\n",
+           _lat_min, _lat_max, (uint32_t)(_lat_sum / _handled));
+}
+
+int main(void)
+{
+    unsigned remaining = NUMOF;
+    int failed = 0;
+
+    puts("event queue latency test application.\n");
+
+    _main = (thread_t *)sched_active_thread;
+    for (unsigned i = 0; i < BURST; i++) {
+        _events[i].super.handler = _handler;
+    }
+
+    thread_create(_event_stack, sizeof(_event_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _event_thread, NULL, "event");
+    thread_flags_wait_any(FLAG_DONE);
+    _msg_pid = thread_create(_msg_stack, sizeof(_msg_stack),
+                             THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                             _msg_thread, NULL, "msg");
+
+    printf("periodic: posting %u events every %u us from ISR\n",
+           NUMOF, INTERVAL);
+    _reset(NUMOF);
+    _timer.callback = _periodic_cb;
+    _timer.arg = &remaining;
+    xtimer_set(&_timer, INTERVAL);
+    thread_flags_wait_any(FLAG_DONE);
+
+    printf("posted=%u handled=%u coalesced=%u lost=%u\n", _posted, _handled,
+           _coalesced, _posted - _handled - _coalesced);
+    _print_latency();
+    if (_handled + _coalesced != _posted) {
+        failed = 1;
+    }
+
+    printf("\nburst: posting %u events from a single ISR\n", BURST);
+    _reset(BURST);
+    _timer.callback = _burst_cb;
+    _timer.arg = NULL;
+    xtimer_set(&_timer, INTERVAL);
+    thread_flags_wait_any(FLAG_DONE);
+    /* let the message thread drain its queue */
+    xtimer_usleep(INTERVAL);
+
+    printf("event: posted=%u handled=%u coalesced=%u lost=%u\n", _posted,
+           _handled, _coalesced, _posted - _handled - _coalesced);
+    _print_latency();
+    printf("msg:   sent=%u received=%u lost=%u\n", BURST,
+           (unsigned)_msg_handled, _msg_lost);
+    for (unsigned i = 0; i < BURST; i++) {
+        if (_events[i].handled != 1) {
+            printf("event %u handled %u times\n", i, _events[i].handled);
+            failed = 1;
+        }
+    }
+    if ((_handled != BURST) || (_coalesced != 1)) {
+        failed = 1;
+    }
+
+    puts(failed ? "\nTest failed." : "\nTest complete.");
+    return failed;
+}
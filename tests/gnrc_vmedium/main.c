@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Traffic generator for the native virtual 802.15.4 medium
+ *
+ * Every node configures 2001:db8::<node id>/64 on its interface. The
+ * `flow` shell command sends UDP packets that carry a flow id and a
+ * sequence number, and reports them to the vmedium broker, which measures
+ * delivery ratio and latency per flow.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "msg.h"
+#include "netdev2_vmedium.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6.h"
+#include "net/gnrc/ipv6/netif.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/rpl.h"
+#ifdef MODULE_GNRC_TSCH
+#include "net/gnrc/tsch/tsch.h"
+#endif
+#include "net/gnrc/udp.h"
+#include "shell.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define FLOW_PORT           (8888U)
+#define FLOW_PAYLOAD_MAX    (96U)
+#define MAIN_QUEUE_SIZE     (8U)
+#define SERVER_QUEUE_SIZE   (16U)
+
+/* header at the start of every flow packet, in network byte order */
+typedef struct __attribute__((packed)) {
+    network_uint16_t flow;
+    network_uint32_t seq;
+} flow_hdr_t;
+
+typedef struct {
+    ipv6_addr_t dst;
+    uint16_t flow;
+    uint32_t count;
+    uint32_t interval;
+    size_t size;
+} flow_t;
+
+extern netdev2_vmedium_t netdev2_vmedium;
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static msg_t _server_msg_queue[SERVER_QUEUE_SIZE];
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static char _sender_stack[THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _sender_pid;
+static volatile bool _busy;
+static flow_t _flow;
+static ipv6_addr_t _addr;
+
+static void *_server(void *arg)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(FLOW_PORT,
+                                                           sched_active_pid);
+    msg_t msg;
+
+    (void)arg;
+    msg_init_queue(_server_msg_queue, SERVER_QUEUE_SIZE);
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &entry);
+
+    while (1) {
+        msg_receive(&msg);
+        if (msg.type != GNRC_NETAPI_MSG_TYPE_RCV) {
+            continue;
+        }
+        gnrc_pktsnip_t *pkt = msg.content.ptr;
+        if (pkt->size >= sizeof(flow_hdr_t)) {
+            flow_hdr_t *hdr = pkt->data;
+            netdev2_vmedium_flow_rx(&netdev2_vmedium,
+                                    byteorder_ntohs(hdr->flow),
+                                    byteorder_ntohl(hdr->seq));
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+
+    return NULL;
+}
+
+static int _send(const flow_t *flow, uint32_t seq)
+{
+    gnrc_pktsnip_t *payload, *udp, *ip;
+    flow_hdr_t *hdr;
+
+    payload = gnrc_pktbuf_add(NULL, NULL, flow->size, GNRC_NETTYPE_UNDEF);
+    if (payload == NULL) {
+        return -1;
+    }
+    memset(payload->data, 0, flow->size);
+    hdr = payload->data;
+    hdr->flow = byteorder_htons(flow->flow);
+    hdr->seq = byteorder_htonl(seq);
+    udp = gnrc_udp_hdr_build(payload, FLOW_PORT, FLOW_PORT);
+    if (udp == NULL) {
+        gnrc_pktbuf_release(payload);
+        return -1;
+    }
+    ip = gnrc_ipv6_hdr_build(udp, NULL, (ipv6_addr_t *)&flow->dst);
+    if (ip == NULL) {
+        gnrc_pktbuf_release(udp);
+        return -1;
+    }
+    /* report first, so the broker's clock starts before the stack runs */
+    netdev2_vmedium_flow_tx(&netdev2_vmedium, flow->flow, seq);
+    if (!gnrc_netapi_dispatch_send(GNRC_NETTYPE_UDP, GNRC_NETREG_DEMUX_CTX_ALL,
+                                   ip)) {
+        gnrc_pktbuf_release(ip);
+        return -1;
+    }
+    return 0;
+}
+
+static void *_sender(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        uint32_t failed = 0;
+        xtimer_ticks32_t last = xtimer_now();
+
+        for (uint32_t seq = 0; seq < _flow.count; seq++) {
+            if (_send(&_flow, seq) < 0) {
+                failed++;
+            }
+            xtimer_periodic_wakeup(&last, _flow.interval);
+        }
+        printf("flow %u: sent %" PRIu32 " packets (%" PRIu32 " failed)\n",
+               (unsigned)_flow.flow, _flow.count - failed, failed);
+        _busy = false;
+        thread_sleep();
+    }
+
+    return NULL;
+}
+
+static int _flow_cmd(int argc, char **argv)
+{
+    if ((argc == 2) && (strcmp(argv[1], "root") == 0)) {
+        if (gnrc_rpl_root_init(1, &_addr, false, false) == NULL) {
+            puts("error: unable to initialize RPL root");
+            return 1;
+        }
+        puts("RPL root initialized");
+        return 0;
+    }
+    if ((argc < 6) || (strcmp(argv[1], "send") != 0)) {
+        printf("usage: %s root\n"
+               "       %s send <addr> <flow> <count> <interval in ms> "
+               "[<size>]\n", argv[0], argv[0]);
+        return 1;
+    }
+    if (_busy) {
+        puts("error: a flow is still being sent");
+        return 1;
+    }
+    if (ipv6_addr_from_str(&_flow.dst, argv[2]) == NULL) {
+        puts("error: unable to parse destination address");
+        return 1;
+    }
+    _flow.flow = (uint16_t)atoi(argv[3]);
+    _flow.count = (uint32_t)atoi(argv[4]);
+    _flow.interval = (uint32_t)atoi(argv[5]) * MS_IN_USEC;
+    _flow.size = (argc > 6) ? (size_t)atoi(argv[6]) : sizeof(flow_hdr_t);
+    if ((_flow.size < sizeof(flow_hdr_t)) || (_flow.size > FLOW_PAYLOAD_MAX)) {
+        printf("error: size must be between %u and %u\n",
+               (unsigned)sizeof(flow_hdr_t), FLOW_PAYLOAD_MAX);
+        return 1;
+    }
+    _busy = true;
+    thread_wakeup(_sender_pid);
+    return 0;
+}
+
+#ifdef MODULE_GNRC_TSCH
+static int _tsch_usage(const char *cmd)
+{
+    printf("usage: %s [coord]\n"
+           "       %s <add|del> <slot> <channel offset> [<options> "
+           "[<l2 addr>]]\n"
+           "options: t (TX), r (RX), s (shared), k (timekeeping)\n",
+           cmd, cmd);
+    return 1;
+}
+
+static int _tsch_cmd(int argc, char **argv)
+{
+    static const char *roles[] = { "scanning", "joined", "coordinator" };
+    kernel_pid_t ifs[GNRC_NETIF_NUMOF];
+    gnrc_tsch_cell_t cell;
+    int res;
+
+    if (gnrc_netif_get(ifs) == 0) {
+        puts("error: no interface");
+        return 1;
+    }
+    if (argc == 1) {
+        gnrc_tsch_status_t status;
+        char addr[3 * IEEE802154_LONG_ADDRESS_LEN];
+
+        gnrc_tsch_status(ifs[0], &status);
+        printf("%s, ASN %" PRIu32 ", join priority %u, %u cells, "
+               "%u queued\n", roles[status.role], (uint32_t)status.asn,
+               status.join_priority, status.cells, status.queued);
+        if (status.time_source_len > 0) {
+            printf("time source %s\n",
+                   gnrc_netif_addr_to_str(addr, sizeof(addr),
+                                          status.time_source,
+                                          status.time_source_len));
+        }
+        return 0;
+    }
+    if (strcmp(argv[1], "coord") == 0) {
+        gnrc_tsch_coordinator(ifs[0]);
+        puts("TSCH network started");
+        return 0;
+    }
+    if ((argc < 4) || ((strcmp(argv[1], "add") != 0) &&
+                       (strcmp(argv[1], "del") != 0))) {
+        return _tsch_usage(argv[0]);
+    }
+    memset(&cell, 0, sizeof(cell));
+    cell.slot_offset = (uint16_t)atoi(argv[2]);
+    cell.channel_offset = (uint8_t)atoi(argv[3]);
+    if (argv[1][0] == 'd') {
+        res = gnrc_tsch_cell_remove(ifs[0], &cell);
+    }
+    else {
+        for (const char *opt = (argc > 4) ? argv[4] : "tr"; *opt; opt++) {
+            switch (*opt) {
+                case 't':
+                    cell.options |= GNRC_TSCH_CELL_TX;
+                    break;
+                case 'r':
+                    cell.options |= GNRC_TSCH_CELL_RX;
+                    break;
+                case 's':
+                    cell.options |= GNRC_TSCH_CELL_SHARED;
+                    break;
+                case 'k':
+                    cell.options |= GNRC_TSCH_CELL_TIMEKEEPING;
+                    break;
+                default:
+                    return _tsch_usage(argv[0]);
+            }
+        }
+        if (argc > 5) {
+            cell.addr_len = gnrc_netif_addr_from_str(cell.addr,
+                                                     sizeof(cell.addr),
+                                                     argv[5]);
+            if (cell.addr_len == 0) {
+                puts("error: unable to parse link-layer address");
+                return 1;
+            }
+        }
+        res = gnrc_tsch_cell_add(ifs[0], &cell);
+    }
+    if (res < 0) {
+        printf("error: %d\n", res);
+        return 1;
+    }
+    return 0;
+}
+#endif
+
+static const shell_command_t _commands[] = {
+    { "flow", "generate measured UDP traffic", _flow_cmd },
+#ifdef MODULE_GNRC_TSCH
+    { "tsch", "show TSCH status, start a network, or edit the schedule",
+      _tsch_cmd },
+#endif
+    { NULL, NULL, NULL }
+};
+
+static void _add_addr(void)
+{
+    kernel_pid_t ifs[GNRC_NETIF_NUMOF];
+
+    if (gnrc_netif_get(ifs) == 0) {
+        puts("error: no interface");
+        return;
+    }
+    ipv6_addr_from_str(&_addr, "2001:db8::");
+    _addr.u16[7] = byteorder_htons(netdev2_vmedium.params.node_id);
+    gnrc_ipv6_netif_add_addr(ifs[0], &_addr, 64,
+                             GNRC_IPV6_NETIF_ADDR_FLAGS_UNICAST);
+}
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    _add_addr();
+    thread_create(_server_stack, sizeof(_server_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _server, NULL, "flow server");
+    _sender_pid = thread_create(_sender_stack, sizeof(_sender_stack),
+                                THREAD_PRIORITY_MAIN - 1,
+                                THREAD_CREATE_SLEEPING | THREAD_CREATE_STACKTEST,
+                                _sender, NULL, "flow sender");
+
+    printf("vmedium node %u\n", (unsigned)netdev2_vmedium.params.node_id);
+    shell_run(_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
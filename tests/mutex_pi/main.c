@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the priority inheritance mutex
+ *
+ * Runs the classic priority inversion scenario with a plain mutex and with a
+ * priority inheritance mutex and compares the time the high priority thread
+ * has to wait for the lock.
+ *
+ * @author      agent <agent@local>
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "mutex.h"
+#include "mutex_pi.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define ROUNDS          (10U)
+
+/* time the low priority thread holds the lock */
+#define CRITICAL_US     (2000U)
+/* time the medium priority thread keeps the CPU busy */
+#define BUSY_US         (20000U)
+
+#define PRIO_HIGH       (THREAD_PRIORITY_MAIN - 3)
+#define PRIO_MEDIUM     (THREAD_PRIORITY_MAIN - 2)
+#define PRIO_LOW        (THREAD_PRIORITY_MAIN - 1)
+
+typedef struct {
+    const char *name;
+    void (*lock)(void *lock);
+    void (*unlock)(void *lock);
+    void *arg;
+} lock_ops_t;
+
+static char stack_high[THREAD_STACKSIZE_MAIN];
+static char stack_medium[THREAD_STACKSIZE_MAIN];
+static char stack_low[THREAD_STACKSIZE_MAIN];
+
+static kernel_pid_t pid_high, pid_medium, pid_low;
+
+static mutex_t plain = MUTEX_INIT;
+static mutex_pi_t pi = MUTEX_PI_INIT;
+
+static const lock_ops_t *ops;
+static uint32_t wait_max;
+static uint32_t wait_sum;
+
+static void _plain_lock(void *lock)
+{
+    mutex_lock(lock);
+}
+
+static void _plain_unlock(void *lock)
+{
+    mutex_unlock(lock);
+}
+
+static void _pi_lock(void *lock)
+{
+    mutex_pi_lock(lock);
+}
+
+static void _pi_unlock(void *lock)
+{
+    mutex_pi_unlock(lock);
+}
+
+static const lock_ops_t ops_plain = {
+    "mutex_t", _plain_lock, _plain_unlock, &plain
+};
+
+static const lock_ops_t ops_pi = {
+    "mutex_pi_t", _pi_lock, _pi_unlock, &pi
+};
+
+static void _busy(uint32_t usec)
+{
+    uint32_t start = xtimer_now_usec();
+    while ((xtimer_now_usec() - start) < usec) {}
+}
+
+static void *_high(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+        uint32_t start = xtimer_now_usec();
+        ops->lock(ops->arg);
+        uint32_t wait = xtimer_now_usec() - start;
+        ops->unlock(ops->arg);
+
+        wait_sum += wait;
+        if (wait > wait_max) {
+            wait_max = wait;
+        }
+    }
+
+    return NULL;
+}
+
+static void *_medium(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+        _busy(BUSY_US);
+    }
+
+    return NULL;
+}
+
+static void *_low(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+        ops->lock(ops->arg);
+        /* the high priority thread preempts us and blocks on the lock */
+        thread_wakeup(pid_high);
+        /* the medium priority thread preempts us, unless we inherited the
+         * priority of the high priority thread */
+        thread_wakeup(pid_medium);
+        _busy(CRITICAL_US);
+        ops->unlock(ops->arg);
+    }
+
+    return NULL;
+}
+
+static uint32_t _run(const lock_ops_t *lock_ops)
+{
+    ops = lock_ops;
+    wait_max = 0;
+    wait_sum = 0;
+
+    for (unsigned i = 0; i < ROUNDS; i++) {
+        /* all test threads have a higher priority than main, so the round is
+         * complete when main runs again */
+        thread_wakeup(pid_low);
+    }
+
+    printf("%-10s: wait max %6" PRIu32 " us, avg %6" PRIu32 " us\n",
+           ops->name, wait_max, wait_sum / ROUNDS);
+
+    return wait_max;
+}
+
+int main(void)
+{
+    puts("Priority inheritance mutex test");
+    printf("critical section: %u us, medium priority load: %u us\n",
+           CRITICAL_US, BUSY_US);
+
+    pid_high = thread_create(stack_high, sizeof(stack_high), PRIO_HIGH,
+                             THREAD_CREATE_SLEEPING, _high, NULL, "high");
+    pid_medium = thread_create(stack_medium, sizeof(stack_medium), PRIO_MEDIUM,
+                               THREAD_CREATE_SLEEPING, _medium, NULL, "medium");
+    pid_low = thread_create(stack_low, sizeof(stack_low), PRIO_LOW,
+                            THREAD_CREATE_SLEEPING, _low, NULL, "low");
+
+    _run(&ops_plain);
+    uint32_t max = _run(&ops_pi);
+
+    /* with priority inheritance the wait is bounded by the critical section */
+    if (max < (CRITICAL_US + (BUSY_US / 2))) {
+        puts("SUCCESS");
+    }
+    else {
+        puts("FAILURE: priority inversion not bounded");
+    }
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measures the event latency of native's asynchronous I/O with
+ *              many watched file descriptors
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+
+#include "async_read.h"
+#include "mutex.h"
+#include "native_internal.h"
+#include "xtimer.h"
+
+#ifndef PIPES_NUMOF
+#define PIPES_NUMOF     (48)
+#endif
+
+#define ROUNDS          (10000U)
+
+static int _pipes[PIPES_NUMOF][2];
+static mutex_t _done = MUTEX_INIT_LOCKED;
+static unsigned _wrong;
+static int _expected;
+
+static void _read_cb(int fd, void *arg)
+{
+    char c;
+
+    while (real_read(fd, &c, 1) == 1) {
+        if ((int)(intptr_t)arg != _expected) {
+            _wrong++;
+        }
+        mutex_unlock(&_done);
+    }
+    native_async_read_continue(fd);
+}
+
+int main(void)
+{
+    puts("native async I/O benchmark");
+
+    for (int i = 0; i < PIPES_NUMOF; i++) {
+        if (real_pipe(_pipes[i]) == -1) {
+            puts("pipe() failed");
+            return 1;
+        }
+        native_async_read_add_handler(_pipes[i][0], (void *)(intptr_t)i,
+                                      _read_cb);
+    }
+
+    printf("watching %d file descriptors\n", PIPES_NUMOF);
+
+    uint32_t total = 0, max = 0;
+    uint32_t start = xtimer_now_usec();
+
+    for (unsigned round = 0; round < ROUNDS; round++) {
+        _expected = round % PIPES_NUMOF;
+        uint32_t before = xtimer_now_usec();
+        real_write(_pipes[_expected][1], "x", 1);
+        mutex_lock(&_done);
+        uint32_t diff = xtimer_now_usec() - before;
+        total += diff;
+        if (diff > max) {
+            max = diff;
+        }
+    }
+
+    uint32_t duration = xtimer_now_usec() - start;
+
+    printf("%u events in %" PRIu32 " us: %" PRIu32 " events/s\n", ROUNDS,
+           duration, (uint32_t)(((uint64_t)ROUNDS * SEC_IN_USEC) / duration));
+    printf("latency: avg %" PRIu32 " us, max %" PRIu32 " us\n",
+           total / ROUNDS, max);
+
+    if (_wrong) {
+        printf("FAILURE: %u events dispatched to the wrong handler\n", _wrong);
+    }
+    else {
+        puts("SUCCESS");
+    }
+
+    return 0;
+}
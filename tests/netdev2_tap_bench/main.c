@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Receive throughput benchmark for netdev2_tap
+ *
+ * Counts all frames of unknown ethertype received on the tap interface and
+ * reports the throughput once per second.
+ *
+ * @author      agent <agent@local>
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "netdev2_tap.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define REPORT_INTERVAL     (1U * SEC_IN_USEC)
+#define MSG_TYPE_REPORT     (0x4242)
+#define MSG_QUEUE_SIZE      (64U)
+
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+
+int main(void)
+{
+    gnrc_netreg_entry_t entry = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
+                                                           thread_getpid());
+    msg_t report = { .type = MSG_TYPE_REPORT };
+    xtimer_t timer;
+    uint32_t frames = 0, bytes = 0, total = 0;
+    uint32_t last = xtimer_now_usec();
+
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entry);
+
+    puts("netdev2_tap receive benchmark");
+    printf("frames per event: %u\n", (unsigned)NETDEV2_TAP_RX_BATCH);
+    puts("send frames with an unknown ethertype, e.g. using tx.py");
+
+    xtimer_set_msg(&timer, REPORT_INTERVAL, &report, thread_getpid());
+
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        switch (msg.type) {
+            case GNRC_NETAPI_MSG_TYPE_RCV: {
+                gnrc_pktsnip_t *pkt = msg.content.ptr;
+                frames++;
+                bytes += gnrc_pkt_len(pkt);
+                gnrc_pktbuf_release(pkt);
+                break;
+            }
+            case MSG_TYPE_REPORT: {
+                uint32_t now = xtimer_now_usec();
+                uint32_t elapsed = (now - last) / MS_IN_USEC;
+                last = now;
+                if (frames > 0) {
+                    total += frames;
+                    printf("%" PRIu32 " frames/s, %" PRIu32 " kbit/s, "
+                           "%" PRIu32 " frames total\n",
+                           (frames * 1000) / elapsed, (bytes * 8) / elapsed,
+                           total);
+                }
+                frames = 0;
+                bytes = 0;
+                xtimer_set_msg(&timer, REPORT_INTERVAL, &report, thread_getpid());
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return 0;
+}
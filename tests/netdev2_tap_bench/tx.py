@@ -0,0 +1,43 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2016 agent <agent@local>
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Floods a tap interface with ethernet frames of an unknown ethertype.
+
+usage: sudo ./tx.py <interface> [count] [payload length]
+"""
+
+import socket
+import sys
+import time
+
+ETHERTYPE = 0x88b5  # local experimental ethertype
+
+
+def main():
+    iface = sys.argv[1]
+    count = int(sys.argv[2]) if len(sys.argv) > 2 else 100000
+    length = int(sys.argv[3]) if len(sys.argv) > 3 else 64
+
+    sock = socket.socket(socket.AF_PACKET, socket.SOCK_RAW)
+    sock.bind((iface, 0))
+    frame = (b"\xff" * 6 + sock.getsockname()[4] +
+             ETHERTYPE.to_bytes(2, "big") + bytes(length))
+
+    start = time.time()
+    for _ in range(count):
+        try:
+            sock.send(frame)
+        except BlockingIOError:
+            pass
+    elapsed = time.time() - start
+    print("sent %d frames in %.2f s (%.0f frames/s)"
+          % (count, elapsed, count / elapsed))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test for blocking and asynchronous transfers on the emulated
+ *              SPI bus of native
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "mutex.h"
+#include "periph/spi.h"
+#include "spi_emu.h"
+
+#define DEV             (SPI_0)
+#define REG_READ        (0x80)
+#define FRAME_LEN       (127U)
+
+/* slave model: a 128 byte register file, the first byte of a transaction
+ * selects the start register (MSB set for reading), the following bytes
+ * access consecutive registers */
+typedef struct {
+    uint8_t regs[128];
+    uint8_t addr;
+    uint8_t read;
+    uint8_t first;
+} regfile_t;
+
+static regfile_t _regfile;
+static mutex_t _done = MUTEX_INIT_LOCKED;
+static int _async_res;
+static int _async_in_isr;
+
+static void _begin(void *arg)
+{
+    regfile_t *rf = arg;
+    rf->first = 1;
+}
+
+static uint8_t _transfer(void *arg, uint8_t out)
+{
+    regfile_t *rf = arg;
+    uint8_t res = 0;
+
+    if (rf->first) {
+        rf->first = 0;
+        rf->read = out & REG_READ;
+        rf->addr = out & ~REG_READ;
+        return 0;
+    }
+    if (rf->read) {
+        res = rf->regs[rf->addr];
+    }
+    else {
+        rf->regs[rf->addr] = out;
+    }
+    rf->addr = (rf->addr + 1) & 0x7f;
+    return res;
+}
+
+static const spi_emu_slave_t _slave = {
+    .begin = _begin,
+    .transfer = _transfer,
+    .end = NULL,
+};
+
+static void _async_cb(void *arg, int res)
+{
+    (void)arg;
+    _async_res = res;
+    _async_in_isr = irq_is_in();
+    mutex_unlock(&_done);
+}
+
+static int _check(int cond, const char *msg)
+{
+    if (!cond) {
+        printf("FAILURE: %s\n", msg);
+    }
+    return !cond;
+}
+
+int main(void)
+{
+    char frame[FRAME_LEN];
+    char in[FRAME_LEN];
+    spi_emu_stats_t stats;
+    int failed = 0;
+
+    puts("SPI emulator test");
+
+    for (unsigned i = 0; i < FRAME_LEN; i++) {
+        frame[i] = (char)(i * 7);
+    }
+
+    spi_emu_attach(DEV, &_slave, &_regfile);
+    if (spi_init_master(DEV, SPI_CONF_FIRST_RISING, SPI_SPEED_1MHZ) < 0) {
+        puts("FAILURE: unable to initialize SPI");
+        return 1;
+    }
+
+    /* blocking write of a whole frame */
+    spi_acquire(DEV);
+    spi_transfer_regs(DEV, 0x00, frame, NULL, FRAME_LEN);
+    spi_release(DEV);
+    failed += _check(memcmp(_regfile.regs, frame, FRAME_LEN) == 0,
+                     "blocking write");
+
+    /* asynchronous read of the frame */
+    spi_emu_reset_stats(DEV);
+    memset(in, 0, sizeof(in));
+    spi_acquire(DEV);
+    spi_transfer_byte(DEV, (char)REG_READ, NULL);
+    if (spi_transfer_async(DEV, NULL, in, FRAME_LEN, _async_cb, NULL) < 0) {
+        puts("FAILURE: unable to start asynchronous transfer");
+        return 1;
+    }
+    mutex_lock(&_done);
+    spi_release(DEV);
+
+    failed += _check(_async_res == (int)FRAME_LEN, "asynchronous length");
+    failed += _check(memcmp(in, frame, FRAME_LEN) == 0, "asynchronous read");
+    failed += _check(_async_in_isr, "callback not in interrupt context");
+
+    spi_emu_get_stats(DEV, &stats);
+    printf("transactions: %u, transfers: %u, async: %u, bytes: %u\n",
+           (unsigned)stats.transactions, (unsigned)stats.transfers,
+           (unsigned)stats.async_transfers, (unsigned)stats.bytes);
+    failed += _check((stats.transactions == 1) && (stats.transfers == 1) &&
+                     (stats.async_transfers == 1) &&
+                     (stats.bytes == FRAME_LEN + 1), "bus usage counters");
+
+    /* without a slave, the bus reads a floating line */
+    spi_emu_attach(DEV, NULL, NULL);
+    spi_acquire(DEV);
+    spi_transfer_bytes(DEV, NULL, in, 4);
+    spi_release(DEV);
+    failed += _check((uint8_t)in[0] == 0xff, "floating MISO");
+
+    if (!failed) {
+        puts("SUCCESS");
+    }
+    return 0;
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief Phydat DSP benchmark
+ *
+ * Filters blocks of random 3-axis samples, as e.g. an accelerometer batch,
+ * with every kernel and prints the time per sample.
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "phydat_dsp.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define BLOCK_LEN       (32U)
+#define BLOCKS          (256U)
+#define DIM             (3U)
+#define FIR_TAPS        (16U)
+#define IIR_STAGES      (2U)
+#define MAVG_LEN        (8U)
+
+#define SEED            (0x83d385c0)
+
+typedef void (*kernel_t)(phydat_t *data, size_t n);
+
+static phydat_t data[BLOCK_LEN];
+
+static phydat_dsp_mavg_t mavg;
+static int16_t mavg_hist[MAVG_LEN * DIM];
+
+/* 16 tap Hamming windowed low-pass, cut-off at a quarter of the sample
+ * rate, symmetric so the time reversed order does not matter */
+static const int16_t fir_coeffs[FIR_TAPS] = {
+    -79, -136, 312, 654, -1244, -2280, 4501, 14655,
+    14655, 4501, -2280, -1244, 654, 312, -136, -79,
+};
+static phydat_dsp_fir_t fir;
+static int16_t fir_state[PHYDAT_DSP_FIR_STATE_LEN(FIR_TAPS) * DIM];
+
+/* 4th order Butterworth low-pass at a tenth of the sample rate, coefficients
+ * scaled by 2^-1 */
+static const int16_t iir_coeffs[6 * IIR_STAGES] = {
+    1014, 0, 2028, 1014, 17180, -4852,
+    1277, 0, 2554, 1277, 21642, -10367,
+};
+static phydat_dsp_iir_t iir;
+static int16_t iir_state[PHYDAT_DSP_IIR_STATE_LEN(IIR_STAGES) * DIM];
+
+static phydat_dsp_decim_t decim;
+
+static void _fill(void)
+{
+    for (unsigned i = 0; i < BLOCK_LEN; i++) {
+        for (unsigned d = 0; d < DIM; d++) {
+            data[i].val[d] = (int16_t)(random_uint32() & 0x0fff) - 0x0800;
+        }
+        data[i].unit = UNIT_TEMP_C;
+        data[i].scale = -2;
+    }
+}
+
+static void _none(phydat_t *data, size_t n)
+{
+    (void)data;
+    (void)n;
+}
+
+static void _mavg(phydat_t *data, size_t n)
+{
+    phydat_dsp_mavg(&mavg, data, n);
+}
+
+static void _fir(phydat_t *data, size_t n)
+{
+    phydat_dsp_fir(&fir, data, n);
+}
+
+static void _iir(phydat_t *data, size_t n)
+{
+    phydat_dsp_iir(&iir, data, n);
+}
+
+static void _decimate(phydat_t *data, size_t n)
+{
+    phydat_dsp_decimate(&decim, data, n);
+}
+
+static void _rescale(phydat_t *data, size_t n)
+{
+    phydat_dsp_rescale(data, n, DIM, -1);
+}
+
+static void _convert(phydat_t *data, size_t n)
+{
+    phydat_dsp_convert(data, n, DIM, UNIT_TEMP_F);
+}
+
+static uint32_t fill_time;
+
+static void run(const char *name, kernel_t kernel)
+{
+    uint32_t time = 0;
+
+    random_init(SEED);
+    for (unsigned b = 0; b < BLOCKS; b++) {
+        uint32_t start = xtimer_now_usec();
+        _fill();
+        kernel(data, BLOCK_LEN);
+        time += xtimer_now_usec() - start;
+    }
+    if (name == NULL) {
+        /* time spent generating the samples, subtracted from the others */
+        fill_time = time;
+        return;
+    }
+    time -= fill_time;
+    printf("%-10s %7" PRIu32 " us, %5" PRIu32 " ns/sample\n", name, time,
+           (uint32_t)((time * 1000ULL) / (BLOCKS * BLOCK_LEN)));
+}
+
+int main(void)
+{
+    printf("Phydat DSP benchmark\n\n");
+#ifdef MODULE_PHYDAT_DSP_CMSIS
+    puts("FIR and IIR on CMSIS-DSP");
+#else
+    puts("FIR and IIR portable");
+#endif
+    printf("%u blocks of %u samples with %u dimensions\n\n", BLOCKS,
+           BLOCK_LEN, DIM);
+
+    run(NULL, _none);
+
+    phydat_dsp_mavg_init(&mavg, mavg_hist, MAVG_LEN, DIM);
+    run("mavg", _mavg);
+    phydat_dsp_fir_init(&fir, fir_coeffs, FIR_TAPS, fir_state, DIM);
+    run("fir", _fir);
+    phydat_dsp_iir_init(&iir, iir_coeffs, IIR_STAGES, 1, iir_state, DIM);
+    run("iir", _iir);
+    phydat_dsp_decim_init(&decim, 4, DIM);
+    run("decimate", _decimate);
+    run("rescale", _rescale);
+    run("convert", _convert);
+
+    printf("\nAll done!\n");
+    return 0;
+}
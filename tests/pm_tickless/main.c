@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ * @brief   Test application for tickless idle (pm_tickless)
+ *
+ * Runs pm_layered with pm_tickless on native. The application implements
+ * pm_set() as a simulated CPU with the power modes of
+ * @ref PM_WAKEUP_LATENCY_US: it waits with interrupts disabled until one is
+ * pending and then for the wake-up latency of the mode, before the ISR runs.
+ * For sleeps of different length and with the deepest mode blocked, the
+ * test checks the mode the idle thread selected and that the timer still
+ * fired on time. It also counts the wake-ups of the simulated CPU, and
+ * reports them per hour of the phase's run time.
+ *
+ * @author  agent <agent@local>
+ *
+ * @}
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "pm_layered.h"
+#include "xtimer.h"
+
+#if PM_NUM_MODES != 2
+#error this test needs two simulated power modes
+#endif
+
+#define ROUNDS          (5U)
+#define IDLE            (PM_NUM_MODES)
+#define NO_BLOCK        (-1)
+
+/**
+ * @brief   Maximum time a timer may fire late
+ *
+ * Well below the latency of each mode, so a missing early wake-up fails.
+ */
+#define LATENESS_MAX_US (1000U)
+
+typedef struct {
+    uint32_t sleep;     /**< sleep time in us */
+    int block;          /**< mode to block while sleeping */
+    unsigned mode;      /**< mode the idle thread has to select */
+} phase_t;
+
+static const phase_t _phases[] = {
+    /* the deepest mode fits */
+    { .sleep = 100U * MS_IN_USEC, .block = NO_BLOCK, .mode = 0 },
+    /* only the light mode fits */
+    { .sleep = 10U * MS_IN_USEC, .block = NO_BLOCK, .mode = 1 },
+    /* no mode fits */
+    { .sleep = 3U * MS_IN_USEC, .block = NO_BLOCK, .mode = IDLE },
+    /* the deepest mode fits, but is blocked */
+    { .sleep = 100U * MS_IN_USEC, .block = 0, .mode = 1 },
+};
+
+static const uint32_t _latency[PM_NUM_MODES] = PM_WAKEUP_LATENCY_US;
+
+/* first mode set since _sleep() started, -1 if none */
+static volatile int _mode;
+/* returns from pm_set() */
+static volatile unsigned _wakeups;
+
+void pm_set(unsigned mode)
+{
+    sigset_t pending;
+
+    if (_mode < 0) {
+        _mode = mode;
+    }
+    /* sleep until an interrupt is pending */
+    do {
+        sigpending(&pending);
+    } while (!sigismember(&pending, SIGALRM) && !sigismember(&pending, SIGIO));
+    /* the ISR runs only after the wake-up latency */
+    if (mode < PM_NUM_MODES) {
+        xtimer_spin(xtimer_ticks_from_usec(_latency[mode]));
+    }
+    _wakeups++;
+}
+
+static uint32_t _sleep(uint32_t usec)
+{
+    uint32_t start;
+
+    _mode = -1;
+    start = xtimer_now_usec();
+    xtimer_usleep(usec);
+    return xtimer_now_usec() - start - usec;
+}
+
+int main(void)
+{
+    unsigned errors = 0;
+
+    puts("pm_tickless test application\n");
+    for (unsigned i = 0; i < PM_NUM_MODES; i++) {
+        printf("mode %u: wake-up latency %" PRIu32 " us\n", i, _latency[i]);
+        pm_unblock(i);
+    }
+
+    for (unsigned i = 0; i < (sizeof(_phases) / sizeof(_phases[0])); i++) {
+        const phase_t *phase = &_phases[i];
+        uint32_t lateness_max = 0, start, runtime;
+        unsigned wrong_mode = 0, wakeups;
+
+        if (phase->block != NO_BLOCK) {
+            pm_block(phase->block);
+        }
+        _wakeups = 0;
+        start = xtimer_now_usec();
+        for (unsigned r = 0; r < ROUNDS; r++) {
+            uint32_t lateness = _sleep(phase->sleep);
+
+            if (lateness > lateness_max) {
+                lateness_max = lateness;
+            }
+            if (_mode != (int)phase->mode) {
+                printf("  sleep %" PRIu32 " us: mode %d\n", phase->sleep, _mode);
+                wrong_mode++;
+            }
+        }
+        wakeups = _wakeups;
+        runtime = xtimer_now_usec() - start;
+        if (phase->block != NO_BLOCK) {
+            pm_unblock(phase->block);
+        }
+
+        printf("sleep %6" PRIu32 " us: expected mode %u, %u wrong, "
+               "max. %" PRIu32 " us late\n", phase->sleep, phase->mode,
+               wrong_mode, lateness_max);
+        printf("  %u wake-ups in %" PRIu32 " us (%" PRIu32 " per hour)\n",
+               wakeups, runtime,
+               (uint32_t)(((uint64_t)wakeups * 3600U * SEC_IN_USEC) / runtime));
+        if (wrong_mode || (lateness_max > LATENESS_MAX_US)) {
+            errors++;
+        }
+    }
+
+    puts((errors == 0) ? "SUCCESS" : "FAILURE");
+    return 0;
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Test application for the SAUL sampler
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "saul_sampler.h"
+#include "xtimer.h"
+
+#define RUNTIME             (2U * SEC_IN_USEC)
+#define SLOW_PERIOD         (100U * MS_IN_USEC)
+#define FAST_PERIOD         (50U * MS_IN_USEC)
+#define BATCH               (5U)
+#define BUF_SIZE            (2 * BATCH)
+
+/**
+ * @brief   Simulated sensor, returns the number of reads so far
+ */
+typedef struct {
+    int16_t value;
+    uint8_t unit;
+} sim_t;
+
+typedef struct {
+    saul_sampler_entry_t entry;
+    saul_sampler_sample_t buf[BUF_SIZE];
+    uint32_t times[RUNTIME / FAST_PERIOD + 1];
+    int16_t expected;
+    unsigned count;
+    unsigned errors;
+} sched_t;
+
+static uint32_t _last_read;
+static unsigned _wakeups;
+
+static int _sim_read(void *dev, phydat_t *res)
+{
+    sim_t *sim = dev;
+    uint32_t now = xtimer_now_usec();
+
+    if ((_wakeups == 0) || ((now - _last_read) > SAUL_SAMPLER_COALESCE_US)) {
+        _wakeups++;
+    }
+    _last_read = now;
+    res->val[0] = ++sim->value;
+    res->unit = sim->unit;
+    res->scale = 0;
+    return 1;
+}
+
+static const saul_driver_t _temp_driver = {
+    .read = _sim_read, .write = saul_notsup, .type = SAUL_SENSE_TEMP,
+};
+static const saul_driver_t _hum_driver = {
+    .read = _sim_read, .write = saul_notsup, .type = SAUL_SENSE_HUM,
+};
+static const saul_driver_t _accel_driver = {
+    .read = _sim_read, .write = saul_notsup, .type = SAUL_SENSE_ACCEL,
+};
+
+static sim_t _sims[] = {
+    { .unit = UNIT_TEMP_C },
+    { .unit = UNIT_PERCENT },
+    { .unit = UNIT_G },
+};
+
+static saul_reg_t _regs[] = {
+    { .dev = &_sims[0], .name = "temp", .driver = &_temp_driver },
+    { .dev = &_sims[1], .name = "hum", .driver = &_hum_driver },
+    { .dev = &_sims[2], .name = "accel", .driver = &_accel_driver },
+};
+
+static sched_t _scheds[3];
+
+static void _take(sched_t *sched)
+{
+    saul_sampler_sample_t samples[BATCH];
+    unsigned n;
+
+    while ((n = saul_sampler_read(&sched->entry, samples, BATCH)) > 0) {
+        for (unsigned i = 0; i < n; i++) {
+            if (samples[i].data.val[0] != ++sched->expected) {
+                sched->errors++;
+            }
+            if (sched->count < (sizeof(sched->times) / sizeof(sched->times[0]))) {
+                sched->times[sched->count++] = samples[i].time;
+            }
+        }
+    }
+}
+
+static void _batch_ready(saul_sampler_entry_t *entry, void *arg)
+{
+    sched_t *sched = arg;
+    unsigned old = sched->count;
+
+    _take(sched);
+    printf("%s: %u samples, last %d at %" PRIu32 "\n", entry->dev->name,
+           sched->count - old, sched->expected, sched->times[sched->count - 1]);
+}
+
+int main(void)
+{
+    unsigned errors = 0;
+
+    puts("SAUL sampler test application");
+
+    for (unsigned i = 0; i < 3; i++) {
+        saul_reg_add(&_regs[i]);
+        _scheds[i].entry.dev = &_regs[i];
+        _scheds[i].entry.period = (i < 2) ? SLOW_PERIOD : FAST_PERIOD;
+        _scheds[i].entry.bus = (i < 2) ? 0 : 1;
+        _scheds[i].entry.buf = _scheds[i].buf;
+        _scheds[i].entry.size = BUF_SIZE;
+        _scheds[i].entry.batch = BATCH;
+        _scheds[i].entry.cb = _batch_ready;
+        _scheds[i].entry.arg = &_scheds[i];
+    }
+    saul_sampler_init();
+    /* add the accelerometer first to see that the sensors on bus 0 are read
+     * together anyway */
+    saul_sampler_add(&_scheds[2].entry);
+    saul_sampler_add(&_scheds[0].entry);
+    saul_sampler_add(&_scheds[1].entry);
+
+    xtimer_usleep(RUNTIME + (FAST_PERIOD / 2));
+    for (unsigned i = 0; i < 3; i++) {
+        saul_sampler_remove(&_scheds[i].entry);
+        _take(&_scheds[i]);
+        printf("%s: %u samples, %u lost, %u out of order\n", _regs[i].name,
+               _scheds[i].count, (unsigned)_scheds[i].entry.lost,
+               _scheds[i].errors);
+        errors += _scheds[i].errors + _scheds[i].entry.lost;
+    }
+    if (_scheds[0].count != _scheds[1].count) {
+        errors++;
+    }
+    for (unsigned i = 0; i < _scheds[0].count; i++) {
+        if ((_scheds[1].times[i] - _scheds[0].times[i]) > SAUL_SAMPLER_COALESCE_US) {
+            puts("temp and hum were read in different wake-ups");
+            errors++;
+            break;
+        }
+    }
+    printf("%u reads in %u wake-ups\n",
+           _scheds[0].count + _scheds[1].count + _scheds[2].count, _wakeups);
+    if ((_scheds[2].count != (RUNTIME / FAST_PERIOD)) ||
+        (_wakeups > _scheds[2].count)) {
+        errors++;
+    }
+    puts((errors == 0) ? "SUCCESS" : "FAILURE");
+    return 0;
+}
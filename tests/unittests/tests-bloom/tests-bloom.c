@@ -6,6 +6,7 @@
  * General Public License v2.1. See the file LICENSE in the top level
  * directory for more details.
  */
+#include <errno.h>
 #include <string.h>
 #include <stdio.h>
 
@@ -34,6 +35,18 @@ hashfp_t hashes[TESTS_BLOOM_HASHF] = {
                      (hashfp_t) dek_hash,
                     };
 
+#define TESTS_BLOOM_DH_HASHF (4)
+#define TESTS_BLOOM_DH_PROB_IN_FILTER_MAX (10)
+/* room for filters of 64, 128 and 256 bits */
+#define TESTS_BLOOM_SCALABLE_BYTES (8 + 16 + 32)
+
+static uint8_t counters[BLOOM_COUNTING_BYTES(TESTS_BLOOM_BITS)];
+static uint8_t scalable_buf[TESTS_BLOOM_SCALABLE_BYTES];
+static hashfp_t dh_hashes[2] = {
+                     (hashfp_t) fnv_hash,
+                     (hashfp_t) one_at_a_time_hash,
+                    };
+
 static void load_dictionary_fixture(void)
 {
     for (int i = 0; i < lenB; i++)
@@ -85,11 +98,114 @@ static void test_bloom_based_on_dictionary_fixture(void)
     TEST_ASSERT(false_positive_rate < TESTS_BLOOM_FALSE_POS_RATE_THR);
 }
 
+static void test_bloom_double_hashing(void)
+{
+    int in = 0;
+
+    bloom_init_double(&bloom, TESTS_BLOOM_BITS, bf, dh_hashes,
+                      TESTS_BLOOM_DH_HASHF);
+    TEST_ASSERT_EQUAL_INT(TESTS_BLOOM_DH_HASHF, bloom.k);
+    load_dictionary_fixture();
+
+    for (int i = 0; i < lenB; i++) {
+        TEST_ASSERT(bloom_check(&bloom, (const uint8_t *) B[i], strlen(B[i])));
+    }
+    for (int i = 0; i < lenA; i++) {
+        if (bloom_check(&bloom, (const uint8_t *) A[i], strlen(A[i]))) {
+            in++;
+        }
+    }
+    TEST_ASSERT(in <= TESTS_BLOOM_DH_PROB_IN_FILTER_MAX);
+}
+
+static void test_bloom_counting_remove(void)
+{
+    bloom_counting_t cbf;
+
+    bloom_counting_init(&cbf, TESTS_BLOOM_BITS, counters, dh_hashes,
+                        TESTS_BLOOM_DH_HASHF);
+    for (int i = 0; i < lenB; i++) {
+        bloom_counting_add(&cbf, (const uint8_t *) B[i], strlen(B[i]));
+    }
+    for (int i = 0; i < lenB; i++) {
+        TEST_ASSERT(bloom_counting_check(&cbf, (const uint8_t *) B[i],
+                                         strlen(B[i])));
+    }
+
+    /* adding twice needs removing twice */
+    bloom_counting_add(&cbf, (const uint8_t *) B[0], strlen(B[0]));
+    TEST_ASSERT_EQUAL_INT(0, bloom_counting_remove(&cbf, (const uint8_t *) B[0],
+                                                   strlen(B[0])));
+    TEST_ASSERT(bloom_counting_check(&cbf, (const uint8_t *) B[0],
+                                     strlen(B[0])));
+
+    for (int i = 0; i < lenB; i++) {
+        TEST_ASSERT_EQUAL_INT(0, bloom_counting_remove(&cbf,
+                                                       (const uint8_t *) B[i],
+                                                       strlen(B[i])));
+    }
+    for (size_t i = 0; i < sizeof(counters); i++) {
+        TEST_ASSERT_EQUAL_INT(0, counters[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOENT,
+                          bloom_counting_remove(&cbf, (const uint8_t *) B[0],
+                                                strlen(B[0])));
+}
+
+static void test_bloom_scalable_grow(void)
+{
+    bloom_scalable_t sbf;
+    int in = 0;
+
+    TEST_ASSERT_EQUAL_INT(-ENOMEM,
+                          bloom_scalable_init(&sbf, scalable_buf, 1,
+                                              TESTS_BLOOM_BITS, dh_hashes, 2));
+    TEST_ASSERT_EQUAL_INT(0, bloom_scalable_init(&sbf, scalable_buf,
+                                                 sizeof(scalable_buf),
+                                                 TESTS_BLOOM_BITS / 2,
+                                                 dh_hashes, 3));
+    TEST_ASSERT_EQUAL_INT(1, sbf.numof);
+
+    /* 14 elements fill the first filter, the next ones go to the second */
+    for (int i = 0; i < 3 * lenB; i++) {
+        TEST_ASSERT_EQUAL_INT(0, bloom_scalable_add(&sbf,
+                                                    (const uint8_t *) A[i],
+                                                    strlen(A[i])));
+    }
+    TEST_ASSERT_EQUAL_INT(2, sbf.numof);
+    TEST_ASSERT_EQUAL_INT(4, sbf.slices[1].k);
+    TEST_ASSERT_EQUAL_INT(TESTS_BLOOM_BITS, sbf.slices[1].m);
+
+    for (int i = 0; i < 3 * lenB; i++) {
+        TEST_ASSERT(bloom_scalable_check(&sbf, (const uint8_t *) A[i],
+                                         strlen(A[i])));
+    }
+    for (int i = 3 * lenB; i < lenA; i++) {
+        if (bloom_scalable_check(&sbf, (const uint8_t *) A[i], strlen(A[i]))) {
+            in++;
+        }
+    }
+    TEST_ASSERT(in < (lenA - 3 * lenB) / 5);
+
+    /* the third filter takes 35 elements, there is no room for a fourth */
+    for (int i = 3 * lenB; i < 10 * lenB; i++) {
+        bloom_scalable_add(&sbf, (const uint8_t *) A[i], strlen(A[i]));
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOMEM,
+                          bloom_scalable_add(&sbf, (const uint8_t *) B[0],
+                                             strlen(B[0])));
+    TEST_ASSERT(bloom_scalable_check(&sbf, (const uint8_t *) B[0],
+                                     strlen(B[0])));
+}
+
 Test *tests_bloom_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_bloom_parameters_bytes_hashf),
         new_TestFixture(test_bloom_based_on_dictionary_fixture),
+        new_TestFixture(test_bloom_double_hashing),
+        new_TestFixture(test_bloom_counting_remove),
+        new_TestFixture(test_bloom_scalable_grow),
     };
 
     EMB_UNIT_TESTCALLER(bloom_tests, set_up_bloom, tear_down_bloom, fixtures);
@@ -18,6 +18,7 @@
 #include "bitarithm.h"
 #include "cbor.h"
 
+#include <errno.h>
 #include <float.h>
 #include <math.h>
 #include <stdio.h>
@@ -748,6 +749,227 @@ void test_stream_decode(void)
 }
 #endif /* CBOR_NO_PRINT */
 
+static void test_iter(void)
+{
+    /* {"a": 1, "b": [2, 3], "c": h'0102', "d": (_ "strea", "ming"), "e": -500} */
+    static const unsigned char data[] = {
+        0xa5, 0x61, 0x61, 0x01, 0x61, 0x62, 0x82, 0x02, 0x03, 0x61, 0x63, 0x42,
+        0x01, 0x02, 0x61, 0x64, 0x7f, 0x65, 0x73, 0x74, 0x72, 0x65, 0x61, 0x64,
+        0x6d, 0x69, 0x6e, 0x67, 0xff, 0x61, 0x65, 0x39, 0x01, 0xf3
+    };
+    cbor_iter_t it, map, sub;
+    cbor_item_t item;
+    int64_t val;
+
+    cbor_iter_init(&it, data, sizeof(data));
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&it, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_MAP, item.type);
+    TEST_ASSERT_EQUAL_INT(5, item.val);
+    TEST_ASSERT(item.end == data + sizeof(data));
+    TEST_ASSERT_EQUAL_INT(0, cbor_iter_next(&it, &item));
+    TEST_ASSERT_EQUAL_INT(0, cbor_iter_enter(&item, &map));
+
+    /* key "a": views point into the source buffer */
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&map, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_TEXT, item.type);
+    TEST_ASSERT_EQUAL_INT(1, item.val);
+    TEST_ASSERT(item.data == &data[2]);
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&map, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_UINT, item.type);
+    TEST_ASSERT_EQUAL_INT(1, item.val);
+
+    /* key "b": nested array is skipped as a whole, then entered */
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&map, &item));
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&map, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_ARRAY, item.type);
+    TEST_ASSERT_EQUAL_INT(2, item.val);
+    TEST_ASSERT_EQUAL_INT(0, cbor_iter_enter(&item, &sub));
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&sub, &item));
+    TEST_ASSERT_EQUAL_INT(2, item.val);
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&sub, &item));
+    TEST_ASSERT_EQUAL_INT(3, item.val);
+    TEST_ASSERT_EQUAL_INT(0, cbor_iter_next(&sub, &item));
+
+    /* key "c" */
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&map, &item));
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&map, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_BYTES, item.type);
+    TEST_ASSERT_EQUAL_INT(2, item.val);
+    TEST_ASSERT(item.data == &data[12]);
+    TEST_ASSERT_EQUAL_INT(-EINVAL, cbor_iter_enter(&item, &sub));
+
+    /* key "d": indefinite-length string yields its chunks */
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&map, &item));
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&map, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_TEXT, item.type);
+    TEST_ASSERT(item.val == CBOR_ITER_INDEFINITE);
+    TEST_ASSERT_EQUAL_INT(0, cbor_iter_enter(&item, &sub));
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&sub, &item));
+    TEST_ASSERT_EQUAL_INT(5, item.val);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(item.data, "strea", 5));
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&sub, &item));
+    TEST_ASSERT_EQUAL_INT(4, item.val);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(item.data, "ming", 4));
+    TEST_ASSERT_EQUAL_INT(0, cbor_iter_next(&sub, &item));
+
+    /* key "e" */
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&map, &item));
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&map, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_NEGINT, item.type);
+    TEST_ASSERT_EQUAL_INT(0, cbor_item_get_int(&item, &val));
+    TEST_ASSERT(val == -500);
+    TEST_ASSERT_EQUAL_INT(0, cbor_iter_next(&map, &item));
+}
+
+static void test_iter_invalid(void)
+{
+    /* truncated: array of two items with only one present */
+    static const unsigned char truncated[] = { 0x82, 0x01 };
+    /* truncated: string longer than the buffer */
+    static const unsigned char short_string[] = { 0x63, 0x61, 0x62 };
+    /* reserved additional info */
+    static const unsigned char reserved[] = { 0x1c };
+    /* break outside of an indefinite-length item */
+    static const unsigned char stray_break[] = { 0xff };
+    /* indefinite-length string with a chunk of the wrong type */
+    static const unsigned char bad_chunk[] = { 0x7f, 0x41, 0x61, 0xff };
+    unsigned char deep[CBOR_ITER_NESTING_MAX + 2];
+    cbor_iter_t it;
+    cbor_item_t item;
+
+    cbor_iter_init(&it, truncated, sizeof(truncated));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_iter_next(&it, &item));
+    cbor_iter_init(&it, short_string, sizeof(short_string));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_iter_next(&it, &item));
+    cbor_iter_init(&it, reserved, sizeof(reserved));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_iter_next(&it, &item));
+    cbor_iter_init(&it, stray_break, sizeof(stray_break));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_iter_next(&it, &item));
+    cbor_iter_init(&it, bad_chunk, sizeof(bad_chunk));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_iter_next(&it, &item));
+
+    /* CBOR_ITER_NESTING_MAX arrays around an integer are fine, one more is not */
+    memset(deep, 0x81, sizeof(deep));
+    deep[sizeof(deep) - 1] = 0x00;
+    cbor_iter_init(&it, &deep[1], sizeof(deep) - 1);
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&it, &item));
+    cbor_iter_init(&it, deep, sizeof(deep));
+    TEST_ASSERT_EQUAL_INT(-EBADMSG, cbor_iter_next(&it, &item));
+}
+
+#define WRITER_CHUNKS       (4)
+#define WRITER_CHUNK_SIZE   (4)
+
+static unsigned char writer_chunks[WRITER_CHUNKS][WRITER_CHUNK_SIZE];
+static size_t writer_used[WRITER_CHUNKS];
+
+static unsigned char *writer_next(void *arg, size_t used, size_t *size)
+{
+    unsigned *numof = arg;
+
+    writer_used[*numof - 1] = used;
+    if (*numof == WRITER_CHUNKS) {
+        return NULL;
+    }
+    *size = WRITER_CHUNK_SIZE;
+    return writer_chunks[(*numof)++];
+}
+
+static ssize_t write_test_map(cbor_writer_t *w)
+{
+    cbor_writer_map(w, 3);
+    cbor_writer_text(w, "a", 1);
+    cbor_writer_uint(w, 1);
+    cbor_writer_text(w, "b", 1);
+    cbor_writer_array(w, 2);
+    cbor_writer_int(w, 2);
+    cbor_writer_int(w, -3);
+    cbor_writer_text(w, "c", 1);
+    cbor_writer_bytes(w, "\x01\x02", 2);
+    return cbor_writer_finish(w);
+}
+
+static void test_writer_chain(void)
+{
+    /* {"a": 1, "b": [2, -3], "c": h'0102'} */
+    static const unsigned char expected[] = {
+        0xa3, 0x61, 0x61, 0x01, 0x61, 0x62, 0x82, 0x02, 0x22, 0x61, 0x63, 0x42,
+        0x01, 0x02
+    };
+    cbor_writer_t w;
+    unsigned numof = 1;
+
+    memset(writer_chunks, 0, sizeof(writer_chunks));
+    cbor_writer_init(&w, writer_chunks[0], WRITER_CHUNK_SIZE, writer_next,
+                     &numof);
+    TEST_ASSERT_EQUAL_INT(sizeof(expected), write_test_map(&w));
+    TEST_ASSERT_EQUAL_INT(WRITER_CHUNKS, numof);
+    TEST_ASSERT_EQUAL_INT(WRITER_CHUNK_SIZE, writer_used[0]);
+    TEST_ASSERT_EQUAL_INT(sizeof(expected) % WRITER_CHUNK_SIZE, w.pos);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(writer_chunks, expected, sizeof(expected)));
+
+    /* output of the writer decodes with the pull parser */
+    cbor_iter_t it;
+    cbor_item_t item;
+    cbor_iter_init(&it, writer_chunks[0], sizeof(expected));
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&it, &item));
+    TEST_ASSERT_EQUAL_INT(CBOR_ITEM_MAP, item.type);
+    TEST_ASSERT(item.end == &writer_chunks[0][sizeof(expected)]);
+}
+
+static void test_writer_nobufs(void)
+{
+    cbor_writer_t w;
+    unsigned numof = 2;
+
+    /* only two chunks are left */
+    cbor_writer_init(&w, writer_chunks[1], WRITER_CHUNK_SIZE, writer_next,
+                     &numof);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, write_test_map(&w));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_writer_null(&w));
+
+    /* a single buffer without callback */
+    cbor_writer_init(&w, writer_chunks[0], 1, NULL, NULL);
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_bool(&w, true));
+    TEST_ASSERT_EQUAL_INT(0xf5, writer_chunks[0][0]);
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_writer_uint(&w, 0));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, cbor_writer_finish(&w));
+}
+
+#ifndef CBOR_NO_FLOAT
+static void test_iter_float(void)
+{
+    /* [1.5 (half), 100000.0 (single), 1.1 (double)] */
+    static const unsigned char data[] = {
+        0x83, 0xf9, 0x3e, 0x00, 0xfa, 0x47, 0xc3, 0x50, 0x00, 0xfb, 0x3f, 0xf1,
+        0x99, 0x99, 0x99, 0x99, 0x99, 0x9a
+    };
+    unsigned char buf[5];
+    cbor_writer_t w;
+    cbor_iter_t it, array;
+    cbor_item_t item;
+    double val;
+
+    cbor_iter_init(&it, data, sizeof(data));
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&it, &item));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, cbor_item_get_double(&item, &val));
+    TEST_ASSERT_EQUAL_INT(0, cbor_iter_enter(&item, &array));
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&array, &item));
+    TEST_ASSERT_EQUAL_INT(0, cbor_item_get_double(&item, &val));
+    CBOR_CHECK_DESERIALIZED(1.5, val, EQUAL_FLOAT);
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&array, &item));
+    TEST_ASSERT_EQUAL_INT(0, cbor_item_get_double(&item, &val));
+    CBOR_CHECK_DESERIALIZED(100000.0, val, EQUAL_FLOAT);
+    TEST_ASSERT_EQUAL_INT(1, cbor_iter_next(&array, &item));
+    TEST_ASSERT_EQUAL_INT(0, cbor_item_get_double(&item, &val));
+    CBOR_CHECK_DESERIALIZED(1.1, val, EQUAL_FLOAT);
+
+    cbor_writer_init(&w, buf, sizeof(buf), NULL, NULL);
+    TEST_ASSERT_EQUAL_INT(0, cbor_writer_float(&w, 100000.0));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, &data[4], sizeof(buf)));
+}
+#endif /* CBOR_NO_FLOAT */
+
 /**
  * See examples from CBOR RFC (cf. Appendix A. Examples)
  */
@@ -787,6 +1009,13 @@ TestRef tests_cbor_all(void)
                         new_TestFixture(test_double),
                         new_TestFixture(test_double_invalid),
 #endif /* CBOR_NO_FLOAT */
+                        new_TestFixture(test_iter),
+                        new_TestFixture(test_iter_invalid),
+#ifndef CBOR_NO_FLOAT
+                        new_TestFixture(test_iter_float),
+#endif /* CBOR_NO_FLOAT */
+                        new_TestFixture(test_writer_chain),
+                        new_TestFixture(test_writer_nobufs),
     };
 
     EMB_UNIT_TESTCALLER(CborTest, setUp, tearDown, fixtures);
@@ -16,6 +16,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+#include <string.h>
+
 #include "thread.h"
 #include "ringbuffer.h"
 #include "mutex.h"
@@ -114,10 +116,66 @@ static void tests_core_ringbuffer(void)
     run_add();
 }
 
+static void tests_core_ringbuffer_bulk(void)
+{
+    char buf[BUF_SIZE];
+    char out[BUF_SIZE];
+    ringbuffer_t rb_bulk;
+
+    ringbuffer_init(&rb_bulk, buf, sizeof(buf));
+
+    /* move read position, so the next add wraps around */
+    TEST_ASSERT_EQUAL_INT(5, ringbuffer_add(&rb_bulk, "abcde", 5));
+    TEST_ASSERT_EQUAL_INT(4, ringbuffer_get(&rb_bulk, out, 4));
+    TEST_ASSERT_EQUAL_INT('d', out[3]);
+
+    /* only as many as fit */
+    TEST_ASSERT_EQUAL_INT(6, ringbuffer_add(&rb_bulk, "fghijkl", 7));
+    TEST_ASSERT(ringbuffer_full(&rb_bulk));
+    TEST_ASSERT_EQUAL_INT(7, ringbuffer_get(&rb_bulk, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "efghijk", 7));
+    TEST_ASSERT(ringbuffer_empty(&rb_bulk));
+}
+
+static void tests_core_ringbuffer_zero_copy(void)
+{
+    char buf[BUF_SIZE];
+    ringbuffer_t rb_zc;
+    char *wptr;
+    const char *rptr;
+
+    ringbuffer_init(&rb_zc, buf, sizeof(buf));
+    ringbuffer_add(&rb_zc, "abcde", 5);
+    ringbuffer_remove(&rb_zc, 3);
+    TEST_ASSERT_EQUAL_INT('d', ringbuffer_peek_one(&rb_zc));
+
+    /* free space is split at the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_reserve(&rb_zc, &wptr));
+    TEST_ASSERT(wptr == &buf[5]);
+    memcpy(wptr, "fg", 2);
+    ringbuffer_commit(&rb_zc, 2);
+    TEST_ASSERT_EQUAL_INT(3, ringbuffer_reserve(&rb_zc, &wptr));
+    TEST_ASSERT(wptr == &buf[0]);
+    memcpy(wptr, "hi", 2);
+    ringbuffer_commit(&rb_zc, 2);
+    TEST_ASSERT_EQUAL_INT(6, rb_zc.avail);
+
+    /* so are the elements */
+    TEST_ASSERT_EQUAL_INT(4, ringbuffer_peek_ptr(&rb_zc, &rptr));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(rptr, "defg", 4));
+    TEST_ASSERT_EQUAL_INT(4, ringbuffer_remove(&rb_zc, 4));
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_peek_ptr(&rb_zc, &rptr));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(rptr, "hi", 2));
+    TEST_ASSERT_EQUAL_INT(2, ringbuffer_remove(&rb_zc, 2));
+    TEST_ASSERT(ringbuffer_empty(&rb_zc));
+}
+
 Test *tests_core_ringbuffer_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(tests_core_ringbuffer),
+        new_TestFixture(tests_core_ringbuffer_bulk),
+        new_TestFixture(tests_core_ringbuffer_zero_copy),
     };
 
     EMB_UNIT_TESTCALLER(ringbuffer_tests, NULL, NULL, fixtures);
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include "embUnit.h"
+
+#include "rwlock.h"
+
+#include "tests-core.h"
+
+static rwlock_t rwlock;
+
+static void set_up(void)
+{
+    rwlock_init(&rwlock);
+}
+
+static void test_rwlock_readers(void)
+{
+    rwlock_rdlock(&rwlock);
+    TEST_ASSERT_EQUAL_INT(1, rwlock_tryrdlock(&rwlock));
+    TEST_ASSERT_EQUAL_INT(2, ATOMIC_VALUE(rwlock.state));
+    TEST_ASSERT_EQUAL_INT(0, rwlock_trywrlock(&rwlock));
+    rwlock_unlock(&rwlock);
+    TEST_ASSERT_EQUAL_INT(0, rwlock_trywrlock(&rwlock));
+    rwlock_unlock(&rwlock);
+    TEST_ASSERT_EQUAL_INT(0, ATOMIC_VALUE(rwlock.state));
+}
+
+static void test_rwlock_writer(void)
+{
+    rwlock_wrlock(&rwlock);
+    TEST_ASSERT_EQUAL_INT(RWLOCK_WRITER, ATOMIC_VALUE(rwlock.state));
+    TEST_ASSERT_EQUAL_INT(0, rwlock_tryrdlock(&rwlock));
+    TEST_ASSERT_EQUAL_INT(0, rwlock_trywrlock(&rwlock));
+    rwlock_unlock(&rwlock);
+    TEST_ASSERT_EQUAL_INT(1, rwlock_tryrdlock(&rwlock));
+    rwlock_unlock(&rwlock);
+    TEST_ASSERT_EQUAL_INT(1, rwlock_trywrlock(&rwlock));
+    rwlock_unlock(&rwlock);
+    TEST_ASSERT_EQUAL_INT(0, ATOMIC_VALUE(rwlock.state));
+}
+
+static void test_rwlock_waiting_writer(void)
+{
+    /* a waiting writer blocks new readers */
+    ATOMIC_VALUE(rwlock.state) = 1 | RWLOCK_WAITERS;
+    TEST_ASSERT_EQUAL_INT(0, rwlock_tryrdlock(&rwlock));
+    TEST_ASSERT_EQUAL_INT(0, rwlock_trywrlock(&rwlock));
+}
+
+Test *tests_core_rwlock_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rwlock_readers),
+        new_TestFixture(test_rwlock_writer),
+        new_TestFixture(test_rwlock_waiting_writer),
+    };
+
+    EMB_UNIT_TESTCALLER(core_rwlock_tests, set_up, NULL, fixtures);
+
+    return (Test *)&core_rwlock_tests;
+}
@@ -24,7 +24,7 @@ static fib_entry_t _entries[TEST_FIB_TABLE_SIZE];
 static fib_table_t test_fib_table = { .data.entries = _entries,
                                       .table_type = FIB_TABLE_TYPE_SH,
                                       .size = TEST_FIB_TABLE_SIZE,
-                                      .mtx_access = MUTEX_INIT,
+                                      .mtx_access = RWLOCK_INIT,
                                       .notify_rp_pos = 0 };
 
 /*
@@ -705,7 +705,7 @@ Test *tests_fib_sr_tests(void)
     test_fib_sr_table.data.source_routes = &_entries_sr;
     test_fib_sr_table.table_type = FIB_TABLE_TYPE_SR;
     test_fib_sr_table.size = TEST_MAX_FIB_SR;
-    mutex_init(&(test_fib_sr_table.mtx_access));
+    rwlock_init(&(test_fib_sr_table.mtx_access));
     test_fib_sr_table.notify_rp_pos = 0;
 
     fib_init(&test_fib_sr_table);
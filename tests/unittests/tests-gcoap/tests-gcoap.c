@@ -17,11 +17,220 @@
 
 #include "embUnit.h"
 
+#include "msg.h"
 #include "net/gnrc/coap.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/ipv6/hdr.h"
+#include "net/udp.h"
+#include "thread.h"
+#include "xtimer.h"
 
 #include "unittests-constants.h"
 #include "tests-gcoap.h"
 
+#define MSG_QUEUE_SIZE  (8)
+#define OBS_PORT        (61616)
+
+#ifndef COAP_CODE_EMPTY
+#define COAP_CODE_EMPTY (0)
+#endif
+
+static ipv6_addr_t _remote = { .u8 = { 0xfe, 0x80, [15] = 0x01 } };
+static ipv6_addr_t _remote2 = { .u8 = { 0xfe, 0x80, [15] = 0x02 } };
+
+static msg_t _msg_queue[MSG_QUEUE_SIZE];
+static kernel_pid_t _gcoap_pid = KERNEL_PID_UNDEF;
+/* receives the messages gcoap sends, in place of the UDP thread */
+static gnrc_netreg_entry_t _udp_sink;
+
+/* Responds to a GET with the text "1" */
+static ssize_t _obs_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+{
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    pdu->payload[0] = '1';
+    return gcoap_finish(pdu, 1, COAP_FORMAT_TEXT);
+}
+
+static coap_resource_t _resources[] = {
+    { "/obs", COAP_GET, _obs_handler },
+};
+
+/* response handler state */
+static unsigned _resp_count;
+static unsigned _resp_state;
+static uint8_t _resp_token[GCOAP_TOKENLEN];
+
+static void _resp_handler(unsigned req_state, coap_pkt_t *pdu)
+{
+    _resp_count++;
+    _resp_state = req_state;
+    memcpy(&_resp_token[0], &pdu->hdr->data[0], GCOAP_TOKENLEN);
+}
+
+static gcoap_listener_t _listener = {
+    &_resources[0],
+    sizeof(_resources) / sizeof(_resources[0]),
+    NULL
+};
+
+/*
+ * Takes the next message gcoap has sent, and copies its CoAP PDU to buf.
+ *
+ * Returns the length of the PDU, or 0 if gcoap has sent nothing
+ */
+static size_t _sent(uint8_t *buf, size_t len)
+{
+    msg_t msg;
+
+    while (msg_try_receive(&msg) == 1) {
+        if (msg.type != GNRC_NETAPI_MSG_TYPE_SND) {
+            continue;
+        }
+        /* IPv6 -> UDP -> CoAP */
+        gnrc_pktsnip_t *pkt = msg.content.ptr;
+        gnrc_pktsnip_t *coap = pkt->next->next;
+        size_t pdu_len = (coap->size < len) ? coap->size : len;
+
+        memcpy(buf, coap->data, pdu_len);
+        gnrc_pktbuf_release(pkt);
+        return pdu_len;
+    }
+    return 0;
+}
+
+/* Passes a CoAP message from src and port to gcoap, as the UDP thread does */
+static void _recv(const ipv6_addr_t *src, uint16_t port, uint8_t *data,
+                  size_t len)
+{
+    gnrc_pktsnip_t *ipv6, *udp, *pkt;
+    msg_t msg;
+
+    ipv6 = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t), GNRC_NETTYPE_IPV6);
+    TEST_ASSERT_NOT_NULL(ipv6);
+    memset(ipv6->data, 0, sizeof(ipv6_hdr_t));
+    ((ipv6_hdr_t *)ipv6->data)->src = *src;
+    udp = gnrc_pktbuf_add(ipv6, NULL, sizeof(udp_hdr_t), GNRC_NETTYPE_UDP);
+    TEST_ASSERT_NOT_NULL(udp);
+    memset(udp->data, 0, sizeof(udp_hdr_t));
+    ((udp_hdr_t *)udp->data)->src_port = byteorder_htons(port);
+    ((udp_hdr_t *)udp->data)->dst_port = byteorder_htons(GCOAP_PORT);
+    pkt = gnrc_pktbuf_add(udp, data, len, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt);
+
+    /* gcoap preempts this thread, so it has handled the message on return */
+    msg.type = GNRC_NETAPI_MSG_TYPE_RCV;
+    msg.content.ptr = pkt;
+    msg_send(&msg, _gcoap_pid);
+}
+
+/*
+ * Passes a GET request for /obs from port to gcoap, with the given Observe
+ * value. The token is derived from the port.
+ */
+static void _obs_req(uint16_t port, uint8_t observe)
+{
+    uint8_t pdu_data[] = {
+        0x52, 0x01, 0x20, (uint8_t)port, 0x35, (uint8_t)port,
+        0x61, observe,
+        0x53, 0x6f, 0x62, 0x73
+    };
+
+    _recv(&_remote, port, pdu_data, sizeof(pdu_data));
+}
+
+/* Writes a GET request for /time of the given type and token to buf */
+static size_t _req(uint8_t *buf, unsigned type, const uint8_t *token)
+{
+    coap_pkt_t pdu;
+    char path[] = "/time";
+
+    ssize_t len = gcoap_request(&pdu, buf, GCOAP_PDU_BUF_SIZE, COAP_METHOD_GET,
+                                &path[0]);
+    gcoap_hdr_set_type(pdu.hdr, type);
+    memcpy(&buf[4], token, GCOAP_TOKENLEN);
+    return len;
+}
+
+/* Passes an empty ACK for the message ID from src to gcoap */
+static void _ack(const ipv6_addr_t *src, uint16_t id)
+{
+    uint8_t pdu_data[sizeof(coap_hdr_t)];
+
+    coap_build_hdr((coap_hdr_t *)pdu_data, COAP_TYPE_ACK, NULL, 0,
+                   COAP_CODE_EMPTY, id);
+    _recv(src, GCOAP_PORT, pdu_data, sizeof(pdu_data));
+}
+
+/* Passes a 2.05 response with the token from src to gcoap */
+static void _resp(const ipv6_addr_t *src, unsigned type, const uint8_t *token,
+                  uint16_t id)
+{
+    uint8_t pdu_data[sizeof(coap_hdr_t) + GCOAP_TOKENLEN];
+
+    coap_build_hdr((coap_hdr_t *)pdu_data, type, (uint8_t *)token,
+                   GCOAP_TOKENLEN, COAP_CODE_CONTENT, id);
+    _recv(src, GCOAP_PORT, pdu_data, sizeof(pdu_data));
+}
+
+/* Returns the message ID of a PDU */
+static uint16_t _id(const uint8_t *buf)
+{
+    return (buf[2] << 8) | buf[3];
+}
+
+/* Sleeps until offset usec after start */
+static void _sleep_until(uint32_t start, uint32_t offset)
+{
+    int32_t left = (int32_t)(start + offset - xtimer_now_usec());
+
+    if (left > 0) {
+        xtimer_usleep(left);
+    }
+}
+
+/* Returns the value of the Observe option of a response, or -1 if none */
+static int32_t _obs_seq(const uint8_t *buf)
+{
+    const uint8_t *opt = &buf[4 + (buf[0] & 0x0F)];
+    int32_t seq = 0;
+
+    if ((*opt >> 4) != COAP_OPT_OBSERVE) {
+        return -1;
+    }
+    for (unsigned i = 0; i < (*opt & 0x0FU); i++) {
+        seq = (seq << 8) | opt[1 + i];
+    }
+    return seq;
+}
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    msg_init_queue(_msg_queue, MSG_QUEUE_SIZE);
+    if (_gcoap_pid == KERNEL_PID_UNDEF) {
+        _gcoap_pid = gcoap_init();
+        gcoap_register_listener(&_listener);
+    }
+    gnrc_netreg_entry_init_pid(&_udp_sink, GNRC_NETREG_DEMUX_CTX_ALL,
+                               thread_getpid());
+    gnrc_netreg_register(GNRC_NETTYPE_UDP, &_udp_sink);
+    _resp_count = 0;
+    _resp_state = GCOAP_MEMO_UNUSED;
+}
+
+static void tear_down(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+
+    for (unsigned i = 0; i <= GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        _obs_req(OBS_PORT + i, GCOAP_OBS_DEREGISTER);
+    }
+    while (_sent(buf, sizeof(buf))) {}
+    gnrc_netreg_unregister(GNRC_NETTYPE_UDP, &_udp_sink);
+}
+
 /*
  * Client GET request success case. Test request generation.
  * Request /time resource from libcoap example
@@ -51,6 +260,188 @@ static void test_gcoap__client_get_req(void)
     TEST_ASSERT_EQUAL_INT(sizeof(pdu_data), len);
 }
 
+/*
+ * Client confirmable GET request. Test setting the message type.
+ */
+static void test_gcoap__client_con_req(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    char path[] = "/time";
+
+    ssize_t len = gcoap_request(&pdu, &buf[0], GCOAP_PDU_BUF_SIZE,
+                                COAP_METHOD_GET, &path[0]);
+    gcoap_hdr_set_type(pdu.hdr, COAP_TYPE_CON);
+
+    TEST_ASSERT_EQUAL_INT(COAP_TYPE_CON, coap_get_type(&pdu));
+    TEST_ASSERT_EQUAL_INT(COAP_METHOD_GET, coap_get_code(&pdu));
+    TEST_ASSERT_EQUAL_INT(GCOAP_TOKENLEN, coap_get_token_len(&pdu));
+    TEST_ASSERT_EQUAL_INT(0x42, buf[0]);
+    TEST_ASSERT_EQUAL_INT(11, len);
+}
+
+/*
+ * Confirmable request retransmission. Test the request is retransmitted
+ * GCOAP_MAX_RETRANSMIT times, with the timeout doubled each time, and then
+ * times out.
+ */
+static void test_gcoap__client_con_retransmit(void)
+{
+    uint8_t req[GCOAP_PDU_BUF_SIZE], buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t token[] = { 0x01, 0x01 };
+    size_t len = _req(req, COAP_TYPE_CON, token);
+    uint32_t start = xtimer_now_usec();
+    uint8_t open_reqs;
+
+    TEST_ASSERT(gcoap_req_send(req, len, &_remote, GCOAP_PORT,
+                               _resp_handler) > 0);
+    TEST_ASSERT_EQUAL_INT(len, _sent(buf, sizeof(buf)));
+
+    /* initial timeout in [ACK_TIMEOUT, 1.5 * ACK_TIMEOUT] */
+    _sleep_until(start, GCOAP_ACK_TIMEOUT / 2);
+    TEST_ASSERT_EQUAL_INT(0, _sent(buf, sizeof(buf)));
+
+    /* first retransmission, the next one not before 3 * ACK_TIMEOUT */
+    _sleep_until(start, 9 * GCOAP_ACK_TIMEOUT / 4);
+    TEST_ASSERT_EQUAL_INT(len, _sent(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, req, len));
+    TEST_ASSERT_EQUAL_INT(0, _sent(buf, sizeof(buf)));
+
+    /* second retransmission by 4.5 * ACK_TIMEOUT, time out not before
+     * 7 * ACK_TIMEOUT */
+    _sleep_until(start, 5 * GCOAP_ACK_TIMEOUT);
+    TEST_ASSERT_EQUAL_INT(len, _sent(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, _sent(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, _resp_count);
+
+    /* time out by 10.5 * ACK_TIMEOUT */
+    _sleep_until(start, 12 * GCOAP_ACK_TIMEOUT);
+    TEST_ASSERT_EQUAL_INT(0, _sent(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(1, _resp_count);
+    TEST_ASSERT_EQUAL_INT(GCOAP_MEMO_TIMEOUT, _resp_state);
+    gcoap_op_state(&open_reqs);
+    TEST_ASSERT_EQUAL_INT(0, open_reqs);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+/*
+ * Confirmable requests beyond GCOAP_NSTART. Test a request is queued until an
+ * empty ACK for an outstanding request to the same destination, while a
+ * request to another destination is sent right away.
+ */
+static void test_gcoap__client_con_nstart(void)
+{
+    uint8_t req_a[GCOAP_PDU_BUF_SIZE], req_b[GCOAP_PDU_BUF_SIZE];
+    uint8_t req_c[GCOAP_PDU_BUF_SIZE], buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t token_a[] = { 0x02, 0x01 }, token_b[] = { 0x02, 0x02 };
+    uint8_t token_c[] = { 0x02, 0x03 };
+    size_t len_a = _req(req_a, COAP_TYPE_CON, token_a);
+    size_t len_b = _req(req_b, COAP_TYPE_CON, token_b);
+    size_t len_c = _req(req_c, COAP_TYPE_CON, token_c);
+    uint8_t open_reqs;
+
+    gcoap_req_send(req_a, len_a, &_remote, GCOAP_PORT, _resp_handler);
+    TEST_ASSERT_EQUAL_INT(len_a, _sent(buf, sizeof(buf)));
+    TEST_ASSERT(gcoap_req_send(req_b, len_b, &_remote, GCOAP_PORT,
+                               _resp_handler) > 0);
+    TEST_ASSERT_EQUAL_INT(0, _sent(buf, sizeof(buf)));
+    gcoap_req_send(req_c, len_c, &_remote2, GCOAP_PORT, _resp_handler);
+    TEST_ASSERT_EQUAL_INT(len_c, _sent(buf, sizeof(buf)));
+    gcoap_op_state(&open_reqs);
+    TEST_ASSERT_EQUAL_INT(3, open_reqs);
+
+    /* request B goes out on the ACK for A */
+    _ack(&_remote, _id(req_a));
+    TEST_ASSERT_EQUAL_INT(len_b, _sent(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, req_b, len_b));
+    TEST_ASSERT_EQUAL_INT(0, _resp_count);
+
+    /* separate response for A, piggybacked ones for B and C */
+    _resp(&_remote, COAP_TYPE_NON, token_a, 0x1234);
+    _resp(&_remote, COAP_TYPE_ACK, token_b, _id(req_b));
+    _resp(&_remote2, COAP_TYPE_ACK, token_c, _id(req_c));
+    TEST_ASSERT_EQUAL_INT(3, _resp_count);
+    TEST_ASSERT_EQUAL_INT(GCOAP_MEMO_RESP, _resp_state);
+    gcoap_op_state(&open_reqs);
+    TEST_ASSERT_EQUAL_INT(0, open_reqs);
+    TEST_ASSERT_EQUAL_INT(0, _sent(buf, sizeof(buf)));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+/*
+ * Queued confirmable request. Test a piggybacked response to the outstanding
+ * request releases the queued one, which then is retransmitted on its own.
+ */
+static void test_gcoap__client_con_release_queued(void)
+{
+    uint8_t req_a[GCOAP_PDU_BUF_SIZE], req_b[GCOAP_PDU_BUF_SIZE];
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t token_a[] = { 0x03, 0x01 }, token_b[] = { 0x03, 0x02 };
+    size_t len_a = _req(req_a, COAP_TYPE_CON, token_a);
+    size_t len_b = _req(req_b, COAP_TYPE_CON, token_b);
+    uint32_t start;
+
+    gcoap_req_send(req_a, len_a, &_remote, GCOAP_PORT, _resp_handler);
+    gcoap_req_send(req_b, len_b, &_remote, GCOAP_PORT, _resp_handler);
+    TEST_ASSERT_EQUAL_INT(len_a, _sent(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, _sent(buf, sizeof(buf)));
+
+    _resp(&_remote, COAP_TYPE_ACK, token_a, _id(req_a));
+    start = xtimer_now_usec();
+    TEST_ASSERT_EQUAL_INT(1, _resp_count);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_resp_token[0], token_a, GCOAP_TOKENLEN));
+    TEST_ASSERT_EQUAL_INT(len_b, _sent(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, req_b, len_b));
+
+    /* B waits for its own ACK now */
+    _sleep_until(start, 9 * GCOAP_ACK_TIMEOUT / 4);
+    TEST_ASSERT_EQUAL_INT(len_b, _sent(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(buf, req_b, len_b));
+
+    _resp(&_remote, COAP_TYPE_ACK, token_b, _id(req_b));
+    TEST_ASSERT_EQUAL_INT(2, _resp_count);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_resp_token[0], token_b, GCOAP_TOKENLEN));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+/*
+ * Token slot collisions. Test responses are matched to requests whose tokens
+ * hash to the same slot of the open requests, also after the request in the
+ * first slot is gone.
+ */
+static void test_gcoap__client_token_slot(void)
+{
+    uint8_t req_a[GCOAP_PDU_BUF_SIZE], req_b[GCOAP_PDU_BUF_SIZE];
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    /* all hash to slot 0 */
+    uint8_t token_a[] = { 0x00, GCOAP_REQ_WAITING_MAX };
+    uint8_t token_b[] = { 0x00, 2 * GCOAP_REQ_WAITING_MAX };
+    uint8_t token_c[] = { 0x00, 3 * GCOAP_REQ_WAITING_MAX };
+    size_t len_a = _req(req_a, COAP_TYPE_NON, token_a);
+    size_t len_b = _req(req_b, COAP_TYPE_NON, token_b);
+    uint8_t open_reqs;
+
+    gcoap_req_send(req_a, len_a, &_remote, GCOAP_PORT, _resp_handler);
+    gcoap_req_send(req_b, len_b, &_remote, GCOAP_PORT, _resp_handler);
+    TEST_ASSERT_EQUAL_INT(len_a, _sent(buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(len_b, _sent(buf, sizeof(buf)));
+
+    _resp(&_remote, COAP_TYPE_NON, token_a, 0x1234);
+    TEST_ASSERT_EQUAL_INT(1, _resp_count);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_resp_token[0], token_a, GCOAP_TOKENLEN));
+
+    /* no request for C */
+    _resp(&_remote, COAP_TYPE_NON, token_c, 0x1235);
+    TEST_ASSERT_EQUAL_INT(1, _resp_count);
+
+    _resp(&_remote, COAP_TYPE_NON, token_b, 0x1236);
+    TEST_ASSERT_EQUAL_INT(2, _resp_count);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&_resp_token[0], token_b, GCOAP_TOKENLEN));
+    gcoap_op_state(&open_reqs);
+    TEST_ASSERT_EQUAL_INT(0, open_reqs);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 /*
  * Client GET response success case. Test parsing response.
  * Response for /time resource from libcoap example
@@ -156,16 +547,229 @@ static void test_gcoap__server_get_resp(void)
     }
 }
 
+/*
+ * Deferred response success case. Test writing a separate response for the
+ * /cli/stats request from the token recorded for it.
+ */
+static void test_gcoap__server_deferred_resp(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    gcoap_deferred_t deferred = {
+        .port      = 5683,
+        .token_len = 2,
+        .token     = { 0x35, 0x61 },
+    };
+
+    /* not called from a resource callback */
+    _read_cli_stats_req(&pdu, &buf[0]);
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gcoap_resp_defer(&pdu, &buf[0], sizeof(buf),
+                                                          &deferred));
+
+    /* generate response */
+    memset(buf, 0, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(0, gcoap_deferred_init(&deferred, &pdu, &buf[0],
+                                                 sizeof(buf), COAP_CODE_CONTENT));
+    char resp_payload[]  = "2";
+    memcpy(&pdu.payload[0], &resp_payload[0], strlen(resp_payload));
+    ssize_t res = gcoap_finish(&pdu, strlen(resp_payload), COAP_FORMAT_TEXT);
+
+    uint8_t resp_data[] = {
+        0x52, 0x45, 0x00, 0x00, 0x35, 0x61, 0xc0, 0xff,
+        0x32
+    };
+
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CONTENT, coap_get_code(&pdu));
+    TEST_ASSERT_EQUAL_INT(COAP_TYPE_NON, coap_get_type(&pdu));
+    TEST_ASSERT_EQUAL_INT(sizeof(resp_data), res);
+
+    /* message ID is new, so skip it */
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&buf[0], &resp_data[0], 2));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&buf[4], &resp_data[4], sizeof(resp_data) - 4));
+}
+
+/* Streams a representation of 100 bytes: 0, 1, 2, ... */
+static ssize_t _stream_100(uint8_t *buf, size_t offset, size_t len, void *arg)
+{
+    (void)arg;
+    size_t i;
+    for (i = 0; (i < len) && (offset + i < 100); i++) {
+        buf[i] = offset + i;
+    }
+    return i;
+}
+
+/*
+ * Block-wise response. Test a representation too large for a single PDU is
+ * split, when the request has no Block2 option.
+ */
+static void test_gcoap__server_block2_stream(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+
+    /* read request */
+    _read_cli_stats_req(&pdu, &buf[0]);
+
+    ssize_t res = gcoap_block2_stream(&pdu, &buf[0], sizeof(buf),
+                                      COAP_FORMAT_TEXT, _stream_100, NULL);
+
+    /* Content-Format, and Block2 for block 0 of 64 bytes with more to come */
+    uint8_t resp_hdr[] = {
+        0x52, 0x45, 0x20, 0xb6, 0x35, 0x61, 0xc0, 0xb1,
+        0x0a, 0xff
+    };
+
+    TEST_ASSERT_EQUAL_INT(sizeof(resp_hdr) + 64, res);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&buf[0], &resp_hdr[0], sizeof(resp_hdr)));
+    TEST_ASSERT_EQUAL_INT(64, pdu.payload_len);
+    TEST_ASSERT(pdu.payload == &buf[sizeof(resp_hdr)]);
+    for (unsigned i = 0; i < 64; i++) {
+        TEST_ASSERT_EQUAL_INT(i, pdu.payload[i]);
+    }
+}
+
+/*
+ * Observe notification without observers. Test nothing is scheduled.
+ */
+static void test_gcoap__server_obs_send_none(void)
+{
+    coap_resource_t resource = { "/cli/stats", COAP_GET, NULL };
+
+    TEST_ASSERT_EQUAL_INT(0, gcoap_obs_send(&resource));
+}
+
+/*
+ * Observe registration. Test the response to a registration and the
+ * notification carry Observe, and deregistration ends the notifications.
+ */
+static void test_gcoap__server_obs_register(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t token[] = { 0x35, (uint8_t)OBS_PORT };
+
+    _obs_req(OBS_PORT, GCOAP_OBS_REGISTER);
+    TEST_ASSERT(_sent(buf, sizeof(buf)) > 0);
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CONTENT, buf[1]);
+    TEST_ASSERT(_obs_seq(buf) >= 0);
+
+    TEST_ASSERT_EQUAL_INT(1, gcoap_obs_send(&_resources[0]));
+    xtimer_usleep(2 * GCOAP_OBS_NOTIFY_INTERVAL);
+    TEST_ASSERT(_sent(buf, sizeof(buf)) > 0);
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CONTENT, buf[1]);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&buf[4], &token[0], sizeof(token)));
+    TEST_ASSERT(_obs_seq(buf) >= 0);
+
+    _obs_req(OBS_PORT, GCOAP_OBS_DEREGISTER);
+    TEST_ASSERT(_sent(buf, sizeof(buf)) > 0);
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CONTENT, buf[1]);
+    TEST_ASSERT_EQUAL_INT(-1, _obs_seq(buf));
+    TEST_ASSERT_EQUAL_INT(0, gcoap_obs_send(&_resources[0]));
+}
+
+/*
+ * Full observer table. Test a registration beyond GCOAP_OBS_REGISTRATIONS_MAX
+ * gets a plain response, and no notification.
+ */
+static void test_gcoap__server_obs_full(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    unsigned notifications = 0;
+
+    for (unsigned i = 0; i < GCOAP_OBS_REGISTRATIONS_MAX; i++) {
+        _obs_req(OBS_PORT + i, GCOAP_OBS_REGISTER);
+        TEST_ASSERT(_sent(buf, sizeof(buf)) > 0);
+        TEST_ASSERT(_obs_seq(buf) >= 0);
+    }
+    _obs_req(OBS_PORT + GCOAP_OBS_REGISTRATIONS_MAX, GCOAP_OBS_REGISTER);
+    TEST_ASSERT(_sent(buf, sizeof(buf)) > 0);
+    TEST_ASSERT_EQUAL_INT(COAP_CODE_CONTENT, buf[1]);
+    TEST_ASSERT_EQUAL_INT(-1, _obs_seq(buf));
+
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_REGISTRATIONS_MAX,
+                          gcoap_obs_send(&_resources[0]));
+    xtimer_usleep(2 * GCOAP_OBS_NOTIFY_INTERVAL);
+    while (_sent(buf, sizeof(buf))) {
+        TEST_ASSERT(buf[5] != (uint8_t)(OBS_PORT + GCOAP_OBS_REGISTRATIONS_MAX));
+        notifications++;
+    }
+    TEST_ASSERT_EQUAL_INT(GCOAP_OBS_REGISTRATIONS_MAX, notifications);
+}
+
+/*
+ * Observe sequence numbers. Test each notification has a greater number than
+ * the response to the registration and the previous notification.
+ */
+static void test_gcoap__server_obs_seq(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    int32_t seq;
+
+    _obs_req(OBS_PORT, GCOAP_OBS_REGISTER);
+    TEST_ASSERT(_sent(buf, sizeof(buf)) > 0);
+    seq = _obs_seq(buf);
+    TEST_ASSERT(seq >= 0);
+
+    for (unsigned i = 0; i < 2; i++) {
+        gcoap_obs_send(&_resources[0]);
+        xtimer_usleep(2 * GCOAP_OBS_NOTIFY_INTERVAL);
+        TEST_ASSERT(_sent(buf, sizeof(buf)) > 0);
+        TEST_ASSERT(_obs_seq(buf) > seq);
+        seq = _obs_seq(buf);
+    }
+}
+
+/*
+ * Notification coalescing. Test changes within GCOAP_OBS_NOTIFY_INTERVAL of
+ * the response to the registration yield a single notification, sent when the
+ * interval has passed.
+ */
+static void test_gcoap__server_obs_coalesce(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint32_t start;
+
+    _obs_req(OBS_PORT, GCOAP_OBS_REGISTER);
+    start = xtimer_now_usec();
+    TEST_ASSERT(_sent(buf, sizeof(buf)) > 0);
+
+    for (unsigned i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(1, gcoap_obs_send(&_resources[0]));
+    }
+    xtimer_usleep(GCOAP_OBS_NOTIFY_INTERVAL / 2);
+    TEST_ASSERT_EQUAL_INT(0, _sent(buf, sizeof(buf)));
+
+    _sleep_until(start, 2 * GCOAP_OBS_NOTIFY_INTERVAL);
+    TEST_ASSERT(_sent(buf, sizeof(buf)) > 0);
+    TEST_ASSERT_EQUAL_INT(0, _sent(buf, sizeof(buf)));
+
+    /* nothing left pending */
+    xtimer_usleep(2 * GCOAP_OBS_NOTIFY_INTERVAL);
+    TEST_ASSERT_EQUAL_INT(0, _sent(buf, sizeof(buf)));
+}
+
 Test *tests_gcoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_gcoap__client_get_req),
+        new_TestFixture(test_gcoap__client_con_req),
+        new_TestFixture(test_gcoap__client_con_retransmit),
+        new_TestFixture(test_gcoap__client_con_nstart),
+        new_TestFixture(test_gcoap__client_con_release_queued),
+        new_TestFixture(test_gcoap__client_token_slot),
         new_TestFixture(test_gcoap__client_get_resp),
         new_TestFixture(test_gcoap__server_get_req),
         new_TestFixture(test_gcoap__server_get_resp),
+        new_TestFixture(test_gcoap__server_deferred_resp),
+        new_TestFixture(test_gcoap__server_block2_stream),
+        new_TestFixture(test_gcoap__server_obs_send_none),
+        new_TestFixture(test_gcoap__server_obs_register),
+        new_TestFixture(test_gcoap__server_obs_full),
+        new_TestFixture(test_gcoap__server_obs_seq),
+        new_TestFixture(test_gcoap__server_obs_coalesce),
     };
 
-    EMB_UNIT_TESTCALLER(gcoap_tests, NULL, NULL, fixtures);
+    EMB_UNIT_TESTCALLER(gcoap_tests, set_up, tear_down, fixtures);
 
     return (Test *)&gcoap_tests;
 }
@@ -0,0 +1,455 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "msg.h"
+#include "thread.h"
+#include "utlist.h"
+#include "xtimer.h"
+#include "net/gnrc/lwmac/hdr.h"
+#include "net/gnrc/lwmac/lwmac.h"
+#include "net/gnrc/netdev2.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/ieee802154.h"
+#include "net/netdev2/ieee802154.h"
+
+#include "unittests-constants.h"
+#include "tests-gnrc_lwmac.h"
+
+#define TEST_PAYLOAD    TEST_STRING8
+#define SENT_MAX        (8U)
+
+static const uint8_t _our_addr[] = { 0x00, 0x01 };
+static const uint8_t _other_addr[] = { 0x00, 0x02 };
+static const uint8_t _third_addr[] = { 0x00, 0x03 };
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+static netdev2_ieee802154_t _dev;
+static gnrc_netdev2_t _gnrc_netdev2;
+static gnrc_lwmac_t *const _lwmac = &_gnrc_netdev2.lwmac;
+
+/* mock device state */
+static netopt_state_t _radio_state;
+static gnrc_pktsnip_t *_rx_pkt;
+static bool _data_fails;
+static bool _data_rejected;
+static unsigned _sends;
+static uint8_t _sent_types[SENT_MAX];
+static size_t _sent_len;
+
+static int _mock_init(netdev2_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static void _mock_isr(netdev2_t *dev)
+{
+    dev->event_callback(dev, NETDEV2_EVENT_RX_COMPLETE);
+}
+
+static int _mock_get(netdev2_t *dev, netopt_t opt, void *value,
+                     size_t max_len)
+{
+    (void)dev;
+    (void)opt;
+    (void)value;
+    (void)max_len;
+    return -ENOTSUP;
+}
+
+static int _mock_set(netdev2_t *dev, netopt_t opt, void *value,
+                     size_t value_len)
+{
+    (void)dev;
+    if (opt == NETOPT_STATE) {
+        _radio_state = *((netopt_state_t *)value);
+    }
+    return (int)value_len;
+}
+
+static const netdev2_driver_t _mock_driver = {
+    .init = _mock_init,
+    .isr = _mock_isr,
+    .get = _mock_get,
+    .set = _mock_set,
+};
+
+static int _mock_send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
+{
+    uint8_t type = *((uint8_t *)pkt->next->data);
+    bool is_data;
+    int res;
+
+    (void)gnrc_netdev2;
+    if (_sends < SENT_MAX) {
+        _sent_types[_sends] = type;
+    }
+    _sends++;
+    _sent_len = gnrc_pkt_len(pkt->next);
+    is_data = (type == GNRC_LWMAC_FRAMETYPE_DATA) ||
+              (type == GNRC_LWMAC_FRAMETYPE_DATA_PENDING);
+    if (_data_rejected && is_data) {
+        /* like a malformed packet, rejected without releasing it */
+        return -EBADMSG;
+    }
+    if (_data_fails && is_data) {
+        res = -EIO;
+    }
+    else {
+        res = (int)_sent_len;
+    }
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+
+static gnrc_pktsnip_t *_mock_recv(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_pktsnip_t *pkt = _rx_pkt;
+
+    (void)gnrc_netdev2;
+    _rx_pkt = NULL;
+    return pkt;
+}
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    if (_pid == KERNEL_PID_UNDEF) {
+        _dev.netdev.driver = &_mock_driver;
+        memcpy(_dev.short_addr, _our_addr, sizeof(_our_addr));
+        _gnrc_netdev2.dev = (netdev2_t *)&_dev;
+        _gnrc_netdev2.send = _mock_send;
+        _gnrc_netdev2.recv = _mock_recv;
+        _pid = gnrc_lwmac_init(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                               "lwmac", &_gnrc_netdev2);
+    }
+    /* the thread only runs on messages, so it can be reset from here */
+    memset(&_gnrc_netdev2.tx, 0, sizeof(_gnrc_netdev2.tx));
+    memset(&_gnrc_netdev2.rx, 0, sizeof(_gnrc_netdev2.rx));
+    memset(_lwmac->bcast_seen, 0, sizeof(_lwmac->bcast_seen));
+    _lwmac->bcast_seen_next = 0;
+    _lwmac->state = GNRC_LWMAC_SLEEPING;
+    _lwmac->radio_on = false;
+    _lwmac->tx_retries = 0;
+    _radio_state = NETOPT_STATE_SLEEP;
+    _rx_pkt = NULL;
+    _data_fails = false;
+    _data_rejected = false;
+    _sends = 0;
+    _sent_len = 0;
+}
+
+static void tear_down(void)
+{
+    /* no timer may expire during the following tests */
+    xtimer_remove(&_lwmac->timer);
+    xtimer_remove(&_lwmac->wakeup_timer);
+}
+
+static void _msg(uint16_t type, uint32_t value)
+{
+    msg_t msg;
+
+    msg.type = type;
+    msg.content.value = value;
+    msg_send(&msg, _pid);
+}
+
+/* delivers the message of the last armed timer */
+static void _fire(void)
+{
+    _msg(GNRC_LWMAC_MSG_TYPE_TIMEOUT, _lwmac->timer_gen);
+}
+
+static void _wakeup(void)
+{
+    _msg(GNRC_LWMAC_MSG_TYPE_WAKEUP, 0);
+}
+
+/* queues a packet to dst, a broadcast if dst is NULL */
+static void _send(const uint8_t *dst)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+    msg_t msg;
+
+    pkt = gnrc_pktbuf_add(NULL, TEST_PAYLOAD, sizeof(TEST_PAYLOAD),
+                          GNRC_NETTYPE_UNDEF);
+    netif = gnrc_netif_hdr_build(NULL, 0, (uint8_t *)dst,
+                                 (dst != NULL) ? sizeof(_other_addr) : 0);
+    if (dst == NULL) {
+        ((gnrc_netif_hdr_t *)netif->data)->flags |= GNRC_NETIF_HDR_FLAGS_BROADCAST;
+    }
+    netif->next = pkt;
+    msg.type = GNRC_NETAPI_MSG_TYPE_SND;
+    msg.content.ptr = netif;
+    msg_send(&msg, _pid);
+}
+
+static void _recv(const uint8_t *src, const uint8_t *dst, size_t dst_len,
+                  void *frame, size_t frame_len)
+{
+    gnrc_pktsnip_t *netif;
+
+    _rx_pkt = gnrc_pktbuf_add(NULL, frame, frame_len, GNRC_NETTYPE_UNDEF);
+    netif = gnrc_netif_hdr_build((uint8_t *)src, sizeof(_other_addr),
+                                 (uint8_t *)dst, dst_len);
+    LL_APPEND(_rx_pkt, netif);
+    _msg(NETDEV2_MSG_TYPE_EVENT, 0);
+}
+
+static void _recv_wr(const uint8_t *src, const uint8_t *dst)
+{
+    gnrc_lwmac_hdr_t wr = { GNRC_LWMAC_FRAMETYPE_WR };
+
+    _recv(src, dst, sizeof(_our_addr), &wr, sizeof(wr));
+}
+
+static void _recv_wa(const uint8_t *src)
+{
+    gnrc_lwmac_frame_wa_t wa = {
+        { GNRC_LWMAC_FRAMETYPE_WA }, byteorder_htonl(TEST_UINT16)
+    };
+
+    _recv(src, _our_addr, sizeof(_our_addr), &wa, sizeof(wa));
+}
+
+static void _recv_data(uint8_t type, uint8_t seq_nr)
+{
+    uint8_t frame[sizeof(gnrc_lwmac_frame_broadcast_t) + sizeof(TEST_PAYLOAD)];
+    size_t hdr_len;
+
+    frame[0] = type;
+    if (type == GNRC_LWMAC_FRAMETYPE_BROADCAST) {
+        frame[1] = seq_nr;
+        hdr_len = sizeof(gnrc_lwmac_frame_broadcast_t);
+        memcpy(&frame[hdr_len], TEST_PAYLOAD, sizeof(TEST_PAYLOAD));
+        _recv(_other_addr, ieee802154_addr_bcast, IEEE802154_ADDR_BCAST_LEN,
+              frame, hdr_len + sizeof(TEST_PAYLOAD));
+    }
+    else {
+        hdr_len = sizeof(gnrc_lwmac_hdr_t);
+        memcpy(&frame[hdr_len], TEST_PAYLOAD, sizeof(TEST_PAYLOAD));
+        _recv(_other_addr, _our_addr, sizeof(_our_addr), frame,
+              hdr_len + sizeof(TEST_PAYLOAD));
+    }
+}
+
+static unsigned _rx_queued(void)
+{
+    return gnrc_priority_pktqueue_length(&_gnrc_netdev2.rx.queue);
+}
+
+static void test_wakeup__listen(void)
+{
+    _wakeup();
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_LISTENING, _lwmac->state);
+    TEST_ASSERT_EQUAL_INT(NETOPT_STATE_IDLE, _radio_state);
+    _fire();
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_SLEEPING, _lwmac->state);
+    TEST_ASSERT_EQUAL_INT(NETOPT_STATE_SLEEP, _radio_state);
+    TEST_ASSERT_EQUAL_INT(0, _sends);
+}
+
+static void test_wr__receive(void)
+{
+    uint16_t gen;
+
+    _wakeup();
+    gen = _lwmac->timer_gen;
+    /* wake-up request to another node */
+    _recv_wr(_other_addr, _third_addr);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_LISTENING, _lwmac->state);
+    TEST_ASSERT_EQUAL_INT(0, _sends);
+    _recv_wr(_other_addr, _our_addr);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_RECEIVING, _lwmac->state);
+    TEST_ASSERT_EQUAL_INT(1, _sends);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_FRAMETYPE_WA, _sent_types[0]);
+    /* the listening timer's message arrives after the data timer was armed */
+    _msg(GNRC_LWMAC_MSG_TYPE_TIMEOUT, gen);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_RECEIVING, _lwmac->state);
+    _recv_data(GNRC_LWMAC_FRAMETYPE_DATA_PENDING, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_RECEIVING, _lwmac->state);
+    /* received packets are passed up only when the radio is off */
+    TEST_ASSERT_EQUAL_INT(1, _rx_queued());
+    _recv_data(GNRC_LWMAC_FRAMETYPE_DATA, 0);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_SLEEPING, _lwmac->state);
+    TEST_ASSERT_EQUAL_INT(NETOPT_STATE_SLEEP, _radio_state);
+    TEST_ASSERT_EQUAL_INT(0, _rx_queued());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_tx__retries_exhausted(void)
+{
+    _send(_other_addr);
+    /* the phase is unknown, wake-up requests start at once */
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_TX_WR, _lwmac->state);
+    TEST_ASSERT_EQUAL_INT(NETOPT_STATE_IDLE, _radio_state);
+    TEST_ASSERT_EQUAL_INT(1, _sends);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_FRAMETYPE_WR, _sent_types[0]);
+    _fire();
+    TEST_ASSERT_EQUAL_INT(2, _sends);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_FRAMETYPE_WR, _sent_types[1]);
+    for (unsigned i = 1; i <= GNRC_LWMAC_MAX_TX_RETRIES; i++) {
+        /* no answer until the deadline */
+        _lwmac->deadline = xtimer_now_usec();
+        _fire();
+        TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_SLEEPING, _lwmac->state);
+        if (i < GNRC_LWMAC_MAX_TX_RETRIES) {
+            TEST_ASSERT_EQUAL_INT(i, _lwmac->tx_retries);
+            TEST_ASSERT_NOT_NULL(_gnrc_netdev2.tx.packet);
+            /* the next attempt follows the own wake-up */
+            _wakeup();
+            _fire();
+            TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_TX_WR, _lwmac->state);
+        }
+    }
+    TEST_ASSERT_NULL(_gnrc_netdev2.tx.packet);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_tx__burst(void)
+{
+    _send(_other_addr);
+    _send(_other_addr);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_TX_WR, _lwmac->state);
+    /* wake-up answer of another node */
+    _recv_wa(_third_addr);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_TX_WR, _lwmac->state);
+    TEST_ASSERT_EQUAL_INT(1, _sends);
+    _recv_wa(_other_addr);
+    TEST_ASSERT_EQUAL_INT(3, _sends);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_FRAMETYPE_DATA_PENDING, _sent_types[1]);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_FRAMETYPE_DATA, _sent_types[2]);
+    TEST_ASSERT_EQUAL_INT(sizeof(gnrc_lwmac_hdr_t) + sizeof(TEST_PAYLOAD),
+                          _sent_len);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_SLEEPING, _lwmac->state);
+    TEST_ASSERT_EQUAL_INT(NETOPT_STATE_SLEEP, _radio_state);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+    /* with the phase known the radio stays off until the neighbor wakes up */
+    _send(_other_addr);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_TX_WAIT_PHASE, _lwmac->state);
+    TEST_ASSERT_EQUAL_INT(NETOPT_STATE_SLEEP, _radio_state);
+    TEST_ASSERT_EQUAL_INT(3, _sends);
+    _fire();
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_TX_WR, _lwmac->state);
+    TEST_ASSERT_EQUAL_INT(4, _sends);
+    _recv_wa(_other_addr);
+    TEST_ASSERT_EQUAL_INT(5, _sends);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_FRAMETYPE_DATA, _sent_types[4]);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_tx__send_failure(void)
+{
+    _send(_other_addr);
+    _data_fails = true;
+    _recv_wa(_other_addr);
+    TEST_ASSERT_EQUAL_INT(2, _sends);
+    /* the packet is kept for the neighbor's next wake-up */
+    TEST_ASSERT_NOT_NULL(_gnrc_netdev2.tx.packet);
+    TEST_ASSERT_EQUAL_INT(1, _lwmac->tx_retries);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_TX_WAIT_PHASE, _lwmac->state);
+    _data_fails = false;
+    _fire();
+    _recv_wa(_other_addr);
+    TEST_ASSERT_EQUAL_INT(4, _sends);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_FRAMETYPE_DATA, _sent_types[3]);
+    /* with a single LWMAC header */
+    TEST_ASSERT_EQUAL_INT(sizeof(gnrc_lwmac_hdr_t) + sizeof(TEST_PAYLOAD),
+                          _sent_len);
+    TEST_ASSERT_NULL(_gnrc_netdev2.tx.packet);
+    TEST_ASSERT_EQUAL_INT(0, _lwmac->tx_retries);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_tx__send_rejected(void)
+{
+    _send(_other_addr);
+    _data_rejected = true;
+    _recv_wa(_other_addr);
+    TEST_ASSERT_EQUAL_INT(2, _sends);
+    TEST_ASSERT_NOT_NULL(_gnrc_netdev2.tx.packet);
+    TEST_ASSERT_EQUAL_INT(1, _lwmac->tx_retries);
+    _data_rejected = false;
+    _fire();
+    _recv_wa(_other_addr);
+    TEST_ASSERT_EQUAL_INT(4, _sends);
+    TEST_ASSERT_EQUAL_INT(sizeof(gnrc_lwmac_hdr_t) + sizeof(TEST_PAYLOAD),
+                          _sent_len);
+    TEST_ASSERT_NULL(_gnrc_netdev2.tx.packet);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_tx__broadcast(void)
+{
+    _send(NULL);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_TX_BROADCAST, _lwmac->state);
+    TEST_ASSERT_EQUAL_INT(NETOPT_STATE_IDLE, _radio_state);
+    TEST_ASSERT_EQUAL_INT(1, _sends);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_FRAMETYPE_BROADCAST, _sent_types[0]);
+    _fire();
+    TEST_ASSERT_EQUAL_INT(2, _sends);
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_FRAMETYPE_BROADCAST, _sent_types[1]);
+    _lwmac->deadline = xtimer_now_usec();
+    _fire();
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_SLEEPING, _lwmac->state);
+    TEST_ASSERT_EQUAL_INT(2, _sends);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rx__broadcast_repetitions(void)
+{
+    _wakeup();
+    _recv_data(GNRC_LWMAC_FRAMETYPE_BROADCAST, TEST_UINT8);
+    TEST_ASSERT_EQUAL_INT(1, _rx_queued());
+    _recv_data(GNRC_LWMAC_FRAMETYPE_BROADCAST, TEST_UINT8);
+    TEST_ASSERT_EQUAL_INT(1, _rx_queued());
+    _recv_data(GNRC_LWMAC_FRAMETYPE_BROADCAST, TEST_UINT8 + 1);
+    TEST_ASSERT_EQUAL_INT(2, _rx_queued());
+    _fire();
+    TEST_ASSERT_EQUAL_INT(GNRC_LWMAC_SLEEPING, _lwmac->state);
+    TEST_ASSERT_EQUAL_INT(0, _rx_queued());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+Test *tests_gnrc_lwmac_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_wakeup__listen),
+        new_TestFixture(test_wr__receive),
+        new_TestFixture(test_tx__retries_exhausted),
+        new_TestFixture(test_tx__burst),
+        new_TestFixture(test_tx__send_failure),
+        new_TestFixture(test_tx__send_rejected),
+        new_TestFixture(test_tx__broadcast),
+        new_TestFixture(test_rx__broadcast_repetitions),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_lwmac_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_lwmac_tests;
+}
+
+void tests_gnrc_lwmac(void)
+{
+    TESTS_RUN(tests_gnrc_lwmac_tests());
+}
+/** @} */
@@ -0,0 +1,325 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "net/csma_sender.h"
+#include "net/gnrc/netdev2.h"
+#include "net/gnrc/netdev2/ieee802154_tx.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/ieee802154.h"
+#include "net/netdev2/ieee802154.h"
+#include "thread.h"
+
+#include "unittests-constants.h"
+#include "tests-gnrc_netdev2_ieee802154_tx.h"
+
+#define TEST_PAN        (0x1234)
+#define TEST_SEQ        (TEST_UINT8)
+#define SENT_MAX        (IEEE802154_FRAME_LEN_MAX)
+
+static const uint8_t _our_addr[] = { 0x00, 0x01 };
+static const uint8_t _other_addr[] = { 0x00, 0x02 };
+
+static netdev2_ieee802154_t _dev;
+static gnrc_netdev2_t _gnrc_netdev2;
+
+/* mock device state */
+static netopt_enable_t _clear;
+static unsigned _ccas;
+static unsigned _sends;
+static uint8_t _sent[SENT_MAX];
+static size_t _sent_len;
+static unsigned _events;
+static netdev2_event_t _last_event;
+
+static int _mock_send(netdev2_t *dev, const struct iovec *vector,
+                      unsigned count)
+{
+    (void)dev;
+    _sent_len = 0;
+    for (unsigned i = 0; i < count; i++) {
+        if ((_sent_len + vector[i].iov_len) <= SENT_MAX) {
+            memcpy(&_sent[_sent_len], vector[i].iov_base, vector[i].iov_len);
+        }
+        _sent_len += vector[i].iov_len;
+    }
+    _sends++;
+    return (int)_sent_len;
+}
+
+static int _mock_get(netdev2_t *dev, netopt_t opt, void *value,
+                     size_t max_len)
+{
+    (void)dev;
+    (void)max_len;
+    switch (opt) {
+        case NETOPT_IS_CHANNEL_CLR:
+            _ccas++;
+            *((netopt_enable_t *)value) = _clear;
+            return sizeof(netopt_enable_t);
+        case NETOPT_AUTOACK:
+            /* no CSMA/CA, retransmissions or ACKs in hardware */
+            *((netopt_enable_t *)value) = NETOPT_DISABLE;
+            return sizeof(netopt_enable_t);
+        default:
+            return -ENOTSUP;
+    }
+}
+
+static const netdev2_driver_t _mock_driver = {
+    .send = _mock_send,
+    .get = _mock_get,
+};
+
+static void _event_cb(netdev2_t *dev, netdev2_event_t event)
+{
+    (void)dev;
+    _events++;
+    _last_event = event;
+}
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    memset(&_dev, 0, sizeof(_dev));
+    memset(&_gnrc_netdev2, 0, sizeof(_gnrc_netdev2));
+    _dev.netdev.driver = &_mock_driver;
+    _dev.netdev.event_callback = _event_cb;
+    _dev.pan = TEST_PAN;
+    memcpy(_dev.short_addr, _our_addr, sizeof(_our_addr));
+    _gnrc_netdev2.dev = (netdev2_t *)&_dev;
+    _gnrc_netdev2.pid = thread_getpid();
+    _clear = NETOPT_ENABLE;
+    _ccas = 0;
+    _sends = 0;
+    _sent_len = 0;
+    _events = 0;
+}
+
+static void tear_down(void)
+{
+    xtimer_remove(&_gnrc_netdev2.ieee802154_tx.timer);
+}
+
+/* queues a data frame to _other_addr */
+static int _send(uint8_t flags, uint8_t seq)
+{
+    const le_uint16_t pan = byteorder_btols(byteorder_htons(TEST_PAN));
+    uint8_t mhr[IEEE802154_MAX_HDR_LEN];
+    gnrc_pktsnip_t *pkt, *vec;
+    struct iovec *vector;
+    size_t mhr_len, n;
+
+    mhr_len = ieee802154_set_frame_hdr(mhr, _our_addr, sizeof(_our_addr),
+                                       _other_addr, sizeof(_other_addr),
+                                       pan, pan,
+                                       IEEE802154_FCF_TYPE_DATA | flags, seq);
+    pkt = gnrc_pktbuf_add(NULL, TEST_STRING8, sizeof(TEST_STRING8),
+                          GNRC_NETTYPE_UNDEF);
+    /* placeholder for the MAC header, as the netif header on sending */
+    pkt = gnrc_pktbuf_add(pkt, NULL, mhr_len, GNRC_NETTYPE_UNDEF);
+    vec = gnrc_pktbuf_get_iovec(pkt, &n);
+    vector = vec->data;
+    vector[0].iov_base = mhr;
+    vector[0].iov_len = mhr_len;
+    return gnrc_netdev2_ieee802154_tx_send(&_gnrc_netdev2, vec);
+}
+
+/* delivers the message of the last armed timer */
+static void _fire(void)
+{
+    msg_t msg;
+
+    msg.type = GNRC_NETDEV2_IEEE802154_TX_MSG_TYPE;
+    msg.content.value = _gnrc_netdev2.ieee802154_tx.timer_gen;
+    gnrc_netdev2_ieee802154_tx_timeout(&_gnrc_netdev2, &msg);
+}
+
+static bool _recv_ack(uint8_t seq)
+{
+    const uint8_t ack[] = { IEEE802154_FCF_TYPE_ACK, 0, seq };
+
+    return gnrc_netdev2_ieee802154_tx_recv(&_gnrc_netdev2, ack, sizeof(ack));
+}
+
+static void test_tx_send__no_ack_req(void)
+{
+    TEST_ASSERT(_send(0, TEST_SEQ) > 0);
+    /* nothing is sent before the first backoff */
+    TEST_ASSERT_EQUAL_INT(0, _sends);
+    _fire();
+    TEST_ASSERT_EQUAL_INT(1, _ccas);
+    TEST_ASSERT_EQUAL_INT(1, _sends);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ, ieee802154_get_seq(_sent));
+    TEST_ASSERT_EQUAL_INT(1, _events);
+    TEST_ASSERT_EQUAL_INT(NETDEV2_EVENT_TX_COMPLETE, _last_event);
+    TEST_ASSERT_EQUAL_INT(0, _gnrc_netdev2.ieee802154_tx.len);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_tx_send__queue_full(void)
+{
+    for (unsigned i = 0; i < GNRC_NETDEV2_IEEE802154_TX_QUEUE_SIZE; i++) {
+        TEST_ASSERT(_send(0, TEST_SEQ + i) > 0);
+    }
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, _send(0, TEST_SEQ));
+    /* frames are sent in order, one per backoff */
+    for (unsigned i = 0; i < GNRC_NETDEV2_IEEE802154_TX_QUEUE_SIZE; i++) {
+        TEST_ASSERT_EQUAL_INT(i, _events);
+        _fire();
+        TEST_ASSERT_EQUAL_INT(i + 1, _sends);
+        TEST_ASSERT_EQUAL_INT((uint8_t)(TEST_SEQ + i), ieee802154_get_seq(_sent));
+        TEST_ASSERT_EQUAL_INT(NETDEV2_EVENT_TX_COMPLETE, _last_event);
+    }
+    TEST_ASSERT_EQUAL_INT(GNRC_NETDEV2_IEEE802154_TX_QUEUE_SIZE, _events);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_tx_timeout__backoff_exhaustion(void)
+{
+    const csma_sender_conf_t *conf = &CSMA_SENDER_CONF_DEFAULT;
+
+    _clear = NETOPT_DISABLE;
+    TEST_ASSERT(_send(0, TEST_SEQ) > 0);
+    for (unsigned i = 0; i < conf->max_backoffs; i++) {
+        _fire();
+        TEST_ASSERT_EQUAL_INT(i + 1, _ccas);
+        TEST_ASSERT_EQUAL_INT(0, _events);
+        TEST_ASSERT(_gnrc_netdev2.ieee802154_tx.be <= conf->max_be);
+    }
+    _fire();
+    TEST_ASSERT_EQUAL_INT(conf->max_backoffs + 1, _ccas);
+    TEST_ASSERT_EQUAL_INT(0, _sends);
+    TEST_ASSERT_EQUAL_INT(1, _events);
+    TEST_ASSERT_EQUAL_INT(NETDEV2_EVENT_TX_MEDIUM_BUSY, _last_event);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_tx_timeout__ack_retrans(void)
+{
+    TEST_ASSERT(_send(IEEE802154_FCF_ACK_REQ, TEST_SEQ) > 0);
+    _fire();
+    TEST_ASSERT_EQUAL_INT(1, _sends);
+    for (unsigned i = 0; i < GNRC_NETDEV2_IEEE802154_TX_MAX_RETRANS; i++) {
+        /* ACK timeout starts a new attempt with CSMA/CA */
+        _fire();
+        TEST_ASSERT_EQUAL_INT(i + 1, _sends);
+        TEST_ASSERT_EQUAL_INT(0, _events);
+        _fire();
+        TEST_ASSERT_EQUAL_INT(i + 2, _sends);
+        TEST_ASSERT_EQUAL_INT(TEST_SEQ, ieee802154_get_seq(_sent));
+    }
+    _fire();
+    TEST_ASSERT_EQUAL_INT(GNRC_NETDEV2_IEEE802154_TX_MAX_RETRANS + 1, _sends);
+    TEST_ASSERT_EQUAL_INT(1, _events);
+    TEST_ASSERT_EQUAL_INT(NETDEV2_EVENT_TX_NOACK, _last_event);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_tx_timeout__stale(void)
+{
+    msg_t msg;
+
+    TEST_ASSERT(_send(IEEE802154_FCF_ACK_REQ, TEST_SEQ) > 0);
+    msg.type = GNRC_NETDEV2_IEEE802154_TX_MSG_TYPE;
+    msg.content.value = _gnrc_netdev2.ieee802154_tx.timer_gen;
+    _fire();
+    TEST_ASSERT_EQUAL_INT(1, _sends);
+    /* the backoff timer's message arrives after the ACK timer was armed */
+    gnrc_netdev2_ieee802154_tx_timeout(&_gnrc_netdev2, &msg);
+    TEST_ASSERT_EQUAL_INT(1, _sends);
+    TEST_ASSERT_EQUAL_INT(0, _events);
+    TEST_ASSERT(_recv_ack(TEST_SEQ));
+    TEST_ASSERT_EQUAL_INT(1, _events);
+}
+
+static void test_tx_recv__ack_seq(void)
+{
+    TEST_ASSERT(_send(IEEE802154_FCF_ACK_REQ, TEST_SEQ) > 0);
+    /* ACK before the frame was sent */
+    TEST_ASSERT(_recv_ack(TEST_SEQ));
+    TEST_ASSERT_EQUAL_INT(0, _events);
+    _fire();
+    TEST_ASSERT_EQUAL_INT(1, _sends);
+    /* ACK of another frame */
+    TEST_ASSERT(_recv_ack(TEST_SEQ + 1));
+    TEST_ASSERT_EQUAL_INT(0, _events);
+    TEST_ASSERT(_recv_ack(TEST_SEQ));
+    TEST_ASSERT_EQUAL_INT(1, _events);
+    TEST_ASSERT_EQUAL_INT(NETDEV2_EVENT_TX_COMPLETE, _last_event);
+    TEST_ASSERT_EQUAL_INT(1, _sends);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_tx_recv__send_ack(void)
+{
+    const le_uint16_t pan = byteorder_btols(byteorder_htons(TEST_PAN));
+    uint8_t frame[IEEE802154_MAX_HDR_LEN];
+    size_t len;
+
+    /* unicast to us */
+    len = ieee802154_set_frame_hdr(frame, _other_addr, sizeof(_other_addr),
+                                   _our_addr, sizeof(_our_addr), pan, pan,
+                                   IEEE802154_FCF_TYPE_DATA |
+                                   IEEE802154_FCF_ACK_REQ, TEST_SEQ);
+    TEST_ASSERT(!gnrc_netdev2_ieee802154_tx_recv(&_gnrc_netdev2, frame, len));
+    TEST_ASSERT_EQUAL_INT(1, _sends);
+    TEST_ASSERT_EQUAL_INT(3, _sent_len);
+    TEST_ASSERT_EQUAL_INT(IEEE802154_FCF_TYPE_ACK,
+                          _sent[0] & IEEE802154_FCF_TYPE_MASK);
+    TEST_ASSERT_EQUAL_INT(TEST_SEQ, _sent[2]);
+    /* unicast to another node */
+    len = ieee802154_set_frame_hdr(frame, _our_addr, sizeof(_our_addr),
+                                   _other_addr, sizeof(_other_addr), pan, pan,
+                                   IEEE802154_FCF_TYPE_DATA |
+                                   IEEE802154_FCF_ACK_REQ, TEST_SEQ);
+    TEST_ASSERT(!gnrc_netdev2_ieee802154_tx_recv(&_gnrc_netdev2, frame, len));
+    /* broadcast */
+    len = ieee802154_set_frame_hdr(frame, _other_addr, sizeof(_other_addr),
+                                   ieee802154_addr_bcast,
+                                   IEEE802154_ADDR_BCAST_LEN, pan, pan,
+                                   IEEE802154_FCF_TYPE_DATA |
+                                   IEEE802154_FCF_ACK_REQ, TEST_SEQ);
+    TEST_ASSERT(!gnrc_netdev2_ieee802154_tx_recv(&_gnrc_netdev2, frame, len));
+    TEST_ASSERT_EQUAL_INT(1, _sends);
+    TEST_ASSERT_EQUAL_INT(0, _events);
+}
+
+Test *tests_gnrc_netdev2_ieee802154_tx_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tx_send__no_ack_req),
+        new_TestFixture(test_tx_send__queue_full),
+        new_TestFixture(test_tx_timeout__backoff_exhaustion),
+        new_TestFixture(test_tx_timeout__ack_retrans),
+        new_TestFixture(test_tx_timeout__stale),
+        new_TestFixture(test_tx_recv__ack_seq),
+        new_TestFixture(test_tx_recv__send_ack),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_netdev2_ieee802154_tx_tests, set_up, tear_down,
+                        fixtures);
+
+    return (Test *)&gnrc_netdev2_ieee802154_tx_tests;
+}
+
+void tests_gnrc_netdev2_ieee802154_tx(void)
+{
+    TESTS_RUN(tests_gnrc_netdev2_ieee802154_tx_tests());
+}
+/** @} */
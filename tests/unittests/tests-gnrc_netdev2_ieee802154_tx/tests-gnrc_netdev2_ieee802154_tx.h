@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the IEEE 802.15.4 software TX engine
+ *
+ * @author      agent <agent@local>
+ */
+#ifndef TESTS_GNRC_NETDEV2_IEEE802154_TX_H
+#define TESTS_GNRC_NETDEV2_IEEE802154_TX_H
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Entry point of the test suite
+ */
+void tests_gnrc_netdev2_ieee802154_tx(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_GNRC_NETDEV2_IEEE802154_TX_H */
+/** @} */
@@ -0,0 +1,521 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "byteorder.h"
+#include "msg.h"
+#include "thread.h"
+#include "utlist.h"
+#include "xtimer.h"
+#include "net/gnrc/netdev2.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tsch/hdr.h"
+#include "net/gnrc/tsch/tsch.h"
+#include "net/ieee802154.h"
+#include "net/netdev2/ieee802154.h"
+
+#include "unittests-constants.h"
+#include "tests-gnrc_tsch.h"
+
+#define TEST_PAYLOAD    TEST_STRING8
+#define TEST_EB_ASN     (0x0102030405ULL)
+#define TEST_CORRECTION (150)
+#define SENT_MAX        (sizeof(gnrc_tsch_frame_eb_t))
+
+/* air time of an EB of _other_addr: MAC header with the broadcast address,
+ * FCS, and synchronization and PHY header */
+#define EB_AIRTIME      ((5U + IEEE802154_ADDR_BCAST_LEN + sizeof(_other_addr) + \
+                          sizeof(gnrc_tsch_frame_eb_t) + IEEE802154_FCS_LEN + \
+                          6U) * GNRC_TSCH_BYTE_US)
+
+static const uint8_t _our_addr[] = { 0x00, 0x01 };
+static const uint8_t _other_addr[] = { 0x00, 0x02 };
+static const uint8_t _third_addr[] = { 0x00, 0x03 };
+static const uint8_t _hopping[] = GNRC_TSCH_HOPPING_SEQUENCE;
+
+/* a dedicated cell to _other_addr */
+static const gnrc_tsch_cell_t _cell = {
+    .slot_offset = 1,
+    .channel_offset = 1,
+    .options = GNRC_TSCH_CELL_TX,
+    .addr = { 0x00, 0x02 },
+    .addr_len = sizeof(_other_addr),
+};
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t _pid = KERNEL_PID_UNDEF;
+static netdev2_ieee802154_t _dev;
+static gnrc_netdev2_t _gnrc_netdev2;
+static gnrc_tsch_t *const _tsch = &_gnrc_netdev2.tsch;
+
+/* mock device state */
+static netopt_state_t _radio_state;
+static uint16_t _channel;
+static gnrc_pktsnip_t *_rx_pkt;
+static unsigned _sends;
+static uint8_t _sent[SENT_MAX];
+static uint8_t _sent_dst[IEEE802154_LONG_ADDRESS_LEN];
+static size_t _sent_dst_len;
+static size_t _sent_len;
+
+static int _mock_init(netdev2_t *dev)
+{
+    (void)dev;
+    return 0;
+}
+
+static void _mock_isr(netdev2_t *dev)
+{
+    dev->event_callback(dev, NETDEV2_EVENT_RX_COMPLETE);
+}
+
+static int _mock_get(netdev2_t *dev, netopt_t opt, void *value,
+                     size_t max_len)
+{
+    (void)dev;
+    (void)opt;
+    (void)value;
+    (void)max_len;
+    return -ENOTSUP;
+}
+
+static int _mock_set(netdev2_t *dev, netopt_t opt, void *value,
+                     size_t value_len)
+{
+    (void)dev;
+    if (opt == NETOPT_STATE) {
+        _radio_state = *((netopt_state_t *)value);
+    }
+    else if (opt == NETOPT_CHANNEL) {
+        _channel = *((uint16_t *)value);
+    }
+    return (int)value_len;
+}
+
+static const netdev2_driver_t _mock_driver = {
+    .init = _mock_init,
+    .isr = _mock_isr,
+    .get = _mock_get,
+    .set = _mock_set,
+};
+
+static int _mock_send(gnrc_netdev2_t *gnrc_netdev2, gnrc_pktsnip_t *pkt)
+{
+    uint8_t *dst;
+    int res;
+
+    (void)gnrc_netdev2;
+    _sends++;
+    /* the TSCH header, data follows in its own snip */
+    memset(_sent, 0, sizeof(_sent));
+    memcpy(_sent, pkt->next->data,
+           (pkt->next->size < SENT_MAX) ? pkt->next->size : SENT_MAX);
+    _sent_dst_len = (size_t)gnrc_netif_hdr_get_dstaddr(pkt, &dst);
+    memcpy(_sent_dst, dst, _sent_dst_len);
+    _sent_len = gnrc_pkt_len(pkt->next);
+    res = (int)_sent_len;
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+
+static gnrc_pktsnip_t *_mock_recv(gnrc_netdev2_t *gnrc_netdev2)
+{
+    gnrc_pktsnip_t *pkt = _rx_pkt;
+
+    (void)gnrc_netdev2;
+    _rx_pkt = NULL;
+    return pkt;
+}
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    if (_pid == KERNEL_PID_UNDEF) {
+        _dev.netdev.driver = &_mock_driver;
+        _gnrc_netdev2.dev = (netdev2_t *)&_dev;
+        _gnrc_netdev2.send = _mock_send;
+        _gnrc_netdev2.recv = _mock_recv;
+        _pid = gnrc_tsch_init(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN - 1,
+                              "tsch", &_gnrc_netdev2);
+    }
+    /* the thread only runs on messages, so it can be reset from here: it
+     * scans with only the minimal cell in the slotframe */
+    memset(_tsch, 0, sizeof(*_tsch));
+    _tsch->cells[0].cell.options = GNRC_TSCH_CELL_TX | GNRC_TSCH_CELL_RX |
+                                   GNRC_TSCH_CELL_SHARED |
+                                   GNRC_TSCH_CELL_TIMEKEEPING;
+    _tsch->radio_on = true;
+    _radio_state = NETOPT_STATE_IDLE;
+    _channel = 0;
+    _rx_pkt = NULL;
+    _sends = 0;
+    _sent_dst_len = 0;
+    _sent_len = 0;
+}
+
+static void tear_down(void)
+{
+    /* no timer may expire during the following tests */
+    xtimer_remove(&_tsch->timer);
+}
+
+static void _msg(uint16_t type, uint32_t value)
+{
+    msg_t msg;
+
+    msg.type = type;
+    msg.content.value = value;
+    msg_send(&msg, _pid);
+}
+
+/* delivers the message of the last armed timer */
+static void _fire(void)
+{
+    _msg(GNRC_TSCH_MSG_TYPE_TIMER, _tsch->timer_gen);
+}
+
+/* delivers timeouts until the next frame is sent */
+static void _fire_until_sent(void)
+{
+    unsigned sends = _sends;
+
+    /* a slot takes at most three timeouts */
+    for (unsigned i = 0; (_sends == sends) && (i < (3 * GNRC_TSCH_CELLS_NUMOF));
+         i++) {
+        _fire();
+    }
+}
+
+static void _send(const uint8_t *dst)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+    msg_t msg;
+
+    pkt = gnrc_pktbuf_add(NULL, TEST_PAYLOAD, sizeof(TEST_PAYLOAD),
+                          GNRC_NETTYPE_UNDEF);
+    netif = gnrc_netif_hdr_build(NULL, 0, (uint8_t *)dst, sizeof(_other_addr));
+    netif->next = pkt;
+    msg.type = GNRC_NETAPI_MSG_TYPE_SND;
+    msg.content.ptr = netif;
+    msg_send(&msg, _pid);
+}
+
+static void _recv(const uint8_t *src, const uint8_t *dst, size_t dst_len,
+                  void *frame, size_t frame_len)
+{
+    gnrc_pktsnip_t *netif;
+
+    _rx_pkt = gnrc_pktbuf_add(NULL, frame, frame_len, GNRC_NETTYPE_UNDEF);
+    netif = gnrc_netif_hdr_build((uint8_t *)src, sizeof(_other_addr),
+                                 (uint8_t *)dst, dst_len);
+    LL_APPEND(_rx_pkt, netif);
+    _msg(NETDEV2_MSG_TYPE_EVENT, 0);
+}
+
+static void _recv_eb(const uint8_t *src, uint8_t join_priority)
+{
+    gnrc_tsch_frame_eb_t eb = {
+        { GNRC_TSCH_FRAMETYPE_EB }, { 0x01, 0x02, 0x03, 0x04, 0x05 },
+        join_priority
+    };
+
+    _recv(src, ieee802154_addr_bcast, IEEE802154_ADDR_BCAST_LEN,
+          &eb, sizeof(eb));
+}
+
+static void _recv_data(const uint8_t *src, uint8_t seq)
+{
+    uint8_t frame[sizeof(gnrc_tsch_frame_data_t) + sizeof(TEST_PAYLOAD)];
+
+    frame[0] = GNRC_TSCH_FRAMETYPE_DATA;
+    frame[1] = seq;
+    memcpy(&frame[sizeof(gnrc_tsch_frame_data_t)], TEST_PAYLOAD,
+           sizeof(TEST_PAYLOAD));
+    _recv(src, _our_addr, sizeof(_our_addr), frame, sizeof(frame));
+}
+
+static void _recv_ack(const uint8_t *src, uint8_t seq, int16_t correction)
+{
+    gnrc_tsch_frame_ack_t ack = {
+        { GNRC_TSCH_FRAMETYPE_ACK }, seq, byteorder_htons((uint16_t)correction)
+    };
+
+    _recv(src, _our_addr, sizeof(_our_addr), &ack, sizeof(ack));
+}
+
+/* joins with _other_addr as time source */
+static void _join_network(void)
+{
+    _recv_eb(_other_addr, 0);
+}
+
+static unsigned _queued(unsigned cell)
+{
+    return gnrc_priority_pktqueue_length(&_tsch->cells[cell].queue);
+}
+
+static void test_join__eb(void)
+{
+    gnrc_tsch_hdr_t too_short = { GNRC_TSCH_FRAMETYPE_EB };
+    gnrc_tsch_status_t status;
+    uint32_t before, after, sent;
+    uint64_t skipped;
+
+    _recv(_other_addr, ieee802154_addr_bcast, IEEE802154_ADDR_BCAST_LEN,
+          &too_short, sizeof(too_short));
+    TEST_ASSERT_EQUAL_INT(GNRC_TSCH_SCANNING, _tsch->role);
+    before = xtimer_now_usec();
+    _recv_eb(_other_addr, TEST_UINT8);
+    after = xtimer_now_usec();
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_status(_pid, &status));
+    TEST_ASSERT_EQUAL_INT(GNRC_TSCH_JOINED, status.role);
+    TEST_ASSERT_EQUAL_INT(TEST_UINT8 + 1, status.join_priority);
+    TEST_ASSERT_EQUAL_INT(sizeof(_other_addr), status.time_source_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_other_addr, status.time_source,
+                                    sizeof(_other_addr)));
+    /* the radio sleeps until the next slot of the minimal cell */
+    TEST_ASSERT_EQUAL_INT(NETOPT_STATE_SLEEP, _radio_state);
+    TEST_ASSERT_EQUAL_INT(0, status.asn % GNRC_TSCH_SLOTFRAME_LEN);
+    skipped = status.asn - TEST_EB_ASN;
+    TEST_ASSERT((skipped > 0) && (skipped <= GNRC_TSCH_SLOTFRAME_LEN));
+    /* the EB was sent at the TX offset of the slot given by its ASN */
+    sent = _tsch->slot_start - ((uint32_t)skipped * GNRC_TSCH_SLOT_LEN_US) +
+           GNRC_TSCH_TX_OFFSET_US;
+    TEST_ASSERT((int32_t)(sent + EB_AIRTIME - before) >= 0);
+    TEST_ASSERT((int32_t)(after - (sent + EB_AIRTIME)) >= 0);
+    /* EBs of other nodes outside of a slot change nothing */
+    _recv_eb(_third_addr, 0);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_status(_pid, &status));
+    TEST_ASSERT_EQUAL_INT(TEST_UINT8 + 1, status.join_priority);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_other_addr, status.time_source,
+                                    sizeof(_other_addr)));
+    TEST_ASSERT_EQUAL_INT(0, _sends);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_tx__ack_correction(void)
+{
+    uint32_t slot_start;
+    uint8_t seq;
+
+    _join_network();
+    _send(_other_addr);
+    TEST_ASSERT_EQUAL_INT(1, _queued(0));
+    _fire_until_sent();
+    TEST_ASSERT_EQUAL_INT(1, _sends);
+    TEST_ASSERT_EQUAL_INT(GNRC_TSCH_FRAMETYPE_DATA, _sent[0]);
+    TEST_ASSERT_EQUAL_INT(sizeof(gnrc_tsch_frame_data_t) + sizeof(TEST_PAYLOAD),
+                          _sent_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_other_addr, _sent_dst, _sent_dst_len));
+    seq = _sent[1];
+    slot_start = _tsch->slot_start;
+    /* ACKs of another frame or by another node are ignored */
+    _recv_ack(_other_addr, seq + 1, TEST_CORRECTION);
+    _recv_ack(_third_addr, seq, TEST_CORRECTION);
+    TEST_ASSERT_EQUAL_INT(1, _queued(0));
+    TEST_ASSERT_EQUAL_INT(slot_start, _tsch->slot_start);
+    /* the time source received the frame late, so the slots start later
+     * there; the next one is in the following slotframe */
+    _recv_ack(_other_addr, seq, TEST_CORRECTION);
+    TEST_ASSERT_EQUAL_INT(slot_start - TEST_CORRECTION +
+                          (GNRC_TSCH_SLOTFRAME_LEN * GNRC_TSCH_SLOT_LEN_US),
+                          _tsch->slot_start);
+    TEST_ASSERT_EQUAL_INT(NETOPT_STATE_SLEEP, _radio_state);
+    TEST_ASSERT_EQUAL_INT(0, _queued(0));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_rx__sync(void)
+{
+    gnrc_tsch_frame_ack_t *ack = (gnrc_tsch_frame_ack_t *)_sent;
+    uint32_t slot_start;
+
+    _join_network();
+    /* with nothing to send the node listens in the minimal cell */
+    _fire();
+    _fire();
+    TEST_ASSERT_EQUAL_INT(NETOPT_STATE_IDLE, _radio_state);
+    TEST_ASSERT_EQUAL_INT(0, _sends);
+    /* the frame is expected about now */
+    _tsch->slot_start = xtimer_now_usec() - GNRC_TSCH_TX_OFFSET_US;
+    slot_start = _tsch->slot_start;
+    _recv_data(_other_addr, TEST_UINT8);
+    TEST_ASSERT_EQUAL_INT(1, _sends);
+    TEST_ASSERT_EQUAL_INT(GNRC_TSCH_FRAMETYPE_ACK, ack->header.type);
+    TEST_ASSERT_EQUAL_INT(TEST_UINT8, ack->seq);
+    TEST_ASSERT_EQUAL_INT(sizeof(_other_addr), _sent_dst_len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_other_addr, _sent_dst, _sent_dst_len));
+    /* frames of the time source move the slots by the correction it gets */
+    TEST_ASSERT_EQUAL_INT(slot_start + (int16_t)byteorder_ntohs(ack->correction) +
+                          (GNRC_TSCH_SLOTFRAME_LEN * GNRC_TSCH_SLOT_LEN_US),
+                          _tsch->slot_start);
+    TEST_ASSERT_EQUAL_INT(NETOPT_STATE_SLEEP, _radio_state);
+    /* frames of other nodes are acknowledged but do not move them */
+    _fire();
+    _fire();
+    slot_start = _tsch->slot_start;
+    _recv_data(_third_addr, TEST_UINT8);
+    TEST_ASSERT_EQUAL_INT(2, _sends);
+    TEST_ASSERT_EQUAL_INT(GNRC_TSCH_FRAMETYPE_ACK, ack->header.type);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(_third_addr, _sent_dst, _sent_dst_len));
+    TEST_ASSERT_EQUAL_INT(slot_start +
+                          (GNRC_TSCH_SLOTFRAME_LEN * GNRC_TSCH_SLOT_LEN_US),
+                          _tsch->slot_start);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_tx__shared_backoff(void)
+{
+    gnrc_tsch_cell_entry_t *minimal = &_tsch->cells[0];
+    uint64_t asn;
+
+    _join_network();
+    _send(_other_addr);
+    _fire_until_sent();
+    /* no ACK */
+    _fire();
+    TEST_ASSERT_EQUAL_INT(1, minimal->retries);
+    TEST_ASSERT_EQUAL_INT(1, minimal->backoff_exp);
+    TEST_ASSERT(minimal->backoff < 2);
+    TEST_ASSERT_EQUAL_INT(1, _queued(0));
+    /* the retransmission skips as many slots of the cell as drawn */
+    minimal->backoff = 1;
+    asn = _tsch->asn;
+    _fire_until_sent();
+    TEST_ASSERT_EQUAL_INT(2, _sends);
+    TEST_ASSERT_EQUAL_INT(0, minimal->backoff);
+    TEST_ASSERT(_tsch->asn == (asn + GNRC_TSCH_SLOTFRAME_LEN));
+    /* the backoff window doubles with every failure */
+    _fire();
+    TEST_ASSERT_EQUAL_INT(2, minimal->retries);
+    TEST_ASSERT_EQUAL_INT(2, minimal->backoff_exp);
+    TEST_ASSERT(minimal->backoff < 4);
+    minimal->backoff = 0;
+    asn = _tsch->asn;
+    _fire_until_sent();
+    TEST_ASSERT_EQUAL_INT(3, _sends);
+    TEST_ASSERT(_tsch->asn == asn);
+    /* and is reset by an ACK */
+    _recv_ack(_other_addr, _sent[1], 0);
+    TEST_ASSERT_EQUAL_INT(0, minimal->retries);
+    TEST_ASSERT_EQUAL_INT(0, minimal->backoff_exp);
+    TEST_ASSERT_EQUAL_INT(0, _queued(0));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_tx__retries_exhausted(void)
+{
+    gnrc_tsch_cell_entry_t *dedicated = &_tsch->cells[1];
+    uint8_t seq = 0;
+
+    _join_network();
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_cell_add(_pid, &_cell));
+    _send(_other_addr);
+    TEST_ASSERT_EQUAL_INT(0, _queued(0));
+    TEST_ASSERT_EQUAL_INT(1, _queued(1));
+    for (unsigned i = 0; i <= GNRC_TSCH_MAX_RETRIES; i++) {
+        _fire_until_sent();
+        TEST_ASSERT_EQUAL_INT(i + 1, _sends);
+        /* in the slot and on the channel of the dedicated cell */
+        TEST_ASSERT_EQUAL_INT(_cell.slot_offset,
+                              _tsch->asn % GNRC_TSCH_SLOTFRAME_LEN);
+        TEST_ASSERT_EQUAL_INT(_hopping[(_tsch->asn + _cell.channel_offset) %
+                                       sizeof(_hopping)], _channel);
+        /* with a single TSCH header and the same sequence number */
+        TEST_ASSERT_EQUAL_INT(sizeof(gnrc_tsch_frame_data_t) +
+                              sizeof(TEST_PAYLOAD), _sent_len);
+        if (i == 0) {
+            seq = _sent[1];
+        }
+        TEST_ASSERT_EQUAL_INT(seq, _sent[1]);
+        /* no ACK */
+        _fire();
+        /* dedicated cells do not back off */
+        TEST_ASSERT_EQUAL_INT(0, dedicated->backoff_exp);
+        TEST_ASSERT_EQUAL_INT(0, dedicated->backoff);
+        if (i < GNRC_TSCH_MAX_RETRIES) {
+            TEST_ASSERT_EQUAL_INT(i + 1, dedicated->retries);
+            TEST_ASSERT_EQUAL_INT(1, _queued(1));
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(0, dedicated->retries);
+    TEST_ASSERT_EQUAL_INT(0, _queued(1));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_cell_remove__requeue(void)
+{
+    gnrc_tsch_cell_t minimal = { .options = GNRC_TSCH_CELL_TX };
+    gnrc_tsch_status_t status;
+    uint8_t seq;
+
+    _join_network();
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_cell_add(_pid, &_cell));
+    _send(_other_addr);
+    _send(_other_addr);
+    TEST_ASSERT_EQUAL_INT(2, _queued(1));
+    /* the cell is removed while the first frame waits for its ACK */
+    _fire_until_sent();
+    TEST_ASSERT_EQUAL_INT(_cell.slot_offset,
+                          _tsch->asn % GNRC_TSCH_SLOTFRAME_LEN);
+    seq = _sent[1];
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_cell_remove(_pid, &_cell));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_tsch_cell_remove(_pid, &_cell));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, gnrc_tsch_cell_remove(_pid, &minimal));
+    TEST_ASSERT_EQUAL_INT(NETOPT_STATE_SLEEP, _radio_state);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_tsch_status(_pid, &status));
+    TEST_ASSERT_EQUAL_INT(1, status.cells);
+    TEST_ASSERT_EQUAL_INT(2, status.queued);
+    TEST_ASSERT_EQUAL_INT(2, _queued(0));
+    /* the slot has ended, a late ACK is ignored */
+    _recv_ack(_other_addr, seq, 0);
+    TEST_ASSERT_EQUAL_INT(2, _queued(0));
+    /* both are sent in the minimal cell, in their order */
+    for (unsigned i = 0; i < 2; i++) {
+        _fire_until_sent();
+        TEST_ASSERT_EQUAL_INT(2 + i, _sends);
+        TEST_ASSERT_EQUAL_INT(0, _tsch->asn % GNRC_TSCH_SLOTFRAME_LEN);
+        TEST_ASSERT_EQUAL_INT((uint8_t)(seq + i), _sent[1]);
+        _recv_ack(_other_addr, _sent[1], 0);
+        TEST_ASSERT_EQUAL_INT(1 - i, _queued(0));
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+Test *tests_gnrc_tsch_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_join__eb),
+        new_TestFixture(test_tx__ack_correction),
+        new_TestFixture(test_rx__sync),
+        new_TestFixture(test_tx__shared_backoff),
+        new_TestFixture(test_tx__retries_exhausted),
+        new_TestFixture(test_cell_remove__requeue),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tsch_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_tsch_tests;
+}
+
+void tests_gnrc_tsch(void)
+{
+    TESTS_RUN(tests_gnrc_tsch_tests());
+}
+/** @} */
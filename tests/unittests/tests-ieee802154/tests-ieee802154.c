@@ -958,6 +958,93 @@ static void test_ieee802154_get_dst_dst8_pancomp(void)
     TEST_ASSERT_EQUAL_INT(exp_pan.u16, res_pan.u16);
 }
 
+static void test_ieee802154_dst_filter_dst0(void)
+{
+    const uint8_t short_addr[] = { 0x12, 0x34 };
+    const uint8_t long_addr[] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+    const uint8_t mhr[] = { IEEE802154_FCF_TYPE_DATA,
+                            IEEE802154_FCF_DST_ADDR_VOID, TEST_UINT8 };
+
+    TEST_ASSERT_EQUAL_INT(1, ieee802154_dst_filter(mhr, TEST_UINT16,
+                                                   short_addr, long_addr));
+}
+
+static void test_ieee802154_dst_filter_dst0_beacon(void)
+{
+    const uint8_t short_addr[] = { 0x12, 0x34 };
+    const uint8_t long_addr[] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+    const uint8_t mhr[] = { IEEE802154_FCF_TYPE_BEACON,
+                            IEEE802154_FCF_DST_ADDR_VOID, TEST_UINT8 };
+
+    TEST_ASSERT_EQUAL_INT(0, ieee802154_dst_filter(mhr, TEST_UINT16,
+                                                   short_addr, long_addr));
+}
+
+static void test_ieee802154_dst_filter_dst0_ack(void)
+{
+    const uint8_t short_addr[] = { 0x12, 0x34 };
+    const uint8_t long_addr[] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+    const uint8_t mhr[] = { IEEE802154_FCF_TYPE_ACK,
+                            IEEE802154_FCF_DST_ADDR_VOID, TEST_UINT8 };
+
+    TEST_ASSERT_EQUAL_INT(0, ieee802154_dst_filter(mhr, TEST_UINT16,
+                                                   short_addr, long_addr));
+}
+
+static void test_ieee802154_dst_filter_dst2(void)
+{
+    const uint8_t short_addr[] = { 0x12, 0x34 };
+    const uint8_t long_addr[] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+    const le_uint16_t pan = byteorder_htols(TEST_UINT16);
+    uint8_t mhr[] = { 0, IEEE802154_FCF_DST_ADDR_SHORT, TEST_UINT8,
+                      pan.u8[0], pan.u8[1], 0x34, 0x12 };
+
+    TEST_ASSERT_EQUAL_INT(0, ieee802154_dst_filter(mhr, TEST_UINT16,
+                                                   short_addr, long_addr));
+    /* other PAN */
+    TEST_ASSERT_EQUAL_INT(1, ieee802154_dst_filter(mhr, TEST_UINT16 + 1,
+                                                   short_addr, long_addr));
+    /* other address */
+    mhr[5] = 0x35;
+    TEST_ASSERT_EQUAL_INT(1, ieee802154_dst_filter(mhr, TEST_UINT16,
+                                                   short_addr, long_addr));
+}
+
+static void test_ieee802154_dst_filter_bcast(void)
+{
+    const uint8_t short_addr[] = { 0x12, 0x34 };
+    const uint8_t long_addr[] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+    const le_uint16_t pan = byteorder_htols(TEST_UINT16);
+    uint8_t mhr[] = { 0, IEEE802154_FCF_DST_ADDR_SHORT, TEST_UINT8,
+                      pan.u8[0], pan.u8[1], 0xff, 0xff };
+
+    TEST_ASSERT_EQUAL_INT(0, ieee802154_dst_filter(mhr, TEST_UINT16,
+                                                   short_addr, long_addr));
+    TEST_ASSERT_EQUAL_INT(1, ieee802154_dst_filter(mhr, TEST_UINT16 + 1,
+                                                   short_addr, long_addr));
+    /* broadcast PAN */
+    mhr[3] = 0xff;
+    mhr[4] = 0xff;
+    TEST_ASSERT_EQUAL_INT(0, ieee802154_dst_filter(mhr, TEST_UINT16 + 1,
+                                                   short_addr, long_addr));
+}
+
+static void test_ieee802154_dst_filter_dst8(void)
+{
+    const uint8_t short_addr[] = { 0x12, 0x34 };
+    const uint8_t long_addr[] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+    const le_uint16_t pan = byteorder_htols(TEST_UINT16);
+    uint8_t mhr[] = { 0, IEEE802154_FCF_DST_ADDR_LONG, TEST_UINT8,
+                      pan.u8[0], pan.u8[1],
+                      0xef, 0xcd, 0xab, 0x89, 0x67, 0x45, 0x23, 0x01 };
+
+    TEST_ASSERT_EQUAL_INT(0, ieee802154_dst_filter(mhr, TEST_UINT16,
+                                                   short_addr, long_addr));
+    mhr[12] = 0x02;
+    TEST_ASSERT_EQUAL_INT(1, ieee802154_dst_filter(mhr, TEST_UINT16,
+                                                   short_addr, long_addr));
+}
+
 static void test_ieee802154_get_seq(void)
 {
     const uint8_t mhr[] = { 0x00, 0x00, TEST_UINT8 };
@@ -1068,6 +1155,12 @@ Test *tests_ieee802154_tests(void)
         new_TestFixture(test_ieee802154_get_dst_dst2_pancomp),
         new_TestFixture(test_ieee802154_get_dst_dst8),
         new_TestFixture(test_ieee802154_get_dst_dst8_pancomp),
+        new_TestFixture(test_ieee802154_dst_filter_dst0),
+        new_TestFixture(test_ieee802154_dst_filter_dst0_beacon),
+        new_TestFixture(test_ieee802154_dst_filter_dst0_ack),
+        new_TestFixture(test_ieee802154_dst_filter_dst2),
+        new_TestFixture(test_ieee802154_dst_filter_bcast),
+        new_TestFixture(test_ieee802154_dst_filter_dst8),
         new_TestFixture(test_ieee802154_get_seq),
         new_TestFixture(test_ieee802154_get_iid_addr_len_0),
         new_TestFixture(test_ieee802154_get_iid_addr_len_SIZE_MAX),
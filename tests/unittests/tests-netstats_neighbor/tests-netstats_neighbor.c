@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+
+#include "embUnit.h"
+
+#include "net/netstats/neighbor.h"
+
+#include "unittests-constants.h"
+#include "tests-netstats_neighbor.h"
+
+#define TEST_IFACE      (7)
+
+static const uint8_t _addr1[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01 };
+static const uint8_t _addr2[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02 };
+
+static void set_up(void)
+{
+    netstats_nb_reset();
+}
+
+static void test_netstats_nb_record__invalid_len(void)
+{
+    TEST_ASSERT_NULL(netstats_nb_record(TEST_IFACE, _addr1, 0).nb);
+    TEST_ASSERT_NULL(netstats_nb_record(TEST_IFACE, _addr1, NETSTATS_NB_L2ADDR_MAX_LEN + 1).nb);
+}
+
+static void test_netstats_nb_record__same_entry(void)
+{
+    netstats_nb_t *nb = netstats_nb_record(TEST_IFACE, _addr1, sizeof(_addr1)).nb;
+
+    TEST_ASSERT_NOT_NULL(nb);
+    TEST_ASSERT(nb == netstats_nb_record(TEST_IFACE, _addr1, sizeof(_addr1)).nb);
+    TEST_ASSERT(nb != netstats_nb_record(TEST_IFACE, _addr2, sizeof(_addr2)).nb);
+    TEST_ASSERT(nb != netstats_nb_record(TEST_IFACE + 1, _addr1, sizeof(_addr1)).nb);
+}
+
+static void test_netstats_nb_get_etx__unknown(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, netstats_nb_get_etx(TEST_IFACE, _addr1, sizeof(_addr1)));
+}
+
+static void test_netstats_nb_get_etx__init(void)
+{
+    netstats_nb_record(TEST_IFACE, _addr1, sizeof(_addr1));
+    TEST_ASSERT_EQUAL_INT(NETSTATS_NB_ETX_INIT * NETSTATS_NB_ETX_DIVISOR,
+                          netstats_nb_get_etx(TEST_IFACE, _addr1, sizeof(_addr1)));
+}
+
+static void test_netstats_nb_update_tx__success(void)
+{
+    netstats_nb_ref_t ref = netstats_nb_record(TEST_IFACE, _addr1, sizeof(_addr1));
+
+    for (unsigned i = 0; i < 100; i++) {
+        uint16_t etx = netstats_nb_get_etx(TEST_IFACE, _addr1, sizeof(_addr1));
+        netstats_nb_update_tx(&ref, NETSTATS_NB_SUCCESS);
+        TEST_ASSERT(netstats_nb_get_etx(TEST_IFACE, _addr1, sizeof(_addr1)) <= etx);
+    }
+    /* converges towards a perfect link */
+    TEST_ASSERT(netstats_nb_get_etx(TEST_IFACE, _addr1, sizeof(_addr1)) <
+                (NETSTATS_NB_ETX_DIVISOR + (NETSTATS_NB_ETX_DIVISOR / 8)));
+    TEST_ASSERT_EQUAL_INT(100, ref.nb->tx_count);
+}
+
+static void test_netstats_nb_update_tx__noack(void)
+{
+    netstats_nb_ref_t ref = netstats_nb_record(TEST_IFACE, _addr1, sizeof(_addr1));
+    uint16_t etx = netstats_nb_get_etx(TEST_IFACE, _addr1, sizeof(_addr1));
+
+    netstats_nb_update_tx(&ref, NETSTATS_NB_NOACK);
+    TEST_ASSERT(netstats_nb_get_etx(TEST_IFACE, _addr1, sizeof(_addr1)) > etx);
+    TEST_ASSERT_EQUAL_INT(1, ref.nb->tx_failed);
+}
+
+static void test_netstats_nb_update_tx__busy(void)
+{
+    netstats_nb_ref_t ref = netstats_nb_record(TEST_IFACE, _addr1, sizeof(_addr1));
+    uint16_t etx = netstats_nb_get_etx(TEST_IFACE, _addr1, sizeof(_addr1));
+
+    netstats_nb_update_tx(&ref, NETSTATS_NB_BUSY);
+    TEST_ASSERT_EQUAL_INT(etx, netstats_nb_get_etx(TEST_IFACE, _addr1, sizeof(_addr1)));
+    TEST_ASSERT_EQUAL_INT(1, ref.nb->tx_busy);
+    TEST_ASSERT_EQUAL_INT(0, ref.nb->tx_count);
+}
+
+static void test_netstats_nb_update_tx__null(void)
+{
+    netstats_nb_t nbs[NETSTATS_NB_SIZE];
+    netstats_nb_ref_t ref = { NULL, 0 };
+
+    /* multicast frames are not recorded */
+    netstats_nb_update_tx(&ref, NETSTATS_NB_SUCCESS);
+    TEST_ASSERT_EQUAL_INT(0, netstats_nb_get_all(nbs));
+}
+
+static void test_netstats_nb_record__replace_lru(void)
+{
+    uint8_t addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00 };
+    netstats_nb_t nbs[NETSTATS_NB_SIZE];
+
+    netstats_nb_record(TEST_IFACE, _addr1, sizeof(_addr1));
+    netstats_nb_record(TEST_IFACE, _addr2, sizeof(_addr2));
+    for (unsigned i = 2; i < NETSTATS_NB_SIZE; i++) {
+        addr[7] = i;
+        netstats_nb_record(TEST_IFACE, addr, sizeof(addr));
+    }
+    TEST_ASSERT_EQUAL_INT(NETSTATS_NB_SIZE, netstats_nb_get_all(nbs));
+
+    /* _addr1 is used again, so _addr2 is the least recently used one */
+    netstats_nb_record(TEST_IFACE, _addr1, sizeof(_addr1));
+    addr[7] = 0xff;
+    netstats_nb_record(TEST_IFACE, addr, sizeof(addr));
+    TEST_ASSERT_EQUAL_INT(NETSTATS_NB_SIZE, netstats_nb_get_all(nbs));
+    TEST_ASSERT(netstats_nb_get_etx(TEST_IFACE, _addr1, sizeof(_addr1)) != 0);
+    TEST_ASSERT_EQUAL_INT(0, netstats_nb_get_etx(TEST_IFACE, _addr2, sizeof(_addr2)));
+}
+
+static void test_netstats_nb_update_tx__reused(void)
+{
+    uint8_t addr[] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00 };
+    netstats_nb_ref_t ref = netstats_nb_record(TEST_IFACE, _addr1, sizeof(_addr1));
+
+    /* the entry of _addr1 is replaced while its frame is in flight */
+    for (unsigned i = 0; i < NETSTATS_NB_SIZE; i++) {
+        addr[7] = i;
+        netstats_nb_record(TEST_IFACE, addr, sizeof(addr));
+    }
+    TEST_ASSERT_EQUAL_INT(0, netstats_nb_get_etx(TEST_IFACE, _addr1, sizeof(_addr1)));
+    netstats_nb_update_tx(&ref, NETSTATS_NB_NOACK);
+    /* the outcome is not charged to the new neighbor */
+    TEST_ASSERT_EQUAL_INT(0, ref.nb->tx_failed);
+    TEST_ASSERT_EQUAL_INT(0, ref.nb->tx_count);
+}
+
+Test *tests_netstats_neighbor_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_netstats_nb_record__invalid_len),
+        new_TestFixture(test_netstats_nb_record__same_entry),
+        new_TestFixture(test_netstats_nb_get_etx__unknown),
+        new_TestFixture(test_netstats_nb_get_etx__init),
+        new_TestFixture(test_netstats_nb_update_tx__success),
+        new_TestFixture(test_netstats_nb_update_tx__noack),
+        new_TestFixture(test_netstats_nb_update_tx__busy),
+        new_TestFixture(test_netstats_nb_update_tx__null),
+        new_TestFixture(test_netstats_nb_record__replace_lru),
+        new_TestFixture(test_netstats_nb_update_tx__reused),
+    };
+
+    EMB_UNIT_TESTCALLER(netstats_neighbor_tests, set_up, NULL, fixtures);
+
+    return (Test *)&netstats_neighbor_tests;
+}
+
+void tests_netstats_neighbor(void)
+{
+    TESTS_RUN(tests_netstats_neighbor_tests());
+}
+/** @} */
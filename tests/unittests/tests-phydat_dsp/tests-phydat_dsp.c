@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "phydat_dsp.h"
+#include "tests-phydat_dsp.h"
+
+#define DATA_NUMOF      (8U)
+
+static phydat_t data[DATA_NUMOF];
+
+static void set_up(void)
+{
+    memset(data, 0, sizeof(data));
+}
+
+static void test_mavg_init_invalid(void)
+{
+    phydat_dsp_mavg_t f;
+    int16_t hist[3];
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, phydat_dsp_mavg_init(&f, hist, 0, 1));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, phydat_dsp_mavg_init(&f, hist, 3, 0));
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          phydat_dsp_mavg_init(&f, hist, 1, PHYDAT_DIM + 1));
+}
+
+static void test_mavg_split(void)
+{
+    static const int16_t exp0[] = { 0, 2, 3, 6, 9, 12, 15, 18 };
+    static const int16_t exp1[] = { 0, -1, -1, -2, -3, -4, -5, -6 };
+    phydat_dsp_mavg_t f;
+    int16_t hist[3 * 2];
+
+    TEST_ASSERT_EQUAL_INT(0, phydat_dsp_mavg_init(&f, hist, 3, 2));
+    for (unsigned i = 0; i < DATA_NUMOF; i++) {
+        data[i].val[0] = i * 3;
+        data[i].val[1] = -i;
+        data[i].val[2] = 42;
+    }
+    /* the window spans both calls */
+    phydat_dsp_mavg(&f, data, 5);
+    phydat_dsp_mavg(&f, &data[5], DATA_NUMOF - 5);
+    for (unsigned i = 0; i < DATA_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(exp0[i], data[i].val[0]);
+        TEST_ASSERT_EQUAL_INT(exp1[i], data[i].val[1]);
+        TEST_ASSERT_EQUAL_INT(42, data[i].val[2]);
+    }
+}
+
+static void test_fir_init_invalid(void)
+{
+    static const int16_t coeffs[5] = { 0 };
+    phydat_dsp_fir_t f;
+    int16_t state[PHYDAT_DSP_FIR_STATE_LEN(5)];
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, phydat_dsp_fir_init(&f, coeffs, 2, state, 1));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, phydat_dsp_fir_init(&f, coeffs, 5, state, 1));
+    TEST_ASSERT_EQUAL_INT(-EINVAL, phydat_dsp_fir_init(&f, coeffs, 4, state, 0));
+}
+
+static void test_fir_impulse(void)
+{
+    /* b[0] = 1000, b[1] = 2000, ... in time reversed order */
+    static const int16_t coeffs[] = { 4000, 3000, 2000, 1000 };
+    static const int16_t exp[] = { 999, 1999, 2999, 3999, 0, 0, 0, 0 };
+    phydat_dsp_fir_t f;
+    int16_t state[PHYDAT_DSP_FIR_STATE_LEN(4)];
+
+    TEST_ASSERT_EQUAL_INT(0, phydat_dsp_fir_init(&f, coeffs, 4, state, 1));
+    data[0].val[0] = INT16_MAX;
+    phydat_dsp_fir(&f, data, 3);
+    phydat_dsp_fir(&f, &data[3], DATA_NUMOF - 3);
+    for (unsigned i = 0; i < DATA_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(exp[i], data[i].val[0]);
+    }
+}
+
+static void test_fir_saturate(void)
+{
+    static const int16_t coeffs[] = { INT16_MAX, INT16_MAX, INT16_MAX,
+                                      INT16_MAX };
+    phydat_dsp_fir_t f;
+    int16_t state[PHYDAT_DSP_FIR_STATE_LEN(4) * 2];
+
+    TEST_ASSERT_EQUAL_INT(0, phydat_dsp_fir_init(&f, coeffs, 4, state, 2));
+    for (unsigned i = 0; i < DATA_NUMOF; i++) {
+        data[i].val[0] = INT16_MAX;
+        data[i].val[1] = INT16_MIN;
+    }
+    phydat_dsp_fir(&f, data, DATA_NUMOF);
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, data[DATA_NUMOF - 1].val[0]);
+    TEST_ASSERT_EQUAL_INT(INT16_MIN, data[DATA_NUMOF - 1].val[1]);
+}
+
+static void test_iir_lowpass(void)
+{
+    /* y[n] = 0.5 * x[n] + 0.5 * y[n-1] */
+    static const int16_t coeffs[] = { 16384, 0, 0, 0, 16384, 0 };
+    static const int16_t exp[] = { 500, 750, 875, 937, 968, 984, 992, 996 };
+    phydat_dsp_iir_t f;
+    int16_t state[PHYDAT_DSP_IIR_STATE_LEN(1)];
+
+    TEST_ASSERT_EQUAL_INT(0, phydat_dsp_iir_init(&f, coeffs, 1, 0, state, 1));
+    for (unsigned i = 0; i < DATA_NUMOF; i++) {
+        data[i].val[0] = 1000;
+    }
+    phydat_dsp_iir(&f, data, 2);
+    phydat_dsp_iir(&f, &data[2], DATA_NUMOF - 2);
+    for (unsigned i = 0; i < DATA_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(exp[i], data[i].val[0]);
+    }
+}
+
+static void test_iir_post_shift(void)
+{
+    /* y[n] = 2 * x[n], coefficient scaled by 2^-1 */
+    static const int16_t coeffs[] = { 32767, 0, 0, 0, 0, 0 };
+    phydat_dsp_iir_t f;
+    int16_t state[PHYDAT_DSP_IIR_STATE_LEN(1)];
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL,
+                          phydat_dsp_iir_init(&f, coeffs, 1, 16, state, 1));
+    TEST_ASSERT_EQUAL_INT(0, phydat_dsp_iir_init(&f, coeffs, 1, 1, state, 1));
+    data[0].val[0] = 1000;
+    data[1].val[0] = 20000;
+    phydat_dsp_iir(&f, data, 2);
+    TEST_ASSERT_EQUAL_INT(1999, data[0].val[0]);
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, data[1].val[0]);
+}
+
+static void test_decimate(void)
+{
+    phydat_dsp_decim_t d;
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, phydat_dsp_decim_init(&d, 0, 1));
+    TEST_ASSERT_EQUAL_INT(0, phydat_dsp_decim_init(&d, 3, 1));
+    for (unsigned i = 0; i < DATA_NUMOF; i++) {
+        data[i].val[0] = i;
+        data[i].unit = UNIT_G;
+        data[i].scale = -3;
+    }
+    TEST_ASSERT_EQUAL_INT(1, phydat_dsp_decimate(&d, data, 5));
+    TEST_ASSERT_EQUAL_INT(1, data[0].val[0]);
+    TEST_ASSERT_EQUAL_INT(UNIT_G, data[0].unit);
+    TEST_ASSERT_EQUAL_INT(-3, data[0].scale);
+    /* group of 3, 4 and 5 spans the calls */
+    TEST_ASSERT_EQUAL_INT(1, phydat_dsp_decimate(&d, &data[5], 3));
+    TEST_ASSERT_EQUAL_INT(4, data[5].val[0]);
+}
+
+static void test_rescale(void)
+{
+    data[0].val[0] = 1234;
+    data[0].scale = -2;
+    data[1].val[0] = 5;
+    data[1].scale = 1;
+    data[2].val[0] = 4000;
+    data[2].scale = 0;
+    phydat_dsp_rescale(data, 3, 1, -1);
+    TEST_ASSERT_EQUAL_INT(123, data[0].val[0]);
+    TEST_ASSERT_EQUAL_INT(500, data[1].val[0]);
+    TEST_ASSERT_EQUAL_INT(INT16_MAX, data[2].val[0]);
+    TEST_ASSERT_EQUAL_INT(-1, data[2].scale);
+}
+
+static void test_convert_temp(void)
+{
+    data[0].val[0] = 2500;
+    data[0].unit = UNIT_TEMP_C;
+    data[0].scale = -2;
+    data[1].val[0] = -4000;
+    data[1].unit = UNIT_TEMP_C;
+    data[1].scale = -2;
+    TEST_ASSERT_EQUAL_INT(0, phydat_dsp_convert(data, 2, 1, UNIT_TEMP_K));
+    TEST_ASSERT_EQUAL_INT(29815, data[0].val[0]);
+    TEST_ASSERT_EQUAL_INT(-2, data[0].scale);
+    TEST_ASSERT_EQUAL_INT(UNIT_TEMP_K, data[0].unit);
+    TEST_ASSERT_EQUAL_INT(23315, data[1].val[0]);
+    TEST_ASSERT_EQUAL_INT(0, phydat_dsp_convert(data, 2, 1, UNIT_TEMP_F));
+    TEST_ASSERT_EQUAL_INT(7700, data[0].val[0]);
+    TEST_ASSERT_EQUAL_INT(-4000, data[1].val[0]);
+    TEST_ASSERT_EQUAL_INT(0, phydat_dsp_convert(data, 2, 1, UNIT_TEMP_C));
+    TEST_ASSERT_EQUAL_INT(2500, data[0].val[0]);
+    TEST_ASSERT_EQUAL_INT(-4000, data[1].val[0]);
+}
+
+static void test_convert_overflow(void)
+{
+    data[0].val[0] = 32000;
+    data[0].val[1] = 10;
+    data[0].unit = UNIT_TEMP_C;
+    TEST_ASSERT_EQUAL_INT(0, phydat_dsp_convert(data, 1, 2, UNIT_TEMP_K));
+    TEST_ASSERT_EQUAL_INT(32273, data[0].val[0]);
+    TEST_ASSERT_EQUAL_INT(283, data[0].val[1]);
+    TEST_ASSERT_EQUAL_INT(0, data[0].scale);
+    TEST_ASSERT_EQUAL_INT(0, phydat_dsp_convert(data, 1, 2, UNIT_TEMP_F));
+    TEST_ASSERT_EQUAL_INT(5763, data[0].val[0]);
+    TEST_ASSERT_EQUAL_INT(5, data[0].val[1]);
+    TEST_ASSERT_EQUAL_INT(1, data[0].scale);
+}
+
+static void test_convert_scale(void)
+{
+    data[0].val[0] = 1013;
+    data[0].unit = UNIT_BAR;
+    data[0].scale = -3;
+    TEST_ASSERT_EQUAL_INT(0, phydat_dsp_convert(data, 1, 1, UNIT_PA));
+    TEST_ASSERT_EQUAL_INT(1013, data[0].val[0]);
+    TEST_ASSERT_EQUAL_INT(2, data[0].scale);
+    TEST_ASSERT_EQUAL_INT(UNIT_PA, data[0].unit);
+}
+
+static void test_convert_invalid(void)
+{
+    data[0].unit = UNIT_TEMP_C;
+    data[1].unit = UNIT_TEMP_K;
+    TEST_ASSERT_EQUAL_INT(-EINVAL, phydat_dsp_convert(data, 2, 1, UNIT_TEMP_F));
+    TEST_ASSERT_EQUAL_INT(-ENOTSUP, phydat_dsp_convert(data, 1, 1, UNIT_LUX));
+    TEST_ASSERT_EQUAL_INT(UNIT_TEMP_C, data[0].unit);
+}
+
+Test *tests_phydat_dsp_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_mavg_init_invalid),
+        new_TestFixture(test_mavg_split),
+        new_TestFixture(test_fir_init_invalid),
+        new_TestFixture(test_fir_impulse),
+        new_TestFixture(test_fir_saturate),
+        new_TestFixture(test_iir_lowpass),
+        new_TestFixture(test_iir_post_shift),
+        new_TestFixture(test_decimate),
+        new_TestFixture(test_rescale),
+        new_TestFixture(test_convert_temp),
+        new_TestFixture(test_convert_overflow),
+        new_TestFixture(test_convert_scale),
+        new_TestFixture(test_convert_invalid),
+    };
+
+    EMB_UNIT_TESTCALLER(phydat_dsp_tests, set_up, NULL, fixtures);
+
+    return (Test *)&phydat_dsp_tests;
+}
+
+void tests_phydat_dsp(void)
+{
+    TESTS_RUN(tests_phydat_dsp_tests());
+}
+/** @} */
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  unittests
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the phydat DSP module
+ *
+ * @author      agent <agent@local>
+ */
+#ifndef TESTS_PHYDAT_DSP_H_
+#define TESTS_PHYDAT_DSP_H_
+
+#include "embUnit.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Entry point of the test suite
+ */
+void tests_phydat_dsp(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TESTS_PHYDAT_DSP_H_ */
+/** @} */
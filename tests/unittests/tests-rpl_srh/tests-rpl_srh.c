@@ -11,6 +11,7 @@
  *
  * @file
  */
+#include <errno.h>
 #include <stdlib.h>
 #include <string.h>
 #include "embUnit.h"
@@ -42,6 +43,9 @@
 
 #define SRH_SEG_LEFT        (2)
 
+#define SRH_IFACE           (5)
+#define SRH_LIFETIME        (10000U)
+
 static void test_rpl_srh_nexthop_no_prefix_elided(void)
 {
     ipv6_hdr_t hdr;
@@ -105,14 +109,144 @@ static void test_rpl_srh_nexthop_prefix_elided(void)
     TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &expected2));
 }
 
+static void test_rpl_srh_build_invalid(void)
+{
+    uint8_t buf[sizeof(gnrc_rpl_srh_t) + sizeof(ipv6_addr_t)];
+    ipv6_addr_t route[] = { IPV6_ADDR1, IPV6_ADDR2 };
+
+    TEST_ASSERT_EQUAL_INT(-EINVAL, gnrc_rpl_srh_build((gnrc_rpl_srh_t *) buf, sizeof(buf),
+                                                      route, 1));
+    TEST_ASSERT_EQUAL_INT(-ENOBUFS, gnrc_rpl_srh_build((gnrc_rpl_srh_t *) buf,
+                                                       sizeof(gnrc_rpl_srh_t), route, 2));
+}
+
+static void test_rpl_srh_build_prefix_elided(void)
+{
+    ipv6_hdr_t hdr;
+    uint8_t buf[sizeof(gnrc_rpl_srh_t) + 2 * sizeof(ipv6_addr_t)];
+    gnrc_rpl_srh_t *srh = (gnrc_rpl_srh_t *) buf;
+    ipv6_addr_t route[] = { IPV6_DST, IPV6_ADDR1, IPV6_ADDR2 };
+
+    /* 2 addresses with 15 octets elided each + 6 octets padding */
+    TEST_ASSERT_EQUAL_INT(sizeof(gnrc_rpl_srh_t) + 8,
+                          gnrc_rpl_srh_build(srh, sizeof(buf), route, 3));
+    TEST_ASSERT_EQUAL_INT(GNRC_RPL_SRH_TYPE, srh->type);
+    TEST_ASSERT_EQUAL_INT(1, srh->len);
+    TEST_ASSERT_EQUAL_INT(SRH_SEG_LEFT, srh->seg_left);
+    TEST_ASSERT_EQUAL_INT((15 << 4) | 15, srh->compr);
+    TEST_ASSERT_EQUAL_INT(6 << 4, srh->pad_resv);
+
+    hdr.dst = route[0];
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &route[1]));
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &route[2]));
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_OK, gnrc_rpl_srh_process(&hdr, srh));
+}
+
+static void test_rpl_srh_build_last_not_elided(void)
+{
+    ipv6_hdr_t hdr;
+    uint8_t buf[sizeof(gnrc_rpl_srh_t) + 2 * sizeof(ipv6_addr_t)];
+    gnrc_rpl_srh_t *srh = (gnrc_rpl_srh_t *) buf;
+    ipv6_addr_t route[] = { IPV6_DST, IPV6_ADDR1, IPV6_ADDR2 };
+
+    route[2].u8[0] = 0x30;
+
+    /* 1 address with 15 octets elided + 16 octets + 7 octets padding */
+    TEST_ASSERT_EQUAL_INT(sizeof(gnrc_rpl_srh_t) + 24,
+                          gnrc_rpl_srh_build(srh, sizeof(buf), route, 3));
+    TEST_ASSERT_EQUAL_INT((15 << 4) | 0, srh->compr);
+    TEST_ASSERT_EQUAL_INT(7 << 4, srh->pad_resv);
+
+    hdr.dst = route[0];
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &route[1]));
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &route[2]));
+}
+
+static void tear_down(void)
+{
+    ipv6_addr_t addrs[] = { IPV6_DST, IPV6_ADDR1, IPV6_ADDR2 };
+
+    for (unsigned i = 0; i < (sizeof(addrs) / sizeof(addrs[0])); i++) {
+        gnrc_rpl_srh_route_update(SRH_IFACE, &addrs[i], NULL, 0);
+    }
+}
+
+static void test_rpl_srh_cache_get_child(void)
+{
+    uint8_t buf[GNRC_RPL_SRH_CACHE_HDR_MAX];
+    ipv6_addr_t a1 = IPV6_ADDR1, next_hop;
+    kernel_pid_t iface;
+
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, gnrc_rpl_srh_cache_get(&a1, &iface, &next_hop,
+                                                                (gnrc_rpl_srh_t *) buf,
+                                                                sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_route_update(SRH_IFACE, &a1, NULL, SRH_LIFETIME));
+    /* a child of the root needs no header */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_cache_get(&a1, &iface, &next_hop,
+                                                    (gnrc_rpl_srh_t *) buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_INT(SRH_IFACE, iface);
+    TEST_ASSERT(ipv6_addr_equal(&next_hop, &a1));
+}
+
+static void test_rpl_srh_cache_get_parent_change(void)
+{
+    uint8_t buf[GNRC_RPL_SRH_CACHE_HDR_MAX];
+    gnrc_rpl_srh_t *srh = (gnrc_rpl_srh_t *) buf;
+    ipv6_hdr_t hdr;
+    ipv6_addr_t dst = IPV6_DST, a1 = IPV6_ADDR1, a2 = IPV6_ADDR2, next_hop;
+    kernel_pid_t iface;
+    int len;
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_route_update(SRH_IFACE, &a1, NULL, SRH_LIFETIME));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_route_update(SRH_IFACE, &a2, &a1, SRH_LIFETIME));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_route_update(SRH_IFACE, &dst, &a2, SRH_LIFETIME));
+
+    /* root -> a1 -> a2 -> dst */
+    len = gnrc_rpl_srh_cache_get(&dst, &iface, &next_hop, srh, sizeof(buf));
+    TEST_ASSERT(len > 0);
+    TEST_ASSERT_EQUAL_INT(SRH_IFACE, iface);
+    TEST_ASSERT(ipv6_addr_equal(&next_hop, &a1));
+    TEST_ASSERT_EQUAL_INT(SRH_SEG_LEFT, srh->seg_left);
+
+    /* a refresh keeps the cached header */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_route_update(SRH_IFACE, &dst, &a2, SRH_LIFETIME));
+    memset(buf, 0, sizeof(buf));
+    TEST_ASSERT_EQUAL_INT(len, gnrc_rpl_srh_cache_get(&dst, &iface, &next_hop, srh,
+                                                      sizeof(buf)));
+    TEST_ASSERT(ipv6_addr_equal(&next_hop, &a1));
+
+    /* a DAO moves a2 below the root: the cached header must not be used */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_route_update(SRH_IFACE, &a2, NULL, SRH_LIFETIME));
+    TEST_ASSERT(gnrc_rpl_srh_cache_get(&dst, &iface, &next_hop, srh, sizeof(buf)) > 0);
+    TEST_ASSERT(ipv6_addr_equal(&next_hop, &a2));
+    TEST_ASSERT_EQUAL_INT(SRH_SEG_LEFT - 1, srh->seg_left);
+    hdr.dst = next_hop;
+    TEST_ASSERT_EQUAL_INT(EXT_RH_CODE_FORWARD, gnrc_rpl_srh_process(&hdr, srh));
+    TEST_ASSERT(ipv6_addr_equal(&hdr.dst, &dst));
+
+    /* a No-Path DAO removes the route */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_rpl_srh_route_update(SRH_IFACE, &dst, &a2, 0));
+    TEST_ASSERT_EQUAL_INT(-EHOSTUNREACH, gnrc_rpl_srh_cache_get(&dst, &iface, &next_hop, srh,
+                                                                sizeof(buf)));
+}
+
 Test *tests_rpl_srh_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
         new_TestFixture(test_rpl_srh_nexthop_no_prefix_elided),
         new_TestFixture(test_rpl_srh_nexthop_prefix_elided),
+        new_TestFixture(test_rpl_srh_build_invalid),
+        new_TestFixture(test_rpl_srh_build_prefix_elided),
+        new_TestFixture(test_rpl_srh_build_last_not_elided),
+        new_TestFixture(test_rpl_srh_cache_get_child),
+        new_TestFixture(test_rpl_srh_cache_get_parent_change),
     };
 
-    EMB_UNIT_TESTCALLER(rpl_srh_tests, NULL, NULL, fixtures);
+    EMB_UNIT_TESTCALLER(rpl_srh_tests, NULL, tear_down, fixtures);
 
     return (Test *)&rpl_srh_tests;
 }
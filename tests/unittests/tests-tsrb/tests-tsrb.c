@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2016 agent <agent@local>
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+#include <string.h>
+
+#include "embUnit.h"
+
+#include "tsrb.h"
+
+#define BUF_SIZE    (8)
+
+static char buf[BUF_SIZE];
+static tsrb_t rb;
+
+static void set_up(void)
+{
+    tsrb_init(&rb, buf, sizeof(buf));
+}
+
+static void test_tsrb_add_get_wrap(void)
+{
+    char out[BUF_SIZE];
+
+    /* move read position, so the next add wraps around */
+    TEST_ASSERT_EQUAL_INT(6, tsrb_add(&rb, "abcdef", 6));
+    TEST_ASSERT_EQUAL_INT(5, tsrb_get(&rb, out, 5));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "abcde", 5));
+
+    /* only as many as fit */
+    TEST_ASSERT_EQUAL_INT(7, tsrb_add(&rb, "ghijklmn", 8));
+    TEST_ASSERT(tsrb_full(&rb));
+    TEST_ASSERT_EQUAL_INT(-1, tsrb_add_one(&rb, 'x'));
+
+    TEST_ASSERT_EQUAL_INT(8, tsrb_get(&rb, out, sizeof(out)));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(out, "fghijklm", 8));
+    TEST_ASSERT(tsrb_empty(&rb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_get(&rb, out, sizeof(out)));
+}
+
+static void test_tsrb_reserve_commit(void)
+{
+    char *ptr;
+
+    tsrb_add(&rb, "abcdef", 6);
+    TEST_ASSERT_EQUAL_INT('a', tsrb_get_one(&rb));
+    TEST_ASSERT_EQUAL_INT('b', tsrb_get_one(&rb));
+
+    /* free space is split at the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(2, tsrb_reserve(&rb, &ptr));
+    TEST_ASSERT(ptr == &buf[6]);
+    memcpy(ptr, "gh", 2);
+    tsrb_commit(&rb, 2);
+    TEST_ASSERT_EQUAL_INT(2, tsrb_reserve(&rb, &ptr));
+    TEST_ASSERT(ptr == &buf[0]);
+    memcpy(ptr, "i", 1);
+    tsrb_commit(&rb, 1);
+    TEST_ASSERT_EQUAL_INT(7, tsrb_avail(&rb));
+}
+
+static void test_tsrb_peek_consume(void)
+{
+    char *ptr;
+
+    tsrb_add(&rb, "abcdef", 6);
+    tsrb_consume(&rb, 5);
+    tsrb_add(&rb, "ghi", 3);
+
+    /* bytes are split at the end of the buffer */
+    TEST_ASSERT_EQUAL_INT(3, tsrb_peek_ptr(&rb, &ptr));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(ptr, "fgh", 3));
+    tsrb_consume(&rb, 3);
+    TEST_ASSERT_EQUAL_INT(1, tsrb_peek_ptr(&rb, &ptr));
+    TEST_ASSERT_EQUAL_INT('i', *ptr);
+    tsrb_consume(&rb, 1);
+    TEST_ASSERT(tsrb_empty(&rb));
+    TEST_ASSERT_EQUAL_INT(0, tsrb_peek_ptr(&rb, &ptr));
+}
+
+Test *tests_tsrb_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_tsrb_add_get_wrap),
+        new_TestFixture(test_tsrb_reserve_commit),
+        new_TestFixture(test_tsrb_peek_consume),
+    };
+
+    EMB_UNIT_TESTCALLER(tsrb_tests, set_up, NULL, fixtures);
+
+    return (Test *)&tsrb_tests;
+}
+
+void tests_tsrb(void)
+{
+    TESTS_RUN(tests_tsrb_tests());
+}